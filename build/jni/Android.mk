@@ -15,7 +15,6 @@ LOCAL_PCH := ../Prefix.h
 LOCAL_C_INCLUDES += $(LOCAL_PATH)/../../ouzel \
     $(LOCAL_PATH)/../../shaders \
     $(LOCAL_PATH)/../../external/khronos \
-	$(LOCAL_PATH)/../../external/smbPitchShift \
 	$(LOCAL_PATH)/../../external/stb
 
 LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
@@ -32,6 +31,7 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
 	../../ouzel/assets/Bundle.cpp \
 	../../ouzel/assets/Cache.cpp \
     ../../ouzel/assets/ColladaLoader.cpp \
+    ../../ouzel/assets/CookedLoader.cpp \
 	../../ouzel/assets/GltfLoader.cpp \
     ../../ouzel/assets/ImageLoader.cpp \
 	../../ouzel/assets/Loader.cpp \
@@ -43,9 +43,12 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/assets/VorbisLoader.cpp \
     ../../ouzel/assets/WaveLoader.cpp \
     ../../ouzel/audio/empty/EmptyAudioDevice.cpp \
+    ../../ouzel/audio/offline/OfflineAudioDevice.cpp \
     ../../ouzel/audio/mixer/Bus.cpp \
 	../../ouzel/audio/mixer/Mixer.cpp \
     ../../ouzel/audio/mixer/Processor.cpp \
+    ../../ouzel/audio/mixer/Spatializer.cpp \
+    ../../ouzel/audio/mixer/FFT.cpp \
     ../../ouzel/audio/mixer/Source.cpp \
     ../../ouzel/audio/mixer/SourceData.cpp \
     ../../ouzel/audio/opensl/OSLAudioDevice.cpp \
@@ -73,11 +76,15 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
 	../../ouzel/core/NativeWindow.cpp \
 	../../ouzel/core/System.cpp \
     ../../ouzel/core/Timer.cpp \
+    ../../ouzel/core/FramePacer.cpp \
+    ../../ouzel/core/UpdateScheduler.cpp \
+    ../../ouzel/core/JobSystem.cpp \
     ../../ouzel/core/Window.cpp \
     ../../ouzel/events/EventDispatcher.cpp \
     ../../ouzel/events/EventHandler.cpp \
     ../../ouzel/files/Archive.cpp \
     ../../ouzel/files/File.cpp \
+    ../../ouzel/files/FileData.cpp \
     ../../ouzel/files/FileSystem.cpp \
     ../../ouzel/graphics/empty/EmptyRenderDevice.cpp \
     ../../ouzel/graphics/opengl/android/OGLRenderDeviceAndroid.cpp \
@@ -154,17 +161,23 @@ LOCAL_SRC_FILES :=../../ouzel/animators/Animator.cpp \
     ../../ouzel/scene/Scene.cpp \
     ../../ouzel/scene/SceneManager.cpp \
     ../../ouzel/scene/ShapeRenderer.cpp \
+    ../../ouzel/scene/ProfilerOverlay.cpp \
     ../../ouzel/scene/SkinnedMeshData.cpp \
     ../../ouzel/scene/SkinnedMeshRenderer.cpp \
     ../../ouzel/scene/Sprite.cpp \
     ../../ouzel/scene/SpriteData.cpp \
     ../../ouzel/scene/StaticMeshData.cpp \
     ../../ouzel/scene/StaticMeshRenderer.cpp \
+    ../../ouzel/scene/MeshRenderer.cpp \
     ../../ouzel/scene/TextRenderer.cpp \
     ../../ouzel/utils/Log.cpp \
+    ../../ouzel/utils/JSONDocument.cpp \
+    ../../ouzel/utils/Profiler.cpp \
+    ../../ouzel/utils/MemoryTracker.cpp \
     ../../ouzel/utils/OBF.cpp \
     ../../ouzel/utils/Utils.cpp \
-    ../../ouzel/utils/XML.cpp
+    ../../ouzel/utils/XML.cpp \
+    ../../ouzel/utils/XMLDocument.cpp
 
 include $(BUILD_STATIC_LIBRARY)
 $(call import-module, android/cpufeatures)
\ No newline at end of file
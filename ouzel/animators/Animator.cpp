@@ -13,7 +13,6 @@ namespace ouzel
         Animator::Animator(float initLength):
             Component(Component::ANIMATOR), length(initLength)
         {
-            updateHandler.updateHandler = std::bind(&Animator::handleUpdate, this, std::placeholders::_1);
         }
 
         Animator::~Animator()
@@ -54,18 +53,12 @@ namespace ouzel
                 updateProgress();
             }
             else
-                updateHandler.remove();
-        }
-
-        bool Animator::handleUpdate(const UpdateEvent& event)
-        {
-            update(event.delta);
-            return false;
+                updateEntry.remove();
         }
 
         void Animator::start()
         {
-            engine->getEventDispatcher().addEventHandler(&updateHandler);
+            engine->getUpdateScheduler().add(this, updateEntry);
             play();
 
             std::unique_ptr<AnimationEvent> startEvent(new AnimationEvent());
@@ -6,7 +6,7 @@
 #include <functional>
 #include <memory>
 #include "scene/Component.hpp"
-#include "events/EventHandler.hpp"
+#include "core/UpdateScheduler.hpp"
 
 namespace ouzel
 {
@@ -47,7 +47,6 @@ namespace ouzel
             void removeFromParent();
 
         protected:
-            bool handleUpdate(const UpdateEvent& event);
             virtual void updateProgress() {}
 
             float length = 0.0F;
@@ -59,7 +58,7 @@ namespace ouzel
             Animator* parent = nullptr;
             Actor* targetActor = nullptr;
 
-            EventHandler updateHandler;
+            UpdateScheduler::Entry updateEntry;
 
             std::vector<Animator*> animators;
         };
@@ -0,0 +1,55 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_ASSETS_ASSETID_HPP
+#define OUZEL_ASSETS_ASSETID_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace ouzel
+{
+    namespace assets
+    {
+        // 64-bit FNV-1a hash of the asset name
+        // IDs of constant names can be computed at compile time and reused for lookups without hashing
+        class AssetId final
+        {
+        public:
+            constexpr AssetId() {}
+            explicit constexpr AssetId(const char* name):
+                value(hash(name, OFFSET_BASIS))
+            {
+            }
+            explicit AssetId(const std::string& name):
+                value(hash(name))
+            {
+            }
+
+            inline constexpr uint64_t getValue() const { return value; }
+
+            inline constexpr bool operator==(const AssetId& other) const { return value == other.value; }
+            inline constexpr bool operator!=(const AssetId& other) const { return value != other.value; }
+
+        private:
+            static constexpr uint64_t OFFSET_BASIS = 14695981039346656037ULL;
+            static constexpr uint64_t PRIME = 1099511628211ULL;
+
+            static constexpr uint64_t hash(const char* str, uint64_t result)
+            {
+                return *str ? hash(str + 1, (result ^ static_cast<uint8_t>(*str)) * PRIME) : result;
+            }
+
+            static uint64_t hash(const std::string& str)
+            {
+                uint64_t result = OFFSET_BASIS;
+                for (char c : str)
+                    result = (result ^ static_cast<uint8_t>(c)) * PRIME;
+                return result;
+            }
+
+            uint64_t value = 0;
+        };
+    } // namespace assets
+} // namespace ouzel
+
+#endif // OUZEL_ASSETS_ASSETID_HPP
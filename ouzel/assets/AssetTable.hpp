@@ -0,0 +1,132 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_ASSETS_ASSETTABLE_HPP
+#define OUZEL_ASSETS_ASSETTABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "assets/AssetId.hpp"
+
+namespace ouzel
+{
+    namespace assets
+    {
+        // assets stored by their ID
+        // the entries are kept in insertion order and are not moved, so pointers to the values stay valid until clear()
+        // the index is an open addressing hash table with linear probing that stores positions of the entries
+        template<class T>
+        class AssetTable final
+        {
+        public:
+            struct Entry
+            {
+                AssetId id;
+                std::string name;
+                T value;
+            };
+
+            inline typename std::deque<Entry>::const_iterator begin() const { return entries.begin(); }
+            inline typename std::deque<Entry>::const_iterator end() const { return entries.end(); }
+
+            inline size_t size() const { return entries.size(); }
+            inline bool empty() const { return entries.empty(); }
+
+            T* find(AssetId id)
+            {
+                uint32_t position = findPosition(id);
+                return (position == EMPTY) ? nullptr : &entries[position].value;
+            }
+
+            const T* find(AssetId id) const
+            {
+                uint32_t position = findPosition(id);
+                return (position == EMPTY) ? nullptr : &entries[position].value;
+            }
+
+            // replaces the value if the name is already in the table
+            void insert(AssetId id, const std::string& name, const T& value)
+            {
+                uint32_t position = findPosition(id);
+
+                if (position != EMPTY)
+                {
+                    Entry& entry = entries[position];
+                    if (entry.name != name)
+                        throw std::runtime_error("Asset ID of " + name + " collides with " + entry.name);
+
+                    entry.value = value;
+                    return;
+                }
+
+                // keep the load factor at or below 0.5
+                if ((entries.size() + 1) * 2 > index.size())
+                    rehash(index.empty() ? 16 : index.size() * 2);
+
+                entries.push_back(Entry{id, name, value});
+                index[findSlot(id)] = static_cast<uint32_t>(entries.size() - 1);
+            }
+
+            void clear()
+            {
+                entries.clear();
+                index.clear();
+            }
+
+        private:
+            static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+
+            // FNV-1a does not mix the high bits into the low bits well enough on short names
+            static inline size_t mix(uint64_t value)
+            {
+                value ^= value >> 33;
+                value *= 0xFF51AFD7ED558CCDULL;
+                value ^= value >> 33;
+                return static_cast<size_t>(value);
+            }
+
+            uint32_t findPosition(AssetId id) const
+            {
+                if (index.empty()) return EMPTY;
+
+                const size_t mask = index.size() - 1;
+
+                for (size_t slot = mix(id.getValue()) & mask;; slot = (slot + 1) & mask)
+                {
+                    uint32_t position = index[slot];
+                    if (position == EMPTY || entries[position].id == id)
+                        return position;
+                }
+            }
+
+            size_t findSlot(AssetId id) const
+            {
+                const size_t mask = index.size() - 1;
+
+                size_t slot = mix(id.getValue()) & mask;
+                while (index[slot] != EMPTY)
+                    slot = (slot + 1) & mask;
+
+                return slot;
+            }
+
+            void rehash(size_t capacity)
+            {
+                index.assign(capacity, EMPTY);
+
+                for (size_t position = 0; position < entries.size(); ++position)
+                    index[findSlot(entries[position].id)] = static_cast<uint32_t>(position);
+            }
+
+            std::deque<Entry> entries;
+            std::vector<uint32_t> index; // size is zero or a power of two
+        };
+
+        template<class T>
+        constexpr uint32_t AssetTable<T>::EMPTY;
+    } // namespace assets
+} // namespace ouzel
+
+#endif // OUZEL_ASSETS_ASSETTABLE_HPP
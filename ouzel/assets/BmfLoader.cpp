@@ -2,6 +2,7 @@
 
 #include "BmfLoader.hpp"
 #include "Bundle.hpp"
+#include "Cache.hpp"
 #include "gui/BMFont.hpp"
 
 namespace ouzel
@@ -19,6 +20,7 @@ namespace ouzel
             {
                 // TODO: move the loader here
                 std::shared_ptr<BMFont> font = std::make_shared<BMFont>(data);
+                font->setTexture(cache.getTexture(font->getTextureFilename()));
                 bundle.setFont(filename, font);
             }
             catch (const std::exception&)
@@ -28,5 +30,31 @@ namespace ouzel
 
             return true;
         }
+
+        bool BmfLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            std::shared_ptr<BMFont> font;
+
+            try
+            {
+                font = std::make_shared<BMFont>(data.toVector());
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+
+            // the page texture is loaded before the font is added to the bundle
+            if (!font->getTextureFilename().empty())
+                result.dependencies.push_back(Asset(Loader::IMAGE, font->getTextureFilename(), mipmaps));
+
+            result.create = [this, &bundle, filename, font]() {
+                font->setTexture(cache.getTexture(font->getTextureFilename()));
+                bundle.setFont(filename, font);
+                return true;
+            };
+
+            return true;
+        }
     } // namespace assets
 } // namespace ouzel
@@ -1,16 +1,42 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
+#include <algorithm>
 #include <cctype>
+#include <exception>
+#include <set>
 #include <stdexcept>
 #include "Bundle.hpp"
 #include "Cache.hpp"
 #include "Loader.hpp"
+#include "core/Engine.hpp"
 #include "utils/JSON.hpp"
+#include "utils/Profiler.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
+        struct AsyncLoad::Node final
+        {
+            explicit Node(const Asset& initAsset): asset(initAsset) {}
+
+            Asset asset;
+            Loader::PreparedAsset prepared;
+            // set on a worker thread before the node is passed to the update thread
+            std::string error;
+            uint32_t pendingDependencies = 0;
+            std::vector<Node*> dependents;
+            bool created = false;
+        };
+
+        AsyncLoad::AsyncLoad()
+        {
+        }
+
+        AsyncLoad::~AsyncLoad()
+        {
+        }
+
         Bundle::Bundle(Cache& initCache, FileSystem& initFileSystem):
             cache(initCache), fileSystem(initFileSystem)
         {
@@ -19,21 +45,54 @@ namespace ouzel
 
         Bundle::~Bundle()
         {
+            setWatchFiles(false);
             cache.removeBundle(this);
         }
 
+        static const char* getLoaderZoneName(uint32_t loaderType)
+        {
+            switch (loaderType)
+            {
+                case Loader::FONT: return "Loader::FONT";
+                case Loader::STATIC_MESH: return "Loader::STATIC_MESH";
+                case Loader::SKINNED_MESH: return "Loader::SKINNED_MESH";
+                case Loader::IMAGE: return "Loader::IMAGE";
+                case Loader::MATERIAL: return "Loader::MATERIAL";
+                case Loader::PARTICLE_SYSTEM: return "Loader::PARTICLE_SYSTEM";
+                case Loader::SPRITE: return "Loader::SPRITE";
+                case Loader::SOUND: return "Loader::SOUND";
+                default: return "Loader";
+            }
+        }
+
         void Bundle::loadAsset(uint32_t loaderType, const std::string& filename, bool mipmaps)
         {
-            std::vector<uint8_t> data = fileSystem.readFile(filename);
+            OUZEL_PROFILE_ZONE("Bundle::loadAsset");
+
+            FileData data;
+            {
+                OUZEL_PROFILE_ZONE("FileSystem::mapFile");
+                data = fileSystem.mapFile(filename);
+            }
+
+            loadAsset(loaderType, filename, data, mipmaps);
+        }
 
+        void Bundle::loadAsset(uint32_t loaderType, const std::string& filename, const FileData& data, bool mipmaps)
+        {
             auto loaders = cache.getLoaders();
 
+            OUZEL_PROFILE_ZONE(getLoaderZoneName(loaderType));
+
             for (auto i = loaders.rbegin(); i != loaders.rend(); ++i)
             {
                 Loader* loader = *i;
                 if (loader->getType() == loaderType &&
                     loader->loadAsset(*this, filename, data, mipmaps))
+                {
+                    if (watchFiles) watchAsset(Asset(loaderType, filename, mipmaps));
                     return;
+                }
             }
 
             throw std::runtime_error("Failed to load asset " + filename);
@@ -43,32 +102,328 @@ namespace ouzel
         {
             json::Data data(fileSystem.readFile(filename));
 
+            std::vector<Asset> assets;
+
             for (const json::Value& asset : data["assets"].as<json::Value::Array>())
             {
                 bool mipmaps = asset.hasMember("mipmaps") ? asset["mipmaps"].as<bool>() : true;
-                loadAsset(asset["type"].as<uint32_t>(), asset["filename"].as<std::string>(), mipmaps);
+                assets.push_back(Asset(asset["type"].as<uint32_t>(), asset["filename"].as<std::string>(), mipmaps));
             }
+
+            loadAssets(assets);
         }
 
         void Bundle::loadAssets(const std::vector<Asset>& assets)
         {
+            OUZEL_PROFILE_ZONE("Bundle::loadAssets");
+
+            JobSystem* jobSystem = engine->getJobSystem();
+
+            // only one file per worker is mapped (and decompressed) at a time, so that the memory use does not grow with the number of assets
+            const size_t batchSize = jobSystem ? std::max(jobSystem->getThreadCount(), 1U) : 1;
+
+            std::vector<FileData> files(batchSize);
+            std::vector<std::exception_ptr> errors(batchSize);
+
+            for (size_t batchStart = 0; batchStart < assets.size(); batchStart += batchSize)
+            {
+                const size_t count = std::min(batchSize, assets.size() - batchStart);
+
+                {
+                    OUZEL_PROFILE_ZONE("FileSystem::mapFile");
+
+                    auto readFiles = [this, &assets, &files, &errors, batchStart](uint32_t begin, uint32_t end) {
+                        for (uint32_t i = begin; i < end; ++i)
+                        {
+                            try
+                            {
+                                files[i] = fileSystem.mapFile(assets[batchStart + i].filename);
+                            }
+                            catch (...)
+                            {
+                                errors[i] = std::current_exception();
+                            }
+                        }
+                    };
+
+                    if (jobSystem)
+                        jobSystem->parallelFor(0, static_cast<uint32_t>(count), 1, readFiles);
+                    else
+                        readFiles(0, static_cast<uint32_t>(count));
+                }
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (errors[i]) std::rethrow_exception(errors[i]);
+
+                    const Asset& asset = assets[batchStart + i];
+                    loadAsset(asset.type, asset.filename, files[i], asset.mipmaps);
+
+                    // release the decompressed data as soon as possible
+                    files[i] = FileData();
+                }
+            }
+        }
+
+        std::shared_ptr<AsyncLoad> Bundle::loadAssetsAsync(const std::vector<Asset>& assets,
+                                                           const std::function<void(const AsyncLoad&)>& callback)
+        {
+            std::shared_ptr<AsyncLoad> load = std::make_shared<AsyncLoad>();
+            load->callback = callback;
+
             for (const Asset& asset : assets)
-                loadAsset(asset.type, asset.filename, asset.mipmaps);
+                addAsyncAsset(load, asset);
+
+            if (assets.empty())
+            {
+                load->finished = true;
+                if (load->callback) load->callback(*load);
+            }
+
+            return load;
+        }
+
+        bool Bundle::isAssetLoaded(uint32_t loaderType, const std::string& filename) const
+        {
+            switch (loaderType)
+            {
+                case Loader::FONT: return cache.getFont(filename) != nullptr;
+                case Loader::STATIC_MESH: return cache.getStaticMeshData(filename) != nullptr;
+                case Loader::SKINNED_MESH: return cache.getSkinnedMeshData(filename) != nullptr;
+                case Loader::IMAGE: return cache.getTexture(filename) != nullptr;
+                case Loader::MATERIAL: return cache.getMaterial(filename) != nullptr;
+                case Loader::PARTICLE_SYSTEM: return cache.getParticleSystemData(filename) != nullptr;
+                case Loader::SPRITE: return cache.getSpriteData(filename) != nullptr;
+                case Loader::SOUND: return cache.getSound(filename) != nullptr;
+                default: return false;
+            }
+        }
+
+        AsyncLoad::Node* Bundle::addAsyncAsset(const std::shared_ptr<AsyncLoad>& load, const Asset& asset)
+        {
+            std::unique_ptr<AsyncLoad::Node>& node = load->nodes[std::make_pair(asset.type, asset.filename)];
+            if (node) return node.get();
+
+            node.reset(new AsyncLoad::Node(asset));
+            ++load->total;
+
+            AsyncLoad::Node* result = node.get();
+
+            auto prepare = [this, load, result]() {
+                prepareAsyncAsset(result);
+
+                engine->executeOnUpdateThread([this, load, result]() {
+                    resolveDependencies(load, result);
+                });
+            };
+
+            if (JobSystem* jobSystem = engine->getJobSystem())
+                jobSystem->schedule(prepare);
+            else
+                prepare();
+
+            return result;
+        }
+
+        void Bundle::prepareAsyncAsset(AsyncLoad::Node* node)
+        {
+            OUZEL_PROFILE_ZONE("Bundle::prepareAsyncAsset");
+
+            try
+            {
+                FileData data = fileSystem.mapFile(node->asset.filename);
+
+                auto loaders = cache.getLoaders();
+
+                for (auto i = loaders.rbegin(); i != loaders.rend(); ++i)
+                {
+                    Loader* loader = *i;
+                    if (loader->getType() == node->asset.type)
+                    {
+                        node->prepared = Loader::PreparedAsset();
+
+                        if (loader->prepareAsset(*this, node->asset.filename, data, node->asset.mipmaps, node->prepared))
+                            return;
+                    }
+                }
+
+                node->prepared = Loader::PreparedAsset();
+                node->error = "Failed to load asset " + node->asset.filename;
+            }
+            catch (const std::exception& e)
+            {
+                node->prepared = Loader::PreparedAsset();
+                node->error = e.what();
+            }
+        }
+
+        bool Bundle::dependsOn(const AsyncLoad::Node* node, const AsyncLoad::Node* dependency)
+        {
+            std::vector<const AsyncLoad::Node*> stack(1, dependency);
+            std::set<const AsyncLoad::Node*> visited;
+
+            while (!stack.empty())
+            {
+                const AsyncLoad::Node* current = stack.back();
+                stack.pop_back();
+
+                for (const AsyncLoad::Node* dependent : current->dependents)
+                {
+                    if (dependent == node) return true;
+                    if (visited.insert(dependent).second) stack.push_back(dependent);
+                }
+            }
+
+            return false;
+        }
+
+        void Bundle::resolveDependencies(const std::shared_ptr<AsyncLoad>& load, AsyncLoad::Node* node)
+        {
+            for (const Asset& dependency : node->prepared.dependencies)
+            {
+                if (isAssetLoaded(dependency.type, dependency.filename)) continue;
+
+                AsyncLoad::Node* dependencyNode = addAsyncAsset(load, dependency);
+
+                if (dependencyNode != node && !dependencyNode->created)
+                {
+                    if (dependsOn(dependencyNode, node))
+                    {
+                        // the asset is created with the error once its other dependencies are done, which releases the cycle
+                        node->error = "Circular dependency between " + node->asset.filename + " and " + dependency.filename;
+                        continue;
+                    }
+
+                    dependencyNode->dependents.push_back(node);
+                    ++node->pendingDependencies;
+                }
+            }
+
+            if (!node->pendingDependencies)
+                createAsyncAsset(load, node);
+        }
+
+        void Bundle::createAsyncAsset(const std::shared_ptr<AsyncLoad>& load, AsyncLoad::Node* node)
+        {
+            if (node->error.empty())
+            {
+                OUZEL_PROFILE_ZONE(getLoaderZoneName(node->asset.type));
+
+                reloading = load->reload;
+
+                try
+                {
+                    if (!node->prepared.create())
+                        node->error = "Failed to load asset " + node->asset.filename;
+                }
+                catch (const std::exception& e)
+                {
+                    node->error = e.what();
+                }
+
+                reloading = false;
+
+                if (watchFiles && node->error.empty()) watchAsset(node->asset);
+
+                // the holders that copied the data of the asset take it from the cache again
+                if (load->reload && node->error.empty())
+                {
+                    std::unique_ptr<SystemEvent> reloadEvent = EventDispatcher::createEvent<SystemEvent>();
+                    reloadEvent->type = Event::Type::ASSET_RELOAD;
+                    reloadEvent->filename = node->asset.filename;
+                    engine->getEventDispatcher().queueEvent(std::move(reloadEvent));
+                }
+            }
+
+            if (!node->error.empty())
+            {
+                engine->log(Log::Level::ERR) << node->error;
+                load->errors.push_back(node->error);
+            }
+
+            // release the decoded data
+            node->prepared = Loader::PreparedAsset();
+            node->created = true;
+            ++load->loaded;
+
+            for (AsyncLoad::Node* dependent : node->dependents)
+                if (--dependent->pendingDependencies == 0)
+                    createAsyncAsset(load, dependent);
+
+            node->dependents.clear();
+
+            if (load->loaded == load->total && !load->finished)
+            {
+                load->finished = true;
+                if (load->callback) load->callback(*load);
+            }
         }
 
-        std::shared_ptr<graphics::Texture> Bundle::getTexture(const std::string& filename) const
+        void Bundle::setWatchFiles(bool newWatchFiles)
         {
-            auto i = textures.find(filename);
+            watchFiles = newWatchFiles;
+
+            if (!watchFiles)
+            {
+                for (const auto& watchedAsset : watchedAssets)
+                    fileSystem.unwatchFile(watchedAsset.first.first);
+
+                watchedAssets.clear();
+            }
+        }
+
+        void Bundle::watchAsset(const Asset& asset)
+        {
+            if (watchedAssets.insert(std::make_pair(std::make_pair(asset.filename, asset.type), asset.mipmaps)).second)
+                fileSystem.watchFile(asset.filename);
+        }
+
+        void Bundle::reloadAssets(const std::vector<std::string>& modifiedFiles)
+        {
+            std::vector<Asset> assets;
+
+            for (const std::string& filename : modifiedFiles)
+            {
+                for (auto i = watchedAssets.lower_bound(std::make_pair(filename, 0U));
+                     i != watchedAssets.end() && i->first.first == filename; ++i)
+                    assets.push_back(Asset(i->first.second, filename, i->second));
+            }
+
+            if (assets.empty()) return;
+
+            // the dependencies are already loaded, so only the modified files are decoded
+            std::shared_ptr<AsyncLoad> load = std::make_shared<AsyncLoad>();
+            load->reload = true;
+
+            for (const Asset& asset : assets)
+            {
+                engine->log(Log::Level::INFO) << "Reloading " << asset.filename;
+                addAsyncAsset(load, asset);
+            }
+        }
 
-            if (i != textures.end())
-                return i->second;
+        const std::shared_ptr<graphics::Texture>& Bundle::getTexture(AssetId id) const
+        {
+            static const std::shared_ptr<graphics::Texture> empty;
 
-            return nullptr;
+            const std::shared_ptr<graphics::Texture>* result = textures.find(id);
+            return result ? *result : empty;
         }
 
         void Bundle::setTexture(const std::string& filename, const std::shared_ptr<graphics::Texture>& texture)
         {
-            textures[filename] = texture;
+            if (reloading && texture)
+            {
+                std::shared_ptr<graphics::Texture>* current = textures.find(AssetId(filename));
+                if (current && *current && *current != texture)
+                {
+                    // the old device texture is released with the new texture object
+                    (*current)->swap(*texture);
+                    return;
+                }
+            }
+
+            textures.insert(AssetId(filename), filename, texture);
         }
 
         void Bundle::releaseTextures()
@@ -76,19 +431,17 @@ namespace ouzel
             textures.clear();
         }
 
-        std::shared_ptr<graphics::Shader> Bundle::getShader(const std::string& shaderName) const
+        const std::shared_ptr<graphics::Shader>& Bundle::getShader(AssetId id) const
         {
-            auto i = shaders.find(shaderName);
+            static const std::shared_ptr<graphics::Shader> empty;
 
-            if (i != shaders.end())
-                return i->second;
-
-            return nullptr;
+            const std::shared_ptr<graphics::Shader>* result = shaders.find(id);
+            return result ? *result : empty;
         }
 
         void Bundle::setShader(const std::string& shaderName, const std::shared_ptr<graphics::Shader>& shader)
         {
-            shaders[shaderName] = shader;
+            shaders.insert(AssetId(shaderName), shaderName, shader);
         }
 
         void Bundle::releaseShaders()
@@ -96,19 +449,17 @@ namespace ouzel
             shaders.clear();
         }
 
-        std::shared_ptr<graphics::BlendState> Bundle::getBlendState(const std::string& blendStateName) const
+        const std::shared_ptr<graphics::BlendState>& Bundle::getBlendState(AssetId id) const
         {
-            auto i = blendStates.find(blendStateName);
-
-            if (i != blendStates.end())
-                return i->second;
+            static const std::shared_ptr<graphics::BlendState> empty;
 
-            return nullptr;
+            const std::shared_ptr<graphics::BlendState>* result = blendStates.find(id);
+            return result ? *result : empty;
         }
 
         void Bundle::setBlendState(const std::string& blendStateName, const std::shared_ptr<graphics::BlendState>& blendState)
         {
-            blendStates[blendStateName] = blendState;
+            blendStates.insert(AssetId(blendStateName), blendStateName, blendState);
         }
 
         void Bundle::releaseBlendStates()
@@ -116,19 +467,17 @@ namespace ouzel
             blendStates.clear();
         }
 
-        std::shared_ptr<graphics::DepthStencilState> Bundle::getDepthStencilState(const std::string& depthStencilStateName) const
+        const std::shared_ptr<graphics::DepthStencilState>& Bundle::getDepthStencilState(AssetId id) const
         {
-            auto i = depthStencilStates.find(depthStencilStateName);
-
-            if (i != depthStencilStates.end())
-                return i->second;
+            static const std::shared_ptr<graphics::DepthStencilState> empty;
 
-            return nullptr;
+            const std::shared_ptr<graphics::DepthStencilState>* result = depthStencilStates.find(id);
+            return result ? *result : empty;
         }
 
         void Bundle::setDepthStencilState(const std::string& depthStencilStateName, const std::shared_ptr<graphics::DepthStencilState>& depthStencilState)
         {
-            depthStencilStates[depthStencilStateName] = depthStencilState;
+            depthStencilStates.insert(AssetId(depthStencilStateName), depthStencilStateName, depthStencilState);
         }
 
         void Bundle::releaseDepthStencilStates()
@@ -181,26 +530,21 @@ namespace ouzel
 
                     newSpriteData.animations[""] = std::move(animation);
 
-                    spriteData[filename] = newSpriteData;
+                    spriteData.insert(AssetId(filename), filename, newSpriteData);
                 }
             }
             else
                 loadAsset(Loader::SPRITE, filename, mipmaps);
         }
 
-        const scene::SpriteData* Bundle::getSpriteData(const std::string& filename) const
+        const scene::SpriteData* Bundle::getSpriteData(AssetId id) const
         {
-            auto i = spriteData.find(filename);
-
-            if (i != spriteData.end())
-                return &i->second;
-
-            return nullptr;
+            return spriteData.find(id);
         }
 
         void Bundle::setSpriteData(const std::string& filename, const scene::SpriteData& newSpriteData)
         {
-            spriteData[filename] = newSpriteData;
+            spriteData.insert(AssetId(filename), filename, newSpriteData);
         }
 
         void Bundle::releaseSpriteData()
@@ -208,19 +552,14 @@ namespace ouzel
             spriteData.clear();
         }
 
-        const scene::ParticleSystemData* Bundle::getParticleSystemData(const std::string& filename) const
+        const scene::ParticleSystemData* Bundle::getParticleSystemData(AssetId id) const
         {
-            auto i = particleSystemData.find(filename);
-
-            if (i != particleSystemData.end())
-                return &i->second;
-
-            return nullptr;
+            return particleSystemData.find(id);
         }
 
         void Bundle::setParticleSystemData(const std::string& filename, const scene::ParticleSystemData& newParticleSystemData)
         {
-            particleSystemData[filename] = newParticleSystemData;
+            particleSystemData.insert(AssetId(filename), filename, newParticleSystemData);
         }
 
         void Bundle::releaseParticleSystemData()
@@ -228,19 +567,17 @@ namespace ouzel
             particleSystemData.clear();
         }
 
-        std::shared_ptr<Font> Bundle::getFont(const std::string& filename) const
+        const std::shared_ptr<Font>& Bundle::getFont(AssetId id) const
         {
-            auto i = fonts.find(filename);
-
-            if (i != fonts.end())
-                return i->second;
+            static const std::shared_ptr<Font> empty;
 
-            return nullptr;
+            const std::shared_ptr<Font>* result = fonts.find(id);
+            return result ? *result : empty;
         }
 
         void Bundle::setFont(const std::string& filename, const std::shared_ptr<Font>& font)
         {
-            fonts[filename] = font;
+            fonts.insert(AssetId(filename), filename, font);
         }
 
         void Bundle::releaseFonts()
@@ -248,19 +585,17 @@ namespace ouzel
             fonts.clear();
         }
 
-        std::shared_ptr<audio::Sound> Bundle::getSound(const std::string& filename) const
+        const std::shared_ptr<audio::Sound>& Bundle::getSound(AssetId id) const
         {
-            auto i = sounds.find(filename);
-
-            if (i != sounds.end())
-                return i->second;
+            static const std::shared_ptr<audio::Sound> empty;
 
-            return nullptr;
+            const std::shared_ptr<audio::Sound>* result = sounds.find(id);
+            return result ? *result : empty;
         }
 
         void Bundle::setSound(const std::string& filename, const std::shared_ptr<audio::Sound>& newSound)
         {
-            sounds[filename] = newSound;
+            sounds.insert(AssetId(filename), filename, newSound);
         }
 
         void Bundle::releaseSound()
@@ -268,19 +603,34 @@ namespace ouzel
             sounds.clear();
         }
 
-        std::shared_ptr<graphics::Material> Bundle::getMaterial(const std::string& filename) const
+        const std::shared_ptr<graphics::Material>& Bundle::getMaterial(AssetId id) const
         {
-            auto i = materials.find(filename);
+            static const std::shared_ptr<graphics::Material> empty;
 
-            if (i != materials.end())
-                return i->second;
-
-            return nullptr;
+            const std::shared_ptr<graphics::Material>* result = materials.find(id);
+            return result ? *result : empty;
         }
 
         void Bundle::setMaterial(const std::string& filename, const std::shared_ptr<graphics::Material>& material)
         {
-            materials[filename] = material;
+            if (reloading && material)
+            {
+                std::shared_ptr<graphics::Material>* current = materials.find(AssetId(filename));
+                if (current && *current && *current != material)
+                {
+                    graphics::Material& currentMaterial = **current;
+                    currentMaterial.blendState = material->blendState;
+                    currentMaterial.shader = material->shader;
+                    for (uint32_t i = 0; i < graphics::Texture::LAYERS; ++i)
+                        currentMaterial.textures[i] = material->textures[i];
+                    currentMaterial.cullMode = material->cullMode;
+                    currentMaterial.diffuseColor = material->diffuseColor;
+                    currentMaterial.opacity = material->opacity;
+                    return;
+                }
+            }
+
+            materials.insert(AssetId(filename), filename, material);
         }
 
         void Bundle::releaseMaterials()
@@ -288,19 +638,14 @@ namespace ouzel
             materials.clear();
         }
 
-        const scene::SkinnedMeshData* Bundle::getSkinnedMeshData(const std::string& filename) const
+        const scene::SkinnedMeshData* Bundle::getSkinnedMeshData(AssetId id) const
         {
-            auto i = skinnedMeshData.find(filename);
-
-            if (i != skinnedMeshData.end())
-                return &i->second;
-
-            return nullptr;
+            return skinnedMeshData.find(id);
         }
 
         void Bundle::setSkinnedMeshData(const std::string& filename, const scene::SkinnedMeshData& newSkinnedMeshData)
         {
-            skinnedMeshData[filename] = newSkinnedMeshData;
+            skinnedMeshData.insert(AssetId(filename), filename, newSkinnedMeshData);
         }
 
         void Bundle::releaseSkinnedMeshData()
@@ -308,24 +653,80 @@ namespace ouzel
             skinnedMeshData.clear();
         }
 
-        const scene::StaticMeshData* Bundle::getStaticMeshData(const std::string& filename) const
+        const scene::StaticMeshData* Bundle::getStaticMeshData(AssetId id) const
         {
-            auto i = staticMeshData.find(filename);
-
-            if (i != staticMeshData.end())
-                return &i->second;
-
-            return nullptr;
+            return staticMeshData.find(id);
         }
 
         void Bundle::setStaticMeshData(const std::string& filename, const scene::StaticMeshData& newStaticMeshData)
         {
-            staticMeshData[filename] = newStaticMeshData;
+            staticMeshData.insert(AssetId(filename), filename, newStaticMeshData);
         }
 
         void Bundle::releaseStaticMeshData()
         {
             staticMeshData.clear();
         }
+
+        Bundle::MemoryUsage Bundle::getMemoryUsage() const
+        {
+            MemoryUsage result;
+            std::set<const void*> counted;
+
+            auto addTexture = [&result, &counted](const std::shared_ptr<graphics::Texture>& texture) {
+                if (texture && counted.insert(texture.get()).second)
+                    result.textures += texture->getMemoryUsage();
+            };
+
+            auto addBuffer = [&result, &counted](const std::shared_ptr<graphics::Buffer>& buffer) {
+                if (buffer && counted.insert(buffer.get()).second)
+                    result.buffers += buffer->getMemoryUsage();
+            };
+
+            auto addMaterial = [&addTexture](const std::shared_ptr<graphics::Material>& material) {
+                if (material)
+                    for (const std::shared_ptr<graphics::Texture>& texture : material->textures)
+                        addTexture(texture);
+            };
+
+            for (const auto& i : textures)
+                addTexture(i.value);
+
+            for (const auto& i : materials)
+                addMaterial(i.value);
+
+            for (const auto& i : particleSystemData)
+                addTexture(i.value.texture);
+
+            for (const auto& i : spriteData)
+            {
+                addTexture(i.value.texture);
+
+                for (const auto& animation : i.value.animations)
+                {
+                    for (const scene::SpriteData::Frame& frame : animation.second.frames)
+                    {
+                        addBuffer(frame.getIndexBuffer());
+                        addBuffer(frame.getVertexBuffer());
+                    }
+                }
+            }
+
+            for (const auto& i : skinnedMeshData)
+                addMaterial(i.value.material);
+
+            for (const auto& i : staticMeshData)
+            {
+                addMaterial(i.value.material);
+                addBuffer(i.value.indexBuffer);
+                addBuffer(i.value.vertexBuffer);
+            }
+
+            for (const auto& i : sounds)
+                if (i.value && counted.insert(i.value.get()).second)
+                    result.sounds += i.value->getMemoryUsage();
+
+            return result;
+        }
     } // namespace assets
 } // namespace ouzel
@@ -3,9 +3,15 @@
 #ifndef OUZEL_ASSETS_BUNDLE_HPP
 #define OUZEL_ASSETS_BUNDLE_HPP
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+#include "assets/AssetId.hpp"
+#include "assets/AssetTable.hpp"
 #include "audio/Sound.hpp"
 #include "files/FileSystem.hpp"
 #include "graphics/BlendState.hpp"
@@ -42,10 +48,63 @@ namespace ouzel
             bool mipmaps;
         };
 
+        class Bundle;
+
+        // progress of Bundle::loadAssetsAsync
+        class AsyncLoad final
+        {
+            friend Bundle;
+        public:
+            AsyncLoad();
+            ~AsyncLoad();
+
+            AsyncLoad(const AsyncLoad&) = delete;
+            AsyncLoad& operator=(const AsyncLoad&) = delete;
+
+            AsyncLoad(AsyncLoad&&) = delete;
+            AsyncLoad& operator=(AsyncLoad&&) = delete;
+
+            // the total grows when the dependencies of the assets are discovered
+            inline uint32_t getTotal() const { return total; }
+            inline uint32_t getLoaded() const { return loaded; }
+            inline float getProgress() const
+            {
+                uint32_t currentTotal = total;
+                return currentTotal ? static_cast<float>(loaded) / static_cast<float>(currentTotal) : 1.0F;
+            }
+            inline bool isFinished() const { return finished; }
+
+            // messages of the assets that failed to load, must be accessed on the update thread
+            inline const std::vector<std::string>& getErrors() const { return errors; }
+
+        private:
+            struct Node;
+
+            std::atomic<uint32_t> total{0};
+            std::atomic<uint32_t> loaded{0};
+            std::atomic_bool finished{false};
+            std::function<void(const AsyncLoad&)> callback;
+            bool reload = false;
+
+            // accessed only on the update thread
+            std::vector<std::string> errors;
+            std::map<std::pair<uint32_t, std::string>, std::unique_ptr<Node>> nodes;
+        };
+
         class Bundle final
         {
             friend Cache;
         public:
+            // estimated sizes in bytes, resources shared by several assets are counted once
+            struct MemoryUsage final
+            {
+                size_t textures = 0;
+                size_t buffers = 0;
+                size_t sounds = 0;
+
+                inline size_t getTotal() const { return textures + buffers + sounds; }
+            };
+
             Bundle(Cache& initCache, FileSystem& initFileSystem);
             ~Bundle();
 
@@ -57,72 +116,116 @@ namespace ouzel
 
             void loadAsset(uint32_t loaderType, const std::string& filename, bool mipmaps = true);
             void loadAssets(const std::string& filename);
+            // the files are read (and decompressed) in parallel on the job system, the loaders run on the calling thread
             void loadAssets(const std::vector<Asset>& assets);
+            // must be called on the update thread, the bundle must outlive the load
+            // the files are read and decoded on the job system and the assets are created on the update thread after their dependencies
+            // the callback is called on the update thread when all the assets are loaded
+            std::shared_ptr<AsyncLoad> loadAssetsAsync(const std::vector<Asset>& assets,
+                                                       const std::function<void(const AsyncLoad&)>& callback = nullptr);
 
             void clear();
 
-            std::shared_ptr<graphics::Texture> getTexture(const std::string& filename) const;
+            // the files of the assets loaded while watching are reloaded by the engine when they are modified,
+            // only the modified files are decoded (on the job system) and the textures and the materials are updated in place,
+            // so their holders see the new data, the other assets are replaced in the bundle and an ASSET_RELOAD system event
+            // is sent for every reloaded file (sprites, particle systems, mesh renderers and text renderers created from
+            // a filename initialize themselves again)
+            void setWatchFiles(bool newWatchFiles);
+            inline bool getWatchFiles() const { return watchFiles; }
+
+            const std::shared_ptr<graphics::Texture>& getTexture(AssetId id) const;
+            inline const std::shared_ptr<graphics::Texture>& getTexture(const std::string& filename) const { return getTexture(AssetId(filename)); }
             void setTexture(const std::string& filename, const std::shared_ptr<graphics::Texture>& texture);
             void releaseTextures();
 
-            std::shared_ptr<graphics::Shader> getShader(const std::string& shaderName) const;
+            const std::shared_ptr<graphics::Shader>& getShader(AssetId id) const;
+            inline const std::shared_ptr<graphics::Shader>& getShader(const std::string& shaderName) const { return getShader(AssetId(shaderName)); }
             void setShader(const std::string& shaderName, const std::shared_ptr<graphics::Shader>& shader);
             void releaseShaders();
 
-            std::shared_ptr<graphics::BlendState> getBlendState(const std::string& blendStateName) const;
+            const std::shared_ptr<graphics::BlendState>& getBlendState(AssetId id) const;
+            inline const std::shared_ptr<graphics::BlendState>& getBlendState(const std::string& blendStateName) const { return getBlendState(AssetId(blendStateName)); }
             void setBlendState(const std::string& blendStateName, const std::shared_ptr<graphics::BlendState>& blendState);
             void releaseBlendStates();
 
-            std::shared_ptr<graphics::DepthStencilState> getDepthStencilState(const std::string& depthStencilStateName) const;
+            const std::shared_ptr<graphics::DepthStencilState>& getDepthStencilState(AssetId id) const;
+            inline const std::shared_ptr<graphics::DepthStencilState>& getDepthStencilState(const std::string& depthStencilStateName) const { return getDepthStencilState(AssetId(depthStencilStateName)); }
             void setDepthStencilState(const std::string& depthStencilStateName, const std::shared_ptr<graphics::DepthStencilState>& depthStencilState);
             void releaseDepthStencilStates();
 
             void preloadSpriteData(const std::string& filename, bool mipmaps = true,
                                    uint32_t spritesX = 1, uint32_t spritesY = 1,
                                    const Vector2<float>& pivot = Vector2<float>(0.5F, 0.5F));
-            const scene::SpriteData* getSpriteData(const std::string& filename) const;
+            const scene::SpriteData* getSpriteData(AssetId id) const;
+            inline const scene::SpriteData* getSpriteData(const std::string& filename) const { return getSpriteData(AssetId(filename)); }
             void setSpriteData(const std::string& filename, const scene::SpriteData& newSpriteData);
             void releaseSpriteData();
 
-            const scene::ParticleSystemData* getParticleSystemData(const std::string& filename) const;
+            const scene::ParticleSystemData* getParticleSystemData(AssetId id) const;
+            inline const scene::ParticleSystemData* getParticleSystemData(const std::string& filename) const { return getParticleSystemData(AssetId(filename)); }
             void setParticleSystemData(const std::string& filename, const scene::ParticleSystemData& newParticleSystemData);
             void releaseParticleSystemData();
 
-            std::shared_ptr<Font> getFont(const std::string& filename) const;
+            const std::shared_ptr<Font>& getFont(AssetId id) const;
+            inline const std::shared_ptr<Font>& getFont(const std::string& filename) const { return getFont(AssetId(filename)); }
             void setFont(const std::string& filename, const std::shared_ptr<Font>& font);
             void releaseFonts();
 
-            std::shared_ptr<audio::Sound> getSound(const std::string& filename) const;
+            const std::shared_ptr<audio::Sound>& getSound(AssetId id) const;
+            inline const std::shared_ptr<audio::Sound>& getSound(const std::string& filename) const { return getSound(AssetId(filename)); }
             void setSound(const std::string& filename, const std::shared_ptr<audio::Sound>& newSound);
             void releaseSound();
 
-            std::shared_ptr<graphics::Material> getMaterial(const std::string& filename) const;
+            const std::shared_ptr<graphics::Material>& getMaterial(AssetId id) const;
+            inline const std::shared_ptr<graphics::Material>& getMaterial(const std::string& filename) const { return getMaterial(AssetId(filename)); }
             void setMaterial(const std::string& filename, const std::shared_ptr<graphics::Material>& material);
             void releaseMaterials();
 
-            const scene::SkinnedMeshData* getSkinnedMeshData(const std::string& filename) const;
+            const scene::SkinnedMeshData* getSkinnedMeshData(AssetId id) const;
+            inline const scene::SkinnedMeshData* getSkinnedMeshData(const std::string& filename) const { return getSkinnedMeshData(AssetId(filename)); }
             void setSkinnedMeshData(const std::string& filename, const scene::SkinnedMeshData& newSkinnedMeshData);
             void releaseSkinnedMeshData();
 
-            const scene::StaticMeshData* getStaticMeshData(const std::string& filename) const;
+            const scene::StaticMeshData* getStaticMeshData(AssetId id) const;
+            inline const scene::StaticMeshData* getStaticMeshData(const std::string& filename) const { return getStaticMeshData(AssetId(filename)); }
             void setStaticMeshData(const std::string& filename, const scene::StaticMeshData& newStaticMeshData);
             void releaseStaticMeshData();
 
+            MemoryUsage getMemoryUsage() const;
+
         private:
+            void loadAsset(uint32_t loaderType, const std::string& filename, const FileData& data, bool mipmaps);
+
+            bool isAssetLoaded(uint32_t loaderType, const std::string& filename) const;
+            AsyncLoad::Node* addAsyncAsset(const std::shared_ptr<AsyncLoad>& load, const Asset& asset);
+            void prepareAsyncAsset(AsyncLoad::Node* node);
+            void resolveDependencies(const std::shared_ptr<AsyncLoad>& load, AsyncLoad::Node* node);
+            // checks whether node waits (directly or through other assets) for the dependency to be created
+            static bool dependsOn(const AsyncLoad::Node* node, const AsyncLoad::Node* dependency);
+            void createAsyncAsset(const std::shared_ptr<AsyncLoad>& load, AsyncLoad::Node* node);
+            void watchAsset(const Asset& asset);
+            // called by the cache on the update thread
+            void reloadAssets(const std::vector<std::string>& modifiedFiles);
+
             Cache& cache;
             FileSystem& fileSystem;
 
-            std::map<std::string, std::shared_ptr<graphics::Texture>> textures;
-            std::map<std::string, std::shared_ptr<graphics::Shader>> shaders;
-            std::map<std::string, scene::ParticleSystemData> particleSystemData;
-            std::map<std::string, std::shared_ptr<graphics::BlendState>> blendStates;
-            std::map<std::string, std::shared_ptr<graphics::DepthStencilState>> depthStencilStates;
-            std::map<std::string, scene::SpriteData> spriteData;
-            std::map<std::string, std::shared_ptr<Font>> fonts;
-            std::map<std::string, std::shared_ptr<audio::Sound>> sounds;
-            std::map<std::string, std::shared_ptr<graphics::Material>> materials;
-            std::map<std::string, scene::SkinnedMeshData> skinnedMeshData;
-            std::map<std::string, scene::StaticMeshData> staticMeshData;
+            AssetTable<std::shared_ptr<graphics::Texture>> textures;
+            AssetTable<std::shared_ptr<graphics::Shader>> shaders;
+            AssetTable<scene::ParticleSystemData> particleSystemData;
+            AssetTable<std::shared_ptr<graphics::BlendState>> blendStates;
+            AssetTable<std::shared_ptr<graphics::DepthStencilState>> depthStencilStates;
+            AssetTable<scene::SpriteData> spriteData;
+            AssetTable<std::shared_ptr<Font>> fonts;
+            AssetTable<std::shared_ptr<audio::Sound>> sounds;
+            AssetTable<std::shared_ptr<graphics::Material>> materials;
+            AssetTable<scene::SkinnedMeshData> skinnedMeshData;
+            AssetTable<scene::StaticMeshData> staticMeshData;
+
+            bool watchFiles = false;
+            bool reloading = false; // set while the assets of a reload are created
+            std::map<std::pair<std::string, uint32_t>, bool> watchedAssets; // mipmaps by the filename and the loader type
         };
     } // namespace assets
 } // namespace ouzel
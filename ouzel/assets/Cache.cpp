@@ -4,6 +4,7 @@
 #include "Cache.hpp"
 #include "Bundle.hpp"
 #include "Loader.hpp"
+#include "core/Engine.hpp"
 #include "graphics/Renderer.hpp"
 #include "scene/ParticleSystemData.hpp"
 #include "scene/SpriteData.hpp"
@@ -27,7 +28,13 @@ namespace ouzel
             loaderSprite(*this),
             loaderTTF(*this),
             loaderVorbis(*this),
-            loaderWave(*this)
+            loaderWave(*this),
+            loaderGLTFStaticMesh(*this, Loader::STATIC_MESH),
+            loaderCookedImage(*this, Loader::IMAGE),
+            loaderCookedMaterial(*this, Loader::MATERIAL),
+            loaderCookedParticleSystem(*this, Loader::PARTICLE_SYSTEM),
+            loaderCookedSprite(*this, Loader::SPRITE),
+            loaderCookedStaticMesh(*this, Loader::STATIC_MESH)
         {
         }
 
@@ -45,6 +52,15 @@ namespace ouzel
                 bundles.erase(i);
         }
 
+        void Cache::reloadModifiedAssets()
+        {
+            std::vector<std::string> modifiedFiles = engine->getFileSystem().getModifiedFiles();
+            if (modifiedFiles.empty()) return;
+
+            for (Bundle* bundle : bundles)
+                bundle->reloadAssets(modifiedFiles);
+        }
+
         void Cache::addLoader(Loader* loader)
         {
             auto i = std::find(loaders.begin(), loaders.end(), loader);
@@ -59,100 +75,114 @@ namespace ouzel
                 loaders.erase(i);
         }
 
-        std::shared_ptr<graphics::Texture> Cache::getTexture(const std::string& filename) const
+        const std::shared_ptr<graphics::Texture>& Cache::getTexture(AssetId id) const
         {
+            static const std::shared_ptr<graphics::Texture> empty;
+
             for (Bundle* bundle : bundles)
-                if (std::shared_ptr<graphics::Texture> texture = bundle->getTexture(filename))
+                if (const std::shared_ptr<graphics::Texture>& texture = bundle->getTexture(id))
                     return texture;
 
-            return nullptr;
+            return empty;
         }
 
-        std::shared_ptr<graphics::Shader> Cache::getShader(const std::string& shaderName) const
+        const std::shared_ptr<graphics::Shader>& Cache::getShader(AssetId id) const
         {
+            static const std::shared_ptr<graphics::Shader> empty;
+
             for (Bundle* bundle : bundles)
-                if (std::shared_ptr<graphics::Shader> shader = bundle->getShader(shaderName))
+                if (const std::shared_ptr<graphics::Shader>& shader = bundle->getShader(id))
                     return shader;
 
-            return nullptr;
+            return empty;
         }
 
-        std::shared_ptr<graphics::BlendState> Cache::getBlendState(const std::string& blendStateName) const
+        const std::shared_ptr<graphics::BlendState>& Cache::getBlendState(AssetId id) const
         {
+            static const std::shared_ptr<graphics::BlendState> empty;
+
             for (Bundle* bundle : bundles)
-                if (std::shared_ptr<graphics::BlendState> blendState = bundle->getBlendState(blendStateName))
+                if (const std::shared_ptr<graphics::BlendState>& blendState = bundle->getBlendState(id))
                     return blendState;
 
-            return nullptr;
+            return empty;
         }
 
-        std::shared_ptr<graphics::DepthStencilState> Cache::getDepthStencilState(const std::string& depthStencilStateName) const
+        const std::shared_ptr<graphics::DepthStencilState>& Cache::getDepthStencilState(AssetId id) const
         {
+            static const std::shared_ptr<graphics::DepthStencilState> empty;
+
             for (Bundle* bundle : bundles)
-                if (std::shared_ptr<graphics::DepthStencilState> depthStencilState = bundle->getDepthStencilState(depthStencilStateName))
+                if (const std::shared_ptr<graphics::DepthStencilState>& depthStencilState = bundle->getDepthStencilState(id))
                     return depthStencilState;
 
-            return nullptr;
+            return empty;
         }
 
-        const scene::SpriteData* Cache::getSpriteData(const std::string& filename) const
+        const scene::SpriteData* Cache::getSpriteData(AssetId id) const
         {
             for (Bundle* bundle : bundles)
-                if (const scene::SpriteData* spriteData = bundle->getSpriteData(filename))
+                if (const scene::SpriteData* spriteData = bundle->getSpriteData(id))
                     return spriteData;
 
             return nullptr;
         }
 
-        const scene::ParticleSystemData* Cache::getParticleSystemData(const std::string& filename) const
+        const scene::ParticleSystemData* Cache::getParticleSystemData(AssetId id) const
         {
             for (Bundle* bundle : bundles)
-                if (const scene::ParticleSystemData* particleSystemData = bundle->getParticleSystemData(filename))
+                if (const scene::ParticleSystemData* particleSystemData = bundle->getParticleSystemData(id))
                     return particleSystemData;
 
             return nullptr;
         }
 
-        std::shared_ptr<Font> Cache::getFont(const std::string& filename) const
+        const std::shared_ptr<Font>& Cache::getFont(AssetId id) const
         {
+            static const std::shared_ptr<Font> empty;
+
             for (Bundle* bundle : bundles)
-                if (std::shared_ptr<Font> font = bundle->getFont(filename))
+                if (const std::shared_ptr<Font>& font = bundle->getFont(id))
                     return font;
 
-            return nullptr;
+            return empty;
         }
 
-        std::shared_ptr<audio::Sound> Cache::getSound(const std::string& filename) const
+        const std::shared_ptr<audio::Sound>& Cache::getSound(AssetId id) const
         {
+            static const std::shared_ptr<audio::Sound> empty;
+
             for (Bundle* bundle : bundles)
-                if (std::shared_ptr<audio::Sound> sound = bundle->getSound(filename))
+                if (const std::shared_ptr<audio::Sound>& sound = bundle->getSound(id))
                     return sound;
 
-            return nullptr;
+            return empty;
         }
 
-        std::shared_ptr<graphics::Material> Cache::getMaterial(const std::string& filename) const
+        const std::shared_ptr<graphics::Material>& Cache::getMaterial(AssetId id) const
         {
+            static const std::shared_ptr<graphics::Material> empty;
+
             for (Bundle* bundle : bundles)
-                if (std::shared_ptr<graphics::Material> material = bundle->getMaterial(filename))
+                if (const std::shared_ptr<graphics::Material>& material = bundle->getMaterial(id))
                     return material;
 
-            return nullptr;
+            return empty;
         }
 
-        const scene::SkinnedMeshData* Cache::getSkinnedMeshData(const std::string& filename) const
+        const scene::SkinnedMeshData* Cache::getSkinnedMeshData(AssetId id) const
         {
             for (Bundle* bundle : bundles)
-                if (const scene::SkinnedMeshData* meshData = bundle->getSkinnedMeshData(filename))
+                if (const scene::SkinnedMeshData* meshData = bundle->getSkinnedMeshData(id))
                     return meshData;
 
             return nullptr;
         }
 
-        const scene::StaticMeshData* Cache::getStaticMeshData(const std::string& filename) const
+        const scene::StaticMeshData* Cache::getStaticMeshData(AssetId id) const
         {
             for (Bundle* bundle : bundles)
-                if (const scene::StaticMeshData* meshData = bundle->getStaticMeshData(filename))
+                if (const scene::StaticMeshData* meshData = bundle->getStaticMeshData(id))
                     return meshData;
 
             return nullptr;
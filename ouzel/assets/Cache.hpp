@@ -9,6 +9,7 @@
 #include "assets/Bundle.hpp"
 #include "assets/BmfLoader.hpp"
 #include "assets/ColladaLoader.hpp"
+#include "assets/CookedLoader.hpp"
 #include "assets/GltfLoader.hpp"
 #include "assets/ImageLoader.hpp"
 #include "assets/MtlLoader.hpp"
@@ -42,17 +43,31 @@ namespace ouzel
             const std::vector<Bundle*>& getBundles() const { return bundles; }
             const std::vector<Loader*>& getLoaders() const { return loaders; }
 
-            std::shared_ptr<graphics::Texture> getTexture(const std::string& filename) const;
-            std::shared_ptr<graphics::Shader> getShader(const std::string& shaderName) const;
-            std::shared_ptr<graphics::BlendState> getBlendState(const std::string& blendStateName) const;
-            std::shared_ptr<graphics::DepthStencilState> getDepthStencilState(const std::string& depthStencilStateName) const;
-            const scene::SpriteData* getSpriteData(const std::string& filename) const;
-            const scene::ParticleSystemData* getParticleSystemData(const std::string& filename) const;
-            std::shared_ptr<Font> getFont(const std::string& filename) const;
-            std::shared_ptr<audio::Sound> getSound(const std::string& filename) const;
-            std::shared_ptr<graphics::Material> getMaterial(const std::string& filename) const;
-            const scene::SkinnedMeshData* getSkinnedMeshData(const std::string& filename) const;
-            const scene::StaticMeshData* getStaticMeshData(const std::string& filename) const;
+            // reloads the modified files of the bundles that watch their files, called by the engine on every update
+            void reloadModifiedAssets();
+
+            const std::shared_ptr<graphics::Texture>& getTexture(AssetId id) const;
+            inline const std::shared_ptr<graphics::Texture>& getTexture(const std::string& filename) const { return getTexture(AssetId(filename)); }
+            const std::shared_ptr<graphics::Shader>& getShader(AssetId id) const;
+            inline const std::shared_ptr<graphics::Shader>& getShader(const std::string& shaderName) const { return getShader(AssetId(shaderName)); }
+            const std::shared_ptr<graphics::BlendState>& getBlendState(AssetId id) const;
+            inline const std::shared_ptr<graphics::BlendState>& getBlendState(const std::string& blendStateName) const { return getBlendState(AssetId(blendStateName)); }
+            const std::shared_ptr<graphics::DepthStencilState>& getDepthStencilState(AssetId id) const;
+            inline const std::shared_ptr<graphics::DepthStencilState>& getDepthStencilState(const std::string& depthStencilStateName) const { return getDepthStencilState(AssetId(depthStencilStateName)); }
+            const scene::SpriteData* getSpriteData(AssetId id) const;
+            inline const scene::SpriteData* getSpriteData(const std::string& filename) const { return getSpriteData(AssetId(filename)); }
+            const scene::ParticleSystemData* getParticleSystemData(AssetId id) const;
+            inline const scene::ParticleSystemData* getParticleSystemData(const std::string& filename) const { return getParticleSystemData(AssetId(filename)); }
+            const std::shared_ptr<Font>& getFont(AssetId id) const;
+            inline const std::shared_ptr<Font>& getFont(const std::string& filename) const { return getFont(AssetId(filename)); }
+            const std::shared_ptr<audio::Sound>& getSound(AssetId id) const;
+            inline const std::shared_ptr<audio::Sound>& getSound(const std::string& filename) const { return getSound(AssetId(filename)); }
+            const std::shared_ptr<graphics::Material>& getMaterial(AssetId id) const;
+            inline const std::shared_ptr<graphics::Material>& getMaterial(const std::string& filename) const { return getMaterial(AssetId(filename)); }
+            const scene::SkinnedMeshData* getSkinnedMeshData(AssetId id) const;
+            inline const scene::SkinnedMeshData* getSkinnedMeshData(const std::string& filename) const { return getSkinnedMeshData(AssetId(filename)); }
+            const scene::StaticMeshData* getStaticMeshData(AssetId id) const;
+            inline const scene::StaticMeshData* getStaticMeshData(const std::string& filename) const { return getStaticMeshData(AssetId(filename)); }
 
         private:
             void addBundle(Bundle* bundle);
@@ -75,6 +90,14 @@ namespace ouzel
             TtfLoader loaderTTF;
             VorbisLoader loaderVorbis;
             WaveLoader loaderWave;
+            GltfLoader loaderGLTFStaticMesh; // checked before the OBJ loader
+
+            // loaders are tried in the reverse order, so the cooked assets are checked first
+            CookedLoader loaderCookedImage;
+            CookedLoader loaderCookedMaterial;
+            CookedLoader loaderCookedParticleSystem;
+            CookedLoader loaderCookedSprite;
+            CookedLoader loaderCookedStaticMesh;
         };
     } // namespace assets
 } // namespace ouzel
@@ -1,37 +1,600 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
+#include <cstring>
+#include <map>
 #include <stdexcept>
+#include <unordered_map>
 #include "ColladaLoader.hpp"
 #include "Bundle.hpp"
+#include "Cache.hpp"
+#include "core/Engine.hpp"
+#include "math/MathUtils.hpp"
+#include "math/Matrix4.hpp"
 #include "scene/SkinnedMeshData.hpp"
-#include "utils/XML.hpp"
+#include "utils/XMLDocument.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
-        ColladaLoader::ColladaLoader(Cache& initCache):
-            Loader(initCache, TYPE)
+        typedef xml::Document::Node Node;
+
+        enum class UpAxis
+        {
+            X,
+            Y,
+            Z
+        };
+
+        struct Source final
+        {
+            std::vector<float> values;
+            uint32_t stride = 1;
+        };
+
+        struct VertexKey final
+        {
+            uint32_t position;
+            uint32_t normal;
+            uint32_t texCoord;
+
+            bool operator==(const VertexKey& other) const
+            {
+                return position == other.position && normal == other.normal && texCoord == other.texCoord;
+            }
+        };
+
+        struct VertexKeyHash final
+        {
+            size_t operator()(const VertexKey& key) const
+            {
+                return (static_cast<size_t>(key.position) * 73856093U) ^
+                    (static_cast<size_t>(key.normal) * 19349663U) ^
+                    (static_cast<size_t>(key.texCoord) * 83492791U);
+            }
+        };
+
+        struct Context final
         {
+            explicit Context(ColladaLoader::MeshDescription& initMesh): mesh(initMesh) {}
+
+            ColladaLoader::MeshDescription& mesh;
+            UpAxis upAxis = UpAxis::Y;
+            std::unordered_map<std::string, const Node*> ids;
+            std::map<const Node*, Source> sources; // parsed on the first use
+            bool materialFound = false;
+        };
+
+        static const uint32_t NO_INDEX = 0xFFFFFFFF;
+
+        static inline bool isTag(const Node& node, const char* name)
+        {
+            return node.getType() == Node::Type::TAG && std::strcmp(node.getValue(), name) == 0;
         }
 
-        bool ColladaLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool)
+        // text of the node without the surrounding whitespaces
+        static std::string getText(const Node& node)
         {
-            xml::Data colladaData(data);
+            std::string result = node.getText();
 
-            if (colladaData.getChildren().empty())
-                throw std::runtime_error("Invalid Collada file");
+            size_t first = result.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos) return std::string();
+
+            size_t last = result.find_last_not_of(" \t\r\n");
+            return result.substr(first, last - first + 1);
+        }
+
+        static void collectIds(const Node& node, std::unordered_map<std::string, const Node*>& ids)
+        {
+            if (const char* id = node.getAttribute("id"))
+                ids[id] = &node;
+
+            for (const Node& child : node)
+                if (child.getType() == Node::Type::TAG) collectIds(child, ids);
+        }
+
+        static const Node* findById(const Context& context, const char* url)
+        {
+            if (!url || url[0] != '#') return nullptr;
+
+            auto i = context.ids.find(url + 1);
+            return (i == context.ids.end()) ? nullptr : i->second;
+        }
+
+        static const Node* findBySid(const Node& node, const char* sid)
+        {
+            const char* nodeSid = node.getAttribute("sid");
+            if (nodeSid && std::strcmp(nodeSid, sid) == 0) return &node;
+
+            for (const Node& child : node)
+                if (child.getType() == Node::Type::TAG)
+                    if (const Node* result = findBySid(child, sid)) return result;
+
+            return nullptr;
+        }
+
+        static const Source& getSource(Context& context, const Node& sourceNode)
+        {
+            auto i = context.sources.find(&sourceNode);
+            if (i != context.sources.end()) return i->second;
+
+            Source& source = context.sources[&sourceNode];
+
+            if (const Node* floatArray = sourceNode.findChild("float_array"))
+            {
+                // the numbers are parsed straight from the text in the document
+                if (const char* count = floatArray->getAttribute("count"))
+                    source.values.reserve(std::strtoul(count, nullptr, 10));
+
+                xml::parseFloats(floatArray->getText(), source.values);
+            }
+
+            if (const Node* techniqueCommon = sourceNode.findChild("technique_common"))
+                if (const Node* accessor = techniqueCommon->findChild("accessor"))
+                    if (const char* stride = accessor->getAttribute("stride"))
+                        source.stride = static_cast<uint32_t>(std::strtoul(stride, nullptr, 10));
+
+            if (source.stride == 0)
+                throw std::runtime_error("Invalid accessor stride");
+
+            return source;
+        }
+
+        static Vector3<float> convertUpAxis(const Vector3<float>& vector, UpAxis upAxis)
+        {
+            switch (upAxis)
+            {
+                case UpAxis::X: return Vector3<float>(-vector.v[1], vector.v[0], vector.v[2]);
+                case UpAxis::Z: return Vector3<float>(vector.v[0], vector.v[2], -vector.v[1]);
+                default: return vector;
+            }
+        }
+
+        static std::string getImageFilename(const Context& context, const char* imageId)
+        {
+            auto i = context.ids.find(imageId);
+            if (i == context.ids.end()) return std::string();
+
+            const Node* initFrom = i->second->findChild("init_from");
+            if (!initFrom) return std::string();
+
+            // COLLADA 1.5 stores the path in a ref element
+            std::string filename = getText(initFrom->findChild("ref") ? *initFrom->findChild("ref") : *initFrom);
+
+            if (filename.compare(0, 7, "file://") == 0) filename = filename.substr(7);
+            if (filename.compare(0, 2, "./") == 0) filename = filename.substr(2);
+
+            return filename;
+        }
+
+        // follows the sampler and the surface parameters of the effect to the image
+        static std::string getTextureFilename(const Context& context, const Node& effect, const char* texture)
+        {
+            if (const Node* samplerParam = findBySid(effect, texture))
+                if (const Node* sampler = samplerParam->findChild("sampler2D"))
+                    if (const Node* source = sampler->findChild("source"))
+                        if (const Node* surfaceParam = findBySid(effect, getText(*source).c_str()))
+                            if (const Node* surface = surfaceParam->findChild("surface"))
+                                if (const Node* initFrom = surface->findChild("init_from"))
+                                    return getImageFilename(context, getText(*initFrom).c_str());
+
+            // some exporters reference the image directly
+            return getImageFilename(context, texture);
+        }
+
+        static void readMaterial(Context& context, const Node* bindMaterial, const char* symbol)
+        {
+            if (context.materialFound || !bindMaterial || !symbol) return;
+
+            const Node* techniqueCommon = bindMaterial->findChild("technique_common");
+            if (!techniqueCommon) return;
+
+            const Node* material = nullptr;
+            for (const Node& instanceMaterial : *techniqueCommon)
+            {
+                const char* materialSymbol = instanceMaterial.getAttribute("symbol");
+                if (isTag(instanceMaterial, "instance_material") && materialSymbol && std::strcmp(materialSymbol, symbol) == 0)
+                    material = findById(context, instanceMaterial.getAttribute("target"));
+            }
+
+            if (!material) return;
+
+            const Node* instanceEffect = material->findChild("instance_effect");
+            const Node* effect = instanceEffect ? findById(context, instanceEffect->getAttribute("url")) : nullptr;
+            if (!effect) return;
+
+            const Node* profile = effect->findChild("profile_COMMON");
+            const Node* technique = profile ? profile->findChild("technique") : nullptr;
+            if (!technique) return;
+
+            context.materialFound = true;
+
+            for (const Node& shading : *technique)
+            {
+                if (shading.getType() != Node::Type::TAG) continue;
+
+                if (const Node* diffuse = shading.findChild("diffuse"))
+                {
+                    if (const Node* color = diffuse->findChild("color"))
+                    {
+                        std::vector<float> values;
+                        xml::parseFloats(color->getText(), values);
+                        values.resize(4, 1.0F);
+                        context.mesh.diffuseColor = Color(values.data());
+                    }
+                    else if (const Node* texture = diffuse->findChild("texture"))
+                    {
+                        if (const char* textureName = texture->getAttribute("texture"))
+                            context.mesh.diffuseTexture = getTextureFilename(context, *effect, textureName);
+                    }
+                }
+
+                if (const Node* transparency = shading.findChild("transparency"))
+                    if (const Node* value = transparency->findChild("float"))
+                    {
+                        std::vector<float> values;
+                        if (xml::parseFloats(value->getText(), values) != 1)
+                            throw std::runtime_error("Invalid transparency");
+                        context.mesh.opacity = values[0];
+                    }
+
+                break;
+            }
+        }
+
+        static void readPrimitive(Context& context, const Node& primitive,
+                                  const Matrix4<float>& transform, const Node* bindMaterial)
+        {
+            const Source* positions = nullptr;
+            const Source* normals = nullptr;
+            const Source* texCoords = nullptr;
+            uint32_t positionOffset = NO_INDEX;
+            uint32_t normalOffset = NO_INDEX;
+            uint32_t texCoordOffset = NO_INDEX;
+            uint32_t stride = 0;
+
+            for (const Node& input : primitive)
+            {
+                if (!isTag(input, "input")) continue;
 
-            xml::Node rootNode = colladaData.getChildren().front();
+                const char* semantic = input.getAttribute("semantic");
+                const char* offsetAttribute = input.getAttribute("offset");
+                const Node* source = findById(context, input.getAttribute("source"));
+                if (!semantic || !offsetAttribute || !source) continue;
 
-            if (rootNode.getValue() != "COLLADA")
+                uint32_t offset = static_cast<uint32_t>(std::strtoul(offsetAttribute, nullptr, 10));
+                if (offset + 1 > stride) stride = offset + 1;
+
+                if (std::strcmp(semantic, "VERTEX") == 0)
+                {
+                    // the vertices element lists the per-vertex sources
+                    for (const Node& vertexInput : *source)
+                    {
+                        if (!isTag(vertexInput, "input")) continue;
+
+                        const char* vertexSemantic = vertexInput.getAttribute("semantic");
+                        const Node* vertexSource = findById(context, vertexInput.getAttribute("source"));
+                        if (!vertexSemantic || !vertexSource) continue;
+
+                        if (std::strcmp(vertexSemantic, "POSITION") == 0)
+                        {
+                            positions = &getSource(context, *vertexSource);
+                            positionOffset = offset;
+                        }
+                        else if (std::strcmp(vertexSemantic, "NORMAL") == 0 && !normals)
+                        {
+                            normals = &getSource(context, *vertexSource);
+                            normalOffset = offset;
+                        }
+                        else if (std::strcmp(vertexSemantic, "TEXCOORD") == 0 && !texCoords)
+                        {
+                            texCoords = &getSource(context, *vertexSource);
+                            texCoordOffset = offset;
+                        }
+                    }
+                }
+                else if (std::strcmp(semantic, "NORMAL") == 0)
+                {
+                    normals = &getSource(context, *source);
+                    normalOffset = offset;
+                }
+                else if (std::strcmp(semantic, "TEXCOORD") == 0 && !texCoords) // only the first set is used
+                {
+                    texCoords = &getSource(context, *source);
+                    texCoordOffset = offset;
+                }
+            }
+
+            if (!positions || positions->stride < 3)
+                throw std::runtime_error("Primitive has no positions");
+
+            const Node* p = primitive.findChild("p");
+            if (!p) return;
+
+            std::vector<uint32_t> indices;
+            xml::parseUInts(p->getText(), indices);
+
+            // the number of vertices of each polygon
+            std::vector<uint32_t> vertexCounts;
+            if (isTag(primitive, "polylist"))
+            {
+                if (const Node* vcount = primitive.findChild("vcount"))
+                    xml::parseUInts(vcount->getText(), vertexCounts);
+            }
+            else
+                vertexCounts.assign(indices.size() / stride / 3, 3);
+
+            readMaterial(context, bindMaterial, primitive.getAttribute("material"));
+
+            ColladaLoader::MeshDescription& meshDescription = context.mesh;
+            std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertexMap;
+            std::vector<uint32_t> polygon;
+            const uint32_t* index = indices.data();
+            const uint32_t* indicesEnd = indices.data() + indices.size();
+
+            for (uint32_t vertexCount : vertexCounts)
+            {
+                if (static_cast<size_t>(indicesEnd - index) < static_cast<size_t>(vertexCount) * stride)
+                    throw std::runtime_error("Not enough indices");
+
+                polygon.clear();
+
+                for (uint32_t i = 0; i < vertexCount; ++i, index += stride)
+                {
+                    VertexKey key;
+                    key.position = index[positionOffset];
+                    key.normal = (normalOffset == NO_INDEX) ? NO_INDEX : index[normalOffset];
+                    key.texCoord = (texCoordOffset == NO_INDEX) ? NO_INDEX : index[texCoordOffset];
+
+                    auto vertexIterator = vertexMap.find(key);
+                    if (vertexIterator != vertexMap.end())
+                    {
+                        polygon.push_back(vertexIterator->second);
+                        continue;
+                    }
+
+                    graphics::Vertex vertex;
+                    vertex.color = Color::WHITE;
+
+                    if ((static_cast<size_t>(key.position) + 1) * positions->stride > positions->values.size())
+                        throw std::runtime_error("Invalid position index");
+
+                    const float* position = positions->values.data() + key.position * positions->stride;
+                    transform.transformPoint(Vector3<float>(position[0], position[1], position[2]), vertex.position);
+                    vertex.position = convertUpAxis(vertex.position, context.upAxis);
+
+                    if (key.normal != NO_INDEX && normals->stride >= 3)
+                    {
+                        if ((static_cast<size_t>(key.normal) + 1) * normals->stride > normals->values.size())
+                            throw std::runtime_error("Invalid normal index");
+
+                        const float* normal = normals->values.data() + key.normal * normals->stride;
+                        transform.transformVector(Vector3<float>(normal[0], normal[1], normal[2]), vertex.normal);
+                        vertex.normal.normalize();
+                        vertex.normal = convertUpAxis(vertex.normal, context.upAxis);
+                    }
+
+                    if (key.texCoord != NO_INDEX && texCoords->stride >= 2)
+                    {
+                        if ((static_cast<size_t>(key.texCoord) + 1) * texCoords->stride > texCoords->values.size())
+                            throw std::runtime_error("Invalid texture coordinate index");
+
+                        const float* texCoord = texCoords->values.data() + key.texCoord * texCoords->stride;
+                        vertex.texCoords[0] = Vector2<float>(texCoord[0], texCoord[1]);
+                    }
+
+                    uint32_t vertexIndex = static_cast<uint32_t>(meshDescription.vertices.size());
+                    vertexMap[key] = vertexIndex;
+                    meshDescription.vertices.push_back(vertex);
+                    meshDescription.boundingBox.insertPoint(vertex.position);
+                    polygon.push_back(vertexIndex);
+                }
+
+                // triangle fan
+                for (uint32_t i = 1; i + 1 < polygon.size(); ++i)
+                {
+                    meshDescription.indices.push_back(polygon[0]);
+                    meshDescription.indices.push_back(polygon[i]);
+                    meshDescription.indices.push_back(polygon[i + 1]);
+                }
+            }
+        }
+
+        static void readGeometry(Context& context, const Node& geometry,
+                                 const Matrix4<float>& transform, const Node* bindMaterial)
+        {
+            const Node* mesh = geometry.findChild("mesh");
+            if (!mesh) return; // splines and convex meshes are not supported
+
+            for (const Node& primitive : *mesh)
+                if (isTag(primitive, "triangles") || isTag(primitive, "polylist"))
+                    readPrimitive(context, primitive, transform, bindMaterial);
+        }
+
+        static void readNode(Context& context, const Node& node, const Matrix4<float>& parentTransform)
+        {
+            Matrix4<float> transform = parentTransform;
+
+            // the transformations are applied in the order they are listed
+            for (const Node& child : node)
+            {
+                if (child.getType() != Node::Type::TAG) continue;
+
+                std::vector<float> values;
+
+                if (isTag(child, "matrix"))
+                {
+                    xml::parseFloats(child.getText(), values);
+                    if (values.size() != 16)
+                        throw std::runtime_error("Invalid matrix");
+
+                    // the matrices are stored in row-major order
+                    transform *= Matrix4<float>(values[0], values[1], values[2], values[3],
+                                                values[4], values[5], values[6], values[7],
+                                                values[8], values[9], values[10], values[11],
+                                                values[12], values[13], values[14], values[15]);
+                }
+                else if (isTag(child, "translate"))
+                {
+                    xml::parseFloats(child.getText(), values);
+                    if (values.size() != 3)
+                        throw std::runtime_error("Invalid translation");
+
+                    transform.translate(values[0], values[1], values[2]);
+                }
+                else if (isTag(child, "rotate"))
+                {
+                    xml::parseFloats(child.getText(), values);
+                    if (values.size() != 4)
+                        throw std::runtime_error("Invalid rotation");
+
+                    transform.rotate(Vector3<float>(values[0], values[1], values[2]), degToRad(values[3]));
+                }
+                else if (isTag(child, "scale"))
+                {
+                    xml::parseFloats(child.getText(), values);
+                    if (values.size() != 3)
+                        throw std::runtime_error("Invalid scale");
+
+                    transform.scale(values[0], values[1], values[2]);
+                }
+            }
+
+            for (const Node& child : node)
+            {
+                if (isTag(child, "instance_geometry"))
+                {
+                    if (const Node* geometry = findById(context, child.getAttribute("url")))
+                        readGeometry(context, *geometry, transform, child.findChild("bind_material"));
+                }
+                else if (isTag(child, "instance_controller"))
+                {
+                    // skins are read in the bind pose
+                    const Node* controller = findById(context, child.getAttribute("url"));
+                    const Node* skin = controller ? controller->findChild("skin") : nullptr;
+                    const Node* geometry = skin ? findById(context, skin->getAttribute("source")) : nullptr;
+
+                    if (geometry)
+                    {
+                        Matrix4<float> skinTransform = transform;
+
+                        if (const Node* bindShapeMatrix = skin->findChild("bind_shape_matrix"))
+                        {
+                            std::vector<float> values;
+                            xml::parseFloats(bindShapeMatrix->getText(), values);
+                            if (values.size() != 16)
+                                throw std::runtime_error("Invalid bind shape matrix");
+
+                            skinTransform *= Matrix4<float>(values[0], values[1], values[2], values[3],
+                                                            values[4], values[5], values[6], values[7],
+                                                            values[8], values[9], values[10], values[11],
+                                                            values[12], values[13], values[14], values[15]);
+                        }
+
+                        readGeometry(context, *geometry, skinTransform, child.findChild("bind_material"));
+                    }
+                }
+                else if (isTag(child, "node"))
+                    readNode(context, child, transform);
+            }
+        }
+
+        void ColladaLoader::parseMesh(const FileData& data, MeshDescription& mesh)
+        {
+            xml::Document document(data.toVector());
+
+            const Node* root = document.getRoot();
+            if (!root || std::strcmp(root->getValue(), "COLLADA") != 0)
                 throw std::runtime_error("Invalid Collada file");
 
-            scene::SkinnedMeshData meshData;
+            Context context(mesh);
+            collectIds(*root, context.ids);
 
-            // TODO: load the model
+            if (const Node* asset = root->findChild("asset"))
+            {
+                if (const Node* upAxis = asset->findChild("up_axis"))
+                {
+                    std::string axis = getText(*upAxis);
+                    if (axis == "X_UP") context.upAxis = UpAxis::X;
+                    else if (axis == "Z_UP") context.upAxis = UpAxis::Z;
+                }
+            }
 
+            const Node* scene = root->findChild("scene");
+            const Node* instanceVisualScene = scene ? scene->findChild("instance_visual_scene") : nullptr;
+            const Node* visualScene = instanceVisualScene ? findById(context, instanceVisualScene->getAttribute("url")) : nullptr;
+
+            if (visualScene)
+            {
+                for (const Node& node : *visualScene)
+                    if (isTag(node, "node"))
+                        readNode(context, node, Matrix4<float>::identity());
+            }
+            else if (const Node* geometries = root->findChild("library_geometries"))
+            {
+                // files without a scene contain only the geometries
+                for (const Node& geometry : *geometries)
+                    if (isTag(geometry, "geometry"))
+                        readGeometry(context, geometry, Matrix4<float>::identity(), nullptr);
+            }
+        }
+
+        static void createSkinnedMesh(Bundle& bundle, Cache& cache, const std::string& filename,
+                                      const ColladaLoader::MeshDescription& mesh, bool mipmaps)
+        {
+            std::shared_ptr<graphics::Material> material = std::make_shared<graphics::Material>();
+            material->blendState = cache.getBlendState(BLEND_ALPHA);
+            material->shader = cache.getShader(SHADER_TEXTURE);
+
+            if (!mesh.diffuseTexture.empty())
+            {
+                material->textures[0] = cache.getTexture(mesh.diffuseTexture);
+
+                if (!material->textures[0])
+                {
+                    bundle.loadAsset(Loader::IMAGE, mesh.diffuseTexture, mipmaps);
+                    material->textures[0] = cache.getTexture(mesh.diffuseTexture);
+                }
+            }
+
+            material->diffuseColor = mesh.diffuseColor;
+            material->opacity = mesh.opacity;
+
+            scene::SkinnedMeshData meshData(mesh.boundingBox, mesh.indices, mesh.vertices, material);
             bundle.setSkinnedMeshData(filename, meshData);
+        }
+
+        ColladaLoader::ColladaLoader(Cache& initCache):
+            Loader(initCache, TYPE)
+        {
+        }
+
+        bool ColladaLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, FileData(data.data(), data.size()), mipmaps);
+        }
+
+        bool ColladaLoader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps)
+        {
+            MeshDescription mesh;
+            parseMesh(data, mesh);
+            createSkinnedMesh(bundle, cache, filename, mesh, mipmaps);
+
+            return true;
+        }
+
+        bool ColladaLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            std::shared_ptr<MeshDescription> mesh = std::make_shared<MeshDescription>();
+            parseMesh(data, *mesh);
+
+            if (!mesh->diffuseTexture.empty())
+                result.dependencies.push_back(Asset(Loader::IMAGE, mesh->diffuseTexture, mipmaps));
+
+            result.create = [this, &bundle, filename, mesh, mipmaps]() {
+                createSkinnedMesh(bundle, cache, filename, *mesh, mipmaps);
+                return true;
+            };
 
             return true;
         }
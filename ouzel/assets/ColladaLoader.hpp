@@ -3,7 +3,12 @@
 #ifndef OUZEL_ASSETS_COLLADALOADER_HPP
 #define OUZEL_ASSETS_COLLADALOADER_HPP
 
+#include <string>
+#include <vector>
 #include "assets/Loader.hpp"
+#include "graphics/Vertex.hpp"
+#include "math/Box3.hpp"
+#include "math/Color.hpp"
 
 namespace ouzel
 {
@@ -14,8 +19,25 @@ namespace ouzel
         public:
             static constexpr uint32_t TYPE = Loader::SKINNED_MESH;
 
+            struct MeshDescription final
+            {
+                Box3<float> boundingBox;
+                std::vector<uint32_t> indices;
+                std::vector<graphics::Vertex> vertices;
+                std::string diffuseTexture;
+                Color diffuseColor = Color::WHITE;
+                float opacity = 1.0F;
+            };
+
+            // merges the geometries of the visual scene into one mesh in the bind pose with the material of the first bound primitive
+            // the triangles and the polylists are read, the positions and the normals are converted to Y up
+            // can be called without an engine
+            static void parseMesh(const FileData& data, MeshDescription& mesh);
+
             explicit ColladaLoader(Cache& initCache);
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
@@ -0,0 +1,400 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <cstring>
+#include <stdexcept>
+#include "CookedLoader.hpp"
+#include "Bundle.hpp"
+#include "Cache.hpp"
+#include "core/Engine.hpp"
+#include "scene/SpriteData.hpp"
+#include "scene/StaticMeshData.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    namespace assets
+    {
+        // reads the values of a cooked asset in order, checks all the offsets against the size of the data
+        class CookedReader final
+        {
+        public:
+            explicit CookedReader(const FileData& initData):
+                data(initData)
+            {
+                if (!CookedLoader::isCooked(data))
+                    throw std::runtime_error("Not a cooked asset");
+
+                if (getUInt32(4) != CookedLoader::VERSION)
+                    throw std::runtime_error("Unsupported version of cooked asset");
+
+                type = getUInt32(8);
+
+                if (getUInt32(12) != sizeof(graphics::Vertex))
+                    throw std::runtime_error("Cooked asset has a different vertex layout");
+
+                stringCount = getUInt32(16);
+                stringTableOffset = getUInt32(20);
+                offset = getUInt32(24);
+            }
+
+            inline uint32_t getType() const { return type; }
+
+            uint32_t readUInt32()
+            {
+                uint32_t result = getUInt32(offset);
+                offset += sizeof(uint32_t);
+                return result;
+            }
+
+            float readFloat()
+            {
+                uint32_t value = readUInt32();
+                float result;
+                memcpy(&result, &value, sizeof(result));
+                return result;
+            }
+
+            std::string readString()
+            {
+                uint32_t index = readUInt32();
+                if (index == CookedLoader::NO_STRING) return std::string();
+
+                if (index >= stringCount)
+                    throw std::runtime_error("Invalid string index");
+
+                size_t position = static_cast<size_t>(stringTableOffset) + static_cast<size_t>(index) * 2 * sizeof(uint32_t);
+                uint32_t stringOffset = getUInt32(position);
+                uint32_t stringLength = getUInt32(position + sizeof(uint32_t));
+
+                return std::string(reinterpret_cast<const char*>(getBlob(stringOffset, stringLength, 1)), stringLength);
+            }
+
+            void skip(uint32_t count)
+            {
+                offset += count * sizeof(uint32_t);
+            }
+
+            const uint8_t* getBlob(uint32_t blobOffset, uint64_t blobSize, uint32_t alignment = CookedLoader::ALIGNMENT) const
+            {
+                if (blobOffset % alignment)
+                    throw std::runtime_error("Misaligned data in cooked asset");
+
+                if (blobOffset > data.size() || blobSize > data.size() - blobOffset)
+                    throw std::runtime_error("Data is outside of the cooked asset");
+
+                return data.data() + blobOffset;
+            }
+
+        private:
+            uint32_t getUInt32(size_t position) const
+            {
+                if (position > data.size() || data.size() - position < sizeof(uint32_t))
+                    throw std::runtime_error("Unexpected end of cooked asset");
+
+                return decodeUInt32Little(data.data() + position);
+            }
+
+            const FileData& data;
+            uint32_t type = Loader::NONE;
+            uint32_t stringCount = 0;
+            uint32_t stringTableOffset = 0;
+            size_t offset = 0;
+        };
+
+        class ValueReader final
+        {
+        public:
+            explicit ValueReader(CookedReader& initReader): reader(initReader) {}
+
+            void operator()(uint32_t& value) { value = reader.readUInt32(); }
+            void operator()(float& value) { value = reader.readFloat(); }
+            void operator()(bool& value) { value = reader.readUInt32() != 0; }
+            template<class T> void operator()(T& value) { value = static_cast<T>(reader.readUInt32()); }
+
+        private:
+            CookedReader& reader;
+        };
+
+        static std::shared_ptr<graphics::Texture> getTexture(Bundle& bundle, Cache& cache,
+                                                             const std::string& filename,
+                                                             bool loadDependencies, bool mipmaps)
+        {
+            std::shared_ptr<graphics::Texture> texture = cache.getTexture(filename);
+
+            if (!texture && loadDependencies)
+            {
+                bundle.loadAsset(Loader::IMAGE, filename, mipmaps);
+                texture = cache.getTexture(filename);
+            }
+
+            return texture;
+        }
+
+        static void loadImage(Bundle& bundle, const std::string& filename, CookedReader& reader, bool mipmaps)
+        {
+            uint32_t width = reader.readUInt32();
+            uint32_t height = reader.readUInt32();
+            graphics::PixelFormat pixelFormat = static_cast<graphics::PixelFormat>(reader.readUInt32());
+            uint32_t levelCount = reader.readUInt32();
+
+            if (!levelCount)
+                throw std::runtime_error("Cooked image " + filename + " has no levels");
+
+            // without mipmaps only the first level is uploaded
+            if (!mipmaps) levelCount = 1;
+
+            std::vector<graphics::Texture::Level> levels(levelCount);
+
+            for (graphics::Texture::Level& level : levels)
+            {
+                level.size.v[0] = reader.readUInt32();
+                level.size.v[1] = reader.readUInt32();
+                level.pitch = reader.readUInt32();
+
+                uint64_t levelSize = static_cast<uint64_t>(level.pitch) * level.size.v[1];
+                const uint8_t* levelData = reader.getBlob(reader.readUInt32(), levelSize);
+                level.data.assign(levelData, levelData + levelSize);
+            }
+
+            std::shared_ptr<graphics::Texture> texture = std::make_shared<graphics::Texture>(*engine->getRenderer(),
+                                                                                             levels,
+                                                                                             Size2<uint32_t>(width, height),
+                                                                                             0,
+                                                                                             pixelFormat);
+            bundle.setTexture(filename, texture);
+        }
+
+        static bool loadSprite(Bundle& bundle, Cache& cache, const std::string& filename, CookedReader& reader,
+                               bool loadDependencies, bool mipmaps)
+        {
+            scene::SpriteData spriteData;
+            spriteData.texture = getTexture(bundle, cache, reader.readString(), loadDependencies, mipmaps);
+
+            if (!spriteData.texture)
+                return false;
+
+            uint32_t frameCount = reader.readUInt32();
+
+            scene::SpriteData::Animation animation;
+
+            for (uint32_t i = 0; i < frameCount; ++i)
+            {
+                std::string name = reader.readString();
+                uint32_t indexCount = reader.readUInt32();
+                const uint8_t* indices = reader.getBlob(reader.readUInt32(), static_cast<uint64_t>(indexCount) * sizeof(uint16_t));
+                uint32_t vertexCount = reader.readUInt32();
+                const uint8_t* vertices = reader.getBlob(reader.readUInt32(), static_cast<uint64_t>(vertexCount) * sizeof(graphics::Vertex));
+
+                animation.frames.push_back(scene::SpriteData::Frame(name,
+                                                                    reinterpret_cast<const uint16_t*>(indices), indexCount,
+                                                                    reinterpret_cast<const graphics::Vertex*>(vertices), vertexCount));
+            }
+
+            spriteData.animations[""] = std::move(animation);
+
+            bundle.setSpriteData(filename, spriteData);
+
+            return true;
+        }
+
+        static void loadParticleSystem(Bundle& bundle, Cache& cache, const std::string& filename, CookedReader& reader,
+                                       bool loadDependencies, bool mipmaps)
+        {
+            scene::ParticleSystemData particleSystemData;
+            particleSystemData.name = reader.readString();
+            std::string textureFilename = reader.readString();
+
+            CookedLoader::ValueCounter counter;
+            CookedLoader::visitParticleSystemValues(particleSystemData, counter);
+
+            if (reader.readUInt32() != counter.count)
+                throw std::runtime_error("Invalid value count in cooked particle system " + filename);
+
+            ValueReader valueReader(reader);
+            CookedLoader::visitParticleSystemValues(particleSystemData, valueReader);
+
+            particleSystemData.texture = getTexture(bundle, cache, textureFilename, loadDependencies, mipmaps);
+
+            bundle.setParticleSystemData(filename, particleSystemData);
+        }
+
+        static void loadMaterials(Bundle& bundle, Cache& cache, CookedReader& reader,
+                                  bool loadDependencies, bool mipmaps)
+        {
+            uint32_t materialCount = reader.readUInt32();
+
+            for (uint32_t i = 0; i < materialCount; ++i)
+            {
+                std::string name = reader.readString();
+                std::string diffuseTexture = reader.readString();
+                std::string ambientTexture = reader.readString();
+
+                std::shared_ptr<graphics::Material> material = std::make_shared<graphics::Material>();
+                material->blendState = cache.getBlendState(BLEND_ALPHA);
+                material->shader = cache.getShader(SHADER_TEXTURE);
+
+                if (!diffuseTexture.empty())
+                    material->textures[0] = getTexture(bundle, cache, diffuseTexture, loadDependencies, mipmaps);
+
+                if (!ambientTexture.empty())
+                    material->textures[1] = cache.getTexture(ambientTexture);
+
+                material->diffuseColor = Color(reader.readUInt32());
+                material->opacity = reader.readFloat();
+
+                bundle.setMaterial(name, material);
+            }
+        }
+
+        static void loadStaticMeshes(Bundle& bundle, Cache& cache, CookedReader& reader,
+                                     bool loadDependencies, bool mipmaps)
+        {
+            uint32_t materialLibraryCount = reader.readUInt32();
+
+            for (uint32_t i = 0; i < materialLibraryCount; ++i)
+            {
+                std::string materialLibrary = reader.readString();
+                if (loadDependencies)
+                    bundle.loadAsset(Loader::MATERIAL, materialLibrary, mipmaps);
+            }
+
+            uint32_t meshCount = reader.readUInt32();
+
+            for (uint32_t i = 0; i < meshCount; ++i)
+            {
+                std::string name = reader.readString();
+                std::string materialName = reader.readString();
+
+                Box3<float> boundingBox;
+                for (float& value : boundingBox.min.v) value = reader.readFloat();
+                for (float& value : boundingBox.max.v) value = reader.readFloat();
+
+                uint32_t indexSize = reader.readUInt32();
+                if (indexSize != sizeof(uint16_t) && indexSize != sizeof(uint32_t))
+                    throw std::runtime_error("Invalid index size in cooked mesh " + name);
+
+                uint32_t indexCount = reader.readUInt32();
+                const uint8_t* indices = reader.getBlob(reader.readUInt32(), static_cast<uint64_t>(indexCount) * indexSize);
+                uint32_t vertexCount = reader.readUInt32();
+                const uint8_t* vertices = reader.getBlob(reader.readUInt32(), static_cast<uint64_t>(vertexCount) * sizeof(graphics::Vertex));
+
+                std::shared_ptr<graphics::Material> material;
+                if (!materialName.empty()) material = cache.getMaterial(materialName);
+
+                scene::StaticMeshData meshData(boundingBox,
+                                               indices, indexSize, indexCount,
+                                               reinterpret_cast<const graphics::Vertex*>(vertices), vertexCount,
+                                               material);
+                bundle.setStaticMeshData(name, meshData);
+            }
+        }
+
+        static bool loadCookedAsset(Bundle& bundle, Cache& cache, const std::string& filename, const FileData& data,
+                                    bool loadDependencies, bool mipmaps)
+        {
+            CookedReader reader(data);
+
+            switch (reader.getType())
+            {
+                case Loader::IMAGE:
+                    loadImage(bundle, filename, reader, mipmaps);
+                    return true;
+                case Loader::SPRITE:
+                    return loadSprite(bundle, cache, filename, reader, loadDependencies, mipmaps);
+                case Loader::PARTICLE_SYSTEM:
+                    loadParticleSystem(bundle, cache, filename, reader, loadDependencies, mipmaps);
+                    return true;
+                case Loader::MATERIAL:
+                    loadMaterials(bundle, cache, reader, loadDependencies, mipmaps);
+                    return true;
+                case Loader::STATIC_MESH:
+                    loadStaticMeshes(bundle, cache, reader, loadDependencies, mipmaps);
+                    return true;
+                default:
+                    throw std::runtime_error("Unsupported cooked asset type");
+            }
+        }
+
+        static void getDependencies(const FileData& data, bool mipmaps, std::vector<Asset>& dependencies)
+        {
+            CookedReader reader(data);
+
+            switch (reader.getType())
+            {
+                case Loader::SPRITE:
+                    dependencies.push_back(Asset(Loader::IMAGE, reader.readString(), mipmaps));
+                    break;
+                case Loader::PARTICLE_SYSTEM:
+                    reader.skip(1); // name
+                    dependencies.push_back(Asset(Loader::IMAGE, reader.readString(), mipmaps));
+                    break;
+                case Loader::MATERIAL:
+                {
+                    uint32_t materialCount = reader.readUInt32();
+                    for (uint32_t i = 0; i < materialCount; ++i)
+                    {
+                        reader.skip(1); // name
+                        std::string diffuseTexture = reader.readString();
+                        if (!diffuseTexture.empty())
+                            dependencies.push_back(Asset(Loader::IMAGE, diffuseTexture, mipmaps));
+                        reader.skip(3); // ambient texture, diffuse color and opacity
+                    }
+                    break;
+                }
+                case Loader::STATIC_MESH:
+                {
+                    uint32_t materialLibraryCount = reader.readUInt32();
+                    for (uint32_t i = 0; i < materialLibraryCount; ++i)
+                        dependencies.push_back(Asset(Loader::MATERIAL, reader.readString(), mipmaps));
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        bool CookedLoader::isCooked(const FileData& data)
+        {
+            return data.size() >= HEADER_SIZE && decodeUInt32Little(data.data()) == MAGIC;
+        }
+
+        CookedLoader::CookedLoader(Cache& initCache, uint32_t initType):
+            Loader(initCache, initType)
+        {
+        }
+
+        bool CookedLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, FileData(data.data(), data.size()), mipmaps);
+        }
+
+        bool CookedLoader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps)
+        {
+            if (!isCooked(data))
+                return false;
+
+            if (CookedReader(data).getType() != type)
+                throw std::runtime_error("Cooked asset " + filename + " is of a different type");
+
+            return loadCookedAsset(bundle, cache, filename, data, true, mipmaps);
+        }
+
+        bool CookedLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            if (!isCooked(data))
+                return false;
+
+            if (CookedReader(data).getType() != type)
+                throw std::runtime_error("Cooked asset " + filename + " is of a different type");
+
+            getDependencies(data, mipmaps, result.dependencies);
+
+            // the data is kept mapped until the asset is created
+            result.create = [this, &bundle, filename, data, mipmaps]() {
+                return loadCookedAsset(bundle, cache, filename, data, false, mipmaps);
+            };
+
+            return true;
+        }
+    } // namespace assets
+} // namespace ouzel
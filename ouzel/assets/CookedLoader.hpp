@@ -0,0 +1,117 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_ASSETS_COOKEDLOADER_HPP
+#define OUZEL_ASSETS_COOKEDLOADER_HPP
+
+#include "assets/Loader.hpp"
+#include "scene/ParticleSystemData.hpp"
+
+namespace ouzel
+{
+    namespace assets
+    {
+        // loads assets written by the cooker (tools/cooker), returns false for files that are not cooked
+        // the cooked files keep the names of their sources, so the references between the assets stay valid
+        //
+        // all the values are little endian 32-bit integers or floats, the blobs are aligned to ALIGNMENT bytes
+        // header: MAGIC, VERSION, asset type, size of graphics::Vertex, string count, string table offset, content offset
+        // string table: offset and length of each string, strings are referenced by their index or NO_STRING
+        // content of IMAGE: width, height, pixel format, level count, level count * (width, height, pitch, data offset)
+        // content of SPRITE: image, frame count, frame count * (name, index count, index offset, vertex count, vertex offset)
+        // content of PARTICLE_SYSTEM: name, texture, value count, values in the order of visitParticleSystemValues
+        // content of MATERIAL: material count, material count * (name, diffuse texture, ambient texture, diffuse color, opacity)
+        // content of STATIC_MESH: material library count, material libraries, mesh count,
+        //     mesh count * (name, material, bounding box min xyz, max xyz, index size, index count, index offset, vertex count, vertex offset)
+        // sprite indices are 16-bit, mesh indices are 16-bit or 32-bit, vertices are stored as graphics::Vertex
+        class CookedLoader final: public Loader
+        {
+        public:
+            static constexpr uint32_t MAGIC = 0x435A554F; // "OUZC"
+            static constexpr uint32_t VERSION = 1;
+            static constexpr uint32_t ALIGNMENT = 16;
+            static constexpr uint32_t NO_STRING = 0xFFFFFFFF;
+            static constexpr uint32_t HEADER_SIZE = 7 * sizeof(uint32_t);
+
+            // counts the values passed to it by visitParticleSystemValues
+            class ValueCounter final
+            {
+            public:
+                template<class T> void operator()(const T&) { ++count; }
+
+                uint32_t count = 0;
+            };
+
+            // all the values are 4 bytes long, enums and bools are stored as integers
+            template<class Data, class Visitor>
+            static void visitParticleSystemValues(Data& data, Visitor& visitor)
+            {
+                visitor(data.blendFuncSource);
+                visitor(data.blendFuncDestination);
+                visitor(data.emitterType);
+                visitor(data.maxParticles);
+                visitor(data.duration);
+                visitor(data.particleLifespan);
+                visitor(data.particleLifespanVariance);
+                visitor(data.speed);
+                visitor(data.speedVariance);
+                visitor(data.sourcePosition.v[0]);
+                visitor(data.sourcePosition.v[1]);
+                visitor(data.sourcePositionVariance.v[0]);
+                visitor(data.sourcePositionVariance.v[1]);
+                visitor(data.positionType);
+                visitor(data.startParticleSize);
+                visitor(data.startParticleSizeVariance);
+                visitor(data.finishParticleSize);
+                visitor(data.finishParticleSizeVariance);
+                visitor(data.angle);
+                visitor(data.angleVariance);
+                visitor(data.startRotation);
+                visitor(data.startRotationVariance);
+                visitor(data.finishRotation);
+                visitor(data.finishRotationVariance);
+                visitor(data.rotatePerSecond);
+                visitor(data.rotatePerSecondVariance);
+                visitor(data.minRadius);
+                visitor(data.minRadiusVariance);
+                visitor(data.maxRadius);
+                visitor(data.maxRadiusVariance);
+                visitor(data.radialAcceleration);
+                visitor(data.radialAccelVariance);
+                visitor(data.tangentialAcceleration);
+                visitor(data.tangentialAccelVariance);
+                visitor(data.absolutePosition);
+                visitor(data.yCoordFlipped);
+                visitor(data.rotationIsDir);
+                visitor(data.gravity.v[0]);
+                visitor(data.gravity.v[1]);
+                visitor(data.startColorRed);
+                visitor(data.startColorGreen);
+                visitor(data.startColorBlue);
+                visitor(data.startColorAlpha);
+                visitor(data.startColorRedVariance);
+                visitor(data.startColorGreenVariance);
+                visitor(data.startColorBlueVariance);
+                visitor(data.startColorAlphaVariance);
+                visitor(data.finishColorRed);
+                visitor(data.finishColorGreen);
+                visitor(data.finishColorBlue);
+                visitor(data.finishColorAlpha);
+                visitor(data.finishColorRedVariance);
+                visitor(data.finishColorGreenVariance);
+                visitor(data.finishColorBlueVariance);
+                visitor(data.finishColorAlphaVariance);
+                visitor(data.emissionRate);
+            }
+
+            // returns true if the data starts with the cooked header
+            static bool isCooked(const FileData& data);
+
+            CookedLoader(Cache& initCache, uint32_t initType);
+            bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
+        };
+    } // namespace assets
+} // namespace ouzel
+
+#endif // OUZEL_ASSETS_COOKEDLOADER_HPP
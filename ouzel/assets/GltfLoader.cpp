@@ -1,19 +1,859 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
 #include "GltfLoader.hpp"
 #include "Bundle.hpp"
+#include "Cache.hpp"
+#include "ImageLoader.hpp"
+#include "core/Engine.hpp"
+#include "graphics/ImageData.hpp"
+#include "graphics/Material.hpp"
+#include "graphics/Texture.hpp"
+#include "math/Matrix4.hpp"
+#include "scene/SkinnedMeshData.hpp"
+#include "scene/StaticMeshData.hpp"
+#include "utils/JSONDocument.hpp"
+#include "utils/Utils.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
-        GltfLoader::GltfLoader(Cache& initCache):
-            Loader(initCache, TYPE)
+        static constexpr uint32_t GLB_VERSION = 2;
+        static constexpr uint32_t GLB_HEADER_SIZE = 12;
+        static constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A; // "JSON"
+        static constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942; // "BIN\0"
+
+        // component types of the accessors
+        static constexpr uint32_t COMPONENT_BYTE = 5120;
+        static constexpr uint32_t COMPONENT_UNSIGNED_BYTE = 5121;
+        static constexpr uint32_t COMPONENT_SHORT = 5122;
+        static constexpr uint32_t COMPONENT_UNSIGNED_SHORT = 5123;
+        static constexpr uint32_t COMPONENT_UNSIGNED_INT = 5125;
+        static constexpr uint32_t COMPONENT_FLOAT = 5126;
+
+        // primitive modes
+        static constexpr uint32_t MODE_TRIANGLES = 4;
+        static constexpr uint32_t MODE_TRIANGLE_STRIP = 5;
+        static constexpr uint32_t MODE_TRIANGLE_FAN = 6;
+
+        static const uint32_t NO_INDEX = 0xFFFFFFFF;
+
+        struct Model final
+        {
+            struct Image final
+            {
+                std::string name;
+                bool embedded = false;
+                FileData data; // encoded data of embedded images
+                graphics::ImageData image;
+            };
+
+            struct Material final
+            {
+                std::string name;
+                uint32_t image = NO_INDEX;
+                Color diffuseColor = Color::WHITE;
+                float opacity = 1.0F;
+                bool doubleSided = false;
+            };
+
+            struct Primitive final
+            {
+                std::string name;
+                uint32_t material = NO_INDEX;
+                Box3<float> boundingBox;
+                const uint8_t* indices = nullptr; // points into the buffers if the indices were not converted
+                std::vector<uint8_t> indexData;
+                uint32_t indexSize = 0;
+                uint32_t indexCount = 0;
+                std::vector<graphics::Vertex> vertices;
+
+                inline const uint8_t* getIndices() const { return indexData.empty() ? indices : indexData.data(); }
+            };
+
+            // kept until the meshes are created
+            std::vector<FileData> buffers;
+            std::vector<Image> images;
+            std::vector<Material> materials;
+            std::vector<Primitive> primitives;
+        };
+
+        static inline bool isArray(const json::Node& node)
+        {
+            return node.getType() == json::Node::Type::ARRAY;
+        }
+
+        static inline size_t getArraySize(const json::Node& node)
+        {
+            return isArray(node) ? node.getSize() : 0;
+        }
+
+        static uint32_t getUInt(const json::Node& node, uint32_t defaultValue)
+        {
+            if (node.getType() != json::Node::Type::NUMBER) return defaultValue;
+
+            double value = node.as<double>();
+            if (value < 0.0 || value > 4294967295.0)
+                throw std::runtime_error("Invalid glTF index");
+
+            return static_cast<uint32_t>(value);
+        }
+
+        static uint32_t getIndex(const json::Node& node, size_t count, const char* error)
         {
+            uint32_t index = getUInt(node, NO_INDEX);
+            if (index >= count)
+                throw std::runtime_error(error);
+
+            return index;
         }
 
-        bool GltfLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool)
+        static inline std::string getString(const json::Node& node)
         {
+            return node.getType() == json::Node::Type::STRING ? node.as<std::string>() : std::string();
+        }
+
+        static std::vector<uint8_t> decodeBase64(const char* str, size_t length)
+        {
+            std::vector<uint8_t> result;
+            result.reserve(length / 4 * 3);
+
+            uint32_t value = 0;
+            uint32_t bits = 0;
+
+            for (const char* i = str; i != str + length; ++i)
+            {
+                uint32_t c;
+                if (*i >= 'A' && *i <= 'Z') c = static_cast<uint32_t>(*i - 'A');
+                else if (*i >= 'a' && *i <= 'z') c = static_cast<uint32_t>(*i - 'a') + 26;
+                else if (*i >= '0' && *i <= '9') c = static_cast<uint32_t>(*i - '0') + 52;
+                else if (*i == '+') c = 62;
+                else if (*i == '/') c = 63;
+                else if (*i == '=') break;
+                else throw std::runtime_error("Invalid base64 data");
+
+                value = (value << 6) | c;
+                bits += 6;
+
+                if (bits >= 8)
+                {
+                    bits -= 8;
+                    result.push_back(static_cast<uint8_t>(value >> bits));
+                }
+            }
+
+            return result;
+        }
+
+        // the URIs are relative to the file, the data URIs are decoded
+        static FileData readUri(const std::string& filename, const std::string& uri)
+        {
+            if (uri.compare(0, 5, "data:") == 0)
+            {
+                size_t dataStart = uri.find(";base64,");
+                if (dataStart == std::string::npos)
+                    throw std::runtime_error("Unsupported data URI in " + filename);
+
+                dataStart += 8;
+                return FileData(decodeBase64(uri.data() + dataStart, uri.length() - dataStart));
+            }
+
+            std::string directory = FileSystem::getDirectoryPart(filename);
+            return engine->getFileSystem().mapFile(directory.empty() ? uri : directory + "/" + uri);
+        }
+
+        static std::string decodeUri(const std::string& uri)
+        {
+            std::string result;
+            result.reserve(uri.length());
+
+            for (size_t i = 0; i < uri.length(); ++i)
+            {
+                if (uri[i] == '%' && i + 2 < uri.length())
+                {
+                    result.push_back(static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16)));
+                    i += 2;
+                }
+                else
+                    result.push_back(uri[i]);
+            }
+
+            return result;
+        }
+
+        class Accessor final
+        {
+        public:
+            Accessor(const json::Node& root, const Model& model, uint32_t index)
+            {
+                const json::Node& accessors = root["accessors"];
+                if (index >= getArraySize(accessors))
+                    throw std::runtime_error("Invalid glTF accessor");
+
+                const json::Node& accessor = accessors[index];
+
+                if (!accessor["sparse"].isNull())
+                    throw std::runtime_error("Sparse glTF accessors are not supported");
+
+                count = getUInt(accessor["count"], 0);
+                componentType = getUInt(accessor["componentType"], 0);
+                normalized = !accessor["normalized"].isNull() && accessor["normalized"].as<bool>();
+
+                switch (componentType)
+                {
+                    case COMPONENT_BYTE: case COMPONENT_UNSIGNED_BYTE: componentSize = 1; break;
+                    case COMPONENT_SHORT: case COMPONENT_UNSIGNED_SHORT: componentSize = 2; break;
+                    case COMPONENT_UNSIGNED_INT: case COMPONENT_FLOAT: componentSize = 4; break;
+                    default: throw std::runtime_error("Invalid glTF component type");
+                }
+
+                std::string accessorType = getString(accessor["type"]);
+                if (accessorType == "SCALAR") componentCount = 1;
+                else if (accessorType == "VEC2") componentCount = 2;
+                else if (accessorType == "VEC3") componentCount = 3;
+                else if (accessorType == "VEC4") componentCount = 4;
+                else if (accessorType == "MAT2") componentCount = 4;
+                else if (accessorType == "MAT3") componentCount = 9;
+                else if (accessorType == "MAT4") componentCount = 16;
+                else throw std::runtime_error("Invalid glTF accessor type");
+
+                stride = componentSize * componentCount;
+
+                // accessors without a buffer view are filled with zeros
+                if (accessor["bufferView"].isNull()) return;
+
+                const json::Node& bufferViews = root["bufferViews"];
+                const json::Node& bufferView = bufferViews[getIndex(accessor["bufferView"], getArraySize(bufferViews), "Invalid glTF buffer view")];
+                const FileData& buffer = model.buffers[getIndex(bufferView["buffer"], model.buffers.size(), "Invalid glTF buffer")];
+
+                uint64_t viewOffset = getUInt(bufferView["byteOffset"], 0);
+                uint64_t viewLength = getUInt(bufferView["byteLength"], 0);
+                if (viewOffset + viewLength > buffer.size())
+                    throw std::runtime_error("glTF buffer view is out of range");
+
+                byteStride = getUInt(bufferView["byteStride"], 0);
+                if (byteStride) stride = byteStride;
+
+                uint64_t offset = getUInt(accessor["byteOffset"], 0);
+                if (count && offset + static_cast<uint64_t>(stride) * (count - 1) + componentSize * componentCount > viewLength)
+                    throw std::runtime_error("glTF accessor is out of range");
+
+                data = buffer.data() + viewOffset + offset;
+            }
+
+            inline uint32_t getCount() const { return count; }
+            inline uint32_t getComponentType() const { return componentType; }
+            inline uint32_t getComponentCount() const { return componentCount; }
+            inline uint32_t getComponentSize() const { return componentSize; }
+            // the elements are tightly packed
+            inline bool isPacked() const { return data && (!byteStride || byteStride == componentSize * componentCount); }
+            inline const uint8_t* getData() const { return data; }
+
+            float getFloat(uint32_t element, uint32_t component) const
+            {
+                if (!data || component >= componentCount) return 0.0F;
+
+                const uint8_t* value = data + static_cast<size_t>(element) * stride + component * componentSize;
+
+                switch (componentType)
+                {
+                    case COMPONENT_FLOAT:
+                    {
+                        uint32_t bits = decodeUInt32Little(value);
+                        float result;
+                        std::memcpy(&result, &bits, sizeof(result));
+                        return result;
+                    }
+                    case COMPONENT_UNSIGNED_BYTE:
+                        return normalized ? *value / 255.0F : *value;
+                    case COMPONENT_BYTE:
+                        return normalized ? std::max(static_cast<int8_t>(*value) / 127.0F, -1.0F) : static_cast<int8_t>(*value);
+                    case COMPONENT_UNSIGNED_SHORT:
+                        return normalized ? decodeUInt16Little(value) / 65535.0F : decodeUInt16Little(value);
+                    case COMPONENT_SHORT:
+                        return normalized ? std::max(decodeInt16Little(value) / 32767.0F, -1.0F) : decodeInt16Little(value);
+                    case COMPONENT_UNSIGNED_INT:
+                        return static_cast<float>(decodeUInt32Little(value));
+                    default:
+                        return 0.0F;
+                }
+            }
+
+            uint32_t getElementIndex(uint32_t element) const
+            {
+                if (!data) return 0;
+
+                const uint8_t* value = data + static_cast<size_t>(element) * stride;
+
+                switch (componentType)
+                {
+                    case COMPONENT_UNSIGNED_BYTE: return *value;
+                    case COMPONENT_UNSIGNED_SHORT: return decodeUInt16Little(value);
+                    case COMPONENT_UNSIGNED_INT: return decodeUInt32Little(value);
+                    default: throw std::runtime_error("Invalid glTF index component type");
+                }
+            }
+
+        private:
+            const uint8_t* data = nullptr;
+            uint32_t count = 0;
+            uint32_t componentType = 0;
+            uint32_t componentCount = 0;
+            uint32_t componentSize = 0;
+            uint32_t byteStride = 0;
+            uint32_t stride = 0;
+            bool normalized = false;
+        };
+
+        static Matrix4<float> getNodeTransform(const json::Node& node)
+        {
+            const json::Node& matrix = node["matrix"];
+            if (getArraySize(matrix) == 16)
+            {
+                // stored in column-major order
+                float values[16];
+                for (size_t i = 0; i < 16; ++i) values[i] = matrix[i].as<float>();
+                return Matrix4<float>(values);
+            }
+
+            Matrix4<float> transform = Matrix4<float>::identity();
+
+            const json::Node& translation = node["translation"];
+            if (getArraySize(translation) == 3)
+                transform.translate(translation[0].as<float>(), translation[1].as<float>(), translation[2].as<float>());
+
+            const json::Node& rotation = node["rotation"];
+            if (getArraySize(rotation) == 4)
+            {
+                Matrix4<float> rotationMatrix;
+                rotationMatrix.setRotation(Quaternion<float>(rotation[0].as<float>(), rotation[1].as<float>(),
+                                                             rotation[2].as<float>(), rotation[3].as<float>()));
+                transform *= rotationMatrix;
+            }
+
+            const json::Node& scale = node["scale"];
+            if (getArraySize(scale) == 3)
+                transform.scale(scale[0].as<float>(), scale[1].as<float>(), scale[2].as<float>());
+
+            return transform;
+        }
+
+        // stores the transformation of the first node that references each mesh
+        static void readNode(const json::Node& nodes, uint32_t index, const Matrix4<float>& parentTransform,
+                             std::vector<Matrix4<float>>& meshTransforms, std::vector<bool>& meshFound, uint32_t depth)
+        {
+            if (depth > nodes.getSize())
+                throw std::runtime_error("Cyclic glTF node hierarchy");
+
+            const json::Node& node = nodes[index];
+            Matrix4<float> transform = parentTransform * getNodeTransform(node);
+
+            uint32_t mesh = getUInt(node["mesh"], NO_INDEX);
+            if (mesh < meshFound.size() && !meshFound[mesh])
+            {
+                meshTransforms[mesh] = transform;
+                meshFound[mesh] = true;
+            }
+
+            const json::Node& children = node["children"];
+            for (size_t i = 0; i < getArraySize(children); ++i)
+                readNode(nodes, getIndex(children[i], nodes.getSize(), "Invalid glTF node"), transform, meshTransforms, meshFound, depth + 1);
+        }
+
+        static void readIndices(const json::Node& root, const Model& model, const json::Node& primitive,
+                                uint32_t mode, uint32_t vertexCount, Model::Primitive& result)
+        {
+            std::vector<uint32_t> indices;
+
+            if (primitive["indices"].isNull())
+            {
+                indices.resize(vertexCount);
+                for (uint32_t i = 0; i < vertexCount; ++i) indices[i] = i;
+            }
+            else
+            {
+                Accessor accessor(root, model, getUInt(primitive["indices"], NO_INDEX));
+
+                for (uint32_t i = 0; i < accessor.getCount(); ++i)
+                    if (accessor.getElementIndex(i) >= vertexCount)
+                        throw std::runtime_error("glTF vertex index is out of range");
+
+                // tightly packed triangle lists are uploaded directly from the buffer
+                if (mode == MODE_TRIANGLES && accessor.isPacked() &&
+                    (accessor.getComponentType() == COMPONENT_UNSIGNED_SHORT || accessor.getComponentType() == COMPONENT_UNSIGNED_INT))
+                {
+                    result.indices = accessor.getData();
+                    result.indexSize = accessor.getComponentSize();
+                    result.indexCount = accessor.getCount() / 3 * 3;
+                    return;
+                }
+
+                indices.resize(accessor.getCount());
+                for (uint32_t i = 0; i < accessor.getCount(); ++i) indices[i] = accessor.getElementIndex(i);
+            }
+
+            std::vector<uint32_t> triangles;
+
+            if (mode == MODE_TRIANGLE_STRIP)
+            {
+                for (size_t i = 2; i < indices.size(); ++i)
+                {
+                    // every other triangle is flipped to keep the winding order
+                    bool even = (i % 2) == 0;
+                    triangles.push_back(indices[i - 2]);
+                    triangles.push_back(indices[even ? i - 1 : i]);
+                    triangles.push_back(indices[even ? i : i - 1]);
+                }
+            }
+            else if (mode == MODE_TRIANGLE_FAN)
+            {
+                for (size_t i = 2; i < indices.size(); ++i)
+                {
+                    triangles.push_back(indices[0]);
+                    triangles.push_back(indices[i - 1]);
+                    triangles.push_back(indices[i]);
+                }
+            }
+            else
+            {
+                indices.resize(indices.size() / 3 * 3);
+                triangles = std::move(indices);
+            }
+
+            result.indexCount = static_cast<uint32_t>(triangles.size());
+
+            // 16-bit indices are used if all the vertices can be addressed with them
+            if (vertexCount <= 65536)
+            {
+                result.indexSize = sizeof(uint16_t);
+                result.indexData.resize(triangles.size() * sizeof(uint16_t));
+                for (size_t i = 0; i < triangles.size(); ++i)
+                {
+                    uint16_t index = static_cast<uint16_t>(triangles[i]);
+                    std::memcpy(result.indexData.data() + i * sizeof(uint16_t), &index, sizeof(index));
+                }
+            }
+            else
+            {
+                result.indexSize = sizeof(uint32_t);
+                result.indexData.resize(triangles.size() * sizeof(uint32_t));
+                std::memcpy(result.indexData.data(), triangles.data(), result.indexData.size());
+            }
+        }
+
+        static void readPrimitive(const json::Node& root, const Model& model, const json::Node& primitive,
+                                  const Matrix4<float>& transform, Model::Primitive& result)
+        {
+            const json::Node& attributes = primitive["attributes"];
+            if (attributes["POSITION"].isNull())
+                throw std::runtime_error("glTF primitive has no positions");
+
+            Accessor positions(root, model, getUInt(attributes["POSITION"], NO_INDEX));
+            uint32_t vertexCount = positions.getCount();
+
+            // the attributes are interleaved into graphics::Vertex
+            result.vertices.resize(vertexCount);
+
+            for (uint32_t i = 0; i < vertexCount; ++i)
+            {
+                graphics::Vertex& vertex = result.vertices[i];
+                transform.transformPoint(Vector3<float>(positions.getFloat(i, 0), positions.getFloat(i, 1), positions.getFloat(i, 2)),
+                                         vertex.position);
+                vertex.color = Color::WHITE;
+                result.boundingBox.insertPoint(vertex.position);
+            }
+
+            if (!attributes["NORMAL"].isNull())
+            {
+                Accessor normals(root, model, getUInt(attributes["NORMAL"], NO_INDEX));
+                if (normals.getCount() != vertexCount)
+                    throw std::runtime_error("Invalid glTF normal count");
+
+                for (uint32_t i = 0; i < vertexCount; ++i)
+                {
+                    Vector3<float>& normal = result.vertices[i].normal;
+                    transform.transformVector(Vector3<float>(normals.getFloat(i, 0), normals.getFloat(i, 1), normals.getFloat(i, 2)),
+                                              normal);
+                    normal.normalize();
+                }
+            }
+
+            if (!attributes["TEXCOORD_0"].isNull())
+            {
+                Accessor texCoords(root, model, getUInt(attributes["TEXCOORD_0"], NO_INDEX));
+                if (texCoords.getCount() != vertexCount)
+                    throw std::runtime_error("Invalid glTF texture coordinate count");
+
+                for (uint32_t i = 0; i < vertexCount; ++i)
+                    result.vertices[i].texCoords[0] = Vector2<float>(texCoords.getFloat(i, 0), texCoords.getFloat(i, 1));
+            }
+
+            if (!attributes["COLOR_0"].isNull())
+            {
+                Accessor colors(root, model, getUInt(attributes["COLOR_0"], NO_INDEX));
+                if (colors.getCount() != vertexCount)
+                    throw std::runtime_error("Invalid glTF color count");
+
+                for (uint32_t i = 0; i < vertexCount; ++i)
+                {
+                    float color[4] = {
+                        colors.getFloat(i, 0),
+                        colors.getFloat(i, 1),
+                        colors.getFloat(i, 2),
+                        colors.getComponentCount() == 4 ? colors.getFloat(i, 3) : 1.0F
+                    };
+                    result.vertices[i].color = Color(color);
+                }
+            }
+
+            readIndices(root, model, primitive, getUInt(primitive["mode"], MODE_TRIANGLES), vertexCount, result);
+        }
+
+        static void decodeImages(Model& model)
+        {
+            std::vector<Model::Image*> images;
+            for (Model::Image& image : model.images)
+                if (image.embedded) images.push_back(&image);
+
+            std::vector<std::exception_ptr> errors(images.size());
+
+            auto decode = [&images, &errors](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    try
+                    {
+                        images[i]->image = ImageLoader::decodeImage(images[i]->data);
+                        images[i]->data = FileData();
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                }
+            };
+
+            JobSystem* jobSystem = engine ? engine->getJobSystem() : nullptr;
+
+            if (jobSystem && images.size() > 1)
+                jobSystem->parallelFor(0, static_cast<uint32_t>(images.size()), 1, decode);
+            else
+                decode(0, static_cast<uint32_t>(images.size()));
+
+            for (const std::exception_ptr& error : errors)
+                if (error) std::rethrow_exception(error);
+        }
+
+        static void parseModel(const std::string& filename, const FileData& data, Model& model)
+        {
+            std::vector<uint8_t> json;
+            FileData binaryChunk;
+
+            if (data.size() >= GLB_HEADER_SIZE && decodeUInt32Little(data.data()) == GltfLoader::GLB_MAGIC)
+            {
+                if (decodeUInt32Little(data.data() + 4) != GLB_VERSION)
+                    throw std::runtime_error("Unsupported GLB version");
+
+                uint64_t length = std::min(static_cast<uint64_t>(decodeUInt32Little(data.data() + 8)), static_cast<uint64_t>(data.size()));
+                uint64_t offset = GLB_HEADER_SIZE;
+
+                while (offset + 8 <= length)
+                {
+                    uint32_t chunkLength = decodeUInt32Little(data.data() + offset);
+                    uint32_t chunkType = decodeUInt32Little(data.data() + offset + 4);
+                    offset += 8;
+
+                    if (offset + chunkLength > length)
+                        throw std::runtime_error("Invalid GLB chunk length");
+
+                    if (chunkType == GLB_CHUNK_JSON && json.empty())
+                        json.assign(data.data() + offset, data.data() + offset + chunkLength);
+                    else if (chunkType == GLB_CHUNK_BIN && binaryChunk.empty())
+                        binaryChunk = FileData(data, static_cast<size_t>(offset), chunkLength); // shares the storage of the file
+
+                    offset += (chunkLength + 3) & ~3U;
+                }
+
+                if (json.empty())
+                    throw std::runtime_error("GLB file has no JSON chunk");
+            }
+            else
+                json = data.toVector();
+
+            json::Document document(std::move(json));
+            const json::Node& root = document.getRoot();
+
+            if (root.getType() != json::Node::Type::OBJECT)
+                throw std::runtime_error("Invalid glTF file");
+
+            std::string version = getString(root["asset"]["version"]);
+            if (version.compare(0, 2, "2.") != 0)
+                throw std::runtime_error("Unsupported glTF version " + version);
+
+            const json::Node& buffers = root["buffers"];
+            for (size_t i = 0; i < getArraySize(buffers); ++i)
+            {
+                const json::Node& buffer = buffers[i];
+
+                FileData bufferData;
+                if (buffer["uri"].isNull())
+                    bufferData = binaryChunk;
+                else
+                    bufferData = readUri(filename, decodeUri(getString(buffer["uri"])));
+
+                if (bufferData.size() < getUInt(buffer["byteLength"], 0))
+                    throw std::runtime_error("glTF buffer is too short");
+
+                model.buffers.push_back(bufferData);
+            }
+
+            const json::Node& images = root["images"];
+            const json::Node& textures = root["textures"];
+            const json::Node& bufferViews = root["bufferViews"];
+            model.images.resize(getArraySize(images));
+
+            const json::Node& materials = root["materials"];
+            for (size_t i = 0; i < getArraySize(materials); ++i)
+            {
+                const json::Node& material = materials[i];
+                const json::Node& pbr = material["pbrMetallicRoughness"];
+
+                Model::Material description;
+                description.name = getString(material["name"]);
+                description.doubleSided = !material["doubleSided"].isNull() && material["doubleSided"].as<bool>();
+
+                if (pbr.getType() == json::Node::Type::OBJECT)
+                {
+                    const json::Node& baseColorFactor = pbr["baseColorFactor"];
+                    if (getArraySize(baseColorFactor) == 4)
+                    {
+                        float color[4] = {baseColorFactor[0].as<float>(), baseColorFactor[1].as<float>(), baseColorFactor[2].as<float>(), 1.0F};
+                        description.diffuseColor = Color(color);
+                        description.opacity = baseColorFactor[3].as<float>();
+                    }
+
+                    const json::Node& baseColorTexture = pbr["baseColorTexture"];
+                    if (baseColorTexture.getType() == json::Node::Type::OBJECT)
+                    {
+                        const json::Node& texture = textures[getIndex(baseColorTexture["index"], getArraySize(textures), "Invalid glTF texture")];
+                        if (!texture["source"].isNull())
+                            description.image = getIndex(texture["source"], model.images.size(), "Invalid glTF image");
+                    }
+                }
+
+                model.materials.push_back(description);
+            }
+
+            // only the images of the materials are loaded
+            for (const Model::Material& material : model.materials)
+            {
+                if (material.image == NO_INDEX) continue;
+
+                Model::Image& image = model.images[material.image];
+                if (!image.name.empty()) continue;
+
+                const json::Node& imageNode = images[material.image];
+                std::string uri = getString(imageNode["uri"]);
+
+                if (!uri.empty() && uri.compare(0, 5, "data:") != 0)
+                {
+                    std::string directory = FileSystem::getDirectoryPart(filename);
+                    image.name = directory.empty() ? decodeUri(uri) : directory + "/" + decodeUri(uri);
+                }
+                else
+                {
+                    image.name = filename + "#" + std::to_string(material.image);
+                    image.embedded = true;
+
+                    if (!uri.empty())
+                        image.data = readUri(filename, uri);
+                    else
+                    {
+                        const json::Node& bufferView = bufferViews[getIndex(imageNode["bufferView"], getArraySize(bufferViews), "Invalid glTF buffer view")];
+                        const FileData& buffer = model.buffers[getIndex(bufferView["buffer"], model.buffers.size(), "Invalid glTF buffer")];
+
+                        uint64_t offset = getUInt(bufferView["byteOffset"], 0);
+                        uint64_t length = getUInt(bufferView["byteLength"], 0);
+                        if (offset + length > buffer.size())
+                            throw std::runtime_error("glTF buffer view is out of range");
+
+                        image.data = FileData(buffer, static_cast<size_t>(offset), static_cast<size_t>(length));
+                    }
+                }
+            }
+
+            decodeImages(model);
+
+            // transformations of the meshes in the default scene
+            const json::Node& meshes = root["meshes"];
+            std::vector<Matrix4<float>> meshTransforms(getArraySize(meshes), Matrix4<float>::identity());
+            std::vector<bool> meshFound(getArraySize(meshes), false);
+
+            const json::Node& scenes = root["scenes"];
+            const json::Node& nodes = root["nodes"];
+            uint32_t sceneIndex = root["scene"].isNull() ? 0 : getIndex(root["scene"], getArraySize(scenes), "Invalid glTF scene");
+
+            if (sceneIndex < getArraySize(scenes) && isArray(nodes))
+            {
+                const json::Node& sceneNodes = scenes[sceneIndex]["nodes"];
+                for (size_t i = 0; i < getArraySize(sceneNodes); ++i)
+                    readNode(nodes, getIndex(sceneNodes[i], nodes.getSize(), "Invalid glTF node"),
+                             Matrix4<float>::identity(), meshTransforms, meshFound, 0);
+            }
+
+            for (size_t meshIndex = 0; meshIndex < getArraySize(meshes); ++meshIndex)
+            {
+                const json::Node& mesh = meshes[meshIndex];
+
+                std::string name = getString(mesh["name"]);
+                if (name.empty()) name = meshIndex ? filename + "#mesh" + std::to_string(meshIndex) : filename;
+
+                const json::Node& primitives = mesh["primitives"];
+                for (size_t primitiveIndex = 0; primitiveIndex < getArraySize(primitives); ++primitiveIndex)
+                {
+                    const json::Node& primitive = primitives[primitiveIndex];
+
+                    // points and lines are skipped
+                    uint32_t mode = getUInt(primitive["mode"], MODE_TRIANGLES);
+                    if (mode != MODE_TRIANGLES && mode != MODE_TRIANGLE_STRIP && mode != MODE_TRIANGLE_FAN) continue;
+
+                    Model::Primitive result;
+                    result.name = primitiveIndex ? name + "#" + std::to_string(primitiveIndex) : name;
+                    if (!primitive["material"].isNull())
+                        result.material = getIndex(primitive["material"], model.materials.size(), "Invalid glTF material");
+
+                    readPrimitive(root, model, primitive, meshTransforms[meshIndex], result);
+                    model.primitives.push_back(std::move(result));
+                }
+            }
+        }
+
+        static void createModel(Bundle& bundle, Cache& cache, uint32_t type, const Model& model, bool mipmaps)
+        {
+            std::vector<std::shared_ptr<graphics::Texture>> textures(model.images.size());
+
+            for (size_t i = 0; i < model.images.size(); ++i)
+            {
+                const Model::Image& image = model.images[i];
+                if (image.name.empty()) continue;
+
+                if (image.embedded)
+                {
+                    textures[i] = std::make_shared<graphics::Texture>(*engine->getRenderer());
+                    textures[i]->init(image.image.getData(), image.image.getSize(), 0, mipmaps ? 0 : 1, image.image.getPixelFormat());
+                    bundle.setTexture(image.name, textures[i]);
+                }
+                else
+                {
+                    textures[i] = cache.getTexture(image.name);
+
+                    if (!textures[i])
+                    {
+                        bundle.loadAsset(Loader::IMAGE, image.name, mipmaps);
+                        textures[i] = cache.getTexture(image.name);
+                    }
+                }
+            }
+
+            std::vector<std::shared_ptr<graphics::Material>> materials;
+
+            for (const Model::Material& description : model.materials)
+            {
+                std::shared_ptr<graphics::Material> material = std::make_shared<graphics::Material>();
+                material->blendState = cache.getBlendState(BLEND_ALPHA);
+                material->shader = cache.getShader(SHADER_TEXTURE);
+                if (description.image != NO_INDEX) material->textures[0] = textures[description.image];
+                material->cullMode = description.doubleSided ? graphics::CullMode::NONE : graphics::CullMode::BACK;
+                material->diffuseColor = description.diffuseColor;
+                material->opacity = description.opacity;
+
+                if (!description.name.empty())
+                    bundle.setMaterial(description.name, material);
+
+                materials.push_back(material);
+            }
+
+            for (const Model::Primitive& primitive : model.primitives)
+            {
+                std::shared_ptr<graphics::Material> material;
+                if (primitive.material != NO_INDEX) material = materials[primitive.material];
+
+                if (type == Loader::STATIC_MESH)
+                {
+                    scene::StaticMeshData meshData(primitive.boundingBox,
+                                                   primitive.getIndices(), primitive.indexSize, primitive.indexCount,
+                                                   primitive.vertices.data(), static_cast<uint32_t>(primitive.vertices.size()),
+                                                   material);
+                    bundle.setStaticMeshData(primitive.name, meshData);
+                }
+                else
+                {
+                    scene::SkinnedMeshData meshData(primitive.boundingBox,
+                                                    primitive.getIndices(), primitive.indexSize, primitive.indexCount,
+                                                    primitive.vertices.data(), static_cast<uint32_t>(primitive.vertices.size()),
+                                                    material);
+                    bundle.setSkinnedMeshData(primitive.name, meshData);
+                }
+            }
+        }
+
+        bool GltfLoader::isGltf(const FileData& data)
+        {
+            if (data.size() >= GLB_HEADER_SIZE && decodeUInt32Little(data.data()) == GLB_MAGIC)
+                return true;
+
+            // JSON object, optionally after a byte order mark
+            const uint8_t* i = data.begin();
+            if (data.size() >= 3 && i[0] == 0xEF && i[1] == 0xBB && i[2] == 0xBF) i += 3;
+
+            while (i != data.end() && (*i == ' ' || *i == '\t' || *i == '\r' || *i == '\n')) ++i;
+
+            return i != data.end() && *i == '{';
+        }
+
+        GltfLoader::GltfLoader(Cache& initCache, uint32_t initType):
+            Loader(initCache, initType)
+        {
+        }
+
+        bool GltfLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, FileData(data.data(), data.size()), mipmaps);
+        }
+
+        bool GltfLoader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps)
+        {
+            if (!isGltf(data))
+                return false;
+
+            Model model;
+            parseModel(filename, data, model);
+            createModel(bundle, cache, type, model, mipmaps);
+
+            return true;
+        }
+
+        bool GltfLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            if (!isGltf(data))
+                return false;
+
+            // the model keeps the buffers mapped until the meshes are created
+            std::shared_ptr<Model> model = std::make_shared<Model>();
+            parseModel(filename, data, *model);
+
+            for (const Model::Image& image : model->images)
+                if (!image.name.empty() && !image.embedded)
+                    result.dependencies.push_back(Asset(Loader::IMAGE, image.name, mipmaps));
+
+            result.create = [this, &bundle, model, mipmaps]() {
+                createModel(bundle, cache, type, *model, mipmaps);
+                return true;
+            };
+
             return true;
         }
     } // namespace assets
@@ -9,13 +9,24 @@ namespace ouzel
 {
     namespace assets
     {
+        // loads glTF 2.0 files (JSON and binary GLB), returns false for other files
+        // every triangle primitive becomes a mesh data named after its mesh with "#<primitive index>" appended for all but the first primitive,
+        // unnamed meshes are named after the file ("<file name>#mesh<mesh index>" for all but the first mesh), named materials are added to the bundle
+        // the meshes are transformed by the first node of the default scene that references them, skins are read in the bind pose
+        // tightly packed 16-bit and 32-bit index buffer views are uploaded without a conversion
+        // external images are loaded with the image loader, embedded images are decoded in parallel and named "<file name>#<image index>"
         class GltfLoader final: public Loader
         {
         public:
             static constexpr uint32_t TYPE = Loader::SKINNED_MESH;
+            static constexpr uint32_t GLB_MAGIC = 0x46546C67; // "glTF"
 
-            explicit GltfLoader(Cache& initCache);
+            static bool isGltf(const FileData& data);
+
+            explicit GltfLoader(Cache& initCache, uint32_t initType = TYPE);
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
@@ -23,12 +23,7 @@ namespace ouzel
 {
     namespace assets
     {
-        ImageLoader::ImageLoader(Cache& initCache):
-            Loader(initCache, TYPE)
-        {
-        }
-
-        bool ImageLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        graphics::ImageData ImageLoader::decodeImage(const FileData& data)
         {
             int width;
             int height;
@@ -99,15 +94,46 @@ namespace ouzel
                     throw std::runtime_error("Unsupported pixel format");
             }
 
-            graphics::ImageData image(pixelFormat,
-                                      Size2<uint32_t>(static_cast<uint32_t>(width),
-                                                      static_cast<uint32_t>(height)),
-                                      imageData);
+            return graphics::ImageData(pixelFormat,
+                                       Size2<uint32_t>(static_cast<uint32_t>(width),
+                                                       static_cast<uint32_t>(height)),
+                                       imageData);
+        }
 
+        static void createTexture(Bundle& bundle, const std::string& filename, const graphics::ImageData& image, bool mipmaps)
+        {
             std::shared_ptr<graphics::Texture> texture = std::make_shared<graphics::Texture>(*engine->getRenderer());
             texture->init(image.getData(), image.getSize(), 0, mipmaps ? 0 : 1, image.getPixelFormat());
 
             bundle.setTexture(filename, texture);
+        }
+
+        ImageLoader::ImageLoader(Cache& initCache):
+            Loader(initCache, TYPE)
+        {
+        }
+
+        bool ImageLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, FileData(data.data(), data.size()), mipmaps);
+        }
+
+        bool ImageLoader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps)
+        {
+            createTexture(bundle, filename, decodeImage(data), mipmaps);
+
+            return true;
+        }
+
+        bool ImageLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            // decoding is the slow part, only the texture is created on the update thread
+            std::shared_ptr<graphics::ImageData> image = std::make_shared<graphics::ImageData>(decodeImage(data));
+
+            result.create = [&bundle, filename, image, mipmaps]() {
+                createTexture(bundle, filename, *image, mipmaps);
+                return true;
+            };
 
             return true;
         }
@@ -4,6 +4,7 @@
 #define OUZEL_ASSETS_IMAGELOADER_HPP
 
 #include "assets/Loader.hpp"
+#include "graphics/ImageData.hpp"
 
 namespace ouzel
 {
@@ -14,8 +15,13 @@ namespace ouzel
         public:
             static constexpr uint32_t TYPE = Loader::IMAGE;
 
+            // can be called without an engine
+            static graphics::ImageData decodeImage(const FileData& data);
+
             explicit ImageLoader(Cache& initCache);
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
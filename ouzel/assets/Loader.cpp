@@ -19,5 +19,19 @@ namespace ouzel
         {
             cache.removeLoader(this);
         }
+
+        bool Loader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, data.toVector(), mipmaps);
+        }
+
+        bool Loader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            result.create = [this, &bundle, filename, data, mipmaps]() {
+                return loadAsset(bundle, filename, data, mipmaps);
+            };
+
+            return true;
+        }
     } // namespace assets
 } // namespace ouzel
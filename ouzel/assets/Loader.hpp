@@ -3,8 +3,11 @@
 #ifndef OUZEL_ASSETS_LOADER_HPP
 #define OUZEL_ASSETS_LOADER_HPP
 
+#include <functional>
 #include <string>
 #include <vector>
+#include "assets/Bundle.hpp"
+#include "files/FileData.hpp"
 
 namespace ouzel
 {
@@ -29,6 +32,16 @@ namespace ouzel
                 SOUND
             };
 
+            // result of decoding an asset on a worker thread
+            class PreparedAsset final
+            {
+            public:
+                // loaded before create is called
+                std::vector<Asset> dependencies;
+                // called on the update thread, creates the GPU resources and adds the asset to the bundle
+                std::function<bool()> create;
+            };
+
             Loader(Cache& initCache, uint32_t initType);
             virtual ~Loader();
 
@@ -41,6 +54,12 @@ namespace ouzel
             inline uint32_t getType() const { return type; }
 
             virtual bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) = 0;
+            // loaders that can read directly from the mapped file override this, the default implementation copies the data
+            virtual bool loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps = true);
+
+            // called on a worker thread by Bundle::loadAssetsAsync, must not access the bundle or the renderer
+            // the default implementation defers the whole loading to create
+            virtual bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result);
 
         protected:
             Cache& cache;
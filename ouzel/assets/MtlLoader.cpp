@@ -27,8 +27,8 @@ namespace ouzel
             return c <= 0x1F;
         }
 
-        static void skipWhitespaces(const std::vector<uint8_t>& str,
-                                    std::vector<uint8_t>::const_iterator& iterator)
+        static void skipWhitespaces(const FileData& str,
+                                    const uint8_t*& iterator)
         {
             for (;;)
             {
@@ -41,8 +41,8 @@ namespace ouzel
             }
         }
 
-        static void skipLine(const std::vector<uint8_t>& str,
-                             std::vector<uint8_t>::const_iterator& iterator)
+        static void skipLine(const FileData& str,
+                             const uint8_t*& iterator)
         {
             for (;;)
             {
@@ -58,8 +58,8 @@ namespace ouzel
             }
         }
 
-        static std::string parseString(const std::vector<uint8_t>& str,
-                                       std::vector<uint8_t>::const_iterator& iterator)
+        static std::string parseString(const FileData& str,
+                                       const uint8_t*& iterator)
         {
             std::string result;
 
@@ -78,8 +78,8 @@ namespace ouzel
             return result;
         }
 
-        static float parseFloat(const std::vector<uint8_t>& str,
-                               std::vector<uint8_t>::const_iterator& iterator)
+        static float parseFloat(const FileData& str,
+                               const uint8_t*& iterator)
         {
             float result;
             std::string value;
@@ -124,22 +124,15 @@ namespace ouzel
             return result;
         }
 
-        MtlLoader::MtlLoader(Cache& initCache):
-            Loader(initCache, TYPE)
-        {
-        }
-
-        bool MtlLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        void MtlLoader::parseMaterials(const std::string& filename, const FileData& data,
+                                       std::vector<MaterialDescription>& materials)
         {
-            std::string name = filename;
-            std::shared_ptr<graphics::Texture> diffuseTexture;
-            std::shared_ptr<graphics::Texture> ambientTexture;
-            Color diffuseColor = Color::WHITE;
-            float opacity = 1.0F;
+            MaterialDescription material;
+            material.name = filename;
 
             uint32_t materialCount = 0;
 
-            auto iterator = data.cbegin();
+            const uint8_t* iterator = data.cbegin();
 
             std::string keyword;
             std::string value;
@@ -166,51 +159,28 @@ namespace ouzel
                     if (keyword == "newmtl")
                     {
                         if (materialCount)
-                        {
-                            std::shared_ptr<graphics::Material> material = std::make_shared<graphics::Material>();
-                            material->blendState = cache.getBlendState(BLEND_ALPHA);
-                            material->shader = cache.getShader(SHADER_TEXTURE);
-                            material->textures[0] = diffuseTexture;
-                            material->textures[1] = ambientTexture;
-                            material->diffuseColor = diffuseColor;
-                            material->opacity = opacity;
-
-                            bundle.setMaterial(name, material);
-                        }
+                            materials.push_back(material);
+
+                        material = MaterialDescription();
 
                         skipWhitespaces(data, iterator);
-                        name = parseString(data, iterator);
+                        material.name = parseString(data, iterator);
 
                         skipLine(data, iterator);
-
-                        diffuseTexture.reset();
-                        ambientTexture.reset();
-                        diffuseColor = Color::WHITE;
-                        opacity = 1.0F;
                     }
                     else if (keyword == "map_Ka") // ambient texture map
                     {
                         skipWhitespaces(data, iterator);
-                        value = parseString(data, iterator);
+                        material.ambientTexture = parseString(data, iterator);
 
                         skipLine(data, iterator);
-
-                        ambientTexture = cache.getTexture(value);
                     }
                     else if (keyword == "map_Kd") // diffuse texture map
                     {
                         skipWhitespaces(data, iterator);
-                        value = parseString(data, iterator);
+                        material.diffuseTexture = parseString(data, iterator);
 
                         skipLine(data, iterator);
-
-                        diffuseTexture = cache.getTexture(value);
-
-                        if (!diffuseTexture)
-                        {
-                            bundle.loadAsset(Loader::IMAGE, value, mipmaps);
-                            diffuseTexture = cache.getTexture(value);
-                        }
                     }
                     else if (keyword == "Ka") // ambient color
                         skipLine(data, iterator);
@@ -228,7 +198,7 @@ namespace ouzel
                         skipLine(data, iterator);
 
                         color[3] = 1.0F;
-                        diffuseColor = Color(color);
+                        material.diffuseColor = Color(color);
                     }
                     else if (keyword == "Ks") // specular color
                         skipLine(data, iterator);
@@ -237,7 +207,7 @@ namespace ouzel
                     else if (keyword == "d") // opacity
                     {
                         skipWhitespaces(data, iterator);
-                        opacity = parseFloat(data, iterator);
+                        material.opacity = parseFloat(data, iterator);
 
                         skipLine(data, iterator);
                     }
@@ -251,7 +221,7 @@ namespace ouzel
                         skipLine(data, iterator);
 
                         // d = 1 - Tr
-                        opacity = 1.0F - transparency;
+                        material.opacity = 1.0F - transparency;
                     }
                     else
                     {
@@ -264,17 +234,71 @@ namespace ouzel
             }
 
             if (materialCount)
+                materials.push_back(material);
+        }
+
+        static void createMaterials(Bundle& bundle, Cache& cache,
+                                    const std::vector<MtlLoader::MaterialDescription>& materials, bool mipmaps)
+        {
+            for (const MtlLoader::MaterialDescription& description : materials)
             {
                 std::shared_ptr<graphics::Material> material = std::make_shared<graphics::Material>();
                 material->blendState = cache.getBlendState(BLEND_ALPHA);
                 material->shader = cache.getShader(SHADER_TEXTURE);
-                material->textures[0] = diffuseTexture;
-                material->textures[1] = ambientTexture;
-                material->diffuseColor = diffuseColor;
-                material->opacity = opacity;
 
-                bundle.setMaterial(name, material);
+                if (!description.diffuseTexture.empty())
+                {
+                    material->textures[0] = cache.getTexture(description.diffuseTexture);
+
+                    if (!material->textures[0])
+                    {
+                        bundle.loadAsset(Loader::IMAGE, description.diffuseTexture, mipmaps);
+                        material->textures[0] = cache.getTexture(description.diffuseTexture);
+                    }
+                }
+
+                if (!description.ambientTexture.empty())
+                    material->textures[1] = cache.getTexture(description.ambientTexture);
+
+                material->diffuseColor = description.diffuseColor;
+                material->opacity = description.opacity;
+
+                bundle.setMaterial(description.name, material);
             }
+        }
+
+        MtlLoader::MtlLoader(Cache& initCache):
+            Loader(initCache, TYPE)
+        {
+        }
+
+        bool MtlLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, FileData(data.data(), data.size()), mipmaps);
+        }
+
+        bool MtlLoader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps)
+        {
+            std::vector<MaterialDescription> materials;
+            parseMaterials(filename, data, materials);
+            createMaterials(bundle, cache, materials, mipmaps);
+
+            return true;
+        }
+
+        bool MtlLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            std::shared_ptr<std::vector<MaterialDescription>> materials = std::make_shared<std::vector<MaterialDescription>>();
+            parseMaterials(filename, data, *materials);
+
+            for (const MaterialDescription& material : *materials)
+                if (!material.diffuseTexture.empty())
+                    result.dependencies.push_back(Asset(Loader::IMAGE, material.diffuseTexture, mipmaps));
+
+            result.create = [this, &bundle, materials, mipmaps]() {
+                createMaterials(bundle, cache, *materials, mipmaps);
+                return true;
+            };
 
             return true;
         }
@@ -3,7 +3,10 @@
 #ifndef OUZEL_ASSETS_MTLLOADER_HPP
 #define OUZEL_ASSETS_MTLLOADER_HPP
 
+#include <string>
+#include <vector>
 #include "assets/Loader.hpp"
+#include "math/Color.hpp"
 
 namespace ouzel
 {
@@ -14,8 +17,23 @@ namespace ouzel
         public:
             static constexpr uint32_t TYPE = Loader::MATERIAL;
 
+            struct MaterialDescription final
+            {
+                std::string name;
+                std::string diffuseTexture;
+                std::string ambientTexture;
+                Color diffuseColor = Color::WHITE;
+                float opacity = 1.0F;
+            };
+
+            // can be called without an engine
+            static void parseMaterials(const std::string& filename, const FileData& data,
+                                       std::vector<MaterialDescription>& materials);
+
             explicit MtlLoader(Cache& initCache);
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
@@ -1,408 +1,595 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
-#include <cstdlib>
-#include <iterator>
-#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <stdexcept>
 #include <string>
-#include <tuple>
+#include <unordered_map>
 #include "ObjLoader.hpp"
 #include "Bundle.hpp"
 #include "Cache.hpp"
+#include "core/Engine.hpp"
 #include "graphics/Material.hpp"
+#include "utils/NumberParser.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
-        static bool isWhitespace(uint8_t c)
+        static constexpr size_t PARALLEL_PARSE_CHUNK_SIZE = 1024 * 1024;
+
+        static inline bool isWhitespace(uint8_t c)
         {
             return c == ' ' || c == '\t';
         }
 
-        static bool isNewline(uint8_t c)
+        static inline bool isNewline(uint8_t c)
         {
             return c == '\r' || c == '\n';
         }
 
-        static bool isControlChar(uint8_t c)
+        static inline bool isControlChar(uint8_t c)
         {
             return c <= 0x1F;
         }
 
-        static void skipWhitespaces(const std::vector<uint8_t>& str,
-                                    std::vector<uint8_t>::const_iterator& iterator)
+        static inline bool isDigit(uint8_t c)
         {
-            for (;;)
-            {
-                if (iterator == str.end()) break;
-
-                if (isWhitespace(*iterator))
-                    ++iterator;
-                else
-                    break;
-            }
+            return c >= '0' && c <= '9';
         }
 
-        static void skipLine(const std::vector<uint8_t>& str,
-                             std::vector<uint8_t>::const_iterator& iterator)
+        static inline void skipWhitespaces(const uint8_t*& iterator, const uint8_t* end)
         {
-            for (;;)
-            {
-                if (iterator == str.end()) break;
-
-                if (isNewline(*iterator))
-                {
-                    ++iterator;
-                    break;
-                }
-
-                ++iterator;
-            }
+            while (iterator != end && isWhitespace(*iterator)) ++iterator;
         }
 
-        static std::string parseString(const std::vector<uint8_t>& str,
-                                       std::vector<uint8_t>::const_iterator& iterator)
+        static inline void skipLine(const uint8_t*& iterator, const uint8_t* end)
         {
-            std::string result;
+            while (iterator != end && !isNewline(*iterator)) ++iterator;
+            if (iterator != end) ++iterator;
+        }
 
-            for (;;)
-            {
-                if (iterator == str.end() || isControlChar(*iterator) || isWhitespace(*iterator)) break;
+        static std::string parseString(const uint8_t*& iterator, const uint8_t* end)
+        {
+            const uint8_t* start = iterator;
 
-                result.push_back(static_cast<char>(*iterator));
+            while (iterator != end && !isControlChar(*iterator) && !isWhitespace(*iterator)) ++iterator;
 
-                ++iterator;
-            }
-
-            if (result.empty())
+            if (iterator == start)
                 throw std::runtime_error("Invalid string");
 
-            return result;
+            return std::string(reinterpret_cast<const char*>(start), static_cast<size_t>(iterator - start));
         }
 
-        static int32_t parseInt32(const std::vector<uint8_t>& str,
-                                  std::vector<uint8_t>::const_iterator& iterator)
+        // returns 0 if there is no number
+        static int32_t parseInt32(const uint8_t*& iterator, const uint8_t* end)
         {
-            int32_t result;
-            std::string value;
-            uint32_t length = 1;
+            bool negative = false;
 
-            if (iterator != str.end() && *iterator == '-')
+            if (iterator != end && *iterator == '-')
             {
-                value.push_back(static_cast<char>(*iterator));
-                ++length;
+                negative = true;
                 ++iterator;
             }
 
-            for (;;)
-            {
-                if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
+            int64_t result = 0;
 
-                value.push_back(static_cast<char>(*iterator));
+            for (; iterator != end && isDigit(*iterator); ++iterator)
+            {
+                result = result * 10 + (*iterator - '0');
 
-                ++iterator;
+                if (result > INT32_MAX)
+                    throw std::runtime_error("Integer out of range");
             }
 
-            if (value.length() < length) return false;
+            return static_cast<int32_t>(negative ? -result : result);
+        }
+
+        static inline bool parseToken(const uint8_t*& iterator, const uint8_t* end, char token)
+        {
+            if (iterator == end || *iterator != static_cast<uint8_t>(token)) return false;
 
-            result = std::stoi(value);
+            ++iterator;
 
-            return result;
+            return true;
         }
 
-        static float parseFloat(const std::vector<uint8_t>& str,
-                               std::vector<uint8_t>::const_iterator& iterator)
+        static inline bool compareKeyword(const uint8_t* keyword, size_t length, const char* str)
         {
-            float result;
-            std::string value;
-            uint32_t length = 1;
+            return std::strlen(str) == length && std::memcmp(keyword, str, length) == 0;
+        }
 
-            if (iterator != str.end() && *iterator == '-')
+        // the file is split into chunks of lines that are parsed in parallel and merged in order
+        struct Chunk final
+        {
+            enum class Command: uint8_t
             {
-                value.push_back(static_cast<char>(*iterator));
-                ++length;
-                ++iterator;
-            }
+                OBJECT,
+                MATERIAL,
+                FACE
+            };
 
-            for (;;)
+            struct Entry final
             {
-                if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
-
-                value.push_back(static_cast<char>(*iterator));
-
-                ++iterator;
-            }
-
-            if (iterator != str.end() && *iterator == '.')
+                Command command;
+                bool attributes; // for objects, whether a statement preceded it in the chunk
+                uint32_t offset; // index of the string or of the first face vertex
+                uint32_t count;
+            };
+
+            // positive indices are absolute, the negative indices are converted to indices relative to the start of the chunk
+            struct FaceVertex final
             {
-                value.push_back(static_cast<char>(*iterator));
-                ++length;
-                ++iterator;
+                int32_t position;
+                int32_t texCoord;
+                int32_t normal;
+                uint8_t relative; // bit per index
+            };
 
-                for (;;)
+            std::vector<Vector3<float>> positions;
+            std::vector<Vector2<float>> texCoords;
+            std::vector<Vector3<float>> normals;
+            std::vector<FaceVertex> faceVertices;
+            std::vector<std::string> strings;
+            std::vector<std::string> materialLibraries;
+            std::vector<Entry> entries;
+            bool attributes = false;
+        };
+
+        static void parseChunk(const uint8_t* iterator, const uint8_t* end, Chunk& chunk)
+        {
+            while (iterator != end)
+            {
+                if (isNewline(*iterator))
                 {
-                    if (iterator == str.end() || *iterator < '0' || *iterator > '9') break;
-
-                    value.push_back(static_cast<char>(*iterator));
-
+                    // skip empty lines
                     ++iterator;
+                    continue;
                 }
-            }
 
-            if (value.length() < length) return false;
+                skipWhitespaces(iterator, end);
 
-            result = std::stof(value);
+                if (iterator == end) break;
 
-            return result;
-        }
-
-        static bool parseToken(const std::vector<uint8_t>& str,
-                               std::vector<uint8_t>::const_iterator& iterator,
-                               char token)
-        {
-            if (iterator == str.end() || *iterator != static_cast<uint8_t>(token)) return false;
+                if (*iterator == '#' || isNewline(*iterator))
+                {
+                    // skip the comment
+                    skipLine(iterator, end);
+                    continue;
+                }
 
-            ++iterator;
+                const uint8_t* keyword = iterator;
+                while (iterator != end && !isControlChar(*iterator) && !isWhitespace(*iterator)) ++iterator;
+                size_t keywordLength = static_cast<size_t>(iterator - keyword);
 
-            return true;
-        }
+                if (!keywordLength)
+                    throw std::runtime_error("Invalid string");
 
-        ObjLoader::ObjLoader(Cache& initCache):
-            Loader(initCache, TYPE)
-        {
-        }
+                if (compareKeyword(keyword, keywordLength, "v"))
+                {
+                    Vector3<float> position;
 
-        bool ObjLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
-        {
-            std::string name = filename;
-            std::shared_ptr<graphics::Material> material;
-            std::vector<Vector3<float>> positions;
-            std::vector<Vector2<float>> texCoords;
-            std::vector<Vector3<float>> normals;
-            std::vector<graphics::Vertex> vertices;
-            std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> vertexMap;
-            std::vector<uint32_t> indices;
-            Box3<float> boundingBox;
+                    skipWhitespaces(iterator, end);
+                    position.v[0] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    position.v[1] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    position.v[2] = parseFloat(iterator, end);
 
-            uint32_t objectCount = 0;
+                    skipLine(iterator, end);
 
-            auto iterator = data.cbegin();
+                    chunk.positions.push_back(position);
+                }
+                else if (compareKeyword(keyword, keywordLength, "vt"))
+                {
+                    Vector2<float> texCoord;
 
-            std::string keyword;
-            std::string value;
+                    skipWhitespaces(iterator, end);
+                    texCoord.v[0] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    // the v coordinate is optional
+                    if (iterator != end && !isNewline(*iterator))
+                        texCoord.v[1] = parseFloat(iterator, end);
 
-            for (;;)
-            {
-                if (iterator == data.end()) break;
+                    skipLine(iterator, end);
 
-                if (isNewline(*iterator))
-                {
-                    // skip empty lines
-                    ++iterator;
+                    chunk.texCoords.push_back(texCoord);
                 }
-                else if (*iterator == '#')
+                else if (compareKeyword(keyword, keywordLength, "vn"))
                 {
-                    // skip the comment
-                    skipLine(data, iterator);
+                    Vector3<float> normal;
+
+                    skipWhitespaces(iterator, end);
+                    normal.v[0] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    normal.v[1] = parseFloat(iterator, end);
+                    skipWhitespaces(iterator, end);
+                    normal.v[2] = parseFloat(iterator, end);
+
+                    skipLine(iterator, end);
+
+                    chunk.normals.push_back(normal);
                 }
-                else
+                else if (compareKeyword(keyword, keywordLength, "f"))
                 {
-                    skipWhitespaces(data, iterator);
-                    keyword = parseString(data, iterator);
+                    Chunk::Entry entry{Chunk::Command::FACE, false, static_cast<uint32_t>(chunk.faceVertices.size()), 0};
 
-                    if (keyword == "mtllib")
+                    for (;;)
                     {
-                        skipWhitespaces(data, iterator);
-                        value = parseString(data, iterator);
+                        skipWhitespaces(iterator, end);
 
-                        skipLine(data, iterator);
+                        if (iterator == end || isNewline(*iterator)) break;
 
-                        if (!cache.getMaterial(filename))
-                            bundle.loadAsset(Loader::MATERIAL, value, mipmaps);
-                    }
-                    else if (keyword == "usemtl")
-                    {
-                        skipWhitespaces(data, iterator);
-                        value = parseString(data, iterator);
+                        Chunk::FaceVertex faceVertex{0, 0, 0, 0};
 
-                        skipLine(data, iterator);
+                        faceVertex.position = parseInt32(iterator, end);
 
-                        material = cache.getMaterial(value);
-                    }
-                    else if (keyword == "o")
-                    {
-                        if (objectCount)
+                        if (faceVertex.position < 0)
                         {
-                            scene::StaticMeshData meshData(boundingBox, indices, vertices, material);
-                            bundle.setStaticMeshData(name, meshData);
+                            faceVertex.position += static_cast<int32_t>(chunk.positions.size()) + 1;
+                            faceVertex.relative |= 0x01;
                         }
+                        else if (faceVertex.position == 0)
+                            throw std::runtime_error("Invalid position index");
 
-                        skipWhitespaces(data, iterator);
-                        name = parseString(data, iterator);
+                        // has texture coordinates
+                        if (parseToken(iterator, end, '/'))
+                        {
+                            // two slashes in a row indicates no texture coordinates
+                            if (iterator != end && *iterator != '/')
+                            {
+                                faceVertex.texCoord = parseInt32(iterator, end);
 
-                        skipLine(data, iterator);
+                                if (faceVertex.texCoord < 0)
+                                {
+                                    faceVertex.texCoord += static_cast<int32_t>(chunk.texCoords.size()) + 1;
+                                    faceVertex.relative |= 0x02;
+                                }
+                                else if (faceVertex.texCoord == 0)
+                                    throw std::runtime_error("Invalid texture coordinate index");
+                            }
 
-                        material.reset();
-                        vertices.clear();
-                        indices.clear();
-                        vertexMap.clear();
-                        boundingBox.reset();
-                        ++objectCount;
-                    }
-                    else if (keyword == "v")
-                    {
-                        Vector3<float> position;
+                            // has normal
+                            if (parseToken(iterator, end, '/'))
+                            {
+                                faceVertex.normal = parseInt32(iterator, end);
 
-                        skipWhitespaces(data, iterator);
-                        position.v[0] = parseFloat(data, iterator);
-                        skipWhitespaces(data, iterator);
-                        position.v[1] = parseFloat(data, iterator);
-                        skipWhitespaces(data, iterator);
-                        position.v[2] = parseFloat(data, iterator);
+                                if (faceVertex.normal < 0)
+                                {
+                                    faceVertex.normal += static_cast<int32_t>(chunk.normals.size()) + 1;
+                                    faceVertex.relative |= 0x04;
+                                }
+                                else if (faceVertex.normal == 0)
+                                    throw std::runtime_error("Invalid normal index");
+                            }
+                        }
 
-                        skipLine(data, iterator);
+                        if (iterator != end && !isWhitespace(*iterator) && !isNewline(*iterator))
+                            throw std::runtime_error("Invalid face");
 
-                        positions.push_back(position);
+                        chunk.faceVertices.push_back(faceVertex);
+                        ++entry.count;
                     }
-                    else if (keyword == "vt")
-                    {
-                        Vector2<float> texCoord;
 
-                        skipWhitespaces(data, iterator);
-                        texCoord.v[0] = parseFloat(data, iterator);
-                        skipWhitespaces(data, iterator);
-                        texCoord.v[1] = parseFloat(data, iterator);
+                    if (entry.count < 3)
+                        throw std::runtime_error("Invalid face count");
 
-                        skipLine(data, iterator);
-
-                        texCoords.push_back(texCoord);
-                    }
-                    else if (keyword == "vn")
-                    {
-                        Vector3<float> normal;
+                    chunk.entries.push_back(entry);
+                }
+                else if (compareKeyword(keyword, keywordLength, "o"))
+                {
+                    skipWhitespaces(iterator, end);
 
-                        skipWhitespaces(data, iterator);
-                        normal.v[0] = parseFloat(data, iterator);
-                        skipWhitespaces(data, iterator);
-                        normal.v[1] = parseFloat(data, iterator);
-                        skipWhitespaces(data, iterator);
-                        normal.v[2] = parseFloat(data, iterator);
+                    chunk.entries.push_back(Chunk::Entry{Chunk::Command::OBJECT, chunk.attributes,
+                        static_cast<uint32_t>(chunk.strings.size()), 0});
+                    chunk.strings.push_back(parseString(iterator, end));
 
-                        skipLine(data, iterator);
+                    skipLine(iterator, end);
+                }
+                else if (compareKeyword(keyword, keywordLength, "usemtl"))
+                {
+                    skipWhitespaces(iterator, end);
 
-                        normals.push_back(normal);
-                    }
-                    else if (keyword == "f")
-                    {
-                        std::vector<uint32_t> vertexIndices;
+                    chunk.entries.push_back(Chunk::Entry{Chunk::Command::MATERIAL, false,
+                        static_cast<uint32_t>(chunk.strings.size()), 0});
+                    chunk.strings.push_back(parseString(iterator, end));
 
-                        std::tuple<uint32_t, uint32_t, uint32_t> i = std::make_tuple(0, 0, 0);
-                        int32_t positionIndex = 0;
-                        int32_t texCoordIndex = 0;
-                        int32_t normalIndex = 0;
+                    skipLine(iterator, end);
+                }
+                else if (compareKeyword(keyword, keywordLength, "mtllib"))
+                {
+                    skipWhitespaces(iterator, end);
+                    chunk.materialLibraries.push_back(parseString(iterator, end));
 
-                        for (;;)
-                        {
-                            if (iterator == data.end() || isNewline(*iterator)) break;
+                    skipLine(iterator, end);
+                }
+                else
+                {
+                    // skip all unknown commands
+                    skipLine(iterator, end);
+                }
 
-                            skipWhitespaces(data, iterator);
-                            positionIndex = parseInt32(data, iterator);
+                chunk.attributes = true; // if we got at least one attribute, we have an object
+            }
+        }
 
-                            if (positionIndex < 0)
-                                positionIndex = static_cast<int32_t>(positions.size()) + positionIndex + 1;
+        struct VertexKey final
+        {
+            uint32_t position;
+            uint32_t texCoord;
+            uint32_t normal;
 
-                            if (positionIndex < 1 || positionIndex > static_cast<int32_t>(positions.size()))
-                                throw std::runtime_error("Invalid position index");
+            bool operator==(const VertexKey& other) const
+            {
+                return position == other.position && texCoord == other.texCoord && normal == other.normal;
+            }
+        };
 
-                            std::get<0>(i) = static_cast<uint32_t>(positionIndex);
+        struct VertexKeyHash final
+        {
+            size_t operator()(const VertexKey& key) const
+            {
+                return (static_cast<size_t>(key.position) * 73856093U) ^
+                    (static_cast<size_t>(key.texCoord) * 19349663U) ^
+                    (static_cast<size_t>(key.normal) * 83492791U);
+            }
+        };
 
-                            // has texture coordinates
-                            if (parseToken(data, iterator, '/'))
-                            {
-                                // two slashes in a row indicates no texture coordinates
-                                if (iterator != data.end() && *iterator != '/')
-                                {
-                                    texCoordIndex = parseInt32(data, iterator);
+        static uint32_t resolveIndex(int32_t index, bool relative, size_t base, size_t count, const char* error)
+        {
+            int64_t result = relative ? static_cast<int64_t>(base) + index : index;
 
-                                    if (texCoordIndex < 0)
-                                        texCoordIndex = static_cast<int32_t>(texCoords.size()) + texCoordIndex + 1;
+            if (result < 1 || result > static_cast<int64_t>(count))
+                throw std::runtime_error(error);
 
-                                    if (texCoordIndex < 1 || texCoordIndex > static_cast<int32_t>(texCoords.size()))
-                                        throw std::runtime_error("Invalid texture coordinate index");
+            return static_cast<uint32_t>(result);
+        }
 
-                                    std::get<1>(i) = static_cast<uint32_t>(texCoordIndex);
-                                }
+        void ObjLoader::parseObjects(const std::string& filename, const FileData& data,
+                                     std::vector<std::string>& materialLibraries,
+                                     std::vector<ObjectDescription>& objects)
+        {
+            // split the data at the line ends
+            std::vector<const uint8_t*> boundaries;
+            boundaries.push_back(data.cbegin());
 
-                                // has normal
-                                if (parseToken(data, iterator, '/'))
-                                {
-                                    normalIndex = parseInt32(data, iterator);
+            JobSystem* jobSystem = engine ? engine->getJobSystem() : nullptr;
 
-                                    if (normalIndex < 0)
-                                        normalIndex = static_cast<int32_t>(normals.size()) + normalIndex + 1;
+            if (jobSystem && data.size() >= 2 * PARALLEL_PARSE_CHUNK_SIZE)
+            {
+                size_t chunkCount = std::min(data.size() / PARALLEL_PARSE_CHUNK_SIZE,
+                                             static_cast<size_t>(jobSystem->getThreadCount() + 1) * 4);
+                size_t chunkSize = data.size() / chunkCount;
 
-                                    if (normalIndex < 1 || normalIndex > static_cast<int32_t>(normals.size()))
-                                        throw std::runtime_error("Invalid normal index");
+                for (size_t i = 1; i < chunkCount; ++i)
+                {
+                    const uint8_t* boundary = std::max(boundaries.back(), data.cbegin() + i * chunkSize);
+                    skipLine(boundary, data.cend());
+                    if (boundary != data.cend()) boundaries.push_back(boundary);
+                }
+            }
 
-                                    std::get<2>(i) = static_cast<uint32_t>(normalIndex);
-                                }
-                            }
+            boundaries.push_back(data.cend());
 
-                            uint32_t index = 0;
+            std::vector<Chunk> chunks(boundaries.size() - 1);
 
-                            auto vertexIterator = vertexMap.find(i);
-                            if (vertexIterator == vertexMap.end())
-                            {
-                                index = static_cast<uint32_t>(vertices.size());
-                                vertexMap[i] = index;
-
-                                graphics::Vertex vertex;
-                                if (std::get<0>(i) >= 1) vertex.position = positions[std::get<0>(i) - 1];
-                                if (std::get<1>(i) >= 1) vertex.texCoords[0] = texCoords[std::get<1>(i) - 1];
-                                vertex.color = Color::WHITE;
-                                if (std::get<2>(i) >= 1) vertex.normal = normals[std::get<2>(i) - 1];
-                                vertices.push_back(vertex);
-                                boundingBox.insertPoint(vertex.position);
-                            }
-                            else
-                                index = vertexIterator->second;
+            if (chunks.size() > 1)
+            {
+                std::vector<std::exception_ptr> errors(chunks.size());
 
-                            vertexIndices.push_back(index);
+                jobSystem->parallelFor(0, static_cast<uint32_t>(chunks.size()), 1, [&boundaries, &chunks, &errors](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; ++i)
+                    {
+                        try
+                        {
+                            parseChunk(boundaries[i], boundaries[i + 1], chunks[i]);
                         }
-
-                        if (vertexIndices.size() < 3)
-                            throw std::runtime_error("Invalid face count");
-                        else if (vertexIndices.size() == 3)
+                        catch (...)
                         {
-                            for (uint32_t vertexIndex : vertexIndices)
-                                indices.push_back(vertexIndex);
+                            errors[i] = std::current_exception();
                         }
-                        else
+                    }
+                });
+
+                for (const std::exception_ptr& error : errors)
+                    if (error) std::rethrow_exception(error);
+            }
+            else
+                parseChunk(boundaries.front(), boundaries.back(), chunks.front());
+
+            // merge the attributes of the chunks
+            std::vector<Vector3<float>> positions;
+            std::vector<Vector2<float>> texCoords;
+            std::vector<Vector3<float>> normals;
+
+            if (chunks.size() == 1)
+            {
+                positions = std::move(chunks.front().positions);
+                texCoords = std::move(chunks.front().texCoords);
+                normals = std::move(chunks.front().normals);
+            }
+            else
+            {
+                size_t positionCount = 0;
+                size_t texCoordCount = 0;
+                size_t normalCount = 0;
+
+                for (const Chunk& chunk : chunks)
+                {
+                    positionCount += chunk.positions.size();
+                    texCoordCount += chunk.texCoords.size();
+                    normalCount += chunk.normals.size();
+                }
+
+                positions.reserve(positionCount);
+                texCoords.reserve(texCoordCount);
+                normals.reserve(normalCount);
+
+                for (const Chunk& chunk : chunks)
+                {
+                    positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+                    texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+                    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+                }
+            }
+
+            // build the objects in the order of the statements
+            ObjectDescription object;
+            object.name = filename;
+            std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertexMap;
+            std::vector<uint32_t> vertexIndices;
+            bool attributes = false;
+            size_t positionBase = 0;
+            size_t texCoordBase = 0;
+            size_t normalBase = 0;
+
+            for (Chunk& chunk : chunks)
+            {
+                materialLibraries.insert(materialLibraries.end(), chunk.materialLibraries.begin(), chunk.materialLibraries.end());
+
+                for (const Chunk::Entry& entry : chunk.entries)
+                {
+                    switch (entry.command)
+                    {
+                        case Chunk::Command::OBJECT:
+                            if (attributes || entry.attributes)
+                                objects.push_back(std::move(object));
+
+                            object = ObjectDescription();
+                            object.name = std::move(chunk.strings[entry.offset]);
+                            vertexMap.clear();
+                            break;
+                        case Chunk::Command::MATERIAL:
+                            object.material = std::move(chunk.strings[entry.offset]);
+                            break;
+                        case Chunk::Command::FACE:
                         {
+                            vertexIndices.clear();
+
+                            for (uint32_t i = entry.offset; i < entry.offset + entry.count; ++i)
+                            {
+                                const Chunk::FaceVertex& faceVertex = chunk.faceVertices[i];
+
+                                VertexKey key;
+                                key.position = resolveIndex(faceVertex.position, (faceVertex.relative & 0x01) != 0,
+                                                            positionBase, positions.size(), "Invalid position index");
+                                key.texCoord = faceVertex.texCoord ?
+                                    resolveIndex(faceVertex.texCoord, (faceVertex.relative & 0x02) != 0,
+                                                 texCoordBase, texCoords.size(), "Invalid texture coordinate index") : 0;
+                                key.normal = faceVertex.normal ?
+                                    resolveIndex(faceVertex.normal, (faceVertex.relative & 0x04) != 0,
+                                                 normalBase, normals.size(), "Invalid normal index") : 0;
+
+                                auto vertexIterator = vertexMap.find(key);
+                                if (vertexIterator == vertexMap.end())
+                                {
+                                    uint32_t index = static_cast<uint32_t>(object.vertices.size());
+                                    vertexMap.insert(std::make_pair(key, index));
+
+                                    graphics::Vertex vertex;
+                                    vertex.position = positions[key.position - 1];
+                                    if (key.texCoord) vertex.texCoords[0] = texCoords[key.texCoord - 1];
+                                    vertex.color = Color::WHITE;
+                                    if (key.normal) vertex.normal = normals[key.normal - 1];
+                                    object.vertices.push_back(vertex);
+                                    object.boundingBox.insertPoint(vertex.position);
+
+                                    vertexIndices.push_back(index);
+                                }
+                                else
+                                    vertexIndices.push_back(vertexIterator->second);
+                            }
+
+                            // triangle fan
                             for (uint32_t index = 0; index < vertexIndices.size() - 2; ++index)
                             {
-                                indices.push_back(vertexIndices[0]);
-                                indices.push_back(vertexIndices[index + 1]);
-                                indices.push_back(vertexIndices[index + 2]);
+                                object.indices.push_back(vertexIndices[0]);
+                                object.indices.push_back(vertexIndices[index + 1]);
+                                object.indices.push_back(vertexIndices[index + 2]);
                             }
+                            break;
                         }
                     }
-                    else
-                    {
-                        // skip all unknown commands
-                        skipLine(data, iterator);
-                    }
-
-                    if (!objectCount) ++objectCount; // if we got at least one attribute, we have an object
                 }
+
+                attributes = attributes || chunk.attributes;
+                positionBase += chunk.positions.size();
+                texCoordBase += chunk.texCoords.size();
+                normalBase += chunk.normals.size();
+
+                // free the memory of the merged chunk
+                chunk = Chunk();
             }
 
-            if (objectCount)
+            if (attributes)
+                objects.push_back(std::move(object));
+        }
+
+        static void createMeshes(Bundle& bundle, Cache& cache, const std::vector<ObjLoader::ObjectDescription>& objects)
+        {
+            for (const ObjLoader::ObjectDescription& object : objects)
             {
-                scene::StaticMeshData meshData(boundingBox, indices, vertices, material);
-                bundle.setStaticMeshData(name, meshData);
+                std::shared_ptr<graphics::Material> material;
+                if (!object.material.empty()) material = cache.getMaterial(object.material);
+
+                // 16-bit indices are used if all the vertices can be addressed with them
+                if (object.vertices.size() <= 65536)
+                {
+                    std::vector<uint16_t> indices(object.indices.begin(), object.indices.end());
+                    scene::StaticMeshData meshData(object.boundingBox,
+                                                   indices.data(), sizeof(uint16_t), static_cast<uint32_t>(indices.size()),
+                                                   object.vertices.data(), static_cast<uint32_t>(object.vertices.size()),
+                                                   material);
+                    bundle.setStaticMeshData(object.name, meshData);
+                }
+                else
+                {
+                    scene::StaticMeshData meshData(object.boundingBox, object.indices, object.vertices, material);
+                    bundle.setStaticMeshData(object.name, meshData);
+                }
             }
+        }
+
+        ObjLoader::ObjLoader(Cache& initCache):
+            Loader(initCache, TYPE)
+        {
+        }
+
+        bool ObjLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, FileData(data.data(), data.size()), mipmaps);
+        }
+
+        bool ObjLoader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps)
+        {
+            std::vector<std::string> materialLibraries;
+            std::vector<ObjectDescription> objects;
+            parseObjects(filename, data, materialLibraries, objects);
+
+            for (const std::string& materialLibrary : materialLibraries)
+                if (!cache.getMaterial(filename))
+                    bundle.loadAsset(Loader::MATERIAL, materialLibrary, mipmaps);
+
+            createMeshes(bundle, cache, objects);
+
+            return true;
+        }
+
+        bool ObjLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            std::vector<std::string> materialLibraries;
+            std::shared_ptr<std::vector<ObjectDescription>> objects = std::make_shared<std::vector<ObjectDescription>>();
+            parseObjects(filename, data, materialLibraries, *objects);
+
+            for (const std::string& materialLibrary : materialLibraries)
+                result.dependencies.push_back(Asset(Loader::MATERIAL, materialLibrary, mipmaps));
+
+            result.create = [this, &bundle, objects]() {
+                createMeshes(bundle, cache, *objects);
+                return true;
+            };
 
             return true;
         }
@@ -3,7 +3,11 @@
 #ifndef OUZEL_ASSETS_OBJLOADER_HPP
 #define OUZEL_ASSETS_OBJLOADER_HPP
 
+#include <string>
+#include <vector>
 #include "assets/Loader.hpp"
+#include "graphics/Vertex.hpp"
+#include "math/Box3.hpp"
 
 namespace ouzel
 {
@@ -14,8 +18,25 @@ namespace ouzel
         public:
             static constexpr uint32_t TYPE = Loader::STATIC_MESH;
 
+            struct ObjectDescription final
+            {
+                std::string name;
+                std::string material;
+                Box3<float> boundingBox;
+                std::vector<uint32_t> indices;
+                std::vector<graphics::Vertex> vertices;
+            };
+
+            // large files are parsed in chunks on the job system of the engine
+            // can be called without an engine
+            static void parseObjects(const std::string& filename, const FileData& data,
+                                     std::vector<std::string>& materialLibraries,
+                                     std::vector<ObjectDescription>& objects);
+
             explicit ObjLoader(Cache& initCache);
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
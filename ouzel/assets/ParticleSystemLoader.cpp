@@ -4,24 +4,16 @@
 #include "Bundle.hpp"
 #include "Cache.hpp"
 #include "scene/ParticleSystemData.hpp"
-#include "utils/JSON.hpp"
+#include "utils/JSONDocument.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
-        ParticleSystemLoader::ParticleSystemLoader(Cache& initCache):
-            Loader(initCache, TYPE)
-        {
-        }
-
-        bool ParticleSystemLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        bool ParticleSystemLoader::parseParticleSystemData(const json::Node& document, scene::ParticleSystemData& particleSystemData)
         {
-            scene::ParticleSystemData particleSystemData;
-
-            json::Data document(data);
-
-            if (!document.hasMember("textureFileName") ||
+            if (document.getType() != json::Node::Type::OBJECT ||
+                !document.hasMember("textureFileName") ||
                 !document.hasMember("configName"))
                 return false;
 
@@ -105,21 +97,62 @@ namespace ouzel
             if (document.hasMember("finishColorVarianceBlue")) particleSystemData.finishColorBlueVariance = document["finishColorVarianceBlue"].as<float>();
             if (document.hasMember("finishColorVarianceAlpha")) particleSystemData.finishColorAlphaVariance = document["finishColorVarianceAlpha"].as<float>();
 
-            if (document.hasMember("textureFileName"))
+            particleSystemData.emissionRate = static_cast<float>(particleSystemData.maxParticles) / particleSystemData.particleLifespan;
+
+            return true;
+        }
+
+        static void createParticleSystemData(Bundle& bundle, Cache& cache, const std::string& filename,
+                                             scene::ParticleSystemData& particleSystemData,
+                                             const std::string& textureFileName, bool mipmaps)
+        {
+            particleSystemData.texture = cache.getTexture(textureFileName);
+
+            if (!particleSystemData.texture)
             {
-                std::string textureFileName = document["textureFileName"].as<std::string>();
+                bundle.loadAsset(Loader::IMAGE, textureFileName, mipmaps);
                 particleSystemData.texture = cache.getTexture(textureFileName);
-
-                if (!particleSystemData.texture)
-                {
-                    bundle.loadAsset(Loader::IMAGE, textureFileName, mipmaps);
-                    particleSystemData.texture = cache.getTexture(textureFileName);
-                }
             }
 
-            particleSystemData.emissionRate = static_cast<float>(particleSystemData.maxParticles) / particleSystemData.particleLifespan;
-
             bundle.setParticleSystemData(filename, particleSystemData);
+        }
+
+        ParticleSystemLoader::ParticleSystemLoader(Cache& initCache):
+            Loader(initCache, TYPE)
+        {
+        }
+
+        bool ParticleSystemLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            scene::ParticleSystemData particleSystemData;
+
+            json::Document document(data);
+
+            if (!parseParticleSystemData(document.getRoot(), particleSystemData))
+                return false;
+
+            createParticleSystemData(bundle, cache, filename, particleSystemData,
+                                     document.getRoot()["textureFileName"].as<std::string>(), mipmaps);
+
+            return true;
+        }
+
+        bool ParticleSystemLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            std::shared_ptr<scene::ParticleSystemData> particleSystemData = std::make_shared<scene::ParticleSystemData>();
+
+            json::Document document(data.toVector());
+
+            if (!parseParticleSystemData(document.getRoot(), *particleSystemData))
+                return false;
+
+            std::string textureFileName = document.getRoot()["textureFileName"].as<std::string>();
+            result.dependencies.push_back(Asset(Loader::IMAGE, textureFileName, mipmaps));
+
+            result.create = [this, &bundle, filename, particleSystemData, textureFileName, mipmaps]() {
+                createParticleSystemData(bundle, cache, filename, *particleSystemData, textureFileName, mipmaps);
+                return true;
+            };
 
             return true;
         }
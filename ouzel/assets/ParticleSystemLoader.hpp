@@ -4,9 +4,15 @@
 #define OUZEL_ASSETS_PARTICLESYSTEMLOADER_HPP
 
 #include "assets/Loader.hpp"
+#include "scene/ParticleSystemData.hpp"
 
 namespace ouzel
 {
+    namespace json
+    {
+        class Node;
+    }
+
     namespace assets
     {
         class ParticleSystemLoader final: public Loader
@@ -14,8 +20,14 @@ namespace ouzel
         public:
             static constexpr uint32_t TYPE = Loader::PARTICLE_SYSTEM;
 
+            // parses everything but the texture, returns false if the document is not a particle system
+            // can be called without an engine
+            static bool parseParticleSystemData(const json::Node& document, scene::ParticleSystemData& particleSystemData);
+
             explicit ParticleSystemLoader(Cache& initCache);
+            using Loader::loadAsset;
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
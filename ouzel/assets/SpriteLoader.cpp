@@ -5,71 +5,48 @@
 #include "Bundle.hpp"
 #include "Cache.hpp"
 #include "scene/SpriteData.hpp"
-#include "utils/JSON.hpp"
+#include "utils/JSONDocument.hpp"
 
 namespace ouzel
 {
     namespace assets
     {
-        SpriteLoader::SpriteLoader(Cache& initCache):
-            Loader(initCache, TYPE)
+        bool SpriteLoader::isSpriteDocument(const json::Node& document)
         {
+            return document.getType() == json::Node::Type::OBJECT &&
+                document.hasMember("meta") && document.hasMember("frames");
         }
 
-        bool SpriteLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        void SpriteLoader::parseFrames(const json::Node& document, const Size2<float>& textureSize,
+                                       std::vector<FrameDescription>& frames)
         {
-            scene::SpriteData spriteData;
-
-            json::Data document(data);
+            const json::Node& framesArray = document["frames"];
 
-            if (!document.hasMember("meta") ||
-                !document.hasMember("frames"))
-                return false;
-
-            const json::Value& metaObject = document["meta"];
+            frames.reserve(framesArray.getSize());
 
-            std::string imageFilename = metaObject["image"].as<std::string>();
-            spriteData.texture = cache.getTexture(imageFilename);
-            if (!spriteData.texture)
+            for (const json::Node& frameObject : framesArray)
             {
-                bundle.loadAsset(Loader::IMAGE, imageFilename, mipmaps);
-                spriteData.texture = cache.getTexture(imageFilename);
-            }
+                FrameDescription frame;
+                frame.name = frameObject["filename"].as<std::string>();
 
-            if (!spriteData.texture)
-                return false;
-
-            const Size2<float> textureSize(static_cast<float>(spriteData.texture->getSize().v[0]),
-                                           static_cast<float>(spriteData.texture->getSize().v[1]));
-            
-            const json::Value& framesArray = document["frames"];
-
-            scene::SpriteData::Animation animation;
-
-            animation.frames.reserve(framesArray.getSize());
-
-            for (const json::Value& frameObject : framesArray.as<json::Value::Array>())
-            {
-                std::string name = frameObject["filename"].as<std::string>();
-
-                const json::Value& frameRectangleObject = frameObject["frame"];
+                const json::Node& frameRectangleObject = frameObject["frame"];
 
                 Rect<float> frameRectangle(static_cast<float>(frameRectangleObject["x"].as<int32_t>()),
                                            static_cast<float>(frameRectangleObject["y"].as<int32_t>()),
                                            static_cast<float>(frameRectangleObject["w"].as<int32_t>()),
                                            static_cast<float>(frameRectangleObject["h"].as<int32_t>()));
 
-                const json::Value& sourceSizeObject = frameObject["sourceSize"];
+                const json::Node& sourceSizeObject = frameObject["sourceSize"];
 
                 Size2<float> sourceSize(static_cast<float>(sourceSizeObject["w"].as<int32_t>()),
                                         static_cast<float>(sourceSizeObject["h"].as<int32_t>()));
 
-                const json::Value& spriteSourceSizeObject = frameObject["spriteSourceSize"];
+                const json::Node& spriteSourceSizeObject = frameObject["spriteSourceSize"];
 
                 Vector2<float> sourceOffset(static_cast<float>(spriteSourceSizeObject["x"].as<int32_t>()),
                                             static_cast<float>(spriteSourceSizeObject["y"].as<int32_t>()));
 
-                const json::Value& pivotObject = frameObject["pivot"];
+                const json::Node& pivotObject = frameObject["pivot"];
 
                 Vector2<float> pivot(pivotObject["x"].as<float>(),
                                      pivotObject["y"].as<float>());
@@ -78,50 +55,78 @@ namespace ouzel
                     frameObject.hasMember("verticesUV") &&
                     frameObject.hasMember("triangles"))
                 {
-                    std::vector<uint16_t> indices;
+                    const json::Node& trianglesObject = frameObject["triangles"];
 
-                    const json::Value& trianglesObject = frameObject["triangles"];
-
-                    for (const json::Value& triangleObject : trianglesObject.as<json::Value::Array>())
+                    for (const json::Node& triangleObject : trianglesObject)
                     {
-                        for (const json::Value& indexObject : triangleObject.as<json::Value::Array>())
-                            indices.push_back(static_cast<uint16_t>(indexObject.as<uint32_t>()));
+                        for (const json::Node& indexObject : triangleObject)
+                            frame.indices.push_back(static_cast<uint16_t>(indexObject.as<uint32_t>()));
                     }
 
                     // reverse the vertices, so that they are counterclockwise
-                    std::reverse(indices.begin(), indices.end());
-
-                    std::vector<graphics::Vertex> vertices;
+                    std::reverse(frame.indices.begin(), frame.indices.end());
 
-                    const json::Value& verticesObject = frameObject["vertices"];
-                    const json::Value& verticesUVObject = frameObject["verticesUV"];
+                    const json::Node& verticesObject = frameObject["vertices"];
+                    const json::Node& verticesUVObject = frameObject["verticesUV"];
 
                     Vector2<float> finalOffset(-sourceSize.v[0] * pivot.v[0] + sourceOffset.v[0],
                                                -sourceSize.v[1] * pivot.v[1] + (sourceSize.v[1] - frameRectangle.size.v[1] - sourceOffset.v[1]));
 
                     for (size_t vertexIndex = 0; vertexIndex < verticesObject.getSize(); ++vertexIndex)
                     {
-                        const json::Value& vertexObject = verticesObject[vertexIndex];
-                        const json::Value& vertexUVObject = verticesUVObject[vertexIndex];
-
-                        vertices.push_back(graphics::Vertex(Vector3<float>(static_cast<float>(vertexObject[0].as<int32_t>()) + finalOffset.v[0],
-                                                                           -static_cast<float>(vertexObject[1].as<int32_t>()) - finalOffset.v[1],
-                                                                           0.0F),
-                                                            Color::WHITE,
-                                                            Vector2<float>(static_cast<float>(vertexUVObject[0].as<int32_t>()) / textureSize.v[0],
-                                                                           static_cast<float>(vertexUVObject[1].as<int32_t>()) / textureSize.v[1]),
-                                                            Vector3<float>(0.0F, 0.0F, -1.0F)));
+                        const json::Node& vertexObject = verticesObject[vertexIndex];
+                        const json::Node& vertexUVObject = verticesUVObject[vertexIndex];
+
+                        frame.vertices.push_back(graphics::Vertex(Vector3<float>(static_cast<float>(vertexObject[0].as<int32_t>()) + finalOffset.v[0],
+                                                                                 -static_cast<float>(vertexObject[1].as<int32_t>()) - finalOffset.v[1],
+                                                                                 0.0F),
+                                                                  Color::WHITE,
+                                                                  Vector2<float>(static_cast<float>(vertexUVObject[0].as<int32_t>()) / textureSize.v[0],
+                                                                                 static_cast<float>(vertexUVObject[1].as<int32_t>()) / textureSize.v[1]),
+                                                                  Vector3<float>(0.0F, 0.0F, -1.0F)));
                     }
-
-                    animation.frames.push_back(scene::SpriteData::Frame(name, indices, vertices, frameRectangle, sourceSize, sourceOffset, pivot));
                 }
                 else
                 {
                     bool rotated = frameObject["rotated"].as<bool>();
 
-                    animation.frames.push_back(scene::SpriteData::Frame(name, textureSize, frameRectangle, rotated, sourceSize, sourceOffset, pivot));
+                    scene::SpriteData::Frame::calculateVertices(textureSize, frameRectangle, rotated, sourceSize, sourceOffset, pivot,
+                                                                frame.indices, frame.vertices);
                 }
+
+                frames.push_back(std::move(frame));
             }
+        }
+
+        static bool createSpriteData(Bundle& bundle, Cache& cache, const std::string& filename, const json::Node& document, bool mipmaps)
+        {
+            scene::SpriteData spriteData;
+
+            const json::Node& metaObject = document["meta"];
+
+            std::string imageFilename = metaObject["image"].as<std::string>();
+            spriteData.texture = cache.getTexture(imageFilename);
+            if (!spriteData.texture)
+            {
+                bundle.loadAsset(Loader::IMAGE, imageFilename, mipmaps);
+                spriteData.texture = cache.getTexture(imageFilename);
+            }
+
+            if (!spriteData.texture)
+                return false;
+
+            const Size2<float> textureSize(static_cast<float>(spriteData.texture->getSize().v[0]),
+                                           static_cast<float>(spriteData.texture->getSize().v[1]));
+
+            std::vector<SpriteLoader::FrameDescription> frames;
+            SpriteLoader::parseFrames(document, textureSize, frames);
+
+            scene::SpriteData::Animation animation;
+
+            animation.frames.reserve(frames.size());
+
+            for (const SpriteLoader::FrameDescription& frame : frames)
+                animation.frames.push_back(scene::SpriteData::Frame(frame.name, frame.indices, frame.vertices));
 
             spriteData.animations[""] = std::move(animation);
 
@@ -129,5 +134,37 @@ namespace ouzel
 
             return true;
         }
+
+        SpriteLoader::SpriteLoader(Cache& initCache):
+            Loader(initCache, TYPE)
+        {
+        }
+
+        bool SpriteLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            json::Document document(data);
+
+            if (!isSpriteDocument(document.getRoot()))
+                return false;
+
+            return createSpriteData(bundle, cache, filename, document.getRoot(), mipmaps);
+        }
+
+        bool SpriteLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            std::shared_ptr<json::Document> document = std::make_shared<json::Document>(data.toVector());
+
+            if (!isSpriteDocument(document->getRoot()))
+                return false;
+
+            // the frames are calculated from the size of the texture
+            result.dependencies.push_back(Asset(Loader::IMAGE, document->getRoot()["meta"]["image"].as<std::string>(), mipmaps));
+
+            result.create = [this, &bundle, filename, document, mipmaps]() {
+                return createSpriteData(bundle, cache, filename, document->getRoot(), mipmaps);
+            };
+
+            return true;
+        }
     } // namespace assets
 } // namespace ouzel
@@ -3,10 +3,19 @@
 #ifndef OUZEL_ASSETS_SPRITELOADER_HPP
 #define OUZEL_ASSETS_SPRITELOADER_HPP
 
+#include <string>
+#include <vector>
 #include "assets/Loader.hpp"
+#include "graphics/Vertex.hpp"
+#include "math/Size2.hpp"
 
 namespace ouzel
 {
+    namespace json
+    {
+        class Node;
+    }
+
     namespace assets
     {
         class SpriteLoader final: public Loader
@@ -14,8 +23,22 @@ namespace ouzel
         public:
             static constexpr uint32_t TYPE = Loader::SPRITE;
 
+            struct FrameDescription final
+            {
+                std::string name;
+                std::vector<uint16_t> indices;
+                std::vector<graphics::Vertex> vertices;
+            };
+
+            // can be called without an engine
+            static bool isSpriteDocument(const json::Node& document);
+            static void parseFrames(const json::Node& document, const Size2<float>& textureSize,
+                                    std::vector<FrameDescription>& frames);
+
             explicit SpriteLoader(Cache& initCache);
+            using Loader::loadAsset;
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
@@ -28,5 +28,27 @@ namespace ouzel
 
             return true;
         }
+
+        bool TtfLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result)
+        {
+            // the font does not use the renderer until the glyphs are drawn
+            std::shared_ptr<TTFont> font;
+
+            try
+            {
+                font = std::make_shared<TTFont>(data.toVector(), mipmaps);
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+
+            result.create = [&bundle, filename, font]() {
+                bundle.setFont(filename, font);
+                return true;
+            };
+
+            return true;
+        }
     } // namespace assets
 } // namespace ouzel
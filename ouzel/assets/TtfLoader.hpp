@@ -15,7 +15,9 @@ namespace ouzel
             static constexpr uint32_t TYPE = Loader::FONT;
 
             explicit TtfLoader(Cache& initCache);
+            using Loader::loadAsset;
             bool loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps = true) override;
+            bool prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool mipmaps, PreparedAsset& result) override;
         };
     } // namespace assets
 } // namespace ouzel
@@ -28,5 +28,29 @@ namespace ouzel
 
             return true;
         }
+
+        bool VorbisLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool, PreparedAsset& result)
+        {
+            // the header is parsed here, only the sound object is created on the update thread
+            std::shared_ptr<const std::vector<uint8_t>> soundData = std::make_shared<const std::vector<uint8_t>>(data.toVector());
+            audio::VorbisSound::Header header;
+
+            try
+            {
+                header = audio::VorbisSound::readHeader(*soundData);
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+
+            result.create = [&bundle, filename, soundData, header]() {
+                std::shared_ptr<audio::Sound> sound = std::make_shared<audio::VorbisSound>(*engine->getAudio(), soundData, header);
+                bundle.setSound(filename, sound);
+                return true;
+            };
+
+            return true;
+        }
     } // namespace assets
 } // namespace ouzel
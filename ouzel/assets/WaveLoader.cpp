@@ -16,158 +16,168 @@ namespace ouzel
 {
     namespace assets
     {
-        WaveLoader::WaveLoader(Cache& initCache):
-            Loader(initCache, TYPE)
-        {
-        }
-
-        bool WaveLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool)
+        static void decodeWave(const FileData& data, uint16_t& channels, uint32_t& sampleRate, std::vector<float>& samples)
         {
-            try
-            {
-                uint16_t channels;
-                uint32_t sampleRate;
-                std::vector<float> samples;
+            uint32_t offset = 0;
 
-                uint32_t offset = 0;
+            if (data.size() < 12) // RIFF + size + WAVE
+                throw std::runtime_error("Failed to load sound file, file too small");
 
-                if (data.size() < 12) // RIFF + size + WAVE
-                    throw std::runtime_error("Failed to load sound file, file too small");
+            if (data[offset + 0] != 'R' ||
+                data[offset + 1] != 'I' ||
+                data[offset + 2] != 'F' ||
+                data[offset + 3] != 'F')
+                throw std::runtime_error("Failed to load sound file, not a RIFF format");
 
-                if (data[offset + 0] != 'R' ||
-                    data[offset + 1] != 'I' ||
-                    data[offset + 2] != 'F' ||
-                    data[offset + 3] != 'F')
-                    throw std::runtime_error("Failed to load sound file, not a RIFF format");
+            offset += 4;
 
-                offset += 4;
+            uint32_t length = decodeUInt32Little(data.data() + offset);
 
-                uint32_t length = decodeUInt32Little(data.data() + offset);
+            offset += 4;
 
-                offset += 4;
+            if (data.size() < offset + length)
+                throw std::runtime_error("Failed to load sound file, size mismatch");
 
-                if (data.size() < offset + length)
-                    throw std::runtime_error("Failed to load sound file, size mismatch");
+            if (length < 4 ||
+                data[offset + 0] != 'W' ||
+                data[offset + 1] != 'A' ||
+                data[offset + 2] != 'V' ||
+                data[offset + 3] != 'E')
+                throw std::runtime_error("Failed to load sound file, not a WAVE file");
 
-                if (length < 4 ||
-                    data[offset + 0] != 'W' ||
-                    data[offset + 1] != 'A' ||
-                    data[offset + 2] != 'V' ||
-                    data[offset + 3] != 'E')
-                    throw std::runtime_error("Failed to load sound file, not a WAVE file");
+            offset += 4;
 
-                offset += 4;
+            bool formatChunkFound = false;
+            bool dataChunkFound = false;
 
-                bool formatChunkFound = false;
-                bool dataChunkFound = false;
+            uint16_t bitsPerSample = 0;
+            uint16_t formatTag = 0;
+            std::vector<uint8_t> soundData;
 
-                uint16_t bitsPerSample = 0;
-                uint16_t formatTag = 0;
-                std::vector<uint8_t> soundData;
+            while (offset < data.size())
+            {
+                if (data.size() < offset + 8)
+                    throw std::runtime_error("Failed to load sound file, not enough data to read chunk");
 
-                while (offset < data.size())
-                {
-                    if (data.size() < offset + 8)
-                        throw std::runtime_error("Failed to load sound file, not enough data to read chunk");
+                uint8_t chunkHeader[4];
+                chunkHeader[0] = data[offset + 0];
+                chunkHeader[1] = data[offset + 1];
+                chunkHeader[2] = data[offset + 2];
+                chunkHeader[3] = data[offset + 3];
 
-                    uint8_t chunkHeader[4];
-                    chunkHeader[0] = data[offset + 0];
-                    chunkHeader[1] = data[offset + 1];
-                    chunkHeader[2] = data[offset + 2];
-                    chunkHeader[3] = data[offset + 3];
+                offset += 4;
 
-                    offset += 4;
+                uint32_t chunkSize = decodeUInt32Little(data.data() + offset);
+                offset += 4;
 
-                    uint32_t chunkSize = decodeUInt32Little(data.data() + offset);
-                    offset += 4;
+                if (data.size() < offset + chunkSize)
+                    throw std::runtime_error("Failed to load sound file, not enough data to read chunk");
 
-                    if (data.size() < offset + chunkSize)
+                if (chunkHeader[0] == 'f' && chunkHeader[1] == 'm' && chunkHeader[2] == 't' && chunkHeader[3] == ' ')
+                {
+                    if (chunkSize < 16)
                         throw std::runtime_error("Failed to load sound file, not enough data to read chunk");
 
-                    if (chunkHeader[0] == 'f' && chunkHeader[1] == 'm' && chunkHeader[2] == 't' && chunkHeader[3] == ' ')
-                    {
-                        if (chunkSize < 16)
-                            throw std::runtime_error("Failed to load sound file, not enough data to read chunk");
-
-                        uint32_t i = offset;
-
-                        formatTag = decodeUInt16Little(data.data() + i);
-                        i += 2;
+                    uint32_t i = offset;
 
-                        channels = decodeUInt16Little(data.data() + i);
-                        i += 2;
+                    formatTag = decodeUInt16Little(data.data() + i);
+                    i += 2;
 
-                        sampleRate = decodeUInt32Little(data.data() + i);
-                        i += 4;
+                    channels = decodeUInt16Little(data.data() + i);
+                    i += 2;
 
-                        i += 4; // average bytes per second
+                    sampleRate = decodeUInt32Little(data.data() + i);
+                    i += 4;
 
-                        i += 2; // block align
+                    i += 4; // average bytes per second
 
-                        bitsPerSample = decodeUInt16Little(data.data() + i);
-                        i += 2;
+                    i += 2; // block align
 
-                        formatChunkFound = true;
-                    }
-                    else if (chunkHeader[0] == 'd' && chunkHeader[1] == 'a' && chunkHeader[2] == 't' && chunkHeader[3] == 'a')
-                    {
-                        soundData.assign(data.begin() + static_cast<int>(offset), data.begin() + static_cast<int>(offset + chunkSize));
+                    bitsPerSample = decodeUInt16Little(data.data() + i);
+                    i += 2;
 
-                        dataChunkFound = true;
-                    }
+                    formatChunkFound = true;
+                }
+                else if (chunkHeader[0] == 'd' && chunkHeader[1] == 'a' && chunkHeader[2] == 't' && chunkHeader[3] == 'a')
+                {
+                    soundData.assign(data.begin() + static_cast<int>(offset), data.begin() + static_cast<int>(offset + chunkSize));
 
-                    offset += ((chunkSize + 1) & 0xFFFFFFFE);
+                    dataChunkFound = true;
                 }
 
-                if (!formatChunkFound)
-                    throw std::runtime_error("Failed to load sound file, failed to find a format chunk");
+                offset += ((chunkSize + 1) & 0xFFFFFFFE);
+            }
 
-                if (!dataChunkFound)
-                    throw std::runtime_error("Failed to load sound file, failed to find a data chunk");
+            if (!formatChunkFound)
+                throw std::runtime_error("Failed to load sound file, failed to find a format chunk");
 
-                if (bitsPerSample != 8 && bitsPerSample != 16 &&
-                    bitsPerSample != 24 && bitsPerSample != 32)
-                    throw std::runtime_error("Failed to load sound file, unsupported bit depth");
+            if (!dataChunkFound)
+                throw std::runtime_error("Failed to load sound file, failed to find a data chunk");
 
-                uint32_t bytesPerSample = bitsPerSample / 8;
-                uint32_t sampleCount = static_cast<uint32_t>(soundData.size() / bytesPerSample);
-                samples.resize(sampleCount);
+            if (bitsPerSample != 8 && bitsPerSample != 16 &&
+                bitsPerSample != 24 && bitsPerSample != 32)
+                throw std::runtime_error("Failed to load sound file, unsupported bit depth");
 
-                if (formatTag == PCM)
+            uint32_t bytesPerSample = bitsPerSample / 8;
+            uint32_t sampleCount = static_cast<uint32_t>(soundData.size() / bytesPerSample);
+            samples.resize(sampleCount);
+
+            if (formatTag == PCM)
+            {
+                if (bitsPerSample == 8)
                 {
-                    if (bitsPerSample == 8)
-                    {
-                        for (uint32_t i = 0; i < sampleCount; ++i)
-                            samples[i] = 2.0F * static_cast<float>(soundData[i]) / 255.0F - 1.0F;
-                    }
-                    else if (bitsPerSample == 16)
-                    {
-                        for (uint32_t i = 0; i < sampleCount; ++i)
-                            samples[i] = static_cast<float>(static_cast<int16_t>(soundData[i * 2] |
-                                                                                 (soundData[i * 2 + 1] << 8))) / 32767.0F;
-                    }
-                    else if (bitsPerSample == 24)
-                    {
-                        for (uint32_t i = 0; i < sampleCount; ++i)
-                            samples[i] = static_cast<float>(static_cast<int32_t>((soundData[i * 3] << 8) |
-                                                                                 (soundData[i * 3 + 1] << 16) |
-                                                                                 (soundData[i * 3 + 2] << 24))) / 2147483648.0F;
-                    }
-                    else
-                        throw std::runtime_error("Failed to load sound file, unsupported bit depth");
+                    for (uint32_t i = 0; i < sampleCount; ++i)
+                        samples[i] = 2.0F * static_cast<float>(soundData[i]) / 255.0F - 1.0F;
                 }
-                else if (formatTag == IEEE_FLOAT)
+                else if (bitsPerSample == 16)
+                {
+                    for (uint32_t i = 0; i < sampleCount; ++i)
+                        samples[i] = static_cast<float>(static_cast<int16_t>(soundData[i * 2] |
+                                                                             (soundData[i * 2 + 1] << 8))) / 32767.0F;
+                }
+                else if (bitsPerSample == 24)
+                {
+                    for (uint32_t i = 0; i < sampleCount; ++i)
+                        samples[i] = static_cast<float>(static_cast<int32_t>((soundData[i * 3] << 8) |
+                                                                             (soundData[i * 3 + 1] << 16) |
+                                                                             (soundData[i * 3 + 2] << 24))) / 2147483648.0F;
+                }
+                else
+                    throw std::runtime_error("Failed to load sound file, unsupported bit depth");
+            }
+            else if (formatTag == IEEE_FLOAT)
+            {
+                if (bitsPerSample == 32)
                 {
-                    if (bitsPerSample == 32)
-                    {
-                        for (uint32_t i = 0; i < sampleCount; ++i)
-                            samples[i] = reinterpret_cast<float*>(soundData.data())[i];
-                    }
-                    else
-                        throw std::runtime_error("Failed to load sound file, unsupported bit depth");
+                    for (uint32_t i = 0; i < sampleCount; ++i)
+                        samples[i] = reinterpret_cast<float*>(soundData.data())[i];
                 }
                 else
-                    throw std::runtime_error("Failed to load sound file, unsupported format");
+                    throw std::runtime_error("Failed to load sound file, unsupported bit depth");
+            }
+            else
+                throw std::runtime_error("Failed to load sound file, unsupported format");
+        }
+
+        WaveLoader::WaveLoader(Cache& initCache):
+            Loader(initCache, TYPE)
+        {
+        }
+
+        bool WaveLoader::loadAsset(Bundle& bundle, const std::string& filename, const std::vector<uint8_t>& data, bool mipmaps)
+        {
+            return loadAsset(bundle, filename, FileData(data.data(), data.size()), mipmaps);
+        }
+
+        bool WaveLoader::loadAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool)
+        {
+            try
+            {
+                uint16_t channels;
+                uint32_t sampleRate;
+                std::vector<float> samples;
+
+                decodeWave(data, channels, sampleRate, samples);
 
                 std::shared_ptr<audio::Sound> sound = std::make_shared<audio::PCMSound>(*engine->getAudio(), channels, sampleRate, samples);
                 bundle.setSound(filename, sound);
@@ -179,5 +189,31 @@ namespace ouzel
 
             return true;
         }
+
+        bool WaveLoader::prepareAsset(Bundle& bundle, const std::string& filename, const FileData& data, bool, PreparedAsset& result)
+        {
+            // the samples are converted here, only the sound object is created on the update thread
+            uint16_t channels;
+            uint32_t sampleRate;
+            std::shared_ptr<std::vector<float>> samples = std::make_shared<std::vector<float>>();
+
+            try
+            {
+                decodeWave(data, channels, sampleRate, *samples);
+            }
+            catch (const std::exception&)
+            {
+                return false;
+            }
+
+            result.create = [&bundle, filename, channels, sampleRate, samples]() {
+                std::shared_ptr<audio::Sound> sound = std::make_shared<audio::PCMSound>(*engine->getAudio(), channels, sampleRate,
+                                                                                        std::shared_ptr<const std::vector<float>>(samples));
+                bundle.setSound(filename, sound);
+                return true;
+            };
+
+            return true;
+        }
     } // namespace assets
 } // namespace ouzel
@@ -10,6 +10,7 @@
 #include "coreaudio/CAAudioDevice.hpp"
 #include "dsound/DSAudioDevice.hpp"
 #include "empty/EmptyAudioDevice.hpp"
+#include "offline/OfflineAudioDevice.hpp"
 #include "openal/OALAudioDevice.hpp"
 #include "opensl/OSLAudioDevice.hpp"
 #include "xaudio2/XA2AudioDevice.hpp"
@@ -46,6 +47,8 @@ namespace ouzel
             }
             else if (driver == "empty")
                 return Driver::EMPTY;
+            else if (driver == "offline")
+                return Driver::OFFLINE;
             else if (driver == "openal")
                 return Driver::OPENAL;
             else if (driver == "directsound")
@@ -71,6 +74,7 @@ namespace ouzel
             if (availableDrivers.empty())
             {
                 availableDrivers.insert(Driver::EMPTY);
+                availableDrivers.insert(Driver::OFFLINE);
 
 #if OUZEL_COMPILE_OPENAL
                 availableDrivers.insert(Driver::OPENAL);
@@ -103,10 +107,15 @@ namespace ouzel
             return availableDrivers;
         }
 
-        static std::unique_ptr<AudioDevice> createAudioDevice(Driver driver, mixer::Mixer& mixer, bool debugAudio, Window* window)
+        static std::unique_ptr<AudioDevice> createAudioDevice(Driver driver, mixer::Mixer& mixer, bool debugAudio, Window* window,
+                                                              const std::string& offlineOutput, float offlineClockSpeed, float offlineDuration,
+                                                              uint32_t latencyFrames, float latencyTime, bool adaptiveLatency)
         {
             switch (driver)
             {
+                case Driver::OFFLINE:
+                    engine->log(Log::Level::INFO) << "Using offline audio driver";
+                    return std::unique_ptr<AudioDevice>(new OfflineAudioDevice(mixer, offlineOutput, offlineClockSpeed, offlineDuration));
 #if OUZEL_COMPILE_OPENAL
                 case Driver::OPENAL:
                     engine->log(Log::Level::INFO) << "Using OpenAL audio driver";
@@ -135,7 +144,7 @@ namespace ouzel
 #if OUZEL_COMPILE_ALSA
                 case Driver::ALSA:
                     engine->log(Log::Level::INFO) << "Using ALSA audio driver";
-                    return std::unique_ptr<AudioDevice>(new ALSAAudioDevice(mixer));
+                    return std::unique_ptr<AudioDevice>(new ALSAAudioDevice(mixer, latencyFrames, latencyTime, adaptiveLatency));
 #endif
 #if OUZEL_COMPILE_WASAPI
                 case Driver::WASAPI:
@@ -146,14 +155,21 @@ namespace ouzel
                     engine->log(Log::Level::INFO) << "Not using audio driver";
                     (void)debugAudio;
                     (void)window;
+                    (void)latencyFrames;
+                    (void)latencyTime;
+                    (void)adaptiveLatency;
                     return std::unique_ptr<AudioDevice>(new EmptyAudioDevice(mixer));
             }
         }
 
-        Audio::Audio(Driver driver, bool debugAudio, Window* window):
+        Audio::Audio(Driver driver, bool debugAudio, Window* window,
+                     const std::string& offlineOutput, float offlineClockSpeed, float offlineDuration,
+                     uint32_t latencyFrames, float latencyTime, bool adaptiveLatency):
             mixer(std::bind(&Audio::eventCallback, this, std::placeholders::_1)),
             masterMix(*this),
-            device(createAudioDevice(driver, mixer, debugAudio, window))
+            device(createAudioDevice(driver, mixer, debugAudio, window,
+                                     offlineOutput, offlineClockSpeed, offlineDuration,
+                                     latencyFrames, latencyTime, adaptiveLatency))
         {
             mixer.addCommand(std::unique_ptr<mixer::Command>(new mixer::SetMasterBusCommand(masterMix.getBusId())));
         }
@@ -167,6 +183,33 @@ namespace ouzel
             // TODO: handle events from the audio device
         }
 
+        void Audio::setMaxVoices(uint32_t newMaxVoices)
+        {
+            maxVoices = newMaxVoices;
+
+            mixer.addCommand(std::unique_ptr<mixer::Command>(new mixer::SetMaxVoicesCommand(maxVoices)));
+        }
+
+        std::chrono::steady_clock::duration Audio::getCallbackDuration() const
+        {
+            return device->getCallbackDuration();
+        }
+
+        std::chrono::steady_clock::duration Audio::getMaxCallbackDuration() const
+        {
+            return device->getMaxCallbackDuration();
+        }
+
+        uint32_t Audio::getUnderrunCount() const
+        {
+            return device->getUnderrunCount();
+        }
+
+        float Audio::getLatency() const
+        {
+            return static_cast<float>(device->getLatency()) / static_cast<float>(device->getSampleRate());
+        }
+
         void Audio::deleteObject(uintptr_t objectId)
         {
             mixer.addCommand(std::unique_ptr<mixer::Command>(new mixer::DeleteObjectCommand(objectId)));
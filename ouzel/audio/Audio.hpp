@@ -3,10 +3,12 @@
 #ifndef OUZEL_AUDIO_AUDIO_HPP
 #define OUZEL_AUDIO_AUDIO_HPP
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 #include "audio/Driver.hpp"
 #include "audio/Mix.hpp"
@@ -27,7 +29,9 @@ namespace ouzel
         class Audio final
         {
         public:
-            Audio(Driver driver, bool debugAudio, Window* window);
+            Audio(Driver driver, bool debugAudio, Window* window,
+                  const std::string& offlineOutput = "", float offlineClockSpeed = 0.0F, float offlineDuration = 0.0F,
+                  uint32_t latencyFrames = 0, float latencyTime = 0.0F, bool adaptiveLatency = false);
             ~Audio();
 
             Audio(const Audio&) = delete;
@@ -52,12 +56,23 @@ namespace ouzel
 
             Mix& getMasterMix() { return masterMix; }
 
+            // limits the number of voices mixed in total (0 for unlimited), the rest are virtualized
+            uint32_t getMaxVoices() const { return maxVoices; }
+            void setMaxVoices(uint32_t newMaxVoices);
+
+            // audio device telemetry
+            std::chrono::steady_clock::duration getCallbackDuration() const;
+            std::chrono::steady_clock::duration getMaxCallbackDuration() const;
+            uint32_t getUnderrunCount() const;
+            float getLatency() const; // seconds
+
         private:
             void eventCallback(const mixer::Mixer::Event& event);
 
             mixer::Mixer mixer;
             Mix masterMix;
             std::unique_ptr<AudioDevice> device;
+            uint32_t maxVoices = 0;
         };
     } // namespace audio
 } // namespace ouzel
@@ -8,7 +8,7 @@ namespace ouzel
     namespace audio
     {
         AudioDevice::AudioDevice(Driver initDriver, mixer::Mixer& initMixer):
-            driver(initDriver), mixer(initMixer)
+            mixer(initMixer), driver(initDriver)
         {
         }
 
@@ -23,6 +23,8 @@ namespace ouzel
 
         void AudioDevice::getData(uint32_t frames, std::vector<uint8_t>& result)
         {
+            const auto startTime = std::chrono::steady_clock::now();
+
             mixer.getData(frames, channels, sampleRate, buffer);
 
             switch (sampleFormat)
@@ -49,6 +51,10 @@ namespace ouzel
                 default:
                     throw std::runtime_error("Invalid sample format");
             }
+
+            const std::chrono::steady_clock::rep duration = (std::chrono::steady_clock::now() - startTime).count();
+            callbackDuration = duration;
+            if (duration > maxCallbackDuration) maxCallbackDuration = duration;
         }
     } // namespace audio
 } // namespace ouzel
@@ -3,6 +3,8 @@
 #ifndef OUZEL_AUDIO_AUDIODEVICE_HPP
 #define OUZEL_AUDIO_AUDIODEVICE_HPP
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include "audio/Driver.hpp"
 #include "audio/SampleFormat.hpp"
@@ -28,6 +30,22 @@ namespace ouzel
 
             virtual void process();
 
+            uint32_t getSampleRate() const { return sampleRate; }
+            uint16_t getChannels() const { return channels; }
+
+            // telemetry, updated by the audio thread
+            std::chrono::steady_clock::duration getCallbackDuration() const
+            {
+                return std::chrono::steady_clock::duration(callbackDuration.load());
+            }
+            std::chrono::steady_clock::duration getMaxCallbackDuration() const
+            {
+                return std::chrono::steady_clock::duration(maxCallbackDuration.load());
+            }
+            uint32_t getUnderrunCount() const { return underrunCount; }
+            // frames between the mixer and the speakers (0 if unknown)
+            uint32_t getLatency() const { return latency; }
+
         protected:
             void getData(uint32_t frames, std::vector<uint8_t>& result);
 
@@ -39,11 +57,17 @@ namespace ouzel
             uint32_t sampleRate = 44100;
             uint16_t channels = 2;
 
+            mixer::Mixer& mixer;
+
+            std::atomic<std::chrono::steady_clock::rep> callbackDuration{0};
+            std::atomic<std::chrono::steady_clock::rep> maxCallbackDuration{0};
+            std::atomic<uint32_t> underrunCount{0};
+            std::atomic<uint32_t> latency{0};
+
         private:
             std::vector<float> buffer;
 
             Driver driver;
-            mixer::Mixer& mixer;
         };
     } // namespace audio
 } // namespace ouzel
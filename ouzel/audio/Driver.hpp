@@ -10,6 +10,7 @@ namespace ouzel
         enum class Driver
         {
             EMPTY,
+            OFFLINE,
             OPENAL,
             DIRECTSOUND,
             XAUDIO2,
@@ -1,11 +1,15 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
+#include <algorithm>
 #include <cmath>
 #include "Filters.hpp"
 #include "Audio.hpp"
+#include "AudioDevice.hpp"
+#include "PCMSound.hpp"
+#include "mixer/FFT.hpp"
+#include "mixer/PitchShift.hpp"
 #include "scene/Actor.hpp"
 #include "math/MathUtils.hpp"
-#include "smbPitchShift.hpp"
 
 namespace ouzel
 {
@@ -14,19 +18,65 @@ namespace ouzel
         class DelayProcessor final: public mixer::Processor
         {
         public:
-            DelayProcessor()
+            DelayProcessor(float initDelay):
+                delay(initDelay)
             {
             }
 
             void process(uint32_t frames, uint16_t channels, uint32_t sampleRate,
                          std::vector<float>& samples) override
             {
+                const uint32_t delayFrames = static_cast<uint32_t>(delay * sampleRate);
+                if (delayFrames == 0) return;
+
+                if (delayLine.size() != delayFrames * channels)
+                {
+                    delayLine.resize(delayFrames * channels);
+                    std::fill(delayLine.begin(), delayLine.end(), 0.0F);
+                    position = 0;
+                }
+
+                // the ring buffer is processed in contiguous runs up to the wrap-around point
+                for (uint32_t frame = 0; frame < frames;)
+                {
+                    const uint32_t count = std::min(frames - frame, delayFrames - position) * channels;
+                    float* input = samples.data() + frame * channels;
+                    float* line = delayLine.data() + position * channels;
+
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        const float delayed = line[i];
+                        line[i] = input[i] + delayed * feedback;
+                        input[i] += delayed;
+                    }
+
+                    frame += count / channels;
+                    position += count / channels;
+                    if (position == delayFrames) position = 0;
+                }
+            }
+
+            void setDelay(float newDelay)
+            {
+                delay = newDelay;
+            }
+
+            void setFeedback(float newFeedback)
+            {
+                feedback = newFeedback;
             }
+
+        private:
+            float delay = 0.0F;
+            float feedback = 0.0F;
+            std::vector<float> delayLine;
+            uint32_t position = 0;
         };
 
-        Delay::Delay(Audio& initAudio):
+        Delay::Delay(Audio& initAudio, float initDelay):
             Filter(initAudio,
-            initAudio.initProcessor(std::unique_ptr<mixer::Processor>(new DelayProcessor())))
+            initAudio.initProcessor(std::unique_ptr<mixer::Processor>(new DelayProcessor(initDelay)))),
+            delay(initDelay)
         {
         }
 
@@ -37,6 +87,22 @@ namespace ouzel
         void Delay::setDelay(float newDelay)
         {
             delay = newDelay;
+
+            audio.updateProcessor(processorId, [newDelay](mixer::Object* node) {
+                DelayProcessor* delayProcessor = static_cast<DelayProcessor*>(node);
+                delayProcessor->setDelay(newDelay);
+            });
+        }
+
+        void Delay::setFeedback(float newFeedback)
+        {
+            feedback = clamp(newFeedback, 0.0F, 1.0F);
+
+            float processorFeedback = feedback;
+            audio.updateProcessor(processorId, [processorFeedback](mixer::Object* node) {
+                DelayProcessor* delayProcessor = static_cast<DelayProcessor*>(node);
+                delayProcessor->setFeedback(processorFeedback);
+            });
         }
 
         class GainProcessor final: public mixer::Processor
@@ -94,6 +160,42 @@ namespace ouzel
             void process(uint32_t frames, uint16_t channels, uint32_t sampleRate,
                          std::vector<float>& samples) override
             {
+                const mixer::ListenerState& listener = getListener();
+
+                // the mix is treated as a point source, so it is downmixed to mono first
+                monoSamples.resize(frames);
+                const float channelGain = 1.0F / static_cast<float>(channels);
+
+                for (uint32_t frame = 0; frame < frames; ++frame)
+                {
+                    float sample = 0.0F;
+                    for (uint16_t channel = 0; channel < channels; ++channel)
+                        sample += samples[frame * channels + channel];
+                    monoSamples[frame] = sample * channelGain;
+                }
+
+                Quaternion<float> inverseListenerRotation = listener.rotation;
+                inverseListenerRotation.invert();
+                Vector3<float> direction = inverseListenerRotation.rotateVector(position - listener.position);
+
+                newGains.resize(channels);
+                mixer::getPanningGains(direction, minDistance, channels, newGains.data());
+
+                const float attenuation = mixer::getDistanceAttenuation(mixer::DistanceModel::INVERSE,
+                                                                        position.distance(listener.position),
+                                                                        minDistance, maxDistance, rolloffFactor);
+
+                for (uint16_t channel = 0; channel < channels; ++channel)
+                    newGains[channel] *= attenuation;
+
+                if (!gainsValid || gains.size() != channels)
+                    gains = newGains;
+
+                std::fill(samples.begin(), samples.begin() + frames * channels, 0.0F);
+                mixer::mixPanned(frames, monoSamples.data(), channels, gains.data(), newGains.data(), samples.data());
+
+                gains = newGains;
+                gainsValid = true;
             }
 
             void setPosition(const Vector3<float>& newPosition)
@@ -121,6 +223,11 @@ namespace ouzel
             float rolloffFactor = 1.0F;
             float minDistance = 1.0F;
             float maxDistance = FLT_MAX;
+
+            std::vector<float> monoSamples;
+            bool gainsValid = false;
+            std::vector<float> gains;
+            std::vector<float> newGains;
         };
 
         Panner::Panner(Audio& initAudio):
@@ -216,7 +323,7 @@ namespace ouzel
         private:
             float pitch = 1.0f;
             std::vector<float> channelSamples;
-            std::vector<smb::PitchShift> pitchShift;
+            std::vector<mixer::PitchShift> pitchShift;
         };
 
         Pitch::Pitch(Audio& initAudio, float initPitch):
@@ -243,24 +350,221 @@ namespace ouzel
         class ReverbProcessor final: public mixer::Processor
         {
         public:
-            ReverbProcessor()
+            // the input is processed in blocks of this size, which is also the latency of the reverb
+            static constexpr uint32_t BLOCK_SIZE = 512;
+            static constexpr uint32_t BIN_COUNT = BLOCK_SIZE + 1;
+
+            class Channel final
+            {
+            public:
+                std::vector<float> input; // previous and current block
+                std::vector<float> output;
+                std::vector<float> spectra; // frequency domain delay line
+            };
+
+            // impulse response resampled to the sample rate of the mixer and transformed to partition spectra,
+            // built on the thread that sets the impulse response
+            class ImpulseResponse final
+            {
+            public:
+                ImpulseResponse(uint16_t sourceChannels, uint32_t sourceSampleRate,
+                                const std::vector<float>& source,
+                                uint16_t channels, uint32_t sampleRate)
+                {
+                    const uint32_t sourceFrames = static_cast<uint32_t>(source.size() / sourceChannels);
+                    const uint32_t irFrames = static_cast<uint32_t>(static_cast<uint64_t>(sourceFrames) * sampleRate / sourceSampleRate);
+
+                    partitionCount = std::max(1U, (irFrames + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+                    mixer::RealFFT fft(BLOCK_SIZE * 2);
+                    std::vector<float> timeBuffer(BLOCK_SIZE * 2);
+                    filters.resize(sourceChannels);
+
+                    for (uint16_t irChannel = 0; irChannel < sourceChannels; ++irChannel)
+                    {
+                        std::vector<float>& filter = filters[irChannel];
+                        filter.resize(partitionCount * BIN_COUNT * 2);
+
+                        for (uint32_t partition = 0; partition < partitionCount; ++partition)
+                        {
+                            std::fill(timeBuffer.begin(), timeBuffer.end(), 0.0F);
+
+                            for (uint32_t i = 0; i < BLOCK_SIZE; ++i)
+                            {
+                                const uint32_t frame = partition * BLOCK_SIZE + i;
+                                if (frame >= irFrames) break;
+
+                                const float position = static_cast<float>(frame) * sourceSampleRate / sampleRate;
+                                const uint32_t current = std::min(static_cast<uint32_t>(position), sourceFrames - 1);
+                                const uint32_t next = std::min(current + 1, sourceFrames - 1);
+
+                                timeBuffer[i] = lerp(source[current * sourceChannels + irChannel],
+                                                     source[next * sourceChannels + irChannel],
+                                                     position - static_cast<float>(current));
+                            }
+
+                            fft.forward(timeBuffer.data(), filter.data() + partition * BIN_COUNT * 2);
+                        }
+                    }
+
+                    resizeChannels(channels);
+                }
+
+                void resizeChannels(uint16_t channels)
+                {
+                    channelStates.resize(channels);
+                    for (Channel& state : channelStates)
+                    {
+                        state.input.assign(BLOCK_SIZE * 2, 0.0F);
+                        state.output.assign(BLOCK_SIZE, 0.0F);
+                        state.spectra.assign(partitionCount * BIN_COUNT * 2, 0.0F);
+                    }
+                }
+
+                uint32_t partitionCount = 0;
+                std::vector<std::vector<float>> filters; // partition spectra for every channel of the impulse response
+                std::vector<Channel> channelStates;
+            };
+
+            ReverbProcessor():
+                fft(BLOCK_SIZE * 2),
+                timeBuffer(BLOCK_SIZE * 2),
+                accumulator(BIN_COUNT * 2)
             {
             }
 
-            void process(uint32_t frames, uint16_t channels, uint32_t sampleRate,
+            void process(uint32_t frames, uint16_t channels, uint32_t,
                          std::vector<float>& samples) override
             {
+                if (!impulseResponse) return;
+
+                // only happens if the mix has a different channel count than the device
+                if (impulseResponse->channelStates.size() != channels)
+                    impulseResponse->resizeChannels(channels);
+
+                const float dry = 1.0F - wet;
+
+                for (uint32_t frame = 0; frame < frames;)
+                {
+                    const uint32_t count = std::min(frames - frame, BLOCK_SIZE - blockPosition);
+
+                    for (uint16_t channel = 0; channel < channels; ++channel)
+                    {
+                        Channel& state = impulseResponse->channelStates[channel];
+
+                        for (uint32_t i = 0; i < count; ++i)
+                        {
+                            float& sample = samples[(frame + i) * channels + channel];
+                            state.input[BLOCK_SIZE + blockPosition + i] = sample;
+                            sample = sample * dry + state.output[blockPosition + i] * wet;
+                        }
+                    }
+
+                    frame += count;
+                    blockPosition += count;
+
+                    if (blockPosition == BLOCK_SIZE)
+                    {
+                        for (uint16_t channel = 0; channel < channels; ++channel)
+                            processBlock(channel);
+
+                        blockPosition = 0;
+                        spectrumPosition = (spectrumPosition + 1) % impulseResponse->partitionCount;
+                    }
+                }
+            }
+
+            void setImpulseResponse(const std::shared_ptr<ImpulseResponse>& newImpulseResponse)
+            {
+                impulseResponse = newImpulseResponse;
+                blockPosition = 0;
+                spectrumPosition = 0;
             }
+
+            void setWet(float newWet)
+            {
+                wet = newWet;
+            }
+
+        private:
+            // uniformly partitioned overlap-save convolution
+            void processBlock(uint16_t channel)
+            {
+                const uint32_t partitionCount = impulseResponse->partitionCount;
+                Channel& state = impulseResponse->channelStates[channel];
+                const std::vector<float>& filter = impulseResponse->filters[channel % impulseResponse->filters.size()];
+
+                fft.forward(state.input.data(), state.spectra.data() + spectrumPosition * BIN_COUNT * 2);
+
+                std::fill(accumulator.begin(), accumulator.end(), 0.0F);
+
+                for (uint32_t partition = 0; partition < partitionCount; ++partition)
+                {
+                    const uint32_t index = (spectrumPosition + partitionCount - partition) % partitionCount;
+                    mixer::complexMultiplyAdd(state.spectra.data() + index * BIN_COUNT * 2,
+                                              filter.data() + partition * BIN_COUNT * 2,
+                                              BIN_COUNT, accumulator.data());
+                }
+
+                fft.inverse(accumulator.data(), timeBuffer.data());
+
+                // only the last half of the circular convolution is valid
+                std::copy(timeBuffer.begin() + BLOCK_SIZE, timeBuffer.end(), state.output.begin());
+                std::copy(state.input.begin() + BLOCK_SIZE, state.input.end(), state.input.begin());
+            }
+
+            std::shared_ptr<ImpulseResponse> impulseResponse;
+            float wet = 0.5F;
+
+            mixer::RealFFT fft;
+            std::vector<float> timeBuffer;
+            std::vector<float> accumulator;
+            uint32_t blockPosition = 0;
+            uint32_t spectrumPosition = 0;
         };
 
-        Reverb::Reverb(Audio& initAudio):
+        Reverb::Reverb(Audio& initAudio, const std::shared_ptr<PCMSound>& initImpulseResponse):
             Filter(initAudio,
             initAudio.initProcessor(std::unique_ptr<mixer::Processor>(new ReverbProcessor())))
         {
+            if (initImpulseResponse) setImpulseResponse(initImpulseResponse);
         }
 
         Reverb::~Reverb()
         {
         }
+
+        void Reverb::setImpulseResponse(const std::shared_ptr<PCMSound>& newImpulseResponse)
+        {
+            impulseResponse = newImpulseResponse;
+
+            // the resampling and the transforms are done here to keep them off the audio thread
+            std::shared_ptr<ReverbProcessor::ImpulseResponse> processorImpulseResponse;
+            if (impulseResponse && impulseResponse->getSamples() && !impulseResponse->getSamples()->empty())
+            {
+                AudioDevice* device = audio.getDevice();
+                processorImpulseResponse = std::make_shared<ReverbProcessor::ImpulseResponse>(impulseResponse->getChannels(),
+                                                                                              impulseResponse->getSampleRate(),
+                                                                                              *impulseResponse->getSamples(),
+                                                                                              device->getChannels(),
+                                                                                              device->getSampleRate());
+            }
+
+            audio.updateProcessor(processorId, [processorImpulseResponse](mixer::Object* node) {
+                ReverbProcessor* reverbProcessor = static_cast<ReverbProcessor*>(node);
+                reverbProcessor->setImpulseResponse(processorImpulseResponse);
+            });
+        }
+
+        void Reverb::setWet(float newWet)
+        {
+            wet = clamp(newWet, 0.0F, 1.0F);
+
+            float processorWet = wet;
+            audio.updateProcessor(processorId, [processorWet](mixer::Object* node) {
+                ReverbProcessor* reverbProcessor = static_cast<ReverbProcessor*>(node);
+                reverbProcessor->setWet(processorWet);
+            });
+        }
     } // namespace audio
 } // namespace ouzel
@@ -4,6 +4,7 @@
 #define OUZEL_AUDIO_FILTERS_HPP
 
 #include <cfloat>
+#include <memory>
 #include "audio/Filter.hpp"
 #include "math/Vector3.hpp"
 #include "scene/Component.hpp"
@@ -12,10 +13,12 @@ namespace ouzel
 {
     namespace audio
     {
+        class PCMSound;
+
         class Delay final: public Filter
         {
         public:
-            Delay(Audio& initAudio);
+            Delay(Audio& initAudio, float initDelay = 0.0F);
             ~Delay();
 
             Delay(const Delay&) = delete;
@@ -23,11 +26,17 @@ namespace ouzel
             Delay(Delay&&) = delete;
             Delay& operator=(Delay&&) = delete;
 
+            // seconds
             float getDelay() const { return delay; }
             void setDelay(float newDelay);
 
+            // part of the delayed signal that is fed back to the delay line
+            float getFeedback() const { return feedback; }
+            void setFeedback(float newFeedback);
+
         private:
             float delay = 0.0F;
+            float feedback = 0.0F;
         };
 
         class Gain final: public Filter
@@ -101,13 +110,25 @@ namespace ouzel
         class Reverb final: public Filter
         {
         public:
-            Reverb(Audio& initAudio);
+            Reverb(Audio& initAudio, const std::shared_ptr<PCMSound>& initImpulseResponse = nullptr);
             ~Reverb();
 
             Reverb(const Reverb&) = delete;
             Reverb& operator=(const Reverb&) = delete;
             Reverb(Reverb&&) = delete;
             Reverb& operator=(Reverb&&) = delete;
+
+            // the sound is convolved with the impulse response (e.g. a wave asset)
+            const std::shared_ptr<PCMSound>& getImpulseResponse() const { return impulseResponse; }
+            void setImpulseResponse(const std::shared_ptr<PCMSound>& newImpulseResponse);
+
+            // 0 for the dry signal only, 1 for the reverberated signal only
+            float getWet() const { return wet; }
+            void setWet(float newWet);
+
+        private:
+            std::shared_ptr<PCMSound> impulseResponse;
+            float wet = 0.5F;
         };
     } // namespace audio
 } // namespace ouzel
@@ -19,19 +19,58 @@ namespace ouzel
 
         Listener::~Listener()
         {
-            if (mix) mix->removeListener(this);
+            if (mix)
+            {
+                audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetBusListenerCommand(mix->getBusId(), false)));
+                mix->removeListener(this);
+            }
         }
 
         void Listener::setMix(Mix* newMix)
         {
-            if (mix) mix->removeListener(this);
+            if (mix)
+            {
+                audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetBusListenerCommand(mix->getBusId(), false)));
+                mix->removeListener(this);
+            }
+
             mix = newMix;
-            if (mix) mix->addListener(this);
+
+            if (mix)
+            {
+                mix->addListener(this);
+                updateListener();
+            }
+        }
+
+        void Listener::setVelocity(const Vector3<float>& newVelocity)
+        {
+            velocity = newVelocity;
+            updateListener();
         }
 
         void Listener::updateTransform()
         {
-            transformDirty = true;
+            if (actor)
+            {
+                position = actor->getWorldPosition();
+                rotation = actor->getWorldRotation();
+            }
+
+            updateListener();
+        }
+
+        void Listener::updateListener()
+        {
+            if (mix)
+            {
+                mixer::ListenerState listener;
+                listener.position = position;
+                listener.rotation = rotation;
+                listener.velocity = velocity;
+
+                audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetBusListenerCommand(mix->getBusId(), true, listener)));
+            }
         }
     } // namespace audio
 } // namespace ouzel
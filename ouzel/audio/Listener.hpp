@@ -30,15 +30,20 @@ namespace ouzel
 
             void setMix(Mix* newMix);
 
+            // used for the doppler effect (the listener is not moved by it)
+            const Vector3<float>& getVelocity() const { return velocity; }
+            void setVelocity(const Vector3<float>& newVelocity);
+
         private:
             void updateTransform() override;
+            void updateListener();
 
             Audio& audio;
 
             Mix* mix = nullptr;
             Vector3<float> position;
-            Quaternion<float> rotation;
-            bool transformDirty = true;
+            Quaternion<float> rotation = Quaternion<float>::identity();
+            Vector3<float> velocity;
         };
     } // namespace audio
 } // namespace ouzel
@@ -61,6 +61,13 @@ namespace ouzel
             }
         }
 
+        void Mix::setMaxVoices(uint32_t newMaxVoices)
+        {
+            maxVoices = newMaxVoices;
+
+            audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetBusMaxVoicesCommand(busId, maxVoices)));
+        }
+
         void Mix::addInput(Submix* submix)
         {
             auto i = std::find(inputSubmixes.begin(), inputSubmixes.end(), submix);
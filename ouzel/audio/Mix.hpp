@@ -35,6 +35,10 @@ namespace ouzel
             void addFilter(Filter* filter);
             void removeFilter(Filter* filter);
 
+            // limits the number of voices mixed by this mix (0 for unlimited), the rest are virtualized
+            uint32_t getMaxVoices() const { return maxVoices; }
+            void setMaxVoices(uint32_t newMaxVoices);
+
         protected:
             void addInput(Submix* submix);
             void removeInput(Submix* submix);
@@ -45,6 +49,7 @@ namespace ouzel
 
             Audio& audio;
             uintptr_t busId;
+            uint32_t maxVoices = 0;
             std::vector<Submix*> inputSubmixes;
             std::vector<Voice*> inputVoices;
             std::vector<Filter*> filters;
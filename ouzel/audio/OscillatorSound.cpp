@@ -23,6 +23,7 @@ namespace ouzel
             }
 
             void getData(uint32_t frames, std::vector<float>& samples) override;
+            void skip(uint32_t frames) override;
 
         private:
             uint32_t position = 0;
@@ -153,6 +154,30 @@ namespace ouzel
             }
         }
 
+        void OscillatorSource::skip(uint32_t frames)
+        {
+            const float length = static_cast<OscillatorData&>(sourceData).getLength();
+
+            if (length > 0.0F)
+            {
+                const uint32_t frameCount = static_cast<uint32_t>(length * sourceData.getSampleRate());
+
+                if (frameCount == 0) return;
+
+                if (isRepeating())
+                    position = (position + frames) % frameCount;
+                else if (frameCount - position <= frames)
+                {
+                    playing = false; // TODO: fire event
+                    reset();
+                }
+                else
+                    position += frames;
+            }
+            else
+                position += frames;
+        }
+
         OscillatorSound::OscillatorSound(Audio& initAudio, float initFrequency,
                                          Type initType, float initAmplitude, float initLength):
             Sound(initAudio, initAudio.initSourceData(std::unique_ptr<mixer::SourceData>(new OscillatorData(initFrequency, initType, initAmplitude, initLength)))),
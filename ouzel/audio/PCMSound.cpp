@@ -6,6 +6,7 @@
 #include "Audio.hpp"
 #include "mixer/Source.hpp"
 #include "mixer/SourceData.hpp"
+#include "utils/MemoryTracker.hpp"
 
 namespace ouzel
 {
@@ -24,6 +25,7 @@ namespace ouzel
             }
 
             void getData(uint32_t frames, std::vector<float>& samples) override;
+            void skip(uint32_t frames) override;
 
         private:
             uint32_t position = 0;
@@ -33,14 +35,15 @@ namespace ouzel
         {
         public:
             PCMData(uint16_t initChannels, uint32_t initSampleRate,
-                    const std::vector<float>& initSamples):
-                samples(initSamples)
+                    const std::shared_ptr<const std::vector<float>>& initSamples):
+                samples(initSamples),
+                memory(MemoryTag::SOUND, initSamples->size() * sizeof(float))
             {
                 channels = initChannels;
                 sampleRate = initSampleRate;
             }
 
-            const std::vector<float>& getSamples() const { return samples; }
+            const std::vector<float>& getSamples() const { return *samples; }
 
             std::unique_ptr<mixer::Source> createSource() override
             {
@@ -48,7 +51,8 @@ namespace ouzel
             }
 
         private:
-            std::vector<float> samples;
+            std::shared_ptr<const std::vector<float>> samples;
+            TrackedMemory memory;
         };
 
         PCMSource::PCMSource(PCMData& pcmData):
@@ -101,10 +105,44 @@ namespace ouzel
             std::fill(samples.begin() + totalSize, samples.end(), 0.0F);
         }
 
-        PCMSound::PCMSound(Audio& initAudio, uint16_t channels, uint32_t sampleRate,
-                           const std::vector<float>& samples):
-            Sound(initAudio, initAudio.initSourceData(std::unique_ptr<mixer::SourceData>(new PCMData(channels, sampleRate, samples))))
+        void PCMSource::skip(uint32_t frames)
         {
+            PCMData& pcmData = static_cast<PCMData&>(sourceData);
+            const uint32_t dataSize = static_cast<uint32_t>(pcmData.getSamples().size());
+
+            if (dataSize == 0) return;
+
+            uint32_t neededSize = frames * sourceData.getChannels();
+
+            if (isRepeating())
+                position = (position + neededSize) % dataSize;
+            else if (dataSize - position <= neededSize)
+            {
+                playing = false; // TODO: fire event
+                reset();
+            }
+            else
+                position += neededSize;
+        }
+
+        PCMSound::PCMSound(Audio& initAudio, uint16_t initChannels, uint32_t initSampleRate,
+                           const std::vector<float>& initSamples):
+            Sound(initAudio, 0),
+            channels(initChannels),
+            sampleRate(initSampleRate),
+            samples(std::make_shared<const std::vector<float>>(initSamples))
+        {
+            sourceDataId = audio.initSourceData(std::unique_ptr<mixer::SourceData>(new PCMData(channels, sampleRate, samples)));
+        }
+
+        PCMSound::PCMSound(Audio& initAudio, uint16_t initChannels, uint32_t initSampleRate,
+                           const std::shared_ptr<const std::vector<float>>& initSamples):
+            Sound(initAudio, 0),
+            channels(initChannels),
+            sampleRate(initSampleRate),
+            samples(initSamples)
+        {
+            sourceDataId = audio.initSourceData(std::unique_ptr<mixer::SourceData>(new PCMData(channels, sampleRate, samples)));
         }
     } // namespace audio
 } // namespace ouzel
@@ -4,6 +4,7 @@
 #define OUZEL_AUDIO_PCMSOUND_HPP
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include "audio/Sound.hpp"
 
@@ -14,8 +15,22 @@ namespace ouzel
         class PCMSound final: public Sound
         {
         public:
-            PCMSound(Audio& initAudio, uint16_t channels, uint32_t sampleRate,
-                     const std::vector<float>& samples);
+            PCMSound(Audio& initAudio, uint16_t initChannels, uint32_t initSampleRate,
+                     const std::vector<float>& initSamples);
+            PCMSound(Audio& initAudio, uint16_t initChannels, uint32_t initSampleRate,
+                     const std::shared_ptr<const std::vector<float>>& initSamples);
+
+            uint16_t getChannels() const { return channels; }
+            uint32_t getSampleRate() const { return sampleRate; }
+            // the samples are shared with the mixer and never modified
+            const std::shared_ptr<const std::vector<float>>& getSamples() const { return samples; }
+
+            size_t getMemoryUsage() const override { return samples->size() * sizeof(float); }
+
+        private:
+            uint16_t channels;
+            uint32_t sampleRate;
+            std::shared_ptr<const std::vector<float>> samples;
         };
     } // namespace audio
 } // namespace ouzel
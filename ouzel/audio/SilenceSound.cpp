@@ -22,6 +22,7 @@ namespace ouzel
             }
 
             void getData(uint32_t frames, std::vector<float>& samples) override;
+            void skip(uint32_t frames) override;
 
         private:
             uint32_t position = 0;
@@ -98,6 +99,30 @@ namespace ouzel
             }
         }
 
+        void SilenceSource::skip(uint32_t frames)
+        {
+            const float length = static_cast<SilenceData&>(sourceData).getLength();
+
+            if (length > 0.0F)
+            {
+                const uint32_t frameCount = static_cast<uint32_t>(length * sourceData.getSampleRate());
+
+                if (frameCount == 0) return;
+
+                if (isRepeating())
+                    position = (position + frames) % frameCount;
+                else if (frameCount - position <= frames)
+                {
+                    playing = false; // TODO: fire event
+                    reset();
+                }
+                else
+                    position += frames;
+            }
+            else
+                position += frames;
+        }
+
         SilenceSound::SilenceSound(Audio& initAudio, float initLength):
             Sound(initAudio, initAudio.initSourceData(std::unique_ptr<mixer::SourceData>(new SilenceData(initLength)))),
             length(initLength)
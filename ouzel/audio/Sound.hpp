@@ -29,6 +29,9 @@ namespace ouzel
 
             uintptr_t getSourceDataId() const { return sourceDataId; }
 
+            // size of the sound data in bytes
+            virtual size_t getMemoryUsage() const { return 0; }
+
         protected:
             Audio& audio;
             uintptr_t sourceDataId = 0;
@@ -5,12 +5,14 @@
 #include "AudioDevice.hpp"
 #include "Sound.hpp"
 #include "core/Engine.hpp"
+#include "scene/Actor.hpp"
 
 namespace ouzel
 {
     namespace audio
     {
         Voice::Voice(Audio& initAudio, const std::shared_ptr<Sound>& initSound):
+            scene::Component(scene::Component::SOUND),
             audio(initAudio),
             sourceId(audio.initSource(initSound->getSourceDataId()))
         {
@@ -28,10 +30,10 @@ namespace ouzel
             playing = true;
             repeating = repeat;
 
-            std::unique_ptr<SoundEvent> startEvent(new SoundEvent());
+            std::unique_ptr<SoundEvent> startEvent = EventDispatcher::createEvent<SoundEvent>();
             startEvent->type = Event::Type::SOUND_START;
             startEvent->voice = this;
-            engine->getEventDispatcher().postEvent(std::move(startEvent));
+            engine->getEventDispatcher().queueEvent(std::move(startEvent));
         }
 
         void Voice::pause()
@@ -77,5 +79,85 @@ namespace ouzel
             audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetSourceOutputCommand(sourceId,
                                                                                                           output ? output->getBusId() : 0)));
         }
+
+        void Voice::setPriority(int32_t newPriority)
+        {
+            priority = newPriority;
+
+            audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetSourcePriorityCommand(sourceId, priority)));
+        }
+
+        void Voice::setVolume(float newVolume)
+        {
+            volume = newVolume;
+
+            audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetSourceVolumeCommand(sourceId, volume)));
+        }
+
+        void Voice::setSpatialized(bool newSpatialized)
+        {
+            spatialized = newSpatialized;
+            updateSpatialization();
+        }
+
+        void Voice::setPosition(const Vector3<float>& newPosition)
+        {
+            position = newPosition;
+
+            audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetSourcePositionCommand(sourceId, position, velocity)));
+        }
+
+        void Voice::setVelocity(const Vector3<float>& newVelocity)
+        {
+            velocity = newVelocity;
+
+            audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetSourcePositionCommand(sourceId, position, velocity)));
+        }
+
+        void Voice::setDistanceModel(mixer::DistanceModel newDistanceModel)
+        {
+            distanceModel = newDistanceModel;
+            updateSpatialization();
+        }
+
+        void Voice::setRolloffFactor(float newRolloffFactor)
+        {
+            rolloffFactor = newRolloffFactor;
+            updateSpatialization();
+        }
+
+        void Voice::setMinDistance(float newMinDistance)
+        {
+            minDistance = newMinDistance;
+            updateSpatialization();
+        }
+
+        void Voice::setMaxDistance(float newMaxDistance)
+        {
+            maxDistance = newMaxDistance;
+            updateSpatialization();
+        }
+
+        void Voice::setDopplerFactor(float newDopplerFactor)
+        {
+            dopplerFactor = newDopplerFactor;
+            updateSpatialization();
+        }
+
+        void Voice::updateTransform()
+        {
+            if (actor) setPosition(actor->getWorldPosition());
+        }
+
+        void Voice::updateSpatialization()
+        {
+            audio.getMixer().addCommand(std::unique_ptr<mixer::Command>(new mixer::SetSourceSpatializationCommand(sourceId,
+                                                                                                                  spatialized,
+                                                                                                                  distanceModel,
+                                                                                                                  rolloffFactor,
+                                                                                                                  minDistance,
+                                                                                                                  maxDistance,
+                                                                                                                  dopplerFactor)));
+        }
     } // namespace audio
 } // namespace ouzel
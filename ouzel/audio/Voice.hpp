@@ -3,8 +3,11 @@
 #ifndef OUZEL_AUDIO_VOICE_HPP
 #define OUZEL_AUDIO_VOICE_HPP
 
+#include <cfloat>
 #include <memory>
+#include "audio/mixer/Spatializer.hpp"
 #include "math/Vector3.hpp"
+#include "scene/Component.hpp"
 
 namespace ouzel
 {
@@ -14,7 +17,8 @@ namespace ouzel
         class Mix;
         class Sound;
 
-        class Voice final
+        // when added to an actor, the position of a spatialized voice follows the world position of the actor
+        class Voice final: public scene::Component
         {
             friend Mix;
         public:
@@ -37,7 +41,42 @@ namespace ouzel
 
             void setOutput(Mix* newOutput);
 
+            // voices with higher priority are never virtualized in favor of the ones with lower priority
+            int32_t getPriority() const { return priority; }
+            void setPriority(int32_t newPriority);
+
+            float getVolume() const { return volume; }
+            void setVolume(float newVolume);
+
+            // spatialized voices are attenuated and panned according to the listener of their output mix
+            bool isSpatialized() const { return spatialized; }
+            void setSpatialized(bool newSpatialized);
+
+            const Vector3<float>& getPosition() const { return position; }
+            void setPosition(const Vector3<float>& newPosition);
+
+            const Vector3<float>& getVelocity() const { return velocity; }
+            void setVelocity(const Vector3<float>& newVelocity);
+
+            mixer::DistanceModel getDistanceModel() const { return distanceModel; }
+            void setDistanceModel(mixer::DistanceModel newDistanceModel);
+
+            float getRolloffFactor() const { return rolloffFactor; }
+            void setRolloffFactor(float newRolloffFactor);
+
+            float getMinDistance() const { return minDistance; }
+            void setMinDistance(float newMinDistance);
+
+            float getMaxDistance() const { return maxDistance; }
+            void setMaxDistance(float newMaxDistance);
+
+            float getDopplerFactor() const { return dopplerFactor; }
+            void setDopplerFactor(float newDopplerFactor);
+
         private:
+            void updateTransform() override;
+            void updateSpatialization();
+
             Audio& audio;
             uintptr_t sourceId;
 
@@ -45,6 +84,17 @@ namespace ouzel
 
             bool playing = false;
             bool repeating = false;
+            int32_t priority = 0;
+            float volume = 1.0F;
+
+            bool spatialized = false;
+            Vector3<float> position;
+            Vector3<float> velocity;
+            mixer::DistanceModel distanceModel = mixer::DistanceModel::INVERSE;
+            float rolloffFactor = 1.0F;
+            float minDistance = 1.0F;
+            float maxDistance = FLT_MAX;
+            float dopplerFactor = 1.0F;
 
             Mix* output = nullptr;
         };
@@ -5,6 +5,7 @@
 #include "Audio.hpp"
 #include "mixer/Source.hpp"
 #include "mixer/SourceData.hpp"
+#include "utils/MemoryTracker.hpp"
 #include "utils/Utils.hpp"
 
 #include "stb_vorbis.c"
@@ -29,34 +30,36 @@ namespace ouzel
             void reset() override
             {
                 stb_vorbis_seek_start(vorbisStream);
+                skipping = false;
             }
 
             void getData(uint32_t frames, std::vector<float>& samples) override;
+            void skip(uint32_t frames) override;
 
         private:
             stb_vorbis* vorbisStream = nullptr;
+
+            // while the source is virtual only the position is tracked, the stream is seeked once it becomes real
+            bool skipping = false;
+            uint32_t skipPosition = 0;
         };
 
         class VorbisData: public mixer::SourceData
         {
         public:
-            VorbisData(const std::vector<uint8_t>& initData):
-                data(initData)
+            VorbisData(const std::shared_ptr<const std::vector<uint8_t>>& initData,
+                       const VorbisSound::Header& header):
+                data(initData),
+                frameCount(header.frameCount)
             {
-                stb_vorbis* vorbisStream = stb_vorbis_open_memory(data.data(), static_cast<int>(data.size()), nullptr, nullptr);
-
-                if (!vorbisStream)
-                    throw std::runtime_error("Failed to load Vorbis stream");
-
-                stb_vorbis_info info = stb_vorbis_get_info(vorbisStream);
-
-                channels = static_cast<uint16_t>(info.channels);
-                sampleRate = info.sample_rate;
+                memory.setSize(data->size());
 
-                stb_vorbis_close(vorbisStream);
+                channels = header.channels;
+                sampleRate = header.sampleRate;
             }
 
-            const std::vector<uint8_t>& getData() const { return data; }
+            const std::vector<uint8_t>& getData() const { return *data; }
+            uint32_t getFrameCount() const { return frameCount; }
 
             std::unique_ptr<mixer::Source> createSource() override
             {
@@ -64,7 +67,9 @@ namespace ouzel
             }
 
         private:
-            std::vector<uint8_t> data;
+            std::shared_ptr<const std::vector<uint8_t>> data;
+            TrackedMemory memory{MemoryTag::SOUND};
+            uint32_t frameCount = 0;
         };
 
         VorbisSource::VorbisSource(VorbisData& vorbisData):
@@ -79,6 +84,12 @@ namespace ouzel
             uint32_t neededSize = frames * sourceData.getChannels();
             samples.resize(neededSize);
 
+            if (skipping)
+            {
+                stb_vorbis_seek(vorbisStream, skipPosition);
+                skipping = false;
+            }
+
             uint32_t totalSize = 0;
 
             while (neededSize > 0)
@@ -103,8 +114,61 @@ namespace ouzel
             std::fill(samples.begin() + totalSize, samples.end(), 0.0F);
         }
 
+        void VorbisSource::skip(uint32_t frames)
+        {
+            const uint32_t frameCount = static_cast<VorbisData&>(sourceData).getFrameCount();
+
+            if (frameCount == 0) return;
+
+            if (!skipping)
+            {
+                int offset = stb_vorbis_get_sample_offset(vorbisStream);
+                skipPosition = offset > 0 ? static_cast<uint32_t>(offset) : 0;
+                skipping = true;
+            }
+
+            if (isRepeating())
+                skipPosition = (skipPosition + frames) % frameCount;
+            else if (frameCount - skipPosition <= frames)
+            {
+                playing = false; // TODO: fire event
+                reset();
+            }
+            else
+                skipPosition += frames;
+        }
+
+        VorbisSound::Header VorbisSound::readHeader(const std::vector<uint8_t>& data)
+        {
+            stb_vorbis* vorbisStream = stb_vorbis_open_memory(data.data(), static_cast<int>(data.size()), nullptr, nullptr);
+
+            if (!vorbisStream)
+                throw std::runtime_error("Failed to load Vorbis stream");
+
+            stb_vorbis_info info = stb_vorbis_get_info(vorbisStream);
+
+            Header header;
+            header.channels = static_cast<uint16_t>(info.channels);
+            header.sampleRate = info.sample_rate;
+            header.frameCount = stb_vorbis_stream_length_in_samples(vorbisStream);
+
+            stb_vorbis_close(vorbisStream);
+
+            return header;
+        }
+
         VorbisSound::VorbisSound(Audio& initAudio, const std::vector<uint8_t>& initData):
-            Sound(initAudio, initAudio.initSourceData(std::unique_ptr<mixer::SourceData>(new VorbisData(initData))))
+            Sound(initAudio, 0),
+            dataSize(initData.size())
+        {
+            std::shared_ptr<const std::vector<uint8_t>> data = std::make_shared<const std::vector<uint8_t>>(initData);
+            sourceDataId = audio.initSourceData(std::unique_ptr<mixer::SourceData>(new VorbisData(data, readHeader(*data))));
+        }
+
+        VorbisSound::VorbisSound(Audio& initAudio, const std::shared_ptr<const std::vector<uint8_t>>& initData,
+                                 const Header& initHeader):
+            Sound(initAudio, initAudio.initSourceData(std::unique_ptr<mixer::SourceData>(new VorbisData(initData, initHeader)))),
+            dataSize(initData->size())
         {
         }
     } // namespace audio
@@ -4,6 +4,7 @@
 #define OUZEL_AUDIO_VORBISSOUND_HPP
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include "audio/Sound.hpp"
 
@@ -14,10 +15,25 @@ namespace ouzel
         class VorbisSound final: public Sound
         {
         public:
+            class Header final
+            {
+            public:
+                uint16_t channels = 0;
+                uint32_t sampleRate = 0;
+                uint32_t frameCount = 0;
+            };
+
+            // does not need the audio, can be called on a worker thread
+            static Header readHeader(const std::vector<uint8_t>& data);
+
             VorbisSound(Audio& initAudio, const std::vector<uint8_t>& initData);
+            VorbisSound(Audio& initAudio, const std::shared_ptr<const std::vector<uint8_t>>& initData,
+                        const Header& initHeader);
+
+            size_t getMemoryUsage() const override { return dataSize; }
 
         private:
-            std::vector<uint8_t> data;
+            size_t dataSize;
         };
     } // namespace audio
 } // namespace ouzel
@@ -4,6 +4,7 @@
 
 #if OUZEL_COMPILE_ALSA
 
+#include <algorithm>
 #include <system_error>
 #include "ALSAAudioDevice.hpp"
 #include "core/Engine.hpp"
@@ -14,8 +15,14 @@ namespace ouzel
 {
     namespace audio
     {
-        ALSAAudioDevice::ALSAAudioDevice(mixer::Mixer& initMixer):
-            AudioDevice(Driver::ALSA, initMixer)
+        static constexpr snd_pcm_uframes_t MAX_BUFFER_MULTIPLIER = 8;
+        static constexpr std::chrono::seconds BUFFER_SHRINK_DELAY(10);
+
+        ALSAAudioDevice::ALSAAudioDevice(mixer::Mixer& initMixer,
+                                         uint32_t latencyFrames, float latencyTime,
+                                         bool initAdaptiveLatency):
+            AudioDevice(Driver::ALSA, initMixer),
+            adaptiveLatency(initAdaptiveLatency)
         {
             int result;
             if ((result = snd_pcm_open(&playbackHandle, "default", SND_PCM_STREAM_PLAYBACK, 0)) < 0)
@@ -26,64 +33,109 @@ namespace ouzel
             if ((result = snd_pcm_hw_params_malloc(&hwParams)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to allocate memory for hardware parameters");
 
+            if ((result = snd_pcm_sw_params_malloc(&swParams)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to allocate memory for software parameters");
+
             if ((result = snd_pcm_hw_params_any(playbackHandle, hwParams)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to initialize hardware parameters");
 
-            if ((result = snd_pcm_hw_params_set_access(playbackHandle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0)
-                throw std::system_error(result, std::system_category(), "Failed to set access type");
-
             if (snd_pcm_hw_params_test_format(playbackHandle, hwParams, SND_PCM_FORMAT_FLOAT_LE) == 0)
             {
-                if ((result = snd_pcm_hw_params_set_format(playbackHandle, hwParams, SND_PCM_FORMAT_FLOAT_LE)) < 0)
-                    throw std::system_error(result, std::system_category(), "Failed to set sample format");
-
+                format = SND_PCM_FORMAT_FLOAT_LE;
                 sampleFormat = SampleFormat::FLOAT32;
             }
             else if (snd_pcm_hw_params_test_format(playbackHandle, hwParams, SND_PCM_FORMAT_S16_LE) == 0)
             {
-                if ((result = snd_pcm_hw_params_set_format(playbackHandle, hwParams, SND_PCM_FORMAT_S16_LE)) < 0)
-                    throw std::system_error(result, std::system_category(), "Failed to set sample format");
-
+                format = SND_PCM_FORMAT_S16_LE;
                 sampleFormat = SampleFormat::SINT16;
             }
             else
                 throw std::runtime_error("No supported format");
 
+            if (latencyFrames)
+                targetBufferFrames = latencyFrames;
+            else if (latencyTime > 0.0F)
+                targetBufferFrames = static_cast<snd_pcm_uframes_t>(latencyTime * sampleRate);
+            else
+                targetBufferFrames = periods * periodSize;
+
+            configure(targetBufferFrames);
+
+            lastUnderrunTime = std::chrono::steady_clock::now();
+
+            running = true;
+            audioThread = std::thread(&ALSAAudioDevice::run, this);
+        }
+
+        ALSAAudioDevice::~ALSAAudioDevice()
+        {
+            running = false;
+            if (audioThread.joinable()) audioThread.join();
+
+            if (swParams) snd_pcm_sw_params_free(swParams);
+            if (hwParams) snd_pcm_hw_params_free(hwParams);
+            if (playbackHandle) snd_pcm_close(playbackHandle);
+        }
+
+        void ALSAAudioDevice::configure(snd_pcm_uframes_t newBufferSize)
+        {
+            int result;
+            int dir = 0;
+
+            if ((result = snd_pcm_hw_params_any(playbackHandle, hwParams)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to initialize hardware parameters");
+
+            if ((result = snd_pcm_hw_params_set_access(playbackHandle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to set access type");
+
+            if ((result = snd_pcm_hw_params_set_format(playbackHandle, hwParams, format)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to set sample format");
+
             if ((result = snd_pcm_hw_params_set_rate(playbackHandle, hwParams, sampleRate, 0)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to set sample rate");
 
             if ((result = snd_pcm_hw_params_set_channels(playbackHandle, hwParams, channels)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to set channel count");
 
-            unsigned int periodLength = periodSize * 1000000 / sampleRate; // period length in microseconds
-            unsigned int bufferLength = periodLength * periods; // buffer length in microseconds
-            int dir;
+            snd_pcm_uframes_t newPeriodSize = std::max(newBufferSize / periods, static_cast<snd_pcm_uframes_t>(1));
 
-            if ((result = snd_pcm_hw_params_set_buffer_time_near(playbackHandle, hwParams, &bufferLength, &dir)) < 0)
-                throw std::system_error(result, std::system_category(), "Failed to set buffer time");
+            if ((result = snd_pcm_hw_params_set_period_size_near(playbackHandle, hwParams, &newPeriodSize, &dir)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to set period size");
 
-            if ((result = snd_pcm_hw_params_set_period_time_near(playbackHandle, hwParams, &periodLength, &dir)) < 0)
-                throw std::system_error(result, std::system_category(), "Failed to set period time");
+            snd_pcm_uframes_t newBufferFrames = newPeriodSize * periods;
+
+            if ((result = snd_pcm_hw_params_set_buffer_size_near(playbackHandle, hwParams, &newBufferFrames)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to set buffer size");
+
+            if ((result = snd_pcm_hw_params(playbackHandle, hwParams)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to set hardware parameters");
 
             if ((result = snd_pcm_hw_params_get_period_size(hwParams, &periodSize, &dir)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to get period size");
 
-            if ((result = snd_pcm_hw_params_get_periods(hwParams, &periods, &dir)) < 0)
-                throw std::system_error(result, std::system_category(), "Failed to get period count");
+            if ((result = snd_pcm_hw_params_get_buffer_size(hwParams, &bufferFrames)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to get buffer size");
 
-            if ((result = snd_pcm_hw_params(playbackHandle, hwParams)) < 0)
-                throw std::system_error(result, std::system_category(), "Failed to set hardware parameters");
+            setFillFrames(bufferFrames);
 
-            snd_pcm_hw_params_free(hwParams);
-            hwParams = nullptr;
+            if ((result = snd_pcm_prepare(playbackHandle)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to prepare audio interface");
 
-            if ((result = snd_pcm_sw_params_malloc(&swParams)) < 0)
-                throw std::system_error(result, std::system_category(), "Failed to allocate memory for software parameters");
+            engine->log(Log::Level::INFO) << "Audio buffer size: " << bufferFrames << " frames (" <<
+                bufferFrames * 1000 / sampleRate << "ms), period size: " << periodSize << " frames";
+        }
+
+        void ALSAAudioDevice::setFillFrames(snd_pcm_uframes_t newFillFrames)
+        {
+            int result;
+
+            fillFrames = std::min(std::max(newFillFrames, periodSize), bufferFrames);
 
             if ((result = snd_pcm_sw_params_current(playbackHandle, swParams)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to initialize software parameters");
 
-            if ((result = snd_pcm_sw_params_set_avail_min(playbackHandle, swParams, 4096)) < 0)
+            // wake up when a period can be written without exceeding the filled part
+            if ((result = snd_pcm_sw_params_set_avail_min(playbackHandle, swParams, bufferFrames - fillFrames + periodSize)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to set minimum available count");
 
             if ((result = snd_pcm_sw_params_set_start_threshold(playbackHandle, swParams, 0)) < 0)
@@ -92,24 +144,29 @@ namespace ouzel
             if ((result = snd_pcm_sw_params(playbackHandle, swParams)) < 0)
                 throw std::system_error(result, std::system_category(), "Failed to set software parameters");
 
-            if ((result = snd_pcm_prepare(playbackHandle)) < 0)
-                throw std::system_error(result, std::system_category(), "Failed to prepare audio interface");
-
-            snd_pcm_sw_params_free(swParams);
-            swParams = nullptr;
-
-            running = true;
-            audioThread = std::thread(&ALSAAudioDevice::run, this);
+            latency = static_cast<uint32_t>(fillFrames);
         }
 
-        ALSAAudioDevice::~ALSAAudioDevice()
+        void ALSAAudioDevice::handleUnderrun()
         {
-            running = false;
-            if (audioThread.joinable()) audioThread.join();
+            ++underrunCount;
+            lastUnderrunTime = std::chrono::steady_clock::now();
 
-            if (swParams) snd_pcm_sw_params_free(swParams);
-            if (hwParams) snd_pcm_hw_params_free(hwParams);
-            if (playbackHandle) snd_pcm_close(playbackHandle);
+            engine->log(Log::Level::WARN) << "Buffer underrun occurred";
+
+            if (adaptiveLatency && fillFrames < bufferFrames)
+                setFillFrames(fillFrames * 2);
+            else if (adaptiveLatency && bufferFrames < targetBufferFrames * MAX_BUFFER_MULTIPLIER)
+            {
+                // the stream has stopped already, so the larger buffer does not add a gap
+                snd_pcm_drop(playbackHandle);
+                configure(std::min(bufferFrames * 2, targetBufferFrames * MAX_BUFFER_MULTIPLIER));
+                return;
+            }
+
+            int result;
+            if ((result = snd_pcm_prepare(playbackHandle)) < 0)
+                throw std::system_error(result, std::system_category(), "Failed to prepare audio interface");
         }
 
         void ALSAAudioDevice::run()
@@ -124,47 +181,58 @@ namespace ouzel
 
                     process();
 
+                    if (adaptiveLatency && fillFrames > targetBufferFrames &&
+                        std::chrono::steady_clock::now() - lastUnderrunTime > BUFFER_SHRINK_DELAY)
+                    {
+                        // after a period without underruns keep less data queued, the playback continues while the queue drains
+                        lastUnderrunTime = std::chrono::steady_clock::now();
+                        setFillFrames(std::max(fillFrames / 2, targetBufferFrames));
+                    }
+
                     snd_pcm_sframes_t frames;
 
                     if ((frames = snd_pcm_avail_update(playbackHandle)) < 0)
                     {
                         if (frames == -EPIPE)
                         {
-                            engine->log(Log::Level::WARN) << "Buffer underrun occurred";
-
-                            if ((result = snd_pcm_prepare(playbackHandle)) < 0)
-                                throw std::system_error(result, std::system_category(), "Failed to prepare audio interface");
-
+                            handleUnderrun();
                             continue;
                         }
                         else
                             throw std::system_error(frames, std::system_category(), "Failed to get available frames");
                     }
 
-                    if (static_cast<snd_pcm_uframes_t>(frames) > periods * periodSize)
+                    if (static_cast<snd_pcm_uframes_t>(frames) > bufferFrames)
                     {
                         engine->log(Log::Level::WARN) << "Buffer size exceeded, error: " << frames;
                         snd_pcm_reset(playbackHandle);
                         continue;
                     }
 
+                    // only the filled part of the buffer is used
+                    snd_pcm_uframes_t queuedFrames = bufferFrames - static_cast<snd_pcm_uframes_t>(frames);
+                    frames = (queuedFrames < fillFrames) ? static_cast<snd_pcm_sframes_t>(fillFrames - queuedFrames) : 0;
+
                     if (static_cast<snd_pcm_uframes_t>(frames) < periodSize)
+                    {
+                        // wait until a period is available
+                        snd_pcm_wait(playbackHandle, static_cast<int>(periodSize * 1000 / sampleRate) + 1);
                         continue;
+                    }
 
-                    getData(frames, data);
+                    getData(static_cast<uint32_t>(frames), data);
 
                     if ((result = snd_pcm_writei(playbackHandle, data.data(), frames)) < 0)
                     {
                         if (result == -EPIPE)
-                        {
-                            engine->log(Log::Level::WARN) << "Buffer underrun occurred";
-
-                            if ((result = snd_pcm_prepare(playbackHandle)) < 0)
-                                throw std::system_error(result, std::system_category(), "Failed to prepare audio interface");
-                        }
+                            handleUnderrun();
                         else
                             throw std::system_error(result, std::system_category(), "Failed to write data");
                     }
+
+                    snd_pcm_sframes_t delay;
+                    if (snd_pcm_delay(playbackHandle, &delay) == 0 && delay >= 0)
+                        latency = static_cast<uint32_t>(delay);
                 }
                 catch (const std::exception& e)
                 {
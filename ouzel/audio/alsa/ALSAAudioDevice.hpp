@@ -8,6 +8,7 @@
 #if OUZEL_COMPILE_ALSA
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <alsa/asoundlib.h>
 
@@ -20,18 +21,34 @@ namespace ouzel
         class ALSAAudioDevice final: public AudioDevice
         {
         public:
-            explicit ALSAAudioDevice(mixer::Mixer& initMixer);
+            // latency is given either in frames or in seconds (the default is used if both are 0)
+            ALSAAudioDevice(mixer::Mixer& initMixer,
+                            uint32_t latencyFrames, float latencyTime,
+                            bool initAdaptiveLatency);
             ~ALSAAudioDevice();
 
         private:
+            void configure(snd_pcm_uframes_t newBufferSize);
+            // changes the number of frames kept in the buffer without stopping the playback
+            void setFillFrames(snd_pcm_uframes_t newFillFrames);
+            void handleUnderrun();
             void run();
 
             snd_pcm_t* playbackHandle = nullptr;
             snd_pcm_hw_params_t* hwParams = nullptr;
             snd_pcm_sw_params_t* swParams = nullptr;
 
+            snd_pcm_format_t format = SND_PCM_FORMAT_UNKNOWN;
             unsigned int periods = 4;
             snd_pcm_uframes_t periodSize = 1024;
+            snd_pcm_uframes_t bufferFrames = 4096;
+
+            // with adaptive latency the filled part of the buffer grows after underruns and shrinks back after a quiet period
+            // the hardware buffer is reallocated only when it has to grow beyond its size
+            bool adaptiveLatency = false;
+            snd_pcm_uframes_t fillFrames = 4096;
+            snd_pcm_uframes_t targetBufferFrames = 4096;
+            std::chrono::steady_clock::time_point lastUnderrunTime;
 
             std::vector<uint8_t> data;
 
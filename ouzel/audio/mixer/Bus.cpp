@@ -1,6 +1,7 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
 #include <algorithm>
+#include <cmath>
 #include "Bus.hpp"
 #include "Processor.hpp"
 #include "Source.hpp"
@@ -229,23 +230,31 @@ namespace ouzel
             }
 
             void Bus::getData(uint32_t frames, uint16_t channels, uint32_t sampleRate,
-                              const Vector3<float>& listenerPosition, const Quaternion<float>& listenerRotation,
+                              const ListenerState& parentListener,
                               std::vector<float>& samples)
             {
+                const ListenerState& currentListener = listenerActive ? listener : parentListener;
+                const auto startTime = std::chrono::steady_clock::now();
+                std::chrono::steady_clock::duration inputProcessingTime(0);
+
                 samples.resize(frames * channels);
                 std::fill(samples.begin(), samples.end(), 0.0F);
 
+                for (Processor* processor : processors)
+                    processor->listener = currentListener;
+
                 for (Bus* bus : inputBuses)
                 {
-                    bus->getData(frames, channels, sampleRate, listenerPosition, listenerRotation, buffer);
-
-                    for (Processor* processor : processors)
-                        processor->process(frames, channels, sampleRate, buffer);
+                    bus->getData(frames, channels, sampleRate, currentListener, buffer);
+                    inputProcessingTime += bus->totalProcessingTime;
 
                     for (size_t s = 0; s < samples.size(); ++s)
                         samples[s] += buffer[s];
                 }
 
+                Quaternion<float> inverseListenerRotation = currentListener.rotation;
+                inverseListenerRotation.invert();
+
                 for (Source* source : inputSources)
                 {
                     if (source->isPlaying())
@@ -253,27 +262,129 @@ namespace ouzel
                         const uint32_t sourceSampleRate = source->getSourceData().getSampleRate();
                         const uint16_t sourceChannels = source->getSourceData().getChannels();
 
-                        if (sourceSampleRate != sampleRate)
+                        uint32_t sourceFrames = frames;
+
+                        if (source->isSpatialized())
+                        {
+                            float pitch = getDopplerPitch(currentListener, source->getPosition(),
+                                                          source->getVelocity(), source->getDopplerFactor());
+                            sourceFrames = static_cast<uint32_t>(ceilf(frames * pitch * sourceSampleRate / sampleRate));
+                        }
+                        else if (sourceSampleRate != sampleRate)
+                            sourceFrames = (frames * sourceSampleRate + sampleRate - 1) / sampleRate; // round up
+
+                        if (source->isVirtual())
+                        {
+                            // virtual sources only advance their position
+                            source->skip(sourceFrames);
+                            source->gainsValid = false;
+                            continue;
+                        }
+
+                        if (sourceFrames != frames)
                         {
-                            uint32_t sourceFrames = (frames * sourceSampleRate + sampleRate - 1) / sampleRate; // round up
                             source->getData(sourceFrames, resampleBuffer);
                             resample(sourceChannels, sourceFrames, resampleBuffer, frames, mixBuffer);
                         }
                         else
                             source->getData(frames, mixBuffer);
 
-                        if (sourceChannels != channels)
-                            mix(frames, sourceChannels, mixBuffer, channels, buffer);
+                        const float volume = source->getVolume();
+
+                        if (source->isSpatialized())
+                        {
+                            if (sourceChannels != 1)
+                                mix(frames, sourceChannels, mixBuffer, 1, monoBuffer);
+                            else
+                                monoBuffer = mixBuffer;
+
+                            Vector3<float> direction = inverseListenerRotation.rotateVector(source->getPosition() - currentListener.position);
+
+                            panningGains.resize(channels);
+                            getPanningGains(direction, source->getMinDistance(), channels, panningGains.data());
+
+                            const float gain = volume * source->attenuation;
+                            for (uint16_t channel = 0; channel < channels; ++channel)
+                                panningGains[channel] *= gain;
+
+                            // the gains are ramped from the previous block to avoid zipper noise
+                            if (!source->gainsValid || source->gains.size() != channels)
+                                source->gains = panningGains;
+
+                            mixPanned(frames, monoBuffer.data(), channels, source->gains.data(), panningGains.data(), samples.data());
+
+                            source->gains = panningGains;
+                            source->gainsValid = true;
+                        }
                         else
-                            buffer = mixBuffer;
+                        {
+                            if (sourceChannels != channels)
+                                mix(frames, sourceChannels, mixBuffer, channels, buffer);
+                            else
+                                buffer = mixBuffer;
 
-                        for (size_t s = 0; s < samples.size(); ++s)
-                            samples[s] += buffer[s];
+                            for (size_t s = 0; s < samples.size(); ++s)
+                                samples[s] += buffer[s] * volume;
+                        }
                     }
                 }
 
                 for (Processor* processor : processors)
                     processor->process(frames, channels, sampleRate, samples);
+
+                totalProcessingTime = std::chrono::steady_clock::now() - startTime;
+                processingTime = totalProcessingTime - inputProcessingTime;
+            }
+
+            void Bus::setListener(const ListenerState& newListener)
+            {
+                listener = newListener;
+                listenerActive = true;
+            }
+
+            void Bus::removeListener()
+            {
+                listenerActive = false;
+            }
+
+            uint32_t Bus::selectVoices(const ListenerState& parentListener, std::vector<Source*>& realSources)
+            {
+                const ListenerState& currentListener = listenerActive ? listener : parentListener;
+                uint32_t playingCount = 0;
+
+                for (Bus* bus : inputBuses)
+                    playingCount += bus->selectVoices(currentListener, realSources);
+
+                playingSources.clear();
+
+                for (Source* source : inputSources)
+                {
+                    if (source->isPlaying())
+                    {
+                        source->updateAttenuation(currentListener);
+                        playingSources.push_back(source);
+                    }
+                }
+
+                playingCount += static_cast<uint32_t>(playingSources.size());
+
+                if (maxVoices && playingSources.size() > maxVoices)
+                {
+                    std::nth_element(playingSources.begin(), playingSources.begin() + maxVoices, playingSources.end(),
+                                     [](const Source* a, const Source* b) {
+                                         return a->isMoreImportantThan(*b);
+                                     });
+
+                    for (auto i = playingSources.begin() + maxVoices; i != playingSources.end(); ++i)
+                        (*i)->virtualSource = true;
+
+                    playingSources.resize(maxVoices);
+                }
+
+                // the mixer marks them as real after applying the global voice limit
+                realSources.insert(realSources.end(), playingSources.begin(), playingSources.end());
+
+                return playingCount;
             }
 
             void Bus::addProcessor(Processor* processor)
@@ -3,8 +3,10 @@
 #ifndef OUZEL_AUDIO_MIXER_BUS_HPP
 #define OUZEL_AUDIO_MIXER_BUS_HPP
 
+#include <chrono>
 #include <vector>
 #include "audio/mixer/Object.hpp"
+#include "audio/mixer/Spatializer.hpp"
 
 namespace ouzel
 {
@@ -31,12 +33,29 @@ namespace ouzel
                 void setOutput(Bus* newOutput);
 
                 void getData(uint32_t frames, uint16_t channels, uint32_t sampleRate,
-                             const Vector3<float>& listenerPosition, const Quaternion<float>& listenerRotation,
+                             const ListenerState& parentListener,
                              std::vector<float>& samples);
 
                 void addProcessor(Processor* processor);
                 void removeProcessor(Processor* processor);
 
+                // maximum number of input sources that are mixed (0 for unlimited)
+                uint32_t getMaxVoices() const { return maxVoices; }
+                void setMaxVoices(uint32_t newMaxVoices) { maxVoices = newMaxVoices; }
+
+                // picks the sources that will be mixed and virtualizes the rest
+                // adds the candidate sources of the subgraph to realSources and returns the number of playing sources
+                // the candidates keep their virtual state until the mixer has applied the global voice limit
+                uint32_t selectVoices(const ListenerState& parentListener, std::vector<Source*>& realSources);
+
+                // the listener of the bus overrides the one of the output bus for the whole subgraph
+                bool hasListener() const { return listenerActive; }
+                void setListener(const ListenerState& newListener);
+                void removeListener();
+
+                // time spent in the last getData call by this bus, excluding the input buses
+                std::chrono::steady_clock::duration getProcessingTime() const { return processingTime; }
+
             private:
                 void addInput(Bus* bus);
                 void removeInput(Bus* bus);
@@ -47,10 +66,18 @@ namespace ouzel
                 std::vector<Bus*> inputBuses;
                 std::vector<Source*> inputSources;
                 std::vector<Processor*> processors;
+                uint32_t maxVoices = 0;
+                std::vector<Source*> playingSources;
+                bool listenerActive = false;
+                ListenerState listener;
+                std::chrono::steady_clock::duration processingTime{0};
+                std::chrono::steady_clock::duration totalProcessingTime{0};
 
                 std::vector<float> resampleBuffer;
                 std::vector<float> mixBuffer;
                 std::vector<float> buffer;
+                std::vector<float> monoBuffer;
+                std::vector<float> panningGains;
             };
         }
     } // namespace audio
@@ -25,13 +25,20 @@ namespace ouzel
                     DELETE_OBJECT,
                     INIT_BUS,
                     SET_BUS_OUTPUT,
+                    SET_BUS_MAX_VOICES,
+                    SET_BUS_LISTENER,
                     ADD_PROCESSOR,
                     REMOVE_PROCESSOR,
                     SET_MASTER_BUS,
+                    SET_MAX_VOICES,
                     INIT_SOURCE,
                     PLAY_SOURCE,
                     STOP_SOURCE,
                     SET_SOURCE_OUTPUT,
+                    SET_SOURCE_PRIORITY,
+                    SET_SOURCE_VOLUME,
+                    SET_SOURCE_POSITION,
+                    SET_SOURCE_SPATIALIZATION,
                     INIT_SOURCE_DATA,
                     INIT_PROCESSOR,
                     UPDATE_PROCESSOR
@@ -78,6 +85,37 @@ namespace ouzel
                 uintptr_t outputBusId;
             };
 
+            class SetBusMaxVoicesCommand: public Command
+            {
+            public:
+                SetBusMaxVoicesCommand(uintptr_t initBusId,
+                                       uint32_t initMaxVoices):
+                    Command(Command::Type::SET_BUS_MAX_VOICES),
+                    busId(initBusId),
+                    maxVoices(initMaxVoices)
+                {}
+
+                uintptr_t busId;
+                uint32_t maxVoices;
+            };
+
+            class SetBusListenerCommand: public Command
+            {
+            public:
+                SetBusListenerCommand(uintptr_t initBusId,
+                                      bool initActive,
+                                      const ListenerState& initListener = ListenerState()):
+                    Command(Command::Type::SET_BUS_LISTENER),
+                    busId(initBusId),
+                    active(initActive),
+                    listener(initListener)
+                {}
+
+                uintptr_t busId;
+                bool active;
+                ListenerState listener;
+            };
+
             class AddProcessorCommand: public Command
             {
             public:
@@ -117,6 +155,17 @@ namespace ouzel
                 uintptr_t busId;
             };
 
+            class SetMaxVoicesCommand: public Command
+            {
+            public:
+                SetMaxVoicesCommand(uint32_t initMaxVoices):
+                    Command(Command::Type::SET_MAX_VOICES),
+                    maxVoices(initMaxVoices)
+                {}
+
+                uint32_t maxVoices;
+            };
+
             class InitSourceCommand: public Command
             {
             public:
@@ -173,6 +222,80 @@ namespace ouzel
                 uintptr_t busId;
             };
 
+            class SetSourcePriorityCommand: public Command
+            {
+            public:
+                SetSourcePriorityCommand(uintptr_t initSourceId,
+                                         int32_t initPriority):
+                    Command(Command::Type::SET_SOURCE_PRIORITY),
+                    sourceId(initSourceId),
+                    priority(initPriority)
+                {}
+
+                uintptr_t sourceId;
+                int32_t priority;
+            };
+
+            class SetSourceVolumeCommand: public Command
+            {
+            public:
+                SetSourceVolumeCommand(uintptr_t initSourceId,
+                                       float initVolume):
+                    Command(Command::Type::SET_SOURCE_VOLUME),
+                    sourceId(initSourceId),
+                    volume(initVolume)
+                {}
+
+                uintptr_t sourceId;
+                float volume;
+            };
+
+            class SetSourcePositionCommand: public Command
+            {
+            public:
+                SetSourcePositionCommand(uintptr_t initSourceId,
+                                         const Vector3<float>& initPosition,
+                                         const Vector3<float>& initVelocity):
+                    Command(Command::Type::SET_SOURCE_POSITION),
+                    sourceId(initSourceId),
+                    position(initPosition),
+                    velocity(initVelocity)
+                {}
+
+                uintptr_t sourceId;
+                Vector3<float> position;
+                Vector3<float> velocity;
+            };
+
+            class SetSourceSpatializationCommand: public Command
+            {
+            public:
+                SetSourceSpatializationCommand(uintptr_t initSourceId,
+                                               bool initSpatialized,
+                                               DistanceModel initDistanceModel,
+                                               float initRolloffFactor,
+                                               float initMinDistance,
+                                               float initMaxDistance,
+                                               float initDopplerFactor):
+                    Command(Command::Type::SET_SOURCE_SPATIALIZATION),
+                    sourceId(initSourceId),
+                    spatialized(initSpatialized),
+                    distanceModel(initDistanceModel),
+                    rolloffFactor(initRolloffFactor),
+                    minDistance(initMinDistance),
+                    maxDistance(initMaxDistance),
+                    dopplerFactor(initDopplerFactor)
+                {}
+
+                uintptr_t sourceId;
+                bool spatialized;
+                DistanceModel distanceModel;
+                float rolloffFactor;
+                float minDistance;
+                float maxDistance;
+                float dopplerFactor;
+            };
+
             class InitSourceDataCommand: public Command
             {
             public:
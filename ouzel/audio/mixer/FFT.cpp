@@ -0,0 +1,289 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#if defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#elif defined(__SSE__)
+#  include <xmmintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "FFT.hpp"
+#include "math/MathUtils.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        namespace mixer
+        {
+            FFT::FFT(uint32_t initSize)
+            {
+                resize(initSize);
+            }
+
+            void FFT::resize(uint32_t newSize)
+            {
+                if (newSize == size) return;
+
+                if (newSize && !isPowerOfTwo(newSize))
+                    throw std::runtime_error("FFT size must be a power of two");
+
+                size = newSize;
+
+                bitReversal.resize(size);
+
+                uint32_t bits = 0;
+                while ((1U << bits) < size) ++bits;
+
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    uint32_t reversed = 0;
+                    for (uint32_t bit = 0; bit < bits; ++bit)
+                        if (i & (1U << bit)) reversed |= 1U << (bits - 1 - bit);
+                    bitReversal[i] = reversed;
+                }
+
+                forwardTwiddles.resize(size ? (size - 1) * 2 : 0);
+                inverseTwiddles.resize(forwardTwiddles.size());
+
+                for (uint32_t half = 1; half < size; half <<= 1)
+                {
+                    for (uint32_t j = 0; j < half; ++j)
+                    {
+                        double angle = 3.14159265358979323846 * static_cast<double>(j) / static_cast<double>(half);
+                        float real = static_cast<float>(cos(angle));
+                        float imag = static_cast<float>(sin(angle));
+
+                        uint32_t offset = (half - 1 + j) * 2;
+                        forwardTwiddles[offset + 0] = real;
+                        forwardTwiddles[offset + 1] = -imag;
+                        inverseTwiddles[offset + 0] = real;
+                        inverseTwiddles[offset + 1] = imag;
+                    }
+                }
+            }
+
+            void FFT::forward(float* data) const
+            {
+                transform(data, forwardTwiddles);
+            }
+
+            void FFT::inverse(float* data) const
+            {
+                transform(data, inverseTwiddles);
+            }
+
+            void FFT::transform(float* data, const std::vector<float>& twiddles) const
+            {
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    uint32_t j = bitReversal[i];
+                    if (i < j)
+                    {
+                        std::swap(data[i * 2 + 0], data[j * 2 + 0]);
+                        std::swap(data[i * 2 + 1], data[j * 2 + 1]);
+                    }
+                }
+
+                for (uint32_t half = 1; half < size; half <<= 1)
+                {
+                    const float* w = twiddles.data() + (half - 1) * 2;
+
+                    for (uint32_t k = 0; k < size; k += half * 2)
+                    {
+                        float* a = data + k * 2;
+                        float* b = data + (k + half) * 2;
+                        uint32_t j = 0;
+
+                        if (isSimdAvailable)
+                        {
+#if defined(__ARM_NEON__)
+                            for (; j + 4 <= half; j += 4)
+                            {
+                                float32x4x2_t va = vld2q_f32(a + j * 2);
+                                float32x4x2_t vb = vld2q_f32(b + j * 2);
+                                float32x4x2_t vw = vld2q_f32(w + j * 2);
+
+                                float32x4_t real = vmlsq_f32(vmulq_f32(vb.val[0], vw.val[0]), vb.val[1], vw.val[1]);
+                                float32x4_t imag = vmlaq_f32(vmulq_f32(vb.val[1], vw.val[0]), vb.val[0], vw.val[1]);
+
+                                float32x4x2_t ra;
+                                ra.val[0] = vaddq_f32(va.val[0], real);
+                                ra.val[1] = vaddq_f32(va.val[1], imag);
+                                float32x4x2_t rb;
+                                rb.val[0] = vsubq_f32(va.val[0], real);
+                                rb.val[1] = vsubq_f32(va.val[1], imag);
+
+                                vst2q_f32(a + j * 2, ra);
+                                vst2q_f32(b + j * 2, rb);
+                            }
+#elif defined(__SSE__)
+                            const __m128 signs = _mm_setr_ps(-1.0F, 1.0F, -1.0F, 1.0F);
+
+                            for (; j + 2 <= half; j += 2)
+                            {
+                                __m128 va = _mm_loadu_ps(a + j * 2);
+                                __m128 vb = _mm_loadu_ps(b + j * 2);
+                                __m128 vw = _mm_loadu_ps(w + j * 2);
+
+                                __m128 real = _mm_shuffle_ps(vw, vw, _MM_SHUFFLE(2, 2, 0, 0));
+                                __m128 imag = _mm_shuffle_ps(vw, vw, _MM_SHUFFLE(3, 3, 1, 1));
+                                __m128 swapped = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1));
+                                __m128 t = _mm_add_ps(_mm_mul_ps(vb, real), _mm_mul_ps(_mm_mul_ps(swapped, imag), signs));
+
+                                _mm_storeu_ps(a + j * 2, _mm_add_ps(va, t));
+                                _mm_storeu_ps(b + j * 2, _mm_sub_ps(va, t));
+                            }
+#endif
+                        }
+
+                        for (; j < half; ++j)
+                        {
+                            float real = b[j * 2 + 0] * w[j * 2 + 0] - b[j * 2 + 1] * w[j * 2 + 1];
+                            float imag = b[j * 2 + 1] * w[j * 2 + 0] + b[j * 2 + 0] * w[j * 2 + 1];
+
+                            b[j * 2 + 0] = a[j * 2 + 0] - real;
+                            b[j * 2 + 1] = a[j * 2 + 1] - imag;
+                            a[j * 2 + 0] += real;
+                            a[j * 2 + 1] += imag;
+                        }
+                    }
+                }
+            }
+
+            RealFFT::RealFFT(uint32_t initSize)
+            {
+                resize(initSize);
+            }
+
+            void RealFFT::resize(uint32_t newSize)
+            {
+                if (newSize == size) return;
+
+                if (newSize == 1 || (newSize && !isPowerOfTwo(newSize)))
+                    throw std::runtime_error("FFT size must be a power of two");
+
+                size = newSize;
+                fft.resize(size / 2);
+                workBuffer.resize(size);
+
+                twiddles.resize(size ? (size / 2 + 1) * 2 : 0);
+                for (uint32_t k = 0; k <= size / 2 && size; ++k)
+                {
+                    double angle = 2.0 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(size);
+                    twiddles[k * 2 + 0] = static_cast<float>(cos(angle));
+                    twiddles[k * 2 + 1] = static_cast<float>(-sin(angle));
+                }
+            }
+
+            void RealFFT::forward(const float* input, float* output)
+            {
+                const uint32_t half = size / 2;
+
+                // even samples are packed into the real and odd samples into the imaginary parts
+                std::copy(input, input + size, workBuffer.begin());
+                fft.forward(workBuffer.data());
+
+                for (uint32_t k = 0; k <= half; ++k)
+                {
+                    uint32_t i = (k == half) ? 0 : k;
+                    uint32_t c = (k == 0) ? 0 : half - k;
+
+                    float zReal = workBuffer[i * 2 + 0];
+                    float zImag = workBuffer[i * 2 + 1];
+                    float cReal = workBuffer[c * 2 + 0];
+                    float cImag = -workBuffer[c * 2 + 1];
+
+                    // spectra of the even and odd samples
+                    float evenReal = (zReal + cReal) * 0.5F;
+                    float evenImag = (zImag + cImag) * 0.5F;
+                    float oddReal = (zImag - cImag) * 0.5F;
+                    float oddImag = -(zReal - cReal) * 0.5F;
+
+                    float wReal = twiddles[k * 2 + 0];
+                    float wImag = twiddles[k * 2 + 1];
+
+                    output[k * 2 + 0] = evenReal + oddReal * wReal - oddImag * wImag;
+                    output[k * 2 + 1] = evenImag + oddReal * wImag + oddImag * wReal;
+                }
+            }
+
+            void RealFFT::inverse(const float* input, float* output)
+            {
+                const uint32_t half = size / 2;
+
+                for (uint32_t k = 0; k < half; ++k)
+                {
+                    float xReal = input[k * 2 + 0];
+                    float xImag = input[k * 2 + 1];
+                    float cReal = input[(half - k) * 2 + 0];
+                    float cImag = -input[(half - k) * 2 + 1];
+
+                    float evenReal = (xReal + cReal) * 0.5F;
+                    float evenImag = (xImag + cImag) * 0.5F;
+                    float diffReal = (xReal - cReal) * 0.5F;
+                    float diffImag = (xImag - cImag) * 0.5F;
+
+                    // multiply by the conjugated twiddle
+                    float wReal = twiddles[k * 2 + 0];
+                    float wImag = -twiddles[k * 2 + 1];
+                    float oddReal = diffReal * wReal - diffImag * wImag;
+                    float oddImag = diffReal * wImag + diffImag * wReal;
+
+                    workBuffer[k * 2 + 0] = evenReal - oddImag;
+                    workBuffer[k * 2 + 1] = evenImag + oddReal;
+                }
+
+                fft.inverse(workBuffer.data());
+
+                const float scale = 1.0F / static_cast<float>(half);
+                for (uint32_t i = 0; i < size; ++i)
+                    output[i] = workBuffer[i] * scale;
+            }
+
+            void complexMultiplyAdd(const float* a, const float* b, uint32_t bins, float* result)
+            {
+                uint32_t bin = 0;
+
+                if (isSimdAvailable)
+                {
+#if defined(__ARM_NEON__)
+                    for (; bin + 4 <= bins; bin += 4)
+                    {
+                        float32x4x2_t va = vld2q_f32(a + bin * 2);
+                        float32x4x2_t vb = vld2q_f32(b + bin * 2);
+                        float32x4x2_t vr = vld2q_f32(result + bin * 2);
+
+                        vr.val[0] = vmlsq_f32(vmlaq_f32(vr.val[0], va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+                        vr.val[1] = vmlaq_f32(vmlaq_f32(vr.val[1], va.val[0], vb.val[1]), va.val[1], vb.val[0]);
+
+                        vst2q_f32(result + bin * 2, vr);
+                    }
+#elif defined(__SSE__)
+                    const __m128 signs = _mm_setr_ps(-1.0F, 1.0F, -1.0F, 1.0F);
+
+                    for (; bin + 2 <= bins; bin += 2)
+                    {
+                        __m128 va = _mm_loadu_ps(a + bin * 2);
+                        __m128 vb = _mm_loadu_ps(b + bin * 2);
+
+                        __m128 real = _mm_shuffle_ps(va, va, _MM_SHUFFLE(2, 2, 0, 0));
+                        __m128 imag = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 3, 1, 1));
+                        __m128 swapped = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1));
+                        __m128 t = _mm_add_ps(_mm_mul_ps(vb, real), _mm_mul_ps(_mm_mul_ps(swapped, imag), signs));
+
+                        _mm_storeu_ps(result + bin * 2, _mm_add_ps(_mm_loadu_ps(result + bin * 2), t));
+                    }
+#endif
+                }
+
+                for (; bin < bins; ++bin)
+                {
+                    result[bin * 2 + 0] += a[bin * 2 + 0] * b[bin * 2 + 0] - a[bin * 2 + 1] * b[bin * 2 + 1];
+                    result[bin * 2 + 1] += a[bin * 2 + 0] * b[bin * 2 + 1] + a[bin * 2 + 1] * b[bin * 2 + 0];
+                }
+            }
+        }
+    } // namespace audio
+} // namespace ouzel
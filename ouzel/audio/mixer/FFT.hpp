@@ -0,0 +1,66 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_AUDIO_MIXER_FFT_HPP
+#define OUZEL_AUDIO_MIXER_FFT_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace ouzel
+{
+    namespace audio
+    {
+        namespace mixer
+        {
+            // radix-2 complex FFT with precomputed bit reversal and twiddle tables
+            // the data is stored as interleaved (real, imaginary) pairs
+            class FFT final
+            {
+            public:
+                explicit FFT(uint32_t initSize = 0);
+
+                uint32_t getSize() const { return size; }
+                void resize(uint32_t newSize);
+
+                void forward(float* data) const;
+                // not normalized, the result is multiplied by the size
+                void inverse(float* data) const;
+
+            private:
+                void transform(float* data, const std::vector<float>& twiddles) const;
+
+                uint32_t size = 0;
+                std::vector<uint32_t> bitReversal;
+                // twiddles of every stage are stored contiguously (stage with the half size m starts at m - 1)
+                std::vector<float> forwardTwiddles;
+                std::vector<float> inverseTwiddles;
+            };
+
+            // FFT of real signals, computed with a complex FFT of the half size
+            // the spectrum consists of size / 2 + 1 complex bins (size + 2 floats)
+            class RealFFT final
+            {
+            public:
+                explicit RealFFT(uint32_t initSize = 0);
+
+                uint32_t getSize() const { return size; }
+                void resize(uint32_t newSize);
+
+                void forward(const float* input, float* output);
+                // normalized
+                void inverse(const float* input, float* output);
+
+            private:
+                uint32_t size = 0;
+                FFT fft;
+                std::vector<float> twiddles;
+                std::vector<float> workBuffer;
+            };
+
+            // result += a * b for bins complex numbers
+            void complexMultiplyAdd(const float* a, const float* b, uint32_t bins, float* result);
+        }
+    } // namespace audio
+} // namespace ouzel
+
+#endif // OUZEL_AUDIO_MIXER_FFT_HPP
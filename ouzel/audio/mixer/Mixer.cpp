@@ -1,10 +1,12 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
+#include <algorithm>
 #include "Mixer.hpp"
 #include "Bus.hpp"
 #include "Source.hpp"
 #include "SourceData.hpp"
 #include "math/MathUtils.hpp"
+#include "utils/Profiler.hpp"
 
 namespace ouzel
 {
@@ -42,6 +44,9 @@ namespace ouzel
                         {
                             DeleteObjectCommand* deleteObjectCommand = static_cast<DeleteObjectCommand*>(command.get());
                             objects[deleteObjectCommand->objectId - 1].reset();
+
+                            auto i = std::find(busIds.begin(), busIds.end(), deleteObjectCommand->objectId);
+                            if (i != busIds.end()) busIds.erase(i);
                             break;
                         }
                         case Command::Type::INIT_BUS:
@@ -52,6 +57,7 @@ namespace ouzel
                                 objects.resize(initBusCommand->busId);
 
                             objects[initBusCommand->busId - 1].reset(new Bus());
+                            busIds.push_back(initBusCommand->busId);
                             break;
                         }
                         case Command::Type::SET_BUS_OUTPUT:
@@ -62,6 +68,25 @@ namespace ouzel
                             bus->setOutput(setBusOutputCommand->outputBusId ? static_cast<Bus*>(objects[setBusOutputCommand->outputBusId - 1].get()) : nullptr);
                             break;
                         }
+                        case Command::Type::SET_BUS_MAX_VOICES:
+                        {
+                            SetBusMaxVoicesCommand* setBusMaxVoicesCommand = static_cast<SetBusMaxVoicesCommand*>(command.get());
+
+                            Bus* bus = static_cast<Bus*>(objects[setBusMaxVoicesCommand->busId - 1].get());
+                            bus->setMaxVoices(setBusMaxVoicesCommand->maxVoices);
+                            break;
+                        }
+                        case Command::Type::SET_BUS_LISTENER:
+                        {
+                            SetBusListenerCommand* setBusListenerCommand = static_cast<SetBusListenerCommand*>(command.get());
+
+                            Bus* bus = static_cast<Bus*>(objects[setBusListenerCommand->busId - 1].get());
+                            if (setBusListenerCommand->active)
+                                bus->setListener(setBusListenerCommand->listener);
+                            else
+                                bus->removeListener();
+                            break;
+                        }
                         case Command::Type::ADD_PROCESSOR:
                         {
                             AddProcessorCommand* addProcessorCommand = static_cast<AddProcessorCommand*>(command.get());
@@ -87,6 +112,13 @@ namespace ouzel
                             masterBus = setMasterBusCommand->busId ? static_cast<Bus*>(objects[setMasterBusCommand->busId - 1].get()) : nullptr;
                             break;
                         }
+                        case Command::Type::SET_MAX_VOICES:
+                        {
+                            SetMaxVoicesCommand* setMaxVoicesCommand = static_cast<SetMaxVoicesCommand*>(command.get());
+
+                            maxVoices = setMaxVoicesCommand->maxVoices;
+                            break;
+                        }
                         case Command::Type::INIT_SOURCE:
                         {
                             InitSourceCommand* initSourceCommand = static_cast<InitSourceCommand*>(command.get());
@@ -114,6 +146,44 @@ namespace ouzel
                             source->stop(stopSourceCommand->reset);
                             break;
                         }
+                        case Command::Type::SET_SOURCE_PRIORITY:
+                        {
+                            SetSourcePriorityCommand* setSourcePriorityCommand = static_cast<SetSourcePriorityCommand*>(command.get());
+
+                            Source* source = static_cast<Source*>(objects[setSourcePriorityCommand->sourceId - 1].get());
+                            source->setPriority(setSourcePriorityCommand->priority);
+                            break;
+                        }
+                        case Command::Type::SET_SOURCE_VOLUME:
+                        {
+                            SetSourceVolumeCommand* setSourceVolumeCommand = static_cast<SetSourceVolumeCommand*>(command.get());
+
+                            Source* source = static_cast<Source*>(objects[setSourceVolumeCommand->sourceId - 1].get());
+                            source->setVolume(setSourceVolumeCommand->volume);
+                            break;
+                        }
+                        case Command::Type::SET_SOURCE_POSITION:
+                        {
+                            SetSourcePositionCommand* setSourcePositionCommand = static_cast<SetSourcePositionCommand*>(command.get());
+
+                            Source* source = static_cast<Source*>(objects[setSourcePositionCommand->sourceId - 1].get());
+                            source->setPosition(setSourcePositionCommand->position);
+                            source->setVelocity(setSourcePositionCommand->velocity);
+                            break;
+                        }
+                        case Command::Type::SET_SOURCE_SPATIALIZATION:
+                        {
+                            SetSourceSpatializationCommand* setSourceSpatializationCommand = static_cast<SetSourceSpatializationCommand*>(command.get());
+
+                            Source* source = static_cast<Source*>(objects[setSourceSpatializationCommand->sourceId - 1].get());
+                            source->setSpatialized(setSourceSpatializationCommand->spatialized);
+                            source->setDistanceModel(setSourceSpatializationCommand->distanceModel);
+                            source->setRolloffFactor(setSourceSpatializationCommand->rolloffFactor);
+                            source->setMinDistance(setSourceSpatializationCommand->minDistance);
+                            source->setMaxDistance(setSourceSpatializationCommand->maxDistance);
+                            source->setDopplerFactor(setSourceSpatializationCommand->dopplerFactor);
+                            break;
+                        }
                         case Command::Type::INIT_SOURCE_DATA:
                         {
                             InitSourceDataCommand* initSourceDataCommand = static_cast<InitSourceDataCommand*>(command.get());
@@ -158,16 +228,57 @@ namespace ouzel
 
             void Mixer::getData(uint32_t frames, uint16_t channels, uint32_t sampleRate, std::vector<float>& samples)
             {
+                OUZEL_PROFILE_ZONE("Mixer::getData");
+
+                const auto startTime = std::chrono::steady_clock::now();
+
                 if (masterBus)
                 {
-                    Vector3<float> listenerPosition;
-                    Quaternion<float> listenerRotation;
+                    realSources.clear();
+                    uint32_t playingCount = masterBus->selectVoices(listener, realSources);
+
+                    if (maxVoices && realSources.size() > maxVoices)
+                    {
+                        std::nth_element(realSources.begin(), realSources.begin() + maxVoices, realSources.end(),
+                                         [](const Source* a, const Source* b) {
+                                             return a->isMoreImportantThan(*b);
+                                         });
+
+                        for (auto i = realSources.begin() + maxVoices; i != realSources.end(); ++i)
+                            (*i)->virtualSource = true;
+
+                        realSources.resize(maxVoices);
+                    }
 
-                    masterBus->getData(frames, channels, sampleRate, listenerPosition, listenerRotation, samples);
+                    for (Source* source : realSources)
+                        source->virtualSource = false;
+
+                    realVoiceCount = static_cast<uint32_t>(realSources.size());
+                    virtualVoiceCount = playingCount - static_cast<uint32_t>(realSources.size());
+
+                    masterBus->getData(frames, channels, sampleRate, listener, samples);
+                }
+                else
+                {
+                    samples.resize(frames * channels);
+                    std::fill(samples.begin(), samples.end(), 0.0F);
                 }
 
                 for (float& f : samples)
                     f = clamp(f, -1.0F, 1.0F);
+
+                processingTime = (std::chrono::steady_clock::now() - startTime).count();
+            }
+
+            void Mixer::getBusProcessingTimes(std::vector<std::pair<uintptr_t, std::chrono::steady_clock::duration>>& result) const
+            {
+                result.clear();
+
+                for (uintptr_t busId : busIds)
+                {
+                    const Bus* bus = static_cast<const Bus*>(objects[busId - 1].get());
+                    result.push_back(std::make_pair(busId, bus->getProcessingTime()));
+                }
             }
         }
     } // namespace audio
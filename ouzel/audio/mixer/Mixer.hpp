@@ -3,6 +3,8 @@
 #ifndef OUZEL_AUDIO_MIXER_MIXER_HPP
 #define OUZEL_AUDIO_MIXER_MIXER_HPP
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
@@ -72,6 +74,20 @@ namespace ouzel
                     deletedObjectIds.insert(objectId);
                 }
 
+                // number of sources mixed and virtualized during the last getData call
+                uint32_t getRealVoiceCount() const { return realVoiceCount; }
+                uint32_t getVirtualVoiceCount() const { return virtualVoiceCount; }
+
+                // duration of the last getData call
+                std::chrono::steady_clock::duration getProcessingTime() const
+                {
+                    return std::chrono::steady_clock::duration(processingTime.load());
+                }
+
+                // time spent by every bus (excluding its inputs) in the last getData call
+                // must be called from the thread that calls getData
+                void getBusProcessingTimes(std::vector<std::pair<uintptr_t, std::chrono::steady_clock::duration>>& result) const;
+
             private:
                 std::function<void(const Event&)> callback;
 
@@ -81,6 +97,14 @@ namespace ouzel
                 std::vector<std::unique_ptr<Object>> objects;
 
                 Bus* masterBus = nullptr;
+                ListenerState listener; // default listener for buses without one
+                uint32_t maxVoices = 0;
+                std::vector<Source*> realSources;
+                std::atomic<uint32_t> realVoiceCount{0};
+                std::atomic<uint32_t> virtualVoiceCount{0};
+                std::atomic<std::chrono::steady_clock::rep> processingTime{0};
+                std::vector<uintptr_t> busIds;
+
                 std::mutex commandMutex;
                 std::condition_variable commandConditionVariable;
                 std::queue<std::unique_ptr<Command>> commandQueue;
@@ -0,0 +1,213 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_AUDIO_MIXER_PITCHSHIFT_HPP
+#define OUZEL_AUDIO_MIXER_PITCHSHIFT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "audio/mixer/FFT.hpp"
+#include "math/MathUtils.hpp"
+
+// the pitch shifter of external/smbPitchShift with the transform done by mixer::FFT and a cached window
+// COPYRIGHT 1999-2015 Stephan M. Bernsee <s.bernsee [AT] zynaptiq [DOT] com>, The Wide Open License (WOL)
+// Permission to use, copy, modify, distribute and sell this software and its
+// documentation for any purpose is hereby granted without fee, provided that
+// the above copyright notice and this license appear in all source copies.
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY OF
+// ANY KIND. See http://www.dspguru.com/wol.htm for more information.
+
+namespace ouzel
+{
+    namespace audio
+    {
+        namespace mixer
+        {
+            static constexpr unsigned long MAX_PITCH_SHIFT_FRAME_LENGTH = 8192;
+
+            class PitchShift final
+            {
+            public:
+                PitchShift()
+                {
+                    std::fill(std::begin(inFifo), std::end(inFifo), 0.0F);
+                    std::fill(std::begin(outFifo), std::end(outFifo), 0.0F);
+                    std::fill(std::begin(fftWorksp), std::end(fftWorksp), 0.0F);
+                    std::fill(std::begin(lastPhase), std::end(lastPhase), 0.0F);
+                    std::fill(std::begin(sumPhase), std::end(sumPhase), 0.0F);
+                    std::fill(std::begin(outputAccum), std::end(outputAccum), 0.0F);
+                    std::fill(std::begin(anaFreq), std::end(anaFreq), 0.0F);
+                    std::fill(std::begin(anaMagn), std::end(anaMagn), 0.0F);
+                }
+
+                // shifts the pitch by a factor between 0.5 and 2 while maintaining the duration (short time Fourier transform),
+                // fftFrameSize must be a power of two not larger than MAX_PITCH_SHIFT_FRAME_LENGTH, oversamp is the overlap of the frames
+                // and should be at least 4, the buffers can be the same
+                void process(float pitchShift, unsigned long numSampsToProcess, unsigned long fftFrameSize,
+                             unsigned long oversamp, float sampleRate, float* indata, float* outdata)
+                {
+                    // set up some handy variables
+                    unsigned long fftFrameSizeHalf = fftFrameSize / 2;
+                    unsigned long stepSize = fftFrameSize / oversamp;
+                    float freqPerBin = sampleRate / static_cast<float>(fftFrameSize);
+                    float expected = 2.0F * PI * static_cast<float>(stepSize) / static_cast<float>(fftFrameSize);
+                    unsigned long inFifoLatency = fftFrameSize - stepSize;
+                    if (rover == 0) rover = inFifoLatency;
+
+                    // the FFT tables and the window are computed only when the frame size changes
+                    if (fft.getSize() != fftFrameSize)
+                    {
+                        fft.resize(static_cast<uint32_t>(fftFrameSize));
+                        window.resize(fftFrameSize);
+                        for (unsigned long k = 0; k < fftFrameSize; k++)
+                            window[k] = -0.5F * std::cos(2.0F * PI * static_cast<float>(k) / static_cast<float>(fftFrameSize)) + 0.5F;
+                    }
+
+                    // main processing loop
+                    for (unsigned long i = 0; i < numSampsToProcess; i++)
+                    {
+                        // As long as we have not yet collected enough data just read in
+                        inFifo[rover] = indata[i];
+                        outdata[i] = outFifo[rover - inFifoLatency];
+                        rover++;
+
+                        // now we have enough data for processing
+                        if (rover >= fftFrameSize)
+                        {
+                            rover = inFifoLatency;
+
+                            // do windowing and re,im interleave
+                            for (unsigned long k = 0; k < fftFrameSize; k++)
+                            {
+                                fftWorksp[2 * k] = inFifo[k] * window[k];
+                                fftWorksp[2 * k + 1] = 0.0F;
+                            }
+
+                            // ***************** ANALYSIS *******************
+                            // do transform
+                            fft.forward(fftWorksp);
+
+                            // this is the analysis step
+                            for (unsigned long k = 0; k <= fftFrameSizeHalf; k++)
+                            {
+                                // de-interlace FFT buffer
+                                float real = fftWorksp[2 * k];
+                                float imag = fftWorksp[2 * k + 1];
+
+                                // compute magnitude and phase
+                                float magn = 2.0F * sqrtf(real * real + imag * imag);
+
+                                float phase;
+                                float signx = (imag > 0.0F) ? 1.0F : -1.0F;
+                                if (imag == 0.0F) phase = 0.0F;
+                                else if (real == 0.0F) phase = signx * PI / 2.0F;
+                                else phase = std::atan2(imag, real);
+
+                                // compute phase difference
+                                float tmp = phase - lastPhase[k];
+                                lastPhase[k] = phase;
+
+                                // subtract expected phase difference
+                                tmp -= static_cast<float>(k) * expected;
+
+                                // map delta phase into +/- Pi interval
+                                long qpd = static_cast<long>(tmp / PI);
+                                if (qpd >= 0) qpd += qpd & 1;
+                                else qpd -= qpd & 1;
+                                tmp -= PI * static_cast<float>(qpd);
+
+                                // get deviation from bin frequency from the +/- Pi interval
+                                tmp = oversamp * tmp / (2.0F * PI);
+
+                                // compute the k-th partials' true frequency
+                                tmp = static_cast<float>(k) * freqPerBin + tmp * freqPerBin;
+
+                                // store magnitude and true frequency in analysis arrays
+                                anaMagn[k] = magn;
+                                anaFreq[k] = tmp;
+                            }
+
+                            // ***************** PROCESSING *******************
+                            // this does the actual pitch shifting
+                            std::fill(std::begin(synMagn), std::begin(synMagn) + fftFrameSize, 0.0F);
+                            std::fill(std::begin(synFreq), std::begin(synFreq) + fftFrameSize, 0.0F);
+                            for (unsigned long k = 0; k <= fftFrameSizeHalf; k++)
+                            {
+                                unsigned long index = static_cast<unsigned long>(k * pitchShift);
+                                if (index > fftFrameSizeHalf) break;
+                                synMagn[index] += anaMagn[k];
+                                synFreq[index] = anaFreq[k] * pitchShift;
+                            }
+
+                            // ***************** SYNTHESIS *******************
+                            // this is the synthesis step
+                            for (unsigned long k = 0; k <= fftFrameSizeHalf; k++)
+                            {
+                                // get magnitude and true frequency from synthesis arrays
+                                float magn = synMagn[k];
+                                float tmp = synFreq[k];
+
+                                // subtract bin mid frequency
+                                tmp -= static_cast<float>(k) * freqPerBin;
+
+                                // get bin deviation from freq deviation
+                                tmp /= freqPerBin;
+
+                                // take oversampling factor into account
+                                tmp = 2.0F * PI * tmp / oversamp;
+
+                                // add the overlap phase advance back in
+                                tmp += static_cast<float>(k) * expected;
+
+                                // accumulate delta phase to get bin phase
+                                sumPhase[k] += tmp;
+                                float phase = sumPhase[k];
+
+                                // get real and imag part and re-interleave
+                                fftWorksp[2 * k] = magn * std::cos(phase);
+                                fftWorksp[2 * k + 1] = magn * std::sin(phase);
+                            }
+
+                            // zero negative frequencies
+                            for (unsigned long k = fftFrameSizeHalf + 1; k < fftFrameSize; k++) fftWorksp[2 * k] = fftWorksp[2 * k + 1] = 0.0F;
+
+                            // do inverse transform
+                            fft.inverse(fftWorksp);
+
+                            // do windowing and add to output accumulator
+                            for (unsigned long k = 0; k < fftFrameSize; k++)
+                                outputAccum[k] += 2.0F * window[k] * fftWorksp[2 * k] / (fftFrameSizeHalf * oversamp);
+                            unsigned long k;
+                            for (k = 0 ; k < stepSize; k++) outFifo[k] = outputAccum[k];
+                            // shift accumulator
+                            unsigned long j;
+                            for (j = 0; k < fftFrameSize; k++, j++) outputAccum[j] = outputAccum[k];
+                            for (; j < fftFrameSize; j++) outputAccum[j] = 0.0;
+
+                            // move input FIFO
+                            for (k = 0; k < inFifoLatency; k++) inFifo[k] = inFifo[k + stepSize];
+                        }
+                    }
+                }
+
+            private:
+                float inFifo[MAX_PITCH_SHIFT_FRAME_LENGTH];
+                float outFifo[MAX_PITCH_SHIFT_FRAME_LENGTH];
+                float fftWorksp[2 * MAX_PITCH_SHIFT_FRAME_LENGTH];
+                float lastPhase[MAX_PITCH_SHIFT_FRAME_LENGTH / 2 + 1];
+                float sumPhase[MAX_PITCH_SHIFT_FRAME_LENGTH / 2 + 1];
+                float outputAccum[2 * MAX_PITCH_SHIFT_FRAME_LENGTH];
+                float anaFreq[MAX_PITCH_SHIFT_FRAME_LENGTH];
+                float anaMagn[MAX_PITCH_SHIFT_FRAME_LENGTH];
+                float synFreq[MAX_PITCH_SHIFT_FRAME_LENGTH];
+                float synMagn[MAX_PITCH_SHIFT_FRAME_LENGTH];
+                unsigned long rover = 0;
+                FFT fft;
+                std::vector<float> window;
+            };
+        }
+    } // namespace audio
+} // namespace ouzel
+
+#endif // OUZEL_AUDIO_MIXER_PITCHSHIFT_HPP
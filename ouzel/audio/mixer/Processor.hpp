@@ -30,8 +30,13 @@ namespace ouzel
                 virtual void process(uint32_t frames, uint16_t channels, uint32_t sampleRate,
                                      std::vector<float>& samples) = 0;
 
+            protected:
+                // listener of the bus that the processor is attached to, updated before every process call
+                const ListenerState& getListener() const { return listener; }
+
             private:
                 Bus* bus = nullptr;
+                ListenerState listener;
             };
         }
     } // namespace audio
@@ -38,6 +38,37 @@ namespace ouzel
                 playing = false;
                 if (shouldReset) reset();
             }
+
+            // real sources get an advantage so that equally audible sources don't keep swapping
+            static constexpr float REAL_SOURCE_AUDIBILITY_BIAS = 1.1F;
+
+            bool Source::isMoreImportantThan(const Source& other) const
+            {
+                if (priority != other.priority)
+                    return priority > other.priority;
+
+                float audibility = getAudibility();
+                if (!virtualSource) audibility *= REAL_SOURCE_AUDIBILITY_BIAS;
+
+                float otherAudibility = other.getAudibility();
+                if (!other.virtualSource) otherAudibility *= REAL_SOURCE_AUDIBILITY_BIAS;
+
+                return audibility > otherAudibility;
+            }
+
+            void Source::setSpatialized(bool newSpatialized)
+            {
+                spatialized = newSpatialized;
+                gainsValid = false;
+                if (!spatialized) attenuation = 1.0F;
+            }
+
+            void Source::updateAttenuation(const ListenerState& listener)
+            {
+                if (spatialized)
+                    attenuation = getDistanceAttenuation(distanceModel, position.distance(listener.position),
+                                                         minDistance, maxDistance, rolloffFactor);
+            }
         }
     } // namespace audio
 } // namespace ouzel
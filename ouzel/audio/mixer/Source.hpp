@@ -3,7 +3,10 @@
 #ifndef OUZEL_AUDIO_MIXER_SOURCE_HPP
 #define OUZEL_AUDIO_MIXER_SOURCE_HPP
 
+#include <cfloat>
+#include <vector>
 #include "audio/mixer/Object.hpp"
+#include "audio/mixer/Spatializer.hpp"
 
 namespace ouzel
 {
@@ -12,11 +15,13 @@ namespace ouzel
         namespace mixer
         {
             class Bus;
+            class Mixer;
             class SourceData;
 
             class Source: public Object
             {
                 friend Bus;
+                friend Mixer;
             public:
                 Source(SourceData& initSourceData);
                 ~Source();
@@ -25,6 +30,9 @@ namespace ouzel
 
                 virtual void getData(uint32_t frames, std::vector<float>& samples) = 0;
 
+                // advances the playback position without decoding (used for virtual sources)
+                virtual void skip(uint32_t frames) = 0;
+
                 void setOutput(Bus* newOutput);
 
                 bool isPlaying() const { return playing; }
@@ -34,11 +42,70 @@ namespace ouzel
                 void stop(bool shouldReset);
                 virtual void reset() = 0;
 
+                int32_t getPriority() const { return priority; }
+                void setPriority(int32_t newPriority) { priority = newPriority; }
+
+                float getVolume() const { return volume; }
+                void setVolume(float newVolume) { volume = newVolume; }
+
+                // estimated loudness of the source used for voice stealing
+                virtual float getAudibility() const { return volume * attenuation; }
+
+                bool isVirtual() const { return virtualSource; }
+
+                // compares priority first and then audibility
+                bool isMoreImportantThan(const Source& other) const;
+
+                // spatialized sources are downmixed to mono and panned according to their position relative to the listener
+                bool isSpatialized() const { return spatialized; }
+                void setSpatialized(bool newSpatialized);
+
+                const Vector3<float>& getPosition() const { return position; }
+                void setPosition(const Vector3<float>& newPosition) { position = newPosition; }
+
+                const Vector3<float>& getVelocity() const { return velocity; }
+                void setVelocity(const Vector3<float>& newVelocity) { velocity = newVelocity; }
+
+                DistanceModel getDistanceModel() const { return distanceModel; }
+                void setDistanceModel(DistanceModel newDistanceModel) { distanceModel = newDistanceModel; }
+
+                float getRolloffFactor() const { return rolloffFactor; }
+                void setRolloffFactor(float newRolloffFactor) { rolloffFactor = newRolloffFactor; }
+
+                float getMinDistance() const { return minDistance; }
+                void setMinDistance(float newMinDistance) { minDistance = newMinDistance; }
+
+                float getMaxDistance() const { return maxDistance; }
+                void setMaxDistance(float newMaxDistance) { maxDistance = newMaxDistance; }
+
+                float getDopplerFactor() const { return dopplerFactor; }
+                void setDopplerFactor(float newDopplerFactor) { dopplerFactor = newDopplerFactor; }
+
+                // recalculates the distance attenuation (called once per block before the voice selection)
+                void updateAttenuation(const ListenerState& listener);
+
             protected:
                 SourceData& sourceData;
                 Bus* output = nullptr;
                 bool playing = false;
                 bool repeating = false;
+                bool virtualSource = false;
+                int32_t priority = 0;
+                float volume = 1.0F;
+
+                bool spatialized = false;
+                Vector3<float> position;
+                Vector3<float> velocity;
+                DistanceModel distanceModel = DistanceModel::INVERSE;
+                float rolloffFactor = 1.0F;
+                float minDistance = 1.0F;
+                float maxDistance = FLT_MAX;
+                float dopplerFactor = 1.0F;
+                float attenuation = 1.0F;
+
+                // channel gains of the previous block, used to ramp the gains
+                bool gainsValid = false;
+                std::vector<float> gains;
             };
         }
     } // namespace audio
@@ -0,0 +1,269 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#if defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#elif defined(__SSE__)
+#  include <xmmintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include "Spatializer.hpp"
+#include "math/MathUtils.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        namespace mixer
+        {
+            static constexpr float MIN_DOPPLER_PITCH = 0.5F;
+            static constexpr float MAX_DOPPLER_PITCH = 2.0F;
+
+            float getDistanceAttenuation(DistanceModel distanceModel, float distance,
+                                         float minDistance, float maxDistance, float rolloffFactor)
+            {
+                distance = clamp(distance, minDistance, maxDistance);
+
+                switch (distanceModel)
+                {
+                    case DistanceModel::INVERSE:
+                        if (minDistance + rolloffFactor * (distance - minDistance) <= 0.0F) return 1.0F;
+                        return minDistance / (minDistance + rolloffFactor * (distance - minDistance));
+                    case DistanceModel::LINEAR:
+                        if (maxDistance <= minDistance) return 1.0F;
+                        return clamp(1.0F - rolloffFactor * (distance - minDistance) / (maxDistance - minDistance), 0.0F, 1.0F);
+                    case DistanceModel::EXPONENTIAL:
+                        if (minDistance <= 0.0F || distance <= 0.0F) return 1.0F;
+                        return powf(distance / minDistance, -rolloffFactor);
+                    default:
+                        return 1.0F;
+                }
+            }
+
+            struct Speaker
+            {
+                float azimuth; // radians, positive to the right
+                uint16_t channel;
+            };
+
+            // speakers sorted by azimuth (LFE is not used for positioning)
+            static const Speaker QUAD_SPEAKERS[] = {
+                {-0.75F * PI, 2}, // SL
+                {-0.25F * PI, 0}, // L
+                {0.25F * PI, 1}, // R
+                {0.75F * PI, 3} // SR
+            };
+
+            static const Speaker SURROUND_SPEAKERS[] = {
+                {-110.0F * PI / 180.0F, 4}, // SL
+                {-30.0F * PI / 180.0F, 0}, // L
+                {0.0F, 2}, // C
+                {30.0F * PI / 180.0F, 1}, // R
+                {110.0F * PI / 180.0F, 5} // SR
+            };
+
+            template<size_t N>
+            static void panPairwise(float azimuth, const Speaker (&speakers)[N], float* gains)
+            {
+                size_t first = N - 1;
+                size_t second = 0;
+                float span = speakers[0].azimuth + TAU - speakers[N - 1].azimuth;
+                float offset = azimuth - speakers[N - 1].azimuth;
+                if (offset < 0.0F) offset += TAU;
+
+                for (size_t i = 0; i < N - 1; ++i)
+                {
+                    if (azimuth >= speakers[i].azimuth && azimuth < speakers[i + 1].azimuth)
+                    {
+                        first = i;
+                        second = i + 1;
+                        span = speakers[i + 1].azimuth - speakers[i].azimuth;
+                        offset = azimuth - speakers[i].azimuth;
+                        break;
+                    }
+                }
+
+                float t = clamp(offset / span, 0.0F, 1.0F) * PI / 2.0F;
+                gains[speakers[first].channel] = cosf(t);
+                gains[speakers[second].channel] = sinf(t);
+            }
+
+            void getPanningGains(const Vector3<float>& direction, float minDistance,
+                                 uint16_t channels, float* gains)
+            {
+                std::fill(gains, gains + channels, 0.0F);
+
+                if (channels == 1)
+                {
+                    gains[0] = 1.0F;
+                    return;
+                }
+
+                // the panning is done in the horizontal plane of the listener (x is right, z is forward)
+                float horizontalDistance = sqrtf(direction.v[0] * direction.v[0] + direction.v[2] * direction.v[2]);
+                uint16_t speakerCount = channels;
+
+                if (horizontalDistance > 0.0F)
+                {
+                    float azimuth = atan2f(direction.v[0], direction.v[2]);
+
+                    switch (channels)
+                    {
+                        case 2:
+                        {
+                            float angle = (direction.v[0] / horizontalDistance + 1.0F) * PI / 4.0F;
+                            gains[0] = cosf(angle);
+                            gains[1] = sinf(angle);
+                            break;
+                        }
+                        case 4:
+                            panPairwise(azimuth, QUAD_SPEAKERS, gains);
+                            break;
+                        case 6:
+                            panPairwise(azimuth, SURROUND_SPEAKERS, gains);
+                            speakerCount = 5;
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                else if (channels == 6)
+                    speakerCount = 5;
+
+                // sources close to the listener (or right above it) are spread to all speakers to avoid sudden jumps
+                float directivity = (minDistance > 0.0F) ? clamp(horizontalDistance / minDistance, 0.0F, 1.0F) :
+                    (horizontalDistance > 0.0F ? 1.0F : 0.0F);
+
+                // there are no speaker positions for the other layouts, so the source is spread to all the channels
+                if (channels != 2 && channels != 4 && channels != 6) directivity = 0.0F;
+
+                if (directivity < 1.0F)
+                {
+                    float spread = (1.0F - directivity) / static_cast<float>(speakerCount);
+
+                    for (uint16_t channel = 0; channel < channels; ++channel)
+                    {
+                        if (channels == 6 && channel == 3) continue; // LFE
+                        gains[channel] = sqrtf(directivity * gains[channel] * gains[channel] + spread);
+                    }
+                }
+            }
+
+            float getDopplerPitch(const ListenerState& listener,
+                                  const Vector3<float>& sourcePosition, const Vector3<float>& sourceVelocity,
+                                  float dopplerFactor)
+            {
+                if (dopplerFactor <= 0.0F) return 1.0F;
+
+                Vector3<float> sourceToListener = listener.position - sourcePosition;
+                float distance = sourceToListener.length();
+
+                if (distance <= 0.0F) return 1.0F;
+
+                const float maxVelocity = SPEED_OF_SOUND / dopplerFactor;
+                float listenerVelocity = clamp(listener.velocity.dot(sourceToListener) / distance, -maxVelocity, maxVelocity);
+                float sourceVelocityTowards = clamp(sourceVelocity.dot(sourceToListener) / distance, -maxVelocity, maxVelocity);
+
+                float denominator = SPEED_OF_SOUND - dopplerFactor * sourceVelocityTowards;
+                if (denominator <= 0.0F) return MAX_DOPPLER_PITCH;
+
+                return clamp((SPEED_OF_SOUND - dopplerFactor * listenerVelocity) / denominator,
+                             MIN_DOPPLER_PITCH, MAX_DOPPLER_PITCH);
+            }
+
+            void mixPanned(uint32_t frames, const float* monoSamples, uint16_t channels,
+                           const float* startGains, const float* endGains, float* samples)
+            {
+                if (frames == 0) return;
+
+                const float frameCount = static_cast<float>(frames);
+                uint32_t frame = 0;
+
+                if (isSimdAvailable && (channels == 2 || channels == 4))
+                {
+                    float gains[4];
+                    float steps[4];
+
+                    for (uint16_t channel = 0; channel < channels; ++channel)
+                    {
+                        gains[channel] = startGains[channel];
+                        steps[channel] = (endGains[channel] - startGains[channel]) / frameCount;
+                    }
+
+#if defined(__ARM_NEON__)
+                    if (channels == 2)
+                    {
+                        float32x4_t gain = {gains[0], gains[1], gains[0] + steps[0], gains[1] + steps[1]};
+                        float32x4_t step = {steps[0] * 2.0F, steps[1] * 2.0F, steps[0] * 2.0F, steps[1] * 2.0F};
+
+                        for (; frame + 4 <= frames; frame += 4)
+                        {
+                            float32x4x2_t mono = vzipq_f32(vld1q_f32(monoSamples + frame), vld1q_f32(monoSamples + frame));
+                            float* output = samples + frame * 2;
+
+                            vst1q_f32(output, vmlaq_f32(vld1q_f32(output), mono.val[0], gain));
+                            gain = vaddq_f32(gain, step);
+                            vst1q_f32(output + 4, vmlaq_f32(vld1q_f32(output + 4), mono.val[1], gain));
+                            gain = vaddq_f32(gain, step);
+                        }
+                    }
+                    else if (channels == 4)
+                    {
+                        float32x4_t gain = vld1q_f32(gains);
+                        float32x4_t step = vld1q_f32(steps);
+
+                        for (; frame < frames; ++frame)
+                        {
+                            float* output = samples + frame * 4;
+                            vst1q_f32(output, vmlaq_f32(vld1q_f32(output), vdupq_n_f32(monoSamples[frame]), gain));
+                            gain = vaddq_f32(gain, step);
+                        }
+                    }
+#elif defined(__SSE__)
+                    if (channels == 2)
+                    {
+                        __m128 gain = _mm_setr_ps(gains[0], gains[1], gains[0] + steps[0], gains[1] + steps[1]);
+                        __m128 step = _mm_setr_ps(steps[0] * 2.0F, steps[1] * 2.0F, steps[0] * 2.0F, steps[1] * 2.0F);
+
+                        for (; frame + 4 <= frames; frame += 4)
+                        {
+                            __m128 mono = _mm_loadu_ps(monoSamples + frame);
+                            float* output = samples + frame * 2;
+
+                            _mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(_mm_unpacklo_ps(mono, mono), gain)));
+                            gain = _mm_add_ps(gain, step);
+                            _mm_storeu_ps(output + 4, _mm_add_ps(_mm_loadu_ps(output + 4), _mm_mul_ps(_mm_unpackhi_ps(mono, mono), gain)));
+                            gain = _mm_add_ps(gain, step);
+                        }
+                    }
+                    else if (channels == 4)
+                    {
+                        __m128 gain = _mm_loadu_ps(gains);
+                        __m128 step = _mm_loadu_ps(steps);
+
+                        for (; frame < frames; ++frame)
+                        {
+                            float* output = samples + frame * 4;
+                            _mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(_mm_set1_ps(monoSamples[frame]), gain)));
+                            gain = _mm_add_ps(gain, step);
+                        }
+                    }
+#endif
+                }
+
+                // the frames left by the vectorized loops and the layouts without one
+                for (uint16_t channel = 0; channel < channels; ++channel)
+                {
+                    const float step = (endGains[channel] - startGains[channel]) / frameCount;
+                    float gain = startGains[channel] + step * frame;
+
+                    for (uint32_t f = frame; f < frames; ++f)
+                    {
+                        samples[f * channels + channel] += monoSamples[f] * gain;
+                        gain += step;
+                    }
+                }
+            }
+        }
+    } // namespace audio
+} // namespace ouzel
@@ -0,0 +1,52 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_AUDIO_MIXER_SPATIALIZER_HPP
+#define OUZEL_AUDIO_MIXER_SPATIALIZER_HPP
+
+#include <cstdint>
+#include "math/Quaternion.hpp"
+#include "math/Vector3.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        namespace mixer
+        {
+            static constexpr float SPEED_OF_SOUND = 343.3F; // m/s
+
+            enum class DistanceModel
+            {
+                NONE,
+                INVERSE,
+                LINEAR,
+                EXPONENTIAL
+            };
+
+            class ListenerState final
+            {
+            public:
+                Vector3<float> position;
+                Quaternion<float> rotation = Quaternion<float>::identity();
+                Vector3<float> velocity;
+            };
+
+            float getDistanceAttenuation(DistanceModel distanceModel, float distance,
+                                         float minDistance, float maxDistance, float rolloffFactor);
+
+            // constant-power panning of a point source for mono, stereo, quad and 5.1 outputs, other layouts get an even spread
+            void getPanningGains(const Vector3<float>& direction, float minDistance,
+                                 uint16_t channels, float* gains);
+
+            float getDopplerPitch(const ListenerState& listener,
+                                  const Vector3<float>& sourcePosition, const Vector3<float>& sourceVelocity,
+                                  float dopplerFactor);
+
+            // adds the mono samples to the interleaved output, ramping gains linearly from startGains to endGains
+            void mixPanned(uint32_t frames, const float* monoSamples, uint16_t channels,
+                           const float* startGains, const float* endGains, float* samples);
+        }
+    } // namespace audio
+} // namespace ouzel
+
+#endif // OUZEL_AUDIO_MIXER_SPATIALIZER_HPP
@@ -0,0 +1,195 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include "OfflineAudioDevice.hpp"
+#include "core/Engine.hpp"
+#include "files/FileSystem.hpp"
+#include "utils/Log.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        OfflineAudioDevice::OfflineAudioDevice(mixer::Mixer& initMixer,
+                                               const std::string& initFilename,
+                                               float initClockSpeed,
+                                               float initDuration):
+            AudioDevice(Driver::OFFLINE, initMixer),
+            filename(initFilename),
+            clockSpeed(initClockSpeed),
+            totalFrames(static_cast<uint64_t>(initDuration * sampleRate))
+        {
+            sampleFormat = SampleFormat::FLOAT32;
+
+            if (clockSpeed <= 0.0F && totalFrames == 0)
+                throw std::runtime_error("Offline audio rendering without a clock needs a duration");
+
+            if (!filename.empty())
+            {
+                file = File(filename, File::WRITE | File::CREATE | File::TRUNCATE);
+
+                std::string extension = FileSystem::getExtensionPart(filename);
+                std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+                wave = (extension == "wav");
+
+                if (wave) writeHeader();
+
+                engine->log(Log::Level::INFO) << "Rendering audio to " << filename;
+            }
+
+            running = true;
+            audioThread = std::thread(&OfflineAudioDevice::run, this);
+        }
+
+        OfflineAudioDevice::~OfflineAudioDevice()
+        {
+            running = false;
+            if (audioThread.joinable()) audioThread.join();
+
+            try
+            {
+                if (wave && file.isOpen())
+                {
+                    // update the chunk sizes
+                    file.seek(0, File::BEGIN);
+                    writeHeader();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                engine->log(Log::Level::ERR) << e.what();
+            }
+
+            Statistics result = getStatistics();
+
+            if (result.blocks)
+            {
+                engine->log(Log::Level::INFO) << "Rendered " << result.frames << " audio frames in " << result.blocks << " blocks, " <<
+                    "average block time: " << std::chrono::duration_cast<std::chrono::microseconds>(result.totalBlockTime / result.blocks).count() << "us, " <<
+                    "maximum block time: " << std::chrono::duration_cast<std::chrono::microseconds>(result.maxBlockTime).count() << "us";
+
+                for (const auto& busTime : result.busTimes)
+                    if (busTime.second.blocks)
+                        engine->log(Log::Level::INFO) << "Bus " << busTime.first << " average time: " <<
+                            std::chrono::duration_cast<std::chrono::microseconds>(busTime.second.totalTime / busTime.second.blocks).count() << "us";
+            }
+        }
+
+        OfflineAudioDevice::Statistics OfflineAudioDevice::getStatistics() const
+        {
+            std::lock_guard<std::mutex> lock(statisticsMutex);
+            return statistics;
+        }
+
+        void OfflineAudioDevice::writeHeader()
+        {
+            const uint32_t dataChunkSize = static_cast<uint32_t>(dataSize);
+            const uint16_t bytesPerSample = sizeof(float);
+
+            uint8_t header[44];
+            memcpy(header + 0, "RIFF", 4);
+            encodeUInt32Little(header + 4, 36 + dataChunkSize);
+            memcpy(header + 8, "WAVE", 4);
+            memcpy(header + 12, "fmt ", 4);
+            encodeUInt32Little(header + 16, 16);
+            encodeUInt16Little(header + 20, 3); // IEEE float
+            encodeUInt16Little(header + 22, channels);
+            encodeUInt32Little(header + 24, sampleRate);
+            encodeUInt32Little(header + 28, sampleRate * channels * bytesPerSample);
+            encodeUInt16Little(header + 32, static_cast<uint16_t>(channels * bytesPerSample));
+            encodeUInt16Little(header + 34, bytesPerSample * 8);
+            memcpy(header + 36, "data", 4);
+            encodeUInt32Little(header + 40, dataChunkSize);
+
+            file.write(header, sizeof(header), true);
+        }
+
+        void OfflineAudioDevice::run()
+        {
+            setCurrentThreadName("Audio");
+
+            const std::chrono::steady_clock::duration blockDuration =
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(BLOCK_SIZE / (sampleRate * static_cast<double>(clockSpeed > 0.0F ? clockSpeed : 1.0F))));
+            auto nextBlockTime = std::chrono::steady_clock::now();
+
+            while (running)
+            {
+                try
+                {
+                    if (totalFrames && statistics.frames >= totalFrames)
+                    {
+                        engine->log(Log::Level::INFO) << "Offline audio rendering finished";
+                        break;
+                    }
+
+                    process();
+
+                    getData(BLOCK_SIZE, data);
+
+                    const std::chrono::steady_clock::duration blockTime = mixer.getProcessingTime();
+                    mixer.getBusProcessingTimes(busProcessingTimes);
+
+                    if (file.isOpen())
+                    {
+                        if (wave && dataSize + data.size() > MAX_WAVE_DATA_SIZE)
+                        {
+                            engine->log(Log::Level::WARN) << "Offline audio rendering stopped at the size limit of the WAV format";
+                            break;
+                        }
+
+                        file.write(data.data(), static_cast<uint32_t>(data.size()), true);
+                        dataSize += data.size();
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(statisticsMutex);
+                        ++statistics.blocks;
+                        statistics.frames += BLOCK_SIZE;
+                        statistics.lastBlockTime = blockTime;
+                        statistics.totalBlockTime += blockTime;
+                        if (blockTime > statistics.maxBlockTime) statistics.maxBlockTime = blockTime;
+
+                        // the disconnected buses are dropped
+                        for (auto i = statistics.busTimes.begin(); i != statistics.busTimes.end();)
+                        {
+                            uintptr_t busId = i->first;
+                            if (std::find_if(busProcessingTimes.begin(), busProcessingTimes.end(),
+                                             [busId](const std::pair<uintptr_t, std::chrono::steady_clock::duration>& busProcessingTime) {
+                                                 return busProcessingTime.first == busId;
+                                             }) == busProcessingTimes.end())
+                                i = statistics.busTimes.erase(i);
+                            else
+                                ++i;
+                        }
+
+                        for (const auto& busProcessingTime : busProcessingTimes)
+                        {
+                            Statistics::BusTime& busTime = statistics.busTimes[busProcessingTime.first];
+                            ++busTime.blocks;
+                            busTime.totalTime += busProcessingTime.second;
+                        }
+                    }
+
+                    if (clockSpeed > 0.0F)
+                    {
+                        nextBlockTime += blockDuration;
+                        std::this_thread::sleep_until(nextBlockTime);
+                    }
+                    else
+                        std::this_thread::yield();
+                }
+                catch (const std::exception& e)
+                {
+                    engine->log(Log::Level::ERR) << "Offline audio rendering stopped: " << e.what();
+                    break;
+                }
+            }
+
+            running = false;
+        }
+    } // namespace audio
+} // namespace ouzel
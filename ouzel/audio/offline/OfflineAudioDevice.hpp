@@ -0,0 +1,80 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_AUDIO_OFFLINEAUDIODEVICE_HPP
+#define OUZEL_AUDIO_OFFLINEAUDIODEVICE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "audio/AudioDevice.hpp"
+#include "files/File.hpp"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        // renders the mixer without a sound card, either as fast as possible or at a virtual clock
+        class OfflineAudioDevice final: public AudioDevice
+        {
+        public:
+            class Statistics final
+            {
+            public:
+                uint64_t blocks = 0;
+                uint64_t frames = 0;
+                std::chrono::steady_clock::duration lastBlockTime{0};
+                std::chrono::steady_clock::duration maxBlockTime{0};
+                std::chrono::steady_clock::duration totalBlockTime{0};
+                class BusTime final
+                {
+                public:
+                    uint64_t blocks = 0;
+                    std::chrono::steady_clock::duration totalTime{0};
+                };
+
+                std::map<uintptr_t, BusTime> busTimes; // time spent by the connected buses since they were connected
+            };
+
+            // output is written as WAV if the filename ends with .wav, otherwise as raw 32-bit floats (nothing is written if empty)
+            // clockSpeed is the speed of the virtual clock relative to the real time (0 renders as fast as possible)
+            // duration is the rendered time in seconds (0 renders until the device is destroyed and is allowed only with a virtual clock),
+            // the rendering also stops when a WAV file reaches the 4 GB limit of the format or on an error
+            OfflineAudioDevice(mixer::Mixer& initMixer,
+                               const std::string& initFilename,
+                               float initClockSpeed,
+                               float initDuration = 0.0F);
+            ~OfflineAudioDevice();
+
+            Statistics getStatistics() const;
+            // false when the rendering has stopped
+            inline bool isRunning() const { return running; }
+
+        private:
+            void run();
+            void writeHeader();
+
+            std::string filename;
+            float clockSpeed;
+            uint64_t totalFrames = 0; // 0 for no limit
+            File file;
+            bool wave = false;
+            uint64_t dataSize = 0;
+
+            static constexpr uint32_t BLOCK_SIZE = 1024;
+            static constexpr uint64_t MAX_WAVE_DATA_SIZE = 0xFFFFFFFFU - 36; // the RIFF chunk size is 32-bit
+            std::vector<uint8_t> data;
+            std::vector<std::pair<uintptr_t, std::chrono::steady_clock::duration>> busProcessingTimes;
+
+            mutable std::mutex statisticsMutex;
+            Statistics statistics;
+
+            std::atomic_bool running{false};
+            std::thread audioThread;
+        };
+    } // namespace audio
+} // namespace ouzel
+
+#endif // OUZEL_AUDIO_OFFLINEAUDIODEVICE_HPP
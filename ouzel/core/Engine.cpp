@@ -4,11 +4,13 @@
 #  include <TargetConditionals.h>
 #endif
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include "Setup.h"
 #include "Engine.hpp"
 #include "utils/INI.hpp"
 #include "utils/Log.hpp"
+#include "utils/Profiler.hpp"
 #include "utils/Utils.hpp"
 #include "graphics/Renderer.hpp"
 #include "audio/Audio.hpp"
@@ -91,9 +93,9 @@ namespace ouzel
     {
         if (active)
         {
-            std::unique_ptr<SystemEvent> event(new SystemEvent());
+            std::unique_ptr<SystemEvent> event = EventDispatcher::createEvent<SystemEvent>();
             event->type = Event::Type::ENGINE_STOP;
-            eventDispatcher.postEvent(std::move(event));
+            eventDispatcher.queueEvent(std::move(event));
         }
 
         paused = true;
@@ -109,6 +111,9 @@ namespace ouzel
         }
 #endif
 
+        // the jobs use the file system, the cache and the engine, so the workers are stopped before anything else is destroyed
+        jobSystem.reset();
+
         engine = nullptr;
     }
 
@@ -127,7 +132,16 @@ namespace ouzel
         bool debugRenderer = false;
         bool exclusiveFullscreen = false;
         bool highDpi = true; // should high DPI resolution be used
+        uint32_t framesInFlight = 1;
+        float targetFPS = 0.0F; // 0 disables the frame pacing
         bool debugAudio = false;
+        float audioClockSpeed = 0.0F; // speed of the offline audio clock, 0 renders as fast as possible
+        float audioDuration = 0.0F; // seconds rendered by the offline audio driver, required when rendering as fast as possible
+        uint32_t audioLatencyFrames = 0; // 0 for the default
+        float audioLatencyTime = 0.0F;
+        bool audioAdaptiveLatency = false;
+        // the main and the update thread also execute jobs while waiting for them
+        uint32_t jobThreads = std::max(std::thread::hardware_concurrency(), 2U) - 1;
 
         defaultSettings = ini::Data(fileSystem.readFile("settings.ini"));
 
@@ -143,6 +157,18 @@ namespace ouzel
         const ini::Section& userEngineSection = userSettings.getSection("engine");
         const ini::Section& defaultEngineSection = defaultSettings.getSection("engine");
 
+        std::string logFileValue = userEngineSection.getValue("logFile", defaultEngineSection.getValue("logFile"));
+        if (!logFileValue.empty())
+        {
+            if (FileSystem::pathIsRelative(logFileValue))
+                logFileValue = fileSystem.getStorageDirectory() + FileSystem::DIRECTORY_SEPARATOR + logFileValue;
+
+            logger.addSink(std::unique_ptr<LogSink>(new FileLogSink(logFileValue)));
+        }
+
+        std::string jobThreadsValue = userEngineSection.getValue("jobThreads", defaultEngineSection.getValue("jobThreads"));
+        if (!jobThreadsValue.empty()) jobThreads = static_cast<uint32_t>(std::stoul(jobThreadsValue));
+
         std::string graphicsDriverValue = userEngineSection.getValue("graphicsDriver", defaultEngineSection.getValue("graphicsDriver"));
 
         std::string widthValue = userEngineSection.getValue("width", defaultEngineSection.getValue("width"));
@@ -193,11 +219,52 @@ namespace ouzel
         std::string highDpiValue = userEngineSection.getValue("highDpi", defaultEngineSection.getValue("highDpi"));
         if (!highDpiValue.empty()) highDpi = (highDpiValue == "true" || highDpiValue == "1" || highDpiValue == "yes");
 
+        std::string framesInFlightValue = userEngineSection.getValue("framesInFlight", defaultEngineSection.getValue("framesInFlight"));
+        if (!framesInFlightValue.empty()) framesInFlight = static_cast<uint32_t>(std::stoul(framesInFlightValue));
+
+        std::string targetFPSValue = userEngineSection.getValue("targetFPS", defaultEngineSection.getValue("targetFPS"));
+        if (!targetFPSValue.empty()) targetFPS = std::stof(targetFPSValue);
+
+        std::string fixedUpdateRateValue = userEngineSection.getValue("fixedUpdateRate", defaultEngineSection.getValue("fixedUpdateRate"));
+        if (!fixedUpdateRateValue.empty()) setFixedUpdateInterval(1.0F / std::stof(fixedUpdateRateValue));
+
+        std::string maxFixedUpdateStepsValue = userEngineSection.getValue("maxFixedUpdateSteps", defaultEngineSection.getValue("maxFixedUpdateSteps"));
+        if (!maxFixedUpdateStepsValue.empty()) setMaxFixedUpdateSteps(static_cast<uint32_t>(std::stoul(maxFixedUpdateStepsValue)));
+
+        std::string profilerValue = userEngineSection.getValue("profiler", defaultEngineSection.getValue("profiler"));
+        if (!profilerValue.empty()) profiler.setEnabled(profilerValue == "true" || profilerValue == "1" || profilerValue == "yes");
+
         std::string audioDriverValue = userEngineSection.getValue("audioDriver", defaultEngineSection.getValue("audioDriver"));
 
         std::string debugAudioValue = userEngineSection.getValue("debugAudio", defaultEngineSection.getValue("debugAudio"));
         if (!debugAudioValue.empty()) debugAudio = (debugAudioValue == "true" || debugAudioValue == "1" || debugAudioValue == "yes");
 
+        std::string audioOutputValue = userEngineSection.getValue("audioOutput", defaultEngineSection.getValue("audioOutput"));
+
+        std::string audioClockSpeedValue = userEngineSection.getValue("audioClockSpeed", defaultEngineSection.getValue("audioClockSpeed"));
+        if (!audioClockSpeedValue.empty()) audioClockSpeed = std::stof(audioClockSpeedValue);
+
+        std::string audioDurationValue = userEngineSection.getValue("audioDuration", defaultEngineSection.getValue("audioDuration"));
+        if (!audioDurationValue.empty()) audioDuration = std::stof(audioDurationValue);
+
+        // latency is specified either in frames (e.g. 2048) or in milliseconds (e.g. 40ms)
+        std::string audioLatencyValue = userEngineSection.getValue("audioLatency", defaultEngineSection.getValue("audioLatency"));
+        if (!audioLatencyValue.empty())
+        {
+            if (audioLatencyValue.size() > 2 && audioLatencyValue.compare(audioLatencyValue.size() - 2, 2, "ms") == 0)
+                audioLatencyTime = std::stof(audioLatencyValue.substr(0, audioLatencyValue.size() - 2)) / 1000.0F;
+            else
+                audioLatencyFrames = static_cast<uint32_t>(std::stoul(audioLatencyValue));
+        }
+
+        std::string audioAdaptiveLatencyValue = userEngineSection.getValue("audioAdaptiveLatency", defaultEngineSection.getValue("audioAdaptiveLatency"));
+        if (!audioAdaptiveLatencyValue.empty()) audioAdaptiveLatency = (audioAdaptiveLatencyValue == "true" || audioAdaptiveLatencyValue == "1" || audioAdaptiveLatencyValue == "yes");
+
+#if defined(__EMSCRIPTEN__)
+        jobThreads = 0;
+#endif
+        jobSystem.reset(new JobSystem(jobThreads));
+
         graphics::Driver graphicsDriver = graphics::Renderer::getDriver(graphicsDriverValue);
 
         window.reset(new Window(*this,
@@ -220,8 +287,15 @@ namespace ouzel
                                               depth,
                                               debugRenderer));
 
+        renderer->setMaxFramesInFlight(framesInFlight);
+
+        if (targetFPS > 0.0F)
+            framePacer.setTargetFrameTime(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0F / targetFPS)));
+
         audio::Driver audioDriver = audio::Audio::getDriver(audioDriverValue);
-        audio.reset(new audio::Audio(audioDriver, debugAudio, window.get()));
+        audio.reset(new audio::Audio(audioDriver, debugAudio, window.get(),
+                                     audioOutputValue, audioClockSpeed, audioDuration,
+                                     audioLatencyFrames, audioLatencyTime, audioAdaptiveLatency));
 
         inputManager.reset(new input::InputManager());
 
@@ -467,9 +541,9 @@ namespace ouzel
     {
         if (!active)
         {
-            std::unique_ptr<SystemEvent> event(new SystemEvent());
+            std::unique_ptr<SystemEvent> event = EventDispatcher::createEvent<SystemEvent>();
             event->type = Event::Type::ENGINE_START;
-            eventDispatcher.postEvent(std::move(event));
+            eventDispatcher.queueEvent(std::move(event));
 
             active = true;
             paused = false;
@@ -486,9 +560,9 @@ namespace ouzel
     {
         if (active && !paused)
         {
-            std::unique_ptr<SystemEvent> event(new SystemEvent());
+            std::unique_ptr<SystemEvent> event = EventDispatcher::createEvent<SystemEvent>();
             event->type = Event::Type::ENGINE_PAUSE;
-            eventDispatcher.postEvent(std::move(event));
+            eventDispatcher.queueEvent(std::move(event));
 
             paused = true;
         }
@@ -498,9 +572,9 @@ namespace ouzel
     {
         if (active && paused)
         {
-            std::unique_ptr<SystemEvent> event(new SystemEvent());
+            std::unique_ptr<SystemEvent> event = EventDispatcher::createEvent<SystemEvent>();
             event->type = Event::Type::ENGINE_RESUME;
-            eventDispatcher.postEvent(std::move(event));
+            eventDispatcher.queueEvent(std::move(event));
 
             paused = false;
 
@@ -516,9 +590,9 @@ namespace ouzel
 
         if (active)
         {
-            std::unique_ptr<SystemEvent> event(new SystemEvent());
+            std::unique_ptr<SystemEvent> event = EventDispatcher::createEvent<SystemEvent>();
             event->type = Event::Type::ENGINE_STOP;
-            eventDispatcher.postEvent(std::move(event));
+            eventDispatcher.queueEvent(std::move(event));
 
             active = false;
         }
@@ -535,9 +609,33 @@ namespace ouzel
 #endif
     }
 
+    void Engine::setFixedUpdateInterval(float newFixedUpdateInterval)
+    {
+        if (!(newFixedUpdateInterval > 0.0F))
+            throw std::runtime_error("Invalid fixed update interval");
+
+        fixedUpdateInterval = newFixedUpdateInterval;
+    }
+
+    void Engine::setMaxFixedUpdateSteps(uint32_t newMaxFixedUpdateSteps)
+    {
+        if (newMaxFixedUpdateSteps == 0)
+            throw std::runtime_error("Invalid maximum number of fixed update steps");
+
+        maxFixedUpdateSteps = newMaxFixedUpdateSteps;
+    }
+
     void Engine::update()
     {
+        profiler.endFrame();
+
+        OUZEL_PROFILE_ZONE("Engine::update");
+
+        const std::chrono::steady_clock::time_point updateStartTime = std::chrono::steady_clock::now();
+
         eventDispatcher.dispatchEvents();
+        executeAllOnUpdateThread();
+        cache.reloadModifiedAssets();
 
         std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
         auto diff = currentTime - previousUpdateTime;
@@ -549,10 +647,31 @@ namespace ouzel
             previousUpdateTime = currentTime;
             float delta = std::chrono::duration_cast<std::chrono::microseconds>(diff).count() / 1000000.0F;
 
-            std::unique_ptr<UpdateEvent> updateEvent(new UpdateEvent());
-            updateEvent->type = Event::Type::UPDATE;
-            updateEvent->delta = delta;
-            eventDispatcher.dispatchEvent(std::move(updateEvent));
+            fixedUpdateTime += delta;
+
+            for (uint32_t steps = 0; fixedUpdateTime >= fixedUpdateInterval; ++steps)
+            {
+                // drop the time that can not be caught up with, otherwise slow steps would make the next frames even slower
+                if (steps == maxFixedUpdateSteps)
+                {
+                    fixedUpdateTime = std::fmod(fixedUpdateTime, fixedUpdateInterval);
+                    break;
+                }
+
+                fixedUpdatePhase = ++updatePhase;
+                fixedUpdateTime -= fixedUpdateInterval;
+
+                // the components are updated before the handlers, as they were when they used update handlers
+                updateScheduler.fixedUpdate(fixedUpdateInterval);
+                eventDispatcher.dispatchFixedUpdate(fixedUpdateInterval);
+            }
+
+            fixedUpdateAlpha = fixedUpdateTime / fixedUpdateInterval;
+
+            ++updatePhase;
+
+            updateScheduler.update(delta);
+            eventDispatcher.dispatchUpdate(delta);
         }
 
         inputManager->update();
@@ -560,9 +679,40 @@ namespace ouzel
         audio->update();
 
         if (renderer->getRefillQueue())
+        {
+            renderer->beginFrame(updateStartTime);
             sceneManager.draw();
+        }
 
         if (oneUpdatePerFrame) renderer->waitForNextFrame();
+
+#if !defined(__EMSCRIPTEN__)
+        framePacer.wait();
+#endif
+    }
+
+    void Engine::executeOnUpdateThread(const std::function<void()>& func)
+    {
+        std::lock_guard<std::mutex> lock(updateExecuteMutex);
+        updateExecuteQueue.push(func);
+    }
+
+    void Engine::executeAllOnUpdateThread()
+    {
+        std::function<void()> func;
+
+        for (;;)
+        {
+            std::unique_lock<std::mutex> lock(updateExecuteMutex);
+
+            if (updateExecuteQueue.empty()) break;
+
+            func = std::move(updateExecuteQueue.front());
+            updateExecuteQueue.pop();
+            lock.unlock();
+
+            if (func) func();
+        }
     }
 
     void Engine::main()
@@ -8,10 +8,14 @@
 #include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <queue>
 #include <thread>
 #include <vector>
 #include "core/Application.hpp"
+#include "core/FramePacer.hpp"
+#include "core/JobSystem.hpp"
 #include "core/Timer.hpp"
+#include "core/UpdateScheduler.hpp"
 #include "core/Window.hpp"
 #include "graphics/Renderer.hpp"
 #include "audio/Audio.hpp"
@@ -60,8 +64,11 @@ namespace ouzel
         inline Log log(Log::Level level = Log::Level::INFO) const { return logger.log(level); }
         inline Logger& getLogger() { return logger; }
 
+        inline JobSystem* getJobSystem() const { return jobSystem.get(); }
         inline FileSystem& getFileSystem() { return fileSystem; }
         inline EventDispatcher& getEventDispatcher() { return eventDispatcher; }
+        inline UpdateScheduler& getUpdateScheduler() { return updateScheduler; }
+        inline FramePacer& getFramePacer() { return framePacer; }
         inline assets::Cache& getCache() { return cache; }
         inline Window* getWindow() { return window.get(); }
         inline graphics::Renderer* getRenderer() const { return renderer.get(); }
@@ -77,7 +84,7 @@ namespace ouzel
         void start();
         void pause();
         void resume();
-        void exit();
+        virtual void exit();
 
         inline bool isPaused() const { return paused; }
         inline bool isActive() const { return active; }
@@ -85,6 +92,8 @@ namespace ouzel
         void update();
 
         virtual void executeOnMainThread(const std::function<void()>& func) = 0;
+        // the function is called on the update thread before the next update
+        void executeOnUpdateThread(const std::function<void()>& func);
 
         virtual void openURL(const std::string& url);
 
@@ -94,12 +103,31 @@ namespace ouzel
         bool isOneUpdatePerFrame() const { return oneUpdatePerFrame; }
         void setOneUpdatePerFrame(bool value) { oneUpdatePerFrame = value; }
 
+        // the simulation runs in fixed steps, independently of the frame rate
+        inline float getFixedUpdateInterval() const { return fixedUpdateInterval; }
+        void setFixedUpdateInterval(float newFixedUpdateInterval);
+
+        // fixed steps per frame after which the remaining time is dropped
+        inline uint32_t getMaxFixedUpdateSteps() const { return maxFixedUpdateSteps; }
+        void setMaxFixedUpdateSteps(uint32_t newMaxFixedUpdateSteps);
+
+        // part of the fixed update interval that has passed since the last step, used for the interpolation
+        inline float getFixedUpdateAlpha() const { return fixedUpdateAlpha; }
+
+        // incremented before every fixed step and every variable update
+        inline uint64_t getUpdatePhase() const { return updatePhase; }
+        inline uint64_t getFixedUpdatePhase() const { return fixedUpdatePhase; }
+
     protected:
         virtual void main();
+        void executeAllOnUpdateThread();
 
         Logger logger;
+        std::unique_ptr<JobSystem> jobSystem;
         FileSystem fileSystem;
         EventDispatcher eventDispatcher;
+        UpdateScheduler updateScheduler;
+        FramePacer framePacer;
         std::unique_ptr<Window> window;
         std::unique_ptr<graphics::Renderer> renderer;
         std::unique_ptr<audio::Audio> audio;
@@ -120,6 +148,16 @@ namespace ouzel
 #endif
         std::chrono::steady_clock::time_point previousUpdateTime;
 
+        std::queue<std::function<void()>> updateExecuteQueue;
+        std::mutex updateExecuteMutex;
+
+        float fixedUpdateInterval = 1.0F / 60.0F;
+        uint32_t maxFixedUpdateSteps = 8;
+        float fixedUpdateTime = 0.0F;
+        float fixedUpdateAlpha = 0.0F;
+        uint64_t updatePhase = 0;
+        uint64_t fixedUpdatePhase = 0;
+
         std::atomic_bool active{false};
         std::atomic_bool paused{false};
         std::atomic_bool oneUpdatePerFrame{false};
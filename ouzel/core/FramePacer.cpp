@@ -0,0 +1,43 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <stdexcept>
+#include <thread>
+#include "FramePacer.hpp"
+
+namespace ouzel
+{
+    // sleeping is not precise (especially on Windows), so the last part of the wait is spun
+    static constexpr std::chrono::microseconds SPIN_TIME(2000);
+
+    void FramePacer::setTargetFrameTime(std::chrono::steady_clock::duration newTargetFrameTime)
+    {
+        if (newTargetFrameTime.count() < 0)
+            throw std::runtime_error("Invalid target frame time");
+
+        targetFrameTime = newTargetFrameTime;
+        nextFrameTime = std::chrono::steady_clock::time_point();
+    }
+
+    void FramePacer::wait()
+    {
+        if (targetFrameTime.count() == 0) return;
+
+        std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+
+        // start over if the frame took longer than the target, instead of trying to catch up
+        if (nextFrameTime == std::chrono::steady_clock::time_point() ||
+            currentTime > nextFrameTime + targetFrameTime)
+        {
+            nextFrameTime = currentTime + targetFrameTime;
+            return;
+        }
+
+        if (nextFrameTime - currentTime > SPIN_TIME)
+            std::this_thread::sleep_for(nextFrameTime - currentTime - SPIN_TIME);
+
+        while (std::chrono::steady_clock::now() < nextFrameTime)
+            std::this_thread::yield();
+
+        nextFrameTime += targetFrameTime;
+    }
+}
@@ -0,0 +1,35 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_CORE_FRAMEPACER_HPP
+#define OUZEL_CORE_FRAMEPACER_HPP
+
+#include <chrono>
+
+namespace ouzel
+{
+    // keeps a fixed frame time, sleeps for the most of the remaining time and spins for the rest
+    class FramePacer final
+    {
+    public:
+        FramePacer() = default;
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        FramePacer(FramePacer&&) = delete;
+        FramePacer& operator=(FramePacer&&) = delete;
+
+        // zero disables the pacing
+        inline std::chrono::steady_clock::duration getTargetFrameTime() const { return targetFrameTime; }
+        void setTargetFrameTime(std::chrono::steady_clock::duration newTargetFrameTime);
+
+        // blocks until the start of the next frame
+        void wait();
+
+    private:
+        std::chrono::steady_clock::duration targetFrameTime{0};
+        std::chrono::steady_clock::time_point nextFrameTime;
+    };
+}
+
+#endif // OUZEL_CORE_FRAMEPACER_HPP
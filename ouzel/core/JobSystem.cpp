@@ -0,0 +1,257 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <algorithm>
+#include <string>
+#include "JobSystem.hpp"
+#include "Engine.hpp"
+#include "utils/Log.hpp"
+#include "utils/Utils.hpp"
+
+namespace ouzel
+{
+    static thread_local JobSystem* currentJobSystem = nullptr;
+    static thread_local uint32_t currentWorker = 0;
+
+    JobSystem::JobSystem(uint32_t threadCount)
+    {
+        for (uint32_t i = 0; i < threadCount; ++i)
+            workers.push_back(std::unique_ptr<Worker>(new Worker()));
+
+        for (uint32_t i = 0; i < threadCount; ++i)
+            workers[i]->thread = std::thread(&JobSystem::run, this, i);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        running = false;
+        sleepCondition.notify_all();
+        lock.unlock();
+
+        for (const std::unique_ptr<Worker>& worker : workers)
+            if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    void JobSystem::schedule(const std::function<void()>& function,
+                             Fence* fence, Fence* dependency)
+    {
+        if (fence) ++fence->pending;
+
+        Job job{function, fence};
+
+        if (dependency)
+        {
+            std::unique_lock<std::mutex> lock(dependency->mutex);
+            if (dependency->pending != 0)
+            {
+                dependency->dependents.push_back(std::move(job));
+                return;
+            }
+        }
+
+        push(std::move(job));
+    }
+
+    void JobSystem::wait(Fence& fence)
+    {
+        while (fence.pending != 0)
+        {
+            if (runJob()) continue;
+
+            // sleep until the fence is signaled or there is a job to help with
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            while (fence.pending != 0 && queuedJobs == 0)
+                sleepCondition.wait(lock);
+        }
+
+        // make sure that the signaling thread has released the fence
+        std::unique_lock<std::mutex> lock(fence.mutex);
+    }
+
+    void JobSystem::parallelFor(uint32_t begin, uint32_t end, uint32_t grainSize,
+                                const std::function<void(uint32_t, uint32_t)>& function)
+    {
+        if (begin >= end) return;
+
+        const uint32_t count = end - begin;
+
+        if (grainSize == 0)
+            grainSize = std::max(count / (static_cast<uint32_t>(workers.size()) + 1), 1U);
+
+        if (workers.empty() || count <= grainSize)
+        {
+            function(begin, end);
+            return;
+        }
+
+        Fence fence;
+
+        // the first range is processed on the calling thread
+        for (uint32_t first = begin + grainSize; first < end; first += std::min(grainSize, end - first))
+        {
+            uint32_t last = first + std::min(grainSize, end - first);
+            schedule([&function, first, last]() { function(first, last); }, &fence);
+        }
+
+        try
+        {
+            function(begin, begin + grainSize);
+        }
+        catch (...)
+        {
+            wait(fence);
+            throw;
+        }
+
+        wait(fence);
+    }
+
+    void JobSystem::push(Job job)
+    {
+        if (workers.empty())
+        {
+            execute(job);
+            return;
+        }
+
+        ++queuedJobs;
+
+        if (currentJobSystem == this)
+        {
+            Worker& worker = *workers[currentWorker];
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            worker.jobs.push_back(std::move(job));
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(globalMutex);
+            globalJobs.push_back(std::move(job));
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        lock.unlock();
+        sleepCondition.notify_one();
+    }
+
+    bool JobSystem::pop(Job& job)
+    {
+        const uint32_t workerCount = static_cast<uint32_t>(workers.size());
+        uint32_t first = 0;
+        Worker* self = nullptr;
+
+        if (currentJobSystem == this)
+        {
+            // own jobs are taken from the back (most recent first)
+            self = workers[currentWorker].get();
+            std::unique_lock<std::mutex> lock(self->mutex);
+            if (!self->jobs.empty())
+            {
+                job = std::move(self->jobs.back());
+                self->jobs.pop_back();
+                --queuedJobs;
+                return true;
+            }
+
+            first = currentWorker + 1;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(globalMutex);
+            if (!globalJobs.empty())
+            {
+                job = std::move(globalJobs.front());
+                globalJobs.pop_front();
+                --queuedJobs;
+                return true;
+            }
+        }
+
+        // steal the oldest job of another worker
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            Worker& victim = *workers[(first + i) % workerCount];
+            if (&victim == self) continue;
+
+            std::unique_lock<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty())
+            {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                --queuedJobs;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool JobSystem::runJob()
+    {
+        Job job;
+        if (!pop(job)) return false;
+
+        execute(job);
+        return true;
+    }
+
+    void JobSystem::execute(Job& job)
+    {
+        try
+        {
+            job.function();
+        }
+        catch (const std::exception& e)
+        {
+            engine->log(Log::Level::ERR) << e.what();
+        }
+        catch (...)
+        {
+            // the fence must be signaled whatever the job throws
+            engine->log(Log::Level::ERR) << "Unknown error in a job";
+        }
+
+        if (job.fence) signal(*job.fence);
+    }
+
+    void JobSystem::signal(Fence& fence)
+    {
+        std::vector<Job> ready;
+        bool signaled;
+
+        {
+            std::unique_lock<std::mutex> lock(fence.mutex);
+            signaled = (--fence.pending == 0);
+            if (signaled) ready.swap(fence.dependents);
+        }
+
+        // the fence can be destroyed by the waiting thread from here on
+        if (signaled)
+        {
+            // wake the threads that wait for the fence
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            lock.unlock();
+            sleepCondition.notify_all();
+        }
+
+        for (Job& job : ready)
+            push(std::move(job));
+    }
+
+    void JobSystem::run(uint32_t index)
+    {
+        setCurrentThreadName("Worker " + std::to_string(index));
+
+        currentJobSystem = this;
+        currentWorker = index;
+
+        while (running)
+        {
+            if (!runJob())
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                while (running && queuedJobs == 0)
+                    sleepCondition.wait(lock);
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_CORE_JOBSYSTEM_HPP
+#define OUZEL_CORE_JOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ouzel
+{
+    // work-stealing job scheduler, each worker thread has its own queue and steals from others when it runs out of jobs
+    class JobSystem final
+    {
+    public:
+        class Fence;
+
+    private:
+        struct Job final
+        {
+            std::function<void()> function;
+            Fence* fence;
+        };
+
+    public:
+        // counts the unfinished jobs that signal it, jobs can depend on a fence
+        class Fence final
+        {
+            friend JobSystem;
+        public:
+            Fence() = default;
+
+            Fence(const Fence&) = delete;
+            Fence& operator=(const Fence&) = delete;
+
+            Fence(Fence&&) = delete;
+            Fence& operator=(Fence&&) = delete;
+
+            inline bool isSignaled() const { return pending == 0; }
+
+        private:
+            std::atomic<uint32_t> pending{0};
+            std::mutex mutex;
+            std::vector<Job> dependents;
+        };
+
+        // with 0 threads all jobs are executed on the thread that schedules (or signals the dependency of) them
+        explicit JobSystem(uint32_t threadCount);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        inline uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()); }
+
+        // the job is run after the dependency is signaled and signals the fence when finished
+        void schedule(const std::function<void()>& function,
+                      Fence* fence = nullptr, Fence* dependency = nullptr);
+
+        // executes other jobs while waiting
+        void wait(Fence& fence);
+
+        // calls the function for ranges of [begin, end) of at most grainSize elements (0 to split evenly between threads)
+        void parallelFor(uint32_t begin, uint32_t end, uint32_t grainSize,
+                         const std::function<void(uint32_t, uint32_t)>& function);
+
+    private:
+        struct Worker final
+        {
+            std::thread thread;
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        void push(Job job);
+        bool pop(Job& job);
+        bool runJob();
+        // runs the job and signals its fence, exceptions thrown by the job are logged
+        void execute(Job& job);
+        void signal(Fence& fence);
+        void run(uint32_t index);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        // jobs scheduled from threads that are not workers
+        std::mutex globalMutex;
+        std::deque<Job> globalJobs;
+
+        std::atomic<uint32_t> queuedJobs{0};
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+        std::atomic_bool running{true};
+    };
+}
+
+#endif // OUZEL_CORE_JOBSYSTEM_HPP
@@ -0,0 +1,217 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <algorithm>
+#include <stdexcept>
+#include "UpdateScheduler.hpp"
+#include "Engine.hpp"
+
+namespace ouzel
+{
+    static constexpr uint32_t MAX_FIXED_STEPS = 8;
+    static constexpr size_t PARALLEL_UPDATE_GRAIN = 64;
+
+    UpdateScheduler::Entry::~Entry()
+    {
+        remove();
+    }
+
+    void UpdateScheduler::Entry::remove()
+    {
+        if (list) list->scheduler->remove(*this);
+    }
+
+    UpdateScheduler::UpdateScheduler()
+    {
+        addGroup(Mode::VARIABLE);
+        addGroup(Mode::STEP);
+    }
+
+    UpdateScheduler::~UpdateScheduler()
+    {
+        for (const Group& group : groups)
+            for (const std::unique_ptr<List>& list : group.lists)
+                for (Entry* entry : list->entries)
+                    if (entry) entry->list = nullptr;
+    }
+
+    uint32_t UpdateScheduler::addGroup(Mode mode, float interval, bool parallel)
+    {
+        if (updating)
+            throw std::runtime_error("Update groups can not be added during the update");
+
+        if ((mode == Mode::FIXED || mode == Mode::INTERVAL) && interval <= 0.0F)
+            throw std::runtime_error("Invalid update interval");
+
+        Group group;
+        group.mode = mode;
+        group.interval = interval;
+        group.parallel = parallel;
+        group.time = 0.0F;
+        groups.push_back(std::move(group));
+
+        return static_cast<uint32_t>(groups.size() - 1);
+    }
+
+    void UpdateScheduler::add(void* object, Entry& entry, uint32_t group,
+                              const void* typeId, UpdateFunction updateFunction)
+    {
+        if (group >= groups.size())
+            throw std::runtime_error("Invalid update group");
+
+        entry.remove();
+
+        std::vector<std::unique_ptr<List>>& lists = groups[group].lists;
+
+        auto i = std::find_if(lists.begin(), lists.end(), [typeId](const std::unique_ptr<List>& list) {
+            return list->typeId == typeId;
+        });
+
+        List* list;
+
+        if (i == lists.end())
+        {
+            list = new List();
+            list->scheduler = this;
+            list->typeId = typeId;
+            list->updateFunction = updateFunction;
+            lists.push_back(std::unique_ptr<List>(list));
+        }
+        else
+            list = i->get();
+
+        entry.list = list;
+        entry.index = list->objects.size();
+        list->objects.push_back(object);
+        list->entries.push_back(&entry);
+    }
+
+    void UpdateScheduler::remove(Entry& entry)
+    {
+        List* list = entry.list;
+        if (!list) return;
+
+        entry.list = nullptr;
+
+        if (updating)
+        {
+            // the list is compacted after the update
+            list->objects[entry.index] = nullptr;
+            list->entries[entry.index] = nullptr;
+            ++list->removed;
+        }
+        else
+        {
+            Entry* last = list->entries.back();
+            list->objects[entry.index] = list->objects.back();
+            list->entries[entry.index] = last;
+            if (last) last->index = entry.index;
+
+            list->objects.pop_back();
+            list->entries.pop_back();
+        }
+    }
+
+    void UpdateScheduler::update(float delta)
+    {
+        updating = true;
+
+        // objects can add new groups and lists during the update, so indices are used instead of iterators
+        for (size_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex)
+        {
+            Group& group = groups[groupIndex];
+
+            switch (group.mode)
+            {
+                case Mode::VARIABLE:
+                    updateLists(groupIndex, delta);
+                    break;
+                case Mode::FIXED:
+                {
+                    group.time += delta;
+
+                    uint32_t steps = 0;
+                    for (; group.time >= group.interval && steps < MAX_FIXED_STEPS; ++steps)
+                    {
+                        group.time -= group.interval;
+                        updateLists(groupIndex, group.interval);
+                    }
+
+                    // drop the time that could not be caught up with
+                    if (steps == MAX_FIXED_STEPS) group.time = std::min(group.time, group.interval);
+                    break;
+                }
+                case Mode::INTERVAL:
+                    group.time += delta;
+
+                    if (group.time >= group.interval)
+                    {
+                        updateLists(groupIndex, group.time);
+                        group.time = 0.0F;
+                    }
+                    break;
+                case Mode::STEP:
+                    break;
+            }
+        }
+
+        updating = false;
+
+        compactLists();
+    }
+
+    void UpdateScheduler::fixedUpdate(float interval)
+    {
+        updating = true;
+
+        for (size_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex)
+            if (groups[groupIndex].mode == Mode::STEP)
+                updateLists(groupIndex, interval);
+
+        updating = false;
+
+        compactLists();
+    }
+
+    void UpdateScheduler::compactLists()
+    {
+        for (const Group& group : groups)
+        {
+            for (const std::unique_ptr<List>& list : group.lists)
+            {
+                if (list->removed)
+                {
+                    list->objects.erase(std::remove(list->objects.begin(), list->objects.end(), nullptr),
+                                        list->objects.end());
+                    list->entries.erase(std::remove(list->entries.begin(), list->entries.end(), nullptr),
+                                        list->entries.end());
+
+                    for (size_t i = 0; i < list->entries.size(); ++i)
+                        list->entries[i]->index = i;
+
+                    list->removed = 0;
+                }
+            }
+        }
+    }
+
+    void UpdateScheduler::updateLists(size_t groupIndex, float delta)
+    {
+        JobSystem* jobSystem = engine ? engine->getJobSystem() : nullptr;
+
+        for (size_t listIndex = 0; listIndex < groups[groupIndex].lists.size(); ++listIndex)
+        {
+            List& list = *groups[groupIndex].lists[listIndex];
+            const size_t count = list.objects.size();
+
+            if (groups[groupIndex].parallel && jobSystem && count > PARALLEL_UPDATE_GRAIN)
+            {
+                jobSystem->parallelFor(0, static_cast<uint32_t>(count), PARALLEL_UPDATE_GRAIN,
+                                       [&list, delta](uint32_t begin, uint32_t end) {
+                                           list.updateFunction(list.objects, begin, end, delta);
+                                       });
+            }
+            else
+                list.updateFunction(list.objects, 0, count, delta);
+        }
+    }
+}
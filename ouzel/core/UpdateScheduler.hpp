@@ -0,0 +1,124 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_CORE_UPDATESCHEDULER_HPP
+#define OUZEL_CORE_UPDATESCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ouzel
+{
+    // calls update(float delta) of registered objects once per frame (before the UPDATE handlers), objects of the same type are kept in one contiguous list
+    class UpdateScheduler final
+    {
+        class List;
+    public:
+        // position of an object in the scheduler, the object is removed when the entry is destroyed
+        class Entry final
+        {
+            friend UpdateScheduler;
+        public:
+            Entry() = default;
+            ~Entry();
+
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            Entry(Entry&&) = delete;
+            Entry& operator=(Entry&&) = delete;
+
+            void remove();
+            inline bool isActive() const { return list != nullptr; }
+
+        private:
+            List* list = nullptr;
+            size_t index = 0;
+        };
+
+        enum class Mode
+        {
+            VARIABLE, // every frame with the frame delta
+            FIXED, // zero or more times per frame with the interval as the delta
+            INTERVAL, // once the interval has passed with the accumulated delta
+            STEP // in every fixed update step of the engine with the fixed update interval as the delta
+        };
+
+        static constexpr uint32_t DEFAULT_GROUP = 0;
+        static constexpr uint32_t FIXED_GROUP = 1;
+
+        UpdateScheduler();
+        ~UpdateScheduler();
+
+        UpdateScheduler(const UpdateScheduler&) = delete;
+        UpdateScheduler& operator=(const UpdateScheduler&) = delete;
+
+        UpdateScheduler(UpdateScheduler&&) = delete;
+        UpdateScheduler& operator=(UpdateScheduler&&) = delete;
+
+        // objects of parallel groups are updated on the job system and must not add or remove entries in update
+        uint32_t addGroup(Mode mode, float interval = 0.0F, bool parallel = false);
+
+        template<class T>
+        void add(T* object, Entry& entry, uint32_t group = DEFAULT_GROUP)
+        {
+            add(object, entry, group, getTypeId<T>(), &updateObjects<T>);
+        }
+
+        void remove(Entry& entry);
+
+        // updates all groups except the STEP groups
+        void update(float delta);
+        // updates the STEP groups
+        void fixedUpdate(float interval);
+
+    private:
+        typedef void (*UpdateFunction)(const std::vector<void*>& objects, size_t begin, size_t end, float delta);
+
+        template<class T>
+        static const void* getTypeId()
+        {
+            static const char id = 0;
+            return &id;
+        }
+
+        template<class T>
+        static void updateObjects(const std::vector<void*>& objects, size_t begin, size_t end, float delta)
+        {
+            // objects can be added (and the vector reallocated) during the update
+            for (size_t i = begin; i < end; ++i)
+                if (void* object = objects[i]) static_cast<T*>(object)->update(delta);
+        }
+
+        class List final
+        {
+        public:
+            UpdateScheduler* scheduler;
+            const void* typeId;
+            UpdateFunction updateFunction;
+            std::vector<void*> objects;
+            std::vector<Entry*> entries;
+            size_t removed = 0;
+        };
+
+        class Group final
+        {
+        public:
+            Mode mode;
+            float interval;
+            bool parallel;
+            float time;
+            std::vector<std::unique_ptr<List>> lists;
+        };
+
+        void add(void* object, Entry& entry, uint32_t group, const void* typeId, UpdateFunction updateFunction);
+        void updateLists(size_t groupIndex, float delta);
+        void compactLists();
+
+        std::vector<Group> groups;
+        bool updating = false;
+    };
+}
+
+#endif // OUZEL_CORE_UPDATESCHEDULER_HPP
@@ -278,11 +278,11 @@ namespace ouzel
         if (!XInitThreads())
             throw std::runtime_error("Failed to initialize thread support");
 
-        // open a connection to the X server
+        // open a connection to the X server, without it only the empty renderer can be used
         display = XOpenDisplay(nullptr);
 
         if (!display)
-            throw std::runtime_error("Failed to open display");
+            log(Log::Level::WARN) << "Failed to open display, running without a window";
 #else
         bcm_host_init();
 
@@ -295,208 +295,210 @@ namespace ouzel
         init();
         start();
 
-        input::InputSystemLinux* inputLinux = static_cast<input::InputSystemLinux*>(inputManager->getInputSystem());
-
 #if OUZEL_SUPPORTS_X11
-        NativeWindowLinux* windowLinux = static_cast<NativeWindowLinux*>(window->getNativeWindow());
-
-        int xInputOpCode = 0;
-        int eventCode;
-        int err;
-        if (XQueryExtension(display, "XInputExtension", &xInputOpCode, &eventCode, &err))
+        if (display)
         {
-            int majorVersion = 2;
-            int minorVersion = 0;
-
-            XIQueryVersion(display, &majorVersion, &minorVersion);
+            NativeWindowLinux* windowLinux = static_cast<NativeWindowLinux*>(window->getNativeWindow());
 
-            if (majorVersion >= 2)
+            int eventCode;
+            int err;
+            if (XQueryExtension(display, "XInputExtension", &xInputOpCode, &eventCode, &err))
             {
-                unsigned char mask[] = {0, 0 ,0};
+                int majorVersion = 2;
+                int minorVersion = 0;
 
-                XIEventMask eventMask;
-                eventMask.deviceid = XIAllMasterDevices;
-                eventMask.mask_len = sizeof(mask);
-                eventMask.mask = mask;
+                XIQueryVersion(display, &majorVersion, &minorVersion);
 
-                XISetMask(mask, XI_TouchBegin);
-                XISetMask(mask, XI_TouchEnd);
-                XISetMask(mask, XI_TouchUpdate);
+                if (majorVersion >= 2)
+                {
+                    unsigned char mask[] = {0, 0 ,0};
 
-                XISelectEvents(display, windowLinux->getNativeWindow(), &eventMask, 1);
+                    XIEventMask eventMask;
+                    eventMask.deviceid = XIAllMasterDevices;
+                    eventMask.mask_len = sizeof(mask);
+                    eventMask.mask = mask;
+
+                    XISetMask(mask, XI_TouchBegin);
+                    XISetMask(mask, XI_TouchEnd);
+                    XISetMask(mask, XI_TouchUpdate);
+
+                    XISelectEvents(display, windowLinux->getNativeWindow(), &eventMask, 1);
+                }
+                else
+                    log(Log::Level::WARN) << "XInput2 not supported";
             }
             else
-                log(Log::Level::WARN) << "XInput2 not supported";
+                log(Log::Level::WARN) << "XInput not supported";
+
+            // the events are read in the loop below, the handler only wakes up the reactor
+            reactor.addFd(ConnectionNumber(display), []() {});
         }
-        else
-            log(Log::Level::WARN) << "XInput not supported";
+#endif
 
-        executeAtom = XInternAtom(display, "OUZEL_EXECUTE", False);
+        while (active)
+        {
+            executeAll();
 
-        XEvent event;
+#if OUZEL_SUPPORTS_X11
+            if (display)
+            {
+                // XPending also reads the events that arrived on the connection
+                XEvent event;
+                while (XPending(display))
+                {
+                    XNextEvent(display, &event);
+                    handleXEvent(event);
+                }
+            }
+#endif
 
-        while (active)
+            if (!active) break;
+
+            int timeout = -1;
+
+#if OUZEL_SUPPORTS_X11
+            // the render thread can read events from the connection into the queue (e.g. while swapping buffers),
+            // so the descriptor would not become readable for them
+            if (display && XEventsQueued(display, QueuedAlready)) timeout = 0;
+#endif
+
+            // input devices are handled by the input system's handlers
+            reactor.poll(timeout);
+        }
+
+        exit();
+    }
+
+#if OUZEL_SUPPORTS_X11
+    void EngineLinux::handleXEvent(XEvent& event)
+    {
+        NativeWindowLinux* windowLinux = static_cast<NativeWindowLinux*>(window->getNativeWindow());
+
+        switch (event.type)
         {
-            // XNextEvent will block if there is no event pending, so don't call it if engine is not paused
-            if (paused || XPending(display))
+            case ClientMessage:
+            {
+                if (event.xclient.message_type == windowLinux->getProtocolsAtom() && static_cast<Atom>(event.xclient.data.l[0]) == windowLinux->getDeleteAtom())
+                    exit();
+                break;
+            }
+            case FocusIn:
+                windowLinux->handleFocusIn();
+                break;
+            case FocusOut:
+                windowLinux->handleFocusOut();
+                break;
+            case KeyPress: // keyboard
+            case KeyRelease:
             {
-                XNextEvent(display, &event);
+                ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
+                ouzel::input::KeyboardDevice* keyboardDevice = inputSystemLinux->getKeyboardDevice();
+
+                KeySym keySym = XkbKeycodeToKeysym(display,
+                                                   event.xkey.keycode, 0,
+                                                   event.xkey.state & ShiftMask ? 1 : 0);
+
+                if (event.type == KeyPress)
+                    keyboardDevice->handleKeyPress(convertKeyCode(keySym));
+                else
+                    keyboardDevice->handleKeyRelease(convertKeyCode(keySym));
+                break;
+            }
+            case ButtonPress: // mouse button
+            case ButtonRelease:
+            {
+                ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
+                ouzel::input::MouseDeviceLinux* mouseDevice = inputSystemLinux->getMouseDevice();
+
+                Vector2<float> pos(static_cast<float>(event.xbutton.x),
+                            static_cast<float>(event.xbutton.y));
+
+                if (event.type == ButtonPress)
+                    mouseDevice->handleButtonPress(convertButtonCode(event.xbutton.button),
+                                                   window->convertWindowToNormalizedLocation(pos));
+                else
+                    mouseDevice->handleButtonRelease(convertButtonCode(event.xbutton.button),
+                                                     window->convertWindowToNormalizedLocation(pos));
+                break;
+            }
+            case MotionNotify:
+            {
+                ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
+                ouzel::input::MouseDeviceLinux* mouseDevice = inputSystemLinux->getMouseDevice();
 
-                switch (event.type)
-                {
-                    case ClientMessage:
-                    {
-                        if (event.xclient.message_type == executeAtom)
-                            executeAll();
-                        else if (event.xclient.message_type == windowLinux->getProtocolsAtom() && static_cast<Atom>(event.xclient.data.l[0]) == windowLinux->getDeleteAtom())
-                            exit();
-                        break;
-                    }
-                    case FocusIn:
-                        windowLinux->handleFocusIn();
-                        break;
-                    case FocusOut:
-                        windowLinux->handleFocusOut();
-                        break;
-                    case KeyPress: // keyboard
-                    case KeyRelease:
-                    {
-                        ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
-                        ouzel::input::KeyboardDevice* keyboardDevice = inputSystemLinux->getKeyboardDevice();
-
-                        KeySym keySym = XkbKeycodeToKeysym(display,
-                                                           event.xkey.keycode, 0,
-                                                           event.xkey.state & ShiftMask ? 1 : 0);
-
-                        if (event.type == KeyPress)
-                            keyboardDevice->handleKeyPress(convertKeyCode(keySym));
-                        else
-                            keyboardDevice->handleKeyRelease(convertKeyCode(keySym));
-                        break;
-                    }
-                    case ButtonPress: // mouse button
-                    case ButtonRelease:
-                    {
-                        ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
-                        ouzel::input::MouseDeviceLinux* mouseDevice = inputSystemLinux->getMouseDevice();
-
-                        Vector2<float> pos(static_cast<float>(event.xbutton.x),
-                                    static_cast<float>(event.xbutton.y));
-
-                        if (event.type == ButtonPress)
-                            mouseDevice->handleButtonPress(convertButtonCode(event.xbutton.button),
-                                                           window->convertWindowToNormalizedLocation(pos));
-                        else
-                            mouseDevice->handleButtonRelease(convertButtonCode(event.xbutton.button),
-                                                             window->convertWindowToNormalizedLocation(pos));
-                        break;
-                    }
-                    case MotionNotify:
-                    {
-                        ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
-                        ouzel::input::MouseDeviceLinux* mouseDevice = inputSystemLinux->getMouseDevice();
+                Vector2<float> pos(static_cast<float>(event.xmotion.x),
+                                   static_cast<float>(event.xmotion.y));
 
-                        Vector2<float> pos(static_cast<float>(event.xmotion.x),
-                                           static_cast<float>(event.xmotion.y));
+                mouseDevice->handleMove(window->convertWindowToNormalizedLocation(pos));
 
-                        mouseDevice->handleMove(window->convertWindowToNormalizedLocation(pos));
+                break;
+            }
+            case ConfigureNotify:
+            {
+                windowLinux->handleResize(Size2<uint32_t>(static_cast<uint32_t>(event.xconfigure.width),
+                                                          static_cast<uint32_t>(event.xconfigure.height)));
+                break;
+            }
+            case Expose:
+            {
+                // need to redraw
+                break;
+            }
+            case GenericEvent:
+            {
+                XGenericEventCookie* cookie = &event.xcookie;
+                if (cookie->extension == xInputOpCode)
+                {
+                    ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
+                    ouzel::input::TouchpadDevice* touchpadDevice = inputSystemLinux->getTouchpadDevice();
 
-                        break;
-                    }
-                    case ConfigureNotify:
-                    {
-                        windowLinux->handleResize(Size2<uint32_t>(static_cast<uint32_t>(event.xconfigure.width),
-                                                                  static_cast<uint32_t>(event.xconfigure.height)));
-                        break;
-                    }
-                    case Expose:
-                    {
-                        // need to redraw
-                        break;
-                    }
-                    case GenericEvent:
+                    switch (cookie->evtype)
                     {
-                        XGenericEventCookie* cookie = &event.xcookie;
-                        if (cookie->extension == xInputOpCode)
+                        case XI_TouchBegin:
+                        {
+                            XIDeviceEvent* xievent = reinterpret_cast<XIDeviceEvent*>(cookie->data);
+                            touchpadDevice->handleTouchBegin(xievent->detail,
+                                                             window->convertWindowToNormalizedLocation(Vector2<float>(static_cast<float>(xievent->event_x),
+                                                                                                                      static_cast<float>(xievent->event_y))));
+                            break;
+                        }
+                        case XI_TouchEnd:
                         {
-                            ouzel::input::InputSystemLinux* inputSystemLinux = static_cast<ouzel::input::InputSystemLinux*>(inputManager->getInputSystem());
-                            ouzel::input::TouchpadDevice* touchpadDevice = inputSystemLinux->getTouchpadDevice();
-
-                            switch (cookie->evtype)
-                            {
-                                case XI_TouchBegin:
-                                {
-                                    XIDeviceEvent* xievent = reinterpret_cast<XIDeviceEvent*>(cookie->data);
-                                    touchpadDevice->handleTouchBegin(xievent->detail,
-                                                                     window->convertWindowToNormalizedLocation(Vector2<float>(static_cast<float>(xievent->event_x),
-                                                                                                                              static_cast<float>(xievent->event_y))));
-                                    break;
-                                }
-                                case XI_TouchEnd:
-                                {
-                                    XIDeviceEvent* xievent = reinterpret_cast<XIDeviceEvent*>(cookie->data);
-                                    touchpadDevice->handleTouchEnd(xievent->detail,
-                                                                   window->convertWindowToNormalizedLocation(Vector2<float>(static_cast<float>(xievent->event_x),
-                                                                                                                            static_cast<float>(xievent->event_y))));
-                                    break;
-                                }
-                                case XI_TouchUpdate:
-                                {
-                                    XIDeviceEvent* xievent = reinterpret_cast<XIDeviceEvent*>(cookie->data);
-                                    touchpadDevice->handleTouchMove(xievent->detail,
-                                                                    window->convertWindowToNormalizedLocation(Vector2<float>(static_cast<float>(xievent->event_x),
-                                                                                                                             static_cast<float>(xievent->event_y))));
-                                    break;
-                                }
-                            }
+                            XIDeviceEvent* xievent = reinterpret_cast<XIDeviceEvent*>(cookie->data);
+                            touchpadDevice->handleTouchEnd(xievent->detail,
+                                                           window->convertWindowToNormalizedLocation(Vector2<float>(static_cast<float>(xievent->event_x),
+                                                                                                                    static_cast<float>(xievent->event_y))));
+                            break;
+                        }
+                        case XI_TouchUpdate:
+                        {
+                            XIDeviceEvent* xievent = reinterpret_cast<XIDeviceEvent*>(cookie->data);
+                            touchpadDevice->handleTouchMove(xievent->detail,
+                                                            window->convertWindowToNormalizedLocation(Vector2<float>(static_cast<float>(xievent->event_x),
+                                                                                                                     static_cast<float>(xievent->event_y))));
+                            break;
                         }
-                        break;
                     }
                 }
+                break;
             }
-
-            inputLinux->update();
-        }
-#else
-        while (active)
-        {
-            executeAll();
-
-            inputLinux->update();
         }
+    }
 #endif
 
-        exit();
+    void EngineLinux::exit()
+    {
+        Engine::exit();
+        reactor.wakeUp();
     }
 
     void EngineLinux::executeOnMainThread(const std::function<void()>& func)
     {
-#if OUZEL_SUPPORTS_X11
-        NativeWindowLinux* windowLinux = static_cast<NativeWindowLinux*>(window->getNativeWindow());
-
-        XEvent event;
-        event.type = ClientMessage;
-        event.xclient.window = 0;
-        event.xclient.message_type = executeAtom;
-        event.xclient.format = 32; // data is set as 32-bit integers
-        event.xclient.data.l[0] = 0;
-        event.xclient.data.l[1] = CurrentTime;
-        event.xclient.data.l[2] = 0; // unused
-        event.xclient.data.l[3] = 0; // unused
-        event.xclient.data.l[4] = 0; // unused
-
         std::unique_lock<std::mutex> lock(executeMutex);
         executeQueue.push(func);
         lock.unlock();
 
-        if (!XSendEvent(display, windowLinux->getNativeWindow(), False, NoEventMask, &event))
-            throw std::runtime_error("Failed to send X11 delete message");
-
-        XFlush(display);
-#else
-        std::unique_lock<std::mutex> lock(executeMutex);
-        executeQueue.push(func);
-#endif
+        reactor.wakeUp();
     }
 
     void EngineLinux::openURL(const std::string& url)
@@ -512,7 +514,7 @@ namespace ouzel
 
 #if OUZEL_SUPPORTS_X11
         executeOnMainThread([this, newScreenSaverEnabled]() {
-            XScreenSaverSuspend(display, !newScreenSaverEnabled);
+            if (display) XScreenSaverSuspend(display, !newScreenSaverEnabled);
         });
 #endif
     }
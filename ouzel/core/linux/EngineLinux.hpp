@@ -10,6 +10,7 @@
 #  include <bcm_host.h>
 #endif
 #include "core/Engine.hpp"
+#include "core/linux/ReactorLinux.hpp"
 
 namespace ouzel
 {
@@ -20,13 +21,18 @@ namespace ouzel
         ~EngineLinux();
 
         void run();
+        // also wakes up the main thread
+        void exit() override;
 
         void executeOnMainThread(const std::function<void()>& func) override;
         void openURL(const std::string& url) override;
 
         void setScreenSaverEnabled(bool newScreenSaverEnabled) override;
 
+        inline ReactorLinux& getReactor() { return reactor; }
+
 #if OUZEL_SUPPORTS_X11
+        // null if the engine runs without a display
         inline Display* getDisplay() const { return display; }
 #else
         inline DISPMANX_DISPLAY_HANDLE_T getDisplay() const { return display; }
@@ -34,13 +40,18 @@ namespace ouzel
 
     private:
         void executeAll();
+#if OUZEL_SUPPORTS_X11
+        void handleXEvent(XEvent& event);
+#endif
+
+        ReactorLinux reactor;
 
         std::queue<std::function<void()>> executeQueue;
         std::mutex executeMutex;
-        Atom executeAtom = None;
 
 #if OUZEL_SUPPORTS_X11
         Display* display = nullptr;
+        int xInputOpCode = 0;
 #else
         DISPMANX_DISPLAY_HANDLE_T display = DISPMANX_NO_HANDLE;
 #endif
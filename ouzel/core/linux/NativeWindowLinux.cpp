@@ -39,6 +39,16 @@ namespace ouzel
         EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
         display = engineLinux->getDisplay();
 
+        if (!display)
+        {
+            // only the empty renderer can run without a window
+            if (graphicsDriver != graphics::Driver::EMPTY)
+                throw std::runtime_error("Failed to open display");
+
+            resolution = size;
+            return;
+        }
+
         Screen* screen = XDefaultScreenOfDisplay(display);
         int screenIndex = XScreenNumberOfScreen(screen);
 
@@ -240,6 +250,12 @@ namespace ouzel
     void NativeWindowLinux::close()
     {
 #if OUZEL_SUPPORTS_X11
+        if (!display)
+        {
+            engine->exit();
+            return;
+        }
+
         if (!protocolsAtom || !deleteAtom) return;
 
         XEvent event;
@@ -262,20 +278,23 @@ namespace ouzel
         size = newSize;
 
 #if OUZEL_SUPPORTS_X11
-        XWindowChanges changes;
-        changes.width = static_cast<int>(size.v[0]);
-        changes.height = static_cast<int>(size.v[1]);
-        XConfigureWindow(display, window, CWWidth | CWHeight, &changes);
-
-        if (!resizable)
+        if (display)
         {
-            XSizeHints sizeHints;
-            sizeHints.flags = PMinSize | PMaxSize;
-            sizeHints.min_width = static_cast<int>(size.v[0]);
-            sizeHints.max_width = static_cast<int>(size.v[0]);
-            sizeHints.min_height = static_cast<int>(size.v[1]);
-            sizeHints.max_height = static_cast<int>(size.v[1]);
-            XSetWMNormalHints(display, window, &sizeHints);
+            XWindowChanges changes;
+            changes.width = static_cast<int>(size.v[0]);
+            changes.height = static_cast<int>(size.v[1]);
+            XConfigureWindow(display, window, CWWidth | CWHeight, &changes);
+
+            if (!resizable)
+            {
+                XSizeHints sizeHints;
+                sizeHints.flags = PMinSize | PMaxSize;
+                sizeHints.min_width = static_cast<int>(size.v[0]);
+                sizeHints.max_width = static_cast<int>(size.v[0]);
+                sizeHints.min_height = static_cast<int>(size.v[1]);
+                sizeHints.max_height = static_cast<int>(size.v[1]);
+                XSetWMNormalHints(display, window, &sizeHints);
+            }
         }
 
         resolution = size;
@@ -289,7 +308,7 @@ namespace ouzel
     void NativeWindowLinux::setFullscreen(bool newFullscreen)
     {
 #if OUZEL_SUPPORTS_X11
-        if (fullscreen != newFullscreen)
+        if (display && fullscreen != newFullscreen)
         {
             if (!stateAtom)
                 throw std::runtime_error("State atom is null");
@@ -319,7 +338,7 @@ namespace ouzel
     void NativeWindowLinux::setTitle(const std::string& newTitle)
     {
 #if OUZEL_SUPPORTS_X11
-        if (title != newTitle) XStoreName(display, window, newTitle.c_str());
+        if (display && title != newTitle) XStoreName(display, window, newTitle.c_str());
 #endif
 
         title = newTitle;
@@ -0,0 +1,110 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "ReactorLinux.hpp"
+
+namespace ouzel
+{
+    static constexpr int MAX_EVENTS = 32;
+
+    ReactorLinux::ReactorLinux()
+    {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd == -1)
+            throw std::system_error(errno, std::system_category(), "Failed to create epoll instance");
+
+        eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (eventFd == -1)
+        {
+            int error = errno;
+            close(epollFd);
+            throw std::system_error(error, std::system_category(), "Failed to create eventfd");
+        }
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = eventFd;
+
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, eventFd, &event) == -1)
+        {
+            int error = errno;
+            close(eventFd);
+            close(epollFd);
+            throw std::system_error(error, std::system_category(), "Failed to add eventfd to epoll");
+        }
+    }
+
+    ReactorLinux::~ReactorLinux()
+    {
+        if (eventFd != -1) close(eventFd);
+        if (epollFd != -1) close(epollFd);
+    }
+
+    void ReactorLinux::addFd(int fd, const std::function<void()>& handler)
+    {
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1)
+            throw std::system_error(errno, std::system_category(), "Failed to add file descriptor to epoll");
+
+        handlers[fd] = std::make_shared<std::function<void()>>(handler);
+    }
+
+    void ReactorLinux::removeFd(int fd)
+    {
+        auto i = handlers.find(fd);
+        if (i != handlers.end())
+        {
+            // the descriptor may already be closed, which removes it from the epoll set
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            handlers.erase(i);
+        }
+    }
+
+    void ReactorLinux::wakeUp()
+    {
+        uint64_t value = 1;
+        while (write(eventFd, &value, sizeof(value)) == -1 && errno == EINTR);
+    }
+
+    void ReactorLinux::poll(int timeout)
+    {
+        epoll_event events[MAX_EVENTS];
+
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
+
+        if (count == -1)
+        {
+            if (errno == EINTR) return;
+            throw std::system_error(errno, std::system_category(), "Failed to wait for events");
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            int fd = events[i].data.fd;
+
+            if (fd == eventFd)
+            {
+                uint64_t value;
+                while (read(eventFd, &value, sizeof(value)) == -1 && errno == EINTR);
+            }
+            else
+            {
+                // the handler of an earlier descriptor could have removed this one
+                auto handlerIterator = handlers.find(fd);
+                if (handlerIterator != handlers.end())
+                {
+                    std::shared_ptr<std::function<void()>> handler = handlerIterator->second;
+                    (*handler)();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_CORE_REACTORLINUX_HPP
+#define OUZEL_CORE_REACTORLINUX_HPP
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace ouzel
+{
+    // waits on all file descriptors of the main thread (X connection, input devices, inotify) with one epoll instance
+    // other threads wake it up through an eventfd
+    class ReactorLinux final
+    {
+    public:
+        ReactorLinux();
+        ~ReactorLinux();
+
+        ReactorLinux(const ReactorLinux&) = delete;
+        ReactorLinux& operator=(const ReactorLinux&) = delete;
+
+        ReactorLinux(ReactorLinux&&) = delete;
+        ReactorLinux& operator=(ReactorLinux&&) = delete;
+
+        // the handler is called on the main thread when the descriptor becomes readable
+        void addFd(int fd, const std::function<void()>& handler);
+        void removeFd(int fd);
+
+        // can be called from any thread
+        void wakeUp();
+
+        // waits until at least one descriptor is readable or wakeUp is called and calls the handlers
+        // timeout is in milliseconds, -1 waits indefinitely
+        void poll(int timeout = -1);
+
+    private:
+        int epollFd = -1;
+        int eventFd = -1;
+
+        // handlers are shared, so that a handler can remove its own descriptor
+        std::unordered_map<int, std::shared_ptr<std::function<void()>>> handlers;
+    };
+}
+
+#endif // OUZEL_CORE_REACTORLINUX_HPP
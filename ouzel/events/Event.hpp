@@ -64,6 +64,7 @@ namespace ouzel
             ORIENTATION_CHANGE,
             LOW_MEMORY,
             OPEN_FILE,
+            ASSET_RELOAD, // asset was reloaded from its modified file
 
             // UI events
             ACTOR_ENTER, // mouse or touch entered the scene actor
@@ -85,6 +86,7 @@ namespace ouzel
             SOUND_FINISH,
 
             UPDATE,
+            FIXED_UPDATE, // update with the fixed update interval as the delta
 
             USER // user defined event
         };
@@ -150,7 +152,7 @@ namespace ouzel
         };
 
         Orientation orientation;
-        std::string filename;
+        std::string filename; // OPEN_FILE and ASSET_RELOAD
     };
 
     namespace scene
@@ -3,173 +3,296 @@
 #include <algorithm>
 #include "EventDispatcher.hpp"
 #include "EventHandler.hpp"
+#include "utils/Profiler.hpp"
 #include "utils/Utils.hpp"
 
 namespace ouzel
 {
-    EventDispatcher::EventDispatcher()
+    template<class T>
+    static bool dispatch(const std::vector<EventHandler*>& eventHandlers,
+                         std::function<bool(const T&)> EventHandler::* handler,
+                         const T& event)
+    {
+        // handlers added during dispatching are not inserted until the next dispatchEvents, so the list does not change
+        for (size_t i = 0; i < eventHandlers.size(); ++i)
+        {
+            const EventHandler* eventHandler = eventHandlers[i];
+
+            if (eventHandler && eventHandler->*handler && (eventHandler->*handler)(event))
+                return true;
+        }
+
+        return false;
+    }
+
+    EventDispatcher::EventDispatcher():
+        eventQueue(EVENT_QUEUE_SIZE)
     {
     }
 
     EventDispatcher::~EventDispatcher()
     {
+        QueuedEvent queuedEvent;
+        while (popEvent(queuedEvent))
+        {
+            if (queuedEvent.promise)
+            {
+                queuedEvent.promise->set_value(false);
+                delete queuedEvent.promise;
+            }
+            queuedEvent.release(queuedEvent.event);
+        }
+
         for (EventHandler* eventHandler : eventHandlerAddSet)
             eventHandler->eventDispatcher = nullptr;
 
-        for (EventHandler* eventHandler : eventHandlers)
+        for (const std::vector<EventHandler*>& categoryEventHandlers : eventHandlers)
         {
-            auto i = std::find(eventHandlerDeleteSet.begin(), eventHandlerDeleteSet.end(), eventHandler);
-            if (i == eventHandlerDeleteSet.end()) eventHandler->eventDispatcher = nullptr;
+            for (EventHandler* eventHandler : categoryEventHandlers)
+            {
+                if (eventHandler)
+                {
+                    eventHandler->eventDispatcher = nullptr;
+                    eventHandler->categories = 0;
+                }
+            }
         }
-    }
 
-    void EventDispatcher::dispatchEvents()
-    {
-        for (EventHandler* eventHandler : eventHandlerDeleteSet)
+        for (EventHandler* eventHandler : partialEventHandlers)
         {
-            auto i = std::find(eventHandlers.begin(), eventHandlers.end(), eventHandler);
-
-            if (i != eventHandlers.end())
-                eventHandlers.erase(i);
+            if (eventHandler)
+            {
+                eventHandler->eventDispatcher = nullptr;
+                eventHandler->partial = false;
+            }
         }
+    }
 
-        eventHandlerDeleteSet.clear();
+    void EventDispatcher::updateEventHandlers()
+    {
+        // functions set after the handlers were added
+        for (EventHandler* eventHandler : partialEventHandlers)
+            if (eventHandler && (eventHandler->getFunctionCategories() & ~eventHandler->categories))
+                eventHandlerAddSet.insert(eventHandler);
 
-        for (EventHandler* eventHandler : eventHandlerAddSet)
+        if (!removedEventHandlers && eventHandlerAddSet.empty()) return;
+
+        for (uint32_t category = 0; category < EventHandler::CATEGORY_COUNT; ++category)
         {
-            auto i = std::find(eventHandlers.begin(), eventHandlers.end(), eventHandler);
+            std::vector<EventHandler*>& categoryEventHandlers = eventHandlers[category];
+
+            if (removedEventHandlers)
+                categoryEventHandlers.erase(std::remove(categoryEventHandlers.begin(), categoryEventHandlers.end(), nullptr),
+                                            categoryEventHandlers.end());
+
+            bool changed = removedEventHandlers > 0;
 
-            if (i == eventHandlers.end())
+            for (EventHandler* eventHandler : eventHandlerAddSet)
             {
-                auto upperBound = std::upper_bound(eventHandlers.begin(), eventHandlers.end(), eventHandler,
+                const uint32_t categoryBit = 1U << category;
+                if ((eventHandler->categories & categoryBit) ||
+                    !(eventHandler->getFunctionCategories() & categoryBit)) continue;
+
+                auto upperBound = std::upper_bound(categoryEventHandlers.begin(), categoryEventHandlers.end(), eventHandler,
                                                    [](const EventHandler* a, const EventHandler* b) {
                                                        return a->priority > b->priority;
                                                    });
 
-                eventHandlers.insert(upperBound, eventHandler);
+                categoryEventHandlers.insert(upperBound, eventHandler);
+                eventHandler->categories |= 1U << category;
+                changed = true;
             }
-        }
 
-        eventHandlerAddSet.clear();
+            if (changed)
+                for (size_t i = 0; i < categoryEventHandlers.size(); ++i)
+                    categoryEventHandlers[i]->positions[category] = i;
+        }
 
-        std::pair<std::promise<bool>, std::unique_ptr<Event>> event;
+        partialEventHandlers.erase(std::remove_if(partialEventHandlers.begin(), partialEventHandlers.end(),
+                                                  [](EventHandler* eventHandler) {
+                                                      if (!eventHandler) return true;
+                                                      if (eventHandler->categories != EventHandler::ALL_CATEGORIES) return false;
+                                                      eventHandler->partial = false;
+                                                      return true;
+                                                  }),
+                                   partialEventHandlers.end());
 
-        for (;;)
+        for (EventHandler* eventHandler : eventHandlerAddSet)
         {
-            std::unique_lock<std::mutex> lock(eventQueueMutex);
-            if (eventQueue.empty()) break;
+            if (!eventHandler->partial && eventHandler->categories != EventHandler::ALL_CATEGORIES)
+            {
+                eventHandler->partial = true;
+                partialEventHandlers.push_back(eventHandler);
+            }
+        }
 
-            event = std::move(eventQueue.front());
-            eventQueue.pop();
-            lock.unlock();
+        for (size_t i = 0; i < partialEventHandlers.size(); ++i)
+            partialEventHandlers[i]->partialPosition = i;
 
-            event.first.set_value(dispatchEvent(std::move(event.second)));
-        }
+        removedEventHandlers = 0;
+        eventHandlerAddSet.clear();
     }
 
-    bool EventDispatcher::dispatchEvent(std::unique_ptr<Event>&& event)
+    void EventDispatcher::dispatchEvents()
     {
-        if (!event) return false;
+        OUZEL_PROFILE_ZONE("EventDispatcher::dispatchEvents");
 
-        bool handled = false;
+        updateEventHandlers();
 
-        for (const EventHandler* eventHandler : eventHandlers)
+        QueuedEvent queuedEvent;
+
+        while (popEvent(queuedEvent))
         {
-            auto i = std::find(eventHandlerDeleteSet.begin(), eventHandlerDeleteSet.end(), eventHandler);
+            bool handled = dispatchEvent(*queuedEvent.event);
 
-            if (i == eventHandlerDeleteSet.end())
+            if (queuedEvent.promise)
             {
-                switch (event->type)
-                {
-                    case Event::Type::KEYBOARD_CONNECT:
-                    case Event::Type::KEYBOARD_DISCONNECT:
-                    case Event::Type::KEY_PRESS:
-                    case Event::Type::KEY_RELEASE:
-                        if (eventHandler->keyboardHandler)
-                            handled = eventHandler->keyboardHandler(*static_cast<KeyboardEvent*>(event.get()));
-                        break;
-                    case Event::Type::MOUSE_CONNECT:
-                    case Event::Type::MOUSE_DISCONNECT:
-                    case Event::Type::MOUSE_PRESS:
-                    case Event::Type::MOUSE_RELEASE:
-                    case Event::Type::MOUSE_SCROLL:
-                    case Event::Type::MOUSE_MOVE:
-                    case Event::Type::MOUSE_CURSOR_LOCK_CHANGE:
-                        if (eventHandler->mouseHandler)
-                            handled = eventHandler->mouseHandler(*static_cast<MouseEvent*>(event.get()));
-                        break;
-                    case Event::Type::TOUCHPAD_CONNECT:
-                    case Event::Type::TOUCHPAD_DISCONNECT:
-                    case Event::Type::TOUCH_BEGIN:
-                    case Event::Type::TOUCH_MOVE:
-                    case Event::Type::TOUCH_END:
-                    case Event::Type::TOUCH_CANCEL:
-                        if (eventHandler->touchHandler)
-                            handled = eventHandler->touchHandler(*static_cast<TouchEvent*>(event.get()));
-                        break;
-                    case Event::Type::GAMEPAD_CONNECT:
-                    case Event::Type::GAMEPAD_DISCONNECT:
-                    case Event::Type::GAMEPAD_BUTTON_CHANGE:
-                        if (eventHandler->gamepadHandler)
-                            handled = eventHandler->gamepadHandler(*static_cast<GamepadEvent*>(event.get()));
-                        break;
-                    case Event::Type::WINDOW_SIZE_CHANGE:
-                    case Event::Type::WINDOW_TITLE_CHANGE:
-                    case Event::Type::FULLSCREEN_CHANGE:
-                    case Event::Type::SCREEN_CHANGE:
-                    case Event::Type::RESOLUTION_CHANGE:
-                        if (eventHandler->windowHandler)
-                            handled = eventHandler->windowHandler(*static_cast<WindowEvent*>(event.get()));
-                        break;
-                    case Event::Type::ENGINE_START:
-                    case Event::Type::ENGINE_STOP:
-                    case Event::Type::ENGINE_RESUME:
-                    case Event::Type::ENGINE_PAUSE:
-                    case Event::Type::ORIENTATION_CHANGE:
-                    case Event::Type::LOW_MEMORY:
-                    case Event::Type::OPEN_FILE:
-                        if (eventHandler->systemHandler)
-                            handled = eventHandler->systemHandler(*static_cast<SystemEvent*>(event.get()));
-                        break;
-                    case Event::Type::ACTOR_ENTER:
-                    case Event::Type::ACTOR_LEAVE:
-                    case Event::Type::ACTOR_PRESS:
-                    case Event::Type::ACTOR_RELEASE:
-                    case Event::Type::ACTOR_CLICK:
-                    case Event::Type::ACTOR_DRAG:
-                    case Event::Type::WIDGET_CHANGE:
-                        if (eventHandler->uiHandler)
-                            handled = eventHandler->uiHandler(*static_cast<UIEvent*>(event.get()));
-                        break;
-                    case Event::Type::ANIMATION_START:
-                    case Event::Type::ANIMATION_RESET:
-                    case Event::Type::ANIMATION_FINISH:
-                        if (eventHandler->animationHandler)
-                            handled = eventHandler->animationHandler(*static_cast<AnimationEvent*>(event.get()));
-                        break;
-                    case Event::Type::SOUND_START:
-                    case Event::Type::SOUND_RESET:
-                    case Event::Type::SOUND_FINISH:
-                        if (eventHandler->soundHandler)
-                            handled = eventHandler->soundHandler(*static_cast<SoundEvent*>(event.get()));
-                        break;
-                    case Event::Type::UPDATE:
-                        if (eventHandler->updateHandler)
-                            handled = eventHandler->updateHandler(*static_cast<UpdateEvent*>(event.get()));
-                        break;
-                    case Event::Type::USER:
-                        if (eventHandler->userHandler)
-                            handled = eventHandler->userHandler(*static_cast<UserEvent*>(event.get()));
-                        break;
-                    default:
-                        return false; // custom event should not be sent
-                }
+                queuedEvent.promise->set_value(handled);
+                delete queuedEvent.promise;
             }
 
-            if (handled) break;
+            queuedEvent.release(queuedEvent.event);
+        }
+    }
+
+    void EventDispatcher::pushEvent(QueuedEvent&& queuedEvent)
+    {
+#if defined(__EMSCRIPTEN__)
+        bool handled = dispatchEvent(*queuedEvent.event);
+        if (queuedEvent.promise)
+        {
+            queuedEvent.promise->set_value(handled);
+            delete queuedEvent.promise;
+        }
+        queuedEvent.release(queuedEvent.event);
+#else
+        // once an event has overflowed, the following ones must not overtake it through the lock-free queue
+        if (overflowCount == 0 && eventQueue.push(std::move(queuedEvent)))
+            return;
+
+        std::unique_lock<std::mutex> lock(overflowQueueMutex);
+        overflowQueue.push(std::move(queuedEvent));
+        ++overflowCount;
+#endif
+    }
+
+    bool EventDispatcher::popEvent(QueuedEvent& queuedEvent)
+    {
+        // events in the lock-free queue are older than the overflowed ones
+        if (eventQueue.pop(queuedEvent)) return true;
+        if (overflowCount == 0) return false;
+
+        std::unique_lock<std::mutex> lock(overflowQueueMutex);
+        if (overflowQueue.empty()) return false;
+
+        queuedEvent = overflowQueue.front();
+        overflowQueue.pop();
+        --overflowCount;
+        return true;
+    }
+
+    bool EventDispatcher::dispatchEvent(const Event& event)
+    {
+        switch (event.type)
+        {
+            case Event::Type::KEYBOARD_CONNECT:
+            case Event::Type::KEYBOARD_DISCONNECT:
+            case Event::Type::KEY_PRESS:
+            case Event::Type::KEY_RELEASE:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_KEYBOARD], &EventHandler::keyboardHandler,
+                                static_cast<const KeyboardEvent&>(event));
+            case Event::Type::MOUSE_CONNECT:
+            case Event::Type::MOUSE_DISCONNECT:
+            case Event::Type::MOUSE_PRESS:
+            case Event::Type::MOUSE_RELEASE:
+            case Event::Type::MOUSE_SCROLL:
+            case Event::Type::MOUSE_MOVE:
+            case Event::Type::MOUSE_CURSOR_LOCK_CHANGE:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_MOUSE], &EventHandler::mouseHandler,
+                                static_cast<const MouseEvent&>(event));
+            case Event::Type::TOUCHPAD_CONNECT:
+            case Event::Type::TOUCHPAD_DISCONNECT:
+            case Event::Type::TOUCH_BEGIN:
+            case Event::Type::TOUCH_MOVE:
+            case Event::Type::TOUCH_END:
+            case Event::Type::TOUCH_CANCEL:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_TOUCH], &EventHandler::touchHandler,
+                                static_cast<const TouchEvent&>(event));
+            case Event::Type::GAMEPAD_CONNECT:
+            case Event::Type::GAMEPAD_DISCONNECT:
+            case Event::Type::GAMEPAD_BUTTON_CHANGE:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_GAMEPAD], &EventHandler::gamepadHandler,
+                                static_cast<const GamepadEvent&>(event));
+            case Event::Type::WINDOW_SIZE_CHANGE:
+            case Event::Type::WINDOW_TITLE_CHANGE:
+            case Event::Type::FULLSCREEN_CHANGE:
+            case Event::Type::SCREEN_CHANGE:
+            case Event::Type::RESOLUTION_CHANGE:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_WINDOW], &EventHandler::windowHandler,
+                                static_cast<const WindowEvent&>(event));
+            case Event::Type::ENGINE_START:
+            case Event::Type::ENGINE_STOP:
+            case Event::Type::ENGINE_RESUME:
+            case Event::Type::ENGINE_PAUSE:
+            case Event::Type::ORIENTATION_CHANGE:
+            case Event::Type::LOW_MEMORY:
+            case Event::Type::OPEN_FILE:
+            case Event::Type::ASSET_RELOAD:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_SYSTEM], &EventHandler::systemHandler,
+                                static_cast<const SystemEvent&>(event));
+            case Event::Type::ACTOR_ENTER:
+            case Event::Type::ACTOR_LEAVE:
+            case Event::Type::ACTOR_PRESS:
+            case Event::Type::ACTOR_RELEASE:
+            case Event::Type::ACTOR_CLICK:
+            case Event::Type::ACTOR_DRAG:
+            case Event::Type::WIDGET_CHANGE:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_UI], &EventHandler::uiHandler,
+                                static_cast<const UIEvent&>(event));
+            case Event::Type::ANIMATION_START:
+            case Event::Type::ANIMATION_RESET:
+            case Event::Type::ANIMATION_FINISH:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_ANIMATION], &EventHandler::animationHandler,
+                                static_cast<const AnimationEvent&>(event));
+            case Event::Type::SOUND_START:
+            case Event::Type::SOUND_RESET:
+            case Event::Type::SOUND_FINISH:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_SOUND], &EventHandler::soundHandler,
+                                static_cast<const SoundEvent&>(event));
+            case Event::Type::UPDATE:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_UPDATE], &EventHandler::updateHandler,
+                                static_cast<const UpdateEvent&>(event));
+            case Event::Type::FIXED_UPDATE:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_FIXED_UPDATE], &EventHandler::fixedUpdateHandler,
+                                static_cast<const UpdateEvent&>(event));
+            case Event::Type::USER:
+                return dispatch(eventHandlers[EventHandler::CATEGORY_USER], &EventHandler::userHandler,
+                                static_cast<const UserEvent&>(event));
+            default:
+                return false; // custom event should not be sent
         }
+    }
+
+    bool EventDispatcher::dispatchUpdate(float delta)
+    {
+        OUZEL_PROFILE_ZONE("EventDispatcher::dispatchUpdate");
+
+        UpdateEvent event;
+        event.type = Event::Type::UPDATE;
+        event.delta = delta;
+
+        return dispatch(eventHandlers[EventHandler::CATEGORY_UPDATE], &EventHandler::updateHandler, event);
+    }
+
+    bool EventDispatcher::dispatchFixedUpdate(float interval)
+    {
+        OUZEL_PROFILE_ZONE("EventDispatcher::dispatchFixedUpdate");
 
-        return handled;
+        UpdateEvent event;
+        event.type = Event::Type::FIXED_UPDATE;
+        event.delta = interval;
+
+        return dispatch(eventHandlers[EventHandler::CATEGORY_FIXED_UPDATE], &EventHandler::fixedUpdateHandler, event);
     }
 
     void EventDispatcher::addEventHandler(EventHandler* eventHandler)
@@ -180,19 +303,31 @@ namespace ouzel
         eventHandler->eventDispatcher = this;
 
         eventHandlerAddSet.insert(eventHandler);
-
-        auto setIterator = eventHandlerDeleteSet.find(eventHandler);
-
-        if (setIterator != eventHandlerDeleteSet.end())
-            eventHandlerDeleteSet.erase(setIterator);
     }
 
     void EventDispatcher::removeEventHandler(EventHandler* eventHandler)
     {
-        if (eventHandler->eventDispatcher == this)
-            eventHandler->eventDispatcher = nullptr;
+        if (eventHandler->eventDispatcher != this) return;
+
+        eventHandler->eventDispatcher = nullptr;
+
+        // leave a tombstone in every list the handler is in, they are removed in the next dispatchEvents
+        for (uint32_t category = 0; category < EventHandler::CATEGORY_COUNT; ++category)
+        {
+            if (eventHandler->categories & (1U << category))
+            {
+                eventHandlers[category][eventHandler->positions[category]] = nullptr;
+                ++removedEventHandlers;
+            }
+        }
+
+        eventHandler->categories = 0;
 
-        eventHandlerDeleteSet.insert(eventHandler);
+        if (eventHandler->partial)
+        {
+            partialEventHandlers[eventHandler->partialPosition] = nullptr;
+            eventHandler->partial = false;
+        }
 
         auto setIterator = eventHandlerAddSet.find(eventHandler);
 
@@ -202,15 +337,20 @@ namespace ouzel
 
     std::future<bool> EventDispatcher::postEvent(std::unique_ptr<Event>&& event)
     {
-        std::promise<bool> promise;
-        std::future<bool> future = promise.get_future();
+        QueuedEvent queuedEvent;
+        queuedEvent.promise = new std::promise<bool>();
+        std::future<bool> future = queuedEvent.promise->get_future();
 
-#if defined(__EMSCRIPTEN__)
-        promise.set_value(dispatchEvent(std::move(event)));
-#else
-        std::unique_lock<std::mutex> lock(eventQueueMutex);
-        eventQueue.push(std::pair<std::promise<bool>, std::unique_ptr<Event>>(std::move(promise), std::move(event)));
-#endif
+        if (!event)
+        {
+            queuedEvent.promise->set_value(false);
+            delete queuedEvent.promise;
+            return future;
+        }
+
+        queuedEvent.event = event.release();
+        queuedEvent.release = &deleteEvent<Event>;
+        pushEvent(std::move(queuedEvent));
 
         return future;
     }
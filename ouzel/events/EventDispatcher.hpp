@@ -3,14 +3,17 @@
 #ifndef OUZEL_EVENTS_EVENTDISPATCHER_HPP
 #define OUZEL_EVENTS_EVENTDISPATCHER_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <vector>
 #include "events/Event.hpp"
 #include "events/EventHandler.hpp"
+#include "utils/LockFreeQueue.hpp"
 
 namespace ouzel
 {
@@ -30,21 +33,108 @@ namespace ouzel
         void removeEventHandler(EventHandler* eventHandler);
 
         // dispatches the event immediately
-        bool dispatchEvent(std::unique_ptr<Event>&& event);
+        bool dispatchEvent(const Event& event);
+        inline bool dispatchEvent(std::unique_ptr<Event>&& event)
+        {
+            return event ? dispatchEvent(*event) : false;
+        }
+
+        // dispatches the update event immediately without allocating it
+        bool dispatchUpdate(float delta);
+        bool dispatchFixedUpdate(float interval);
 
         // posts the event for dispatching on the game thread
         std::future<bool> postEvent(std::unique_ptr<Event>&& event);
 
+        // returns an event from the pool of its type, it is returned to the pool after it is dispatched by queueEvent
+        template<class T>
+        static std::unique_ptr<T> createEvent()
+        {
+            T* event;
+            if (getPool<T>().pop(event)) return std::unique_ptr<T>(event);
+            return std::unique_ptr<T>(new T());
+        }
+
+        // posts the event for dispatching on the game thread without a result (no promise is allocated)
+        template<class T>
+        void queueEvent(std::unique_ptr<T>&& event)
+        {
+            QueuedEvent queuedEvent;
+            queuedEvent.event = event.release();
+            queuedEvent.release = &releaseEvent<T>;
+            pushEvent(std::move(queuedEvent));
+        }
+
         // dispatches all queued events on the game thread
         void dispatchEvents();
 
     private:
-        std::vector<EventHandler*> eventHandlers;
+        struct QueuedEvent final
+        {
+            Event* event = nullptr;
+            void (*release)(Event*) = nullptr;
+            std::promise<bool>* promise = nullptr;
+        };
+
+        // events of one type that can be reused
+        template<class T>
+        class Pool final
+        {
+        public:
+            Pool(): events(EVENT_POOL_SIZE) {}
+            ~Pool()
+            {
+                T* event;
+                while (events.pop(event)) delete event;
+            }
+
+            inline bool push(T* event) { return events.push(std::move(event)); }
+            inline bool pop(T*& event) { return events.pop(event); }
+
+        private:
+            LockFreeQueue<T*> events;
+        };
+
+        static constexpr size_t EVENT_POOL_SIZE = 256;
+        static constexpr size_t EVENT_QUEUE_SIZE = 4096;
+
+        template<class T>
+        static Pool<T>& getPool()
+        {
+            static Pool<T> pool;
+            return pool;
+        }
+
+        template<class T>
+        static void releaseEvent(Event* event)
+        {
+            T* typedEvent = static_cast<T*>(event);
+            *typedEvent = T();
+            if (!getPool<T>().push(typedEvent)) delete typedEvent;
+        }
+
+        template<class T>
+        static void deleteEvent(Event* event)
+        {
+            delete static_cast<T*>(event);
+        }
+
+        void pushEvent(QueuedEvent&& queuedEvent);
+        bool popEvent(QueuedEvent& queuedEvent);
+        void updateEventHandlers();
+
+        // handlers of every category sorted by priority, removed handlers are replaced with nullptr until the next dispatchEvents
+        std::vector<EventHandler*> eventHandlers[EventHandler::CATEGORY_COUNT];
         std::set<EventHandler*> eventHandlerAddSet;
-        std::set<EventHandler*> eventHandlerDeleteSet;
+        // added handlers that are not in every list, removed handlers are replaced with nullptr
+        std::vector<EventHandler*> partialEventHandlers;
+        size_t removedEventHandlers = 0;
 
-        std::mutex eventQueueMutex;
-        std::queue<std::pair<std::promise<bool>, std::unique_ptr<Event>>> eventQueue;
+        LockFreeQueue<QueuedEvent> eventQueue;
+        // used when the lock-free queue is full, all events go here until it is drained to keep them in order
+        std::atomic<size_t> overflowCount{0};
+        std::mutex overflowQueueMutex;
+        std::queue<QueuedEvent> overflowQueue;
     };
 }
 
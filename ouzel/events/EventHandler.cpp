@@ -10,6 +10,24 @@ namespace ouzel
         if (eventDispatcher) eventDispatcher->removeEventHandler(this);
     }
 
+    uint32_t EventHandler::getFunctionCategories() const
+    {
+        uint32_t result = 0;
+        if (keyboardHandler) result |= 1U << CATEGORY_KEYBOARD;
+        if (mouseHandler) result |= 1U << CATEGORY_MOUSE;
+        if (touchHandler) result |= 1U << CATEGORY_TOUCH;
+        if (gamepadHandler) result |= 1U << CATEGORY_GAMEPAD;
+        if (windowHandler) result |= 1U << CATEGORY_WINDOW;
+        if (systemHandler) result |= 1U << CATEGORY_SYSTEM;
+        if (uiHandler) result |= 1U << CATEGORY_UI;
+        if (animationHandler) result |= 1U << CATEGORY_ANIMATION;
+        if (soundHandler) result |= 1U << CATEGORY_SOUND;
+        if (updateHandler) result |= 1U << CATEGORY_UPDATE;
+        if (fixedUpdateHandler) result |= 1U << CATEGORY_FIXED_UPDATE;
+        if (userHandler) result |= 1U << CATEGORY_USER;
+        return result;
+    }
+
     void EventHandler::remove()
     {
         if (eventDispatcher)
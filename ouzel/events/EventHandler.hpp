@@ -4,6 +4,7 @@
 #define OUZEL_EVENTS_EVENTHANDLER_HPP
 
 #include <functional>
+#include <cstddef>
 #include <cstdint>
 #include "events/Event.hpp"
 
@@ -22,6 +23,7 @@ namespace ouzel
 
         void remove();
 
+        // a function set after the event handler is added to a dispatcher is used from the next EventDispatcher::dispatchEvents
         std::function<bool(const KeyboardEvent&)> keyboardHandler;
         std::function<bool(const MouseEvent&)> mouseHandler;
         std::function<bool(const TouchEvent&)> touchHandler;
@@ -32,11 +34,42 @@ namespace ouzel
         std::function<bool(const AnimationEvent&)> animationHandler;
         std::function<bool(const SoundEvent&)> soundHandler;
         std::function<bool(const UpdateEvent&)> updateHandler;
+        std::function<bool(const UpdateEvent&)> fixedUpdateHandler;
         std::function<bool(const UserEvent&)> userHandler;
 
     private:
+        enum Category
+        {
+            CATEGORY_KEYBOARD,
+            CATEGORY_MOUSE,
+            CATEGORY_TOUCH,
+            CATEGORY_GAMEPAD,
+            CATEGORY_WINDOW,
+            CATEGORY_SYSTEM,
+            CATEGORY_UI,
+            CATEGORY_ANIMATION,
+            CATEGORY_SOUND,
+            CATEGORY_UPDATE,
+            CATEGORY_FIXED_UPDATE,
+            CATEGORY_USER,
+            CATEGORY_COUNT
+        };
+
+        static constexpr uint32_t ALL_CATEGORIES = (1U << CATEGORY_COUNT) - 1;
+
+        // categories that the handler has a function for (bit mask)
+        uint32_t getFunctionCategories() const;
+
         int32_t priority;
         EventDispatcher* eventDispatcher = nullptr;
+
+        // categories in which the handler is registered (bit mask) and its positions in the dispatcher's lists
+        uint32_t categories = 0;
+        size_t positions[CATEGORY_COUNT];
+
+        // handlers that are not in every list are checked for new functions by the dispatcher
+        bool partial = false;
+        size_t partialPosition = 0;
     };
 }
 
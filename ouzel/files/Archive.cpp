@@ -1,75 +1,129 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
+#include <array>
+#include <climits>
 #include <stdexcept>
 #include "Archive.hpp"
 #include "FileSystem.hpp"
 #include "utils/Utils.hpp"
+#include "stb_image.h"
 
 namespace ouzel
 {
-    Archive::Archive(FileSystem& initFileSystem, const std::string& filename):
-        fileSystem(initFileSystem)
+    static constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+    static constexpr uint32_t CENTRAL_DIRECTORY_SIGNATURE = 0x02014b50;
+    static constexpr uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+    static constexpr size_t LOCAL_HEADER_SIZE = 30;
+    static constexpr size_t CENTRAL_DIRECTORY_HEADER_SIZE = 46;
+    static constexpr size_t END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+    static constexpr size_t MAX_COMMENT_SIZE = 0xFFFF;
+
+    static uint32_t calculateCrc32(const uint8_t* data, size_t size)
     {
-        fileSystem.addArchive(this);
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> result;
 
-        file = File(fileSystem.getPath(filename), File::READ);
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t value = i;
+                for (uint32_t bit = 0; bit < 8; ++bit)
+                    value = (value & 1) ? 0xEDB88320 ^ (value >> 1) : value >> 1;
+                result[i] = value;
+            }
 
-        for (;;)
-        {
-            uint32_t signature;
+            return result;
+        }();
 
-            file.read(&signature, sizeof(signature), true);
+        uint32_t crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
 
-            if (decodeUInt32Little(&signature) == 0x02014b50) // central directory
-                break;
+        return crc ^ 0xFFFFFFFF;
+    }
 
-            if (decodeUInt32Little(&signature) != 0x04034b50)
-                throw std::runtime_error("Bad signature");
+    Archive::Archive(FileSystem& initFileSystem, const std::string& filename):
+        fileSystem(initFileSystem)
+    {
+        mapping = FileData(fileSystem.getPath(filename));
 
-            uint8_t version[2];
+        const uint8_t* data = mapping.data();
+        const size_t size = mapping.size();
 
-            file.read(version, sizeof(version), true);
+        if (size < END_OF_CENTRAL_DIRECTORY_SIZE)
+            throw std::runtime_error("Archive " + filename + " is too small");
 
-            uint16_t flags;
+        // the end of central directory record is followed by a comment of variable length
+        size_t endOffset = size - END_OF_CENTRAL_DIRECTORY_SIZE;
+        const size_t endLimit = (size > END_OF_CENTRAL_DIRECTORY_SIZE + MAX_COMMENT_SIZE) ?
+            size - END_OF_CENTRAL_DIRECTORY_SIZE - MAX_COMMENT_SIZE : 0;
 
-            file.read(&flags, sizeof(flags), true);
+        while (decodeUInt32Little(data + endOffset) != END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+        {
+            if (endOffset == endLimit)
+                throw std::runtime_error("Failed to find the central directory of " + filename);
+            --endOffset;
+        }
 
-            uint16_t compression;
-            file.read(&compression, sizeof(compression), true);
+        const uint16_t entryCount = decodeUInt16Little(data + endOffset + 10);
+        const uint32_t directorySize = decodeUInt32Little(data + endOffset + 12);
+        const uint32_t directoryOffset = decodeUInt32Little(data + endOffset + 16);
 
-            if (compression != 0x00)
-                throw std::runtime_error("Unsupported compression");
+        if (directoryOffset > endOffset || directorySize > endOffset - directoryOffset)
+            throw std::runtime_error("Invalid central directory");
 
-            file.seek(4, File::CURRENT); // skip modification time
-            file.seek(4, File::CURRENT); // skip CRC-32
+        entries.reserve(entryCount);
 
-            uint32_t compressedSize;
-            file.read(&compressedSize, sizeof(compressedSize), true);
+        size_t offset = directoryOffset;
+        const size_t directoryEnd = directoryOffset + directorySize;
 
-            uint32_t uncompressedSize;
-            file.read(&uncompressedSize, sizeof(uncompressedSize), true);
+        for (uint16_t i = 0; i < entryCount; ++i)
+        {
+            if (directoryEnd - offset < CENTRAL_DIRECTORY_HEADER_SIZE ||
+                decodeUInt32Little(data + offset) != CENTRAL_DIRECTORY_SIGNATURE)
+                throw std::runtime_error("Bad signature");
+
+            Entry entry;
+            entry.compression = decodeUInt16Little(data + offset + 10);
+            entry.crc32 = decodeUInt32Little(data + offset + 16);
+            entry.compressedSize = decodeUInt32Little(data + offset + 20);
+            entry.size = decodeUInt32Little(data + offset + 24);
+
+            const uint16_t fileNameLength = decodeUInt16Little(data + offset + 28);
+            const uint16_t extraFieldLength = decodeUInt16Little(data + offset + 30);
+            const uint16_t commentLength = decodeUInt16Little(data + offset + 32);
+            const uint32_t localHeaderOffset = decodeUInt32Little(data + offset + 42);
 
-            uint16_t fileNameLength;
-            file.read(&fileNameLength, sizeof(fileNameLength), true);
+            if (directoryEnd - offset < CENTRAL_DIRECTORY_HEADER_SIZE + fileNameLength + extraFieldLength + commentLength)
+                throw std::runtime_error("Invalid central directory");
 
-            uint16_t extraFieldLength;
-            file.read(&extraFieldLength, sizeof(extraFieldLength), true);
+            if (entry.compression != STORED && entry.compression != DEFLATE)
+                throw std::runtime_error("Unsupported compression");
 
-            std::vector<char> name(decodeUInt16Little(&fileNameLength) + 1);
+            std::string name(reinterpret_cast<const char*>(data + offset + CENTRAL_DIRECTORY_HEADER_SIZE), fileNameLength);
 
-            file.read(name.data(), decodeUInt16Little(&fileNameLength), true);
+            // the lengths of the name and the extra field in the local header can differ from the central directory
+            if (size < LOCAL_HEADER_SIZE || localHeaderOffset > size - LOCAL_HEADER_SIZE ||
+                decodeUInt32Little(data + localHeaderOffset) != LOCAL_HEADER_SIGNATURE)
+                throw std::runtime_error("Bad signature");
 
-            name[decodeUInt16Little(&fileNameLength)] = '\0';
+            entry.offset = localHeaderOffset + static_cast<uint32_t>(LOCAL_HEADER_SIZE) +
+                decodeUInt16Little(data + localHeaderOffset + 26) +
+                decodeUInt16Little(data + localHeaderOffset + 28);
 
-            Entry& entry = entries[name.data()];
-            entry.size = decodeUInt32Little(&uncompressedSize);
+            if (entry.offset > size || entry.compressedSize > size - entry.offset)
+                throw std::runtime_error("Entry " + name + " is outside of the archive");
 
-            file.seek(decodeUInt16Little(&extraFieldLength), File::CURRENT); // skip extra field
+            if (entry.compression == STORED && entry.compressedSize != entry.size)
+                throw std::runtime_error("Invalid size of entry " + name);
 
-            entry.offset = file.getOffset();
+            offset += CENTRAL_DIRECTORY_HEADER_SIZE + fileNameLength + extraFieldLength + commentLength;
 
-            file.seek(decodeInt32Little(&uncompressedSize), File::CURRENT); // skip uncompressed size
+            // skip directories
+            if (!name.empty() && name.back() != '/')
+                entries[name] = entry;
         }
+
+        fileSystem.addArchive(this);
     }
 
     Archive::~Archive()
@@ -79,20 +133,38 @@ namespace ouzel
 
     std::vector<uint8_t> Archive::readFile(const std::string& filename) const
     {
-        std::vector<uint8_t> data;
+        return mapFile(filename).toVector();
+    }
 
+    FileData Archive::mapFile(const std::string& filename) const
+    {
         auto i = entries.find(filename);
 
         if (i == entries.end())
             throw std::runtime_error("File " + filename + " does not exist");
 
-        file.seek(static_cast<int32_t>(i->second.offset), File::BEGIN);
+        const Entry& entry = i->second;
+
+        if (entry.compression == STORED)
+            return FileData(mapping, entry.offset, entry.size);
+
+        // stb_image's inflate works with int sizes
+        if (entry.size > INT_MAX || entry.compressedSize > INT_MAX)
+            throw std::runtime_error("File " + filename + " is too big");
+
+        std::vector<uint8_t> data(entry.size);
 
-        data.resize(i->second.size);
+        if (entry.size &&
+            stbi_zlib_decode_noheader_buffer(reinterpret_cast<char*>(data.data()),
+                                             static_cast<int>(data.size()),
+                                             reinterpret_cast<const char*>(mapping.data() + entry.offset),
+                                             static_cast<int>(entry.compressedSize)) != static_cast<int>(entry.size))
+            throw std::runtime_error("Failed to inflate " + filename);
 
-        file.read(data.data(), i->second.size, true);
+        if (calculateCrc32(data.data(), data.size()) != entry.crc32)
+            throw std::runtime_error("CRC mismatch in " + filename);
 
-        return data;
+        return FileData(std::move(data));
     }
 
     bool Archive::fileExists(const std::string& filename) const
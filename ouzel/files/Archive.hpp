@@ -4,15 +4,17 @@
 #define OUZEL_FILES_ARCHIVE_HPP
 
 #include <cstdint>
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include "files/File.hpp"
+#include "files/FileData.hpp"
 
 namespace ouzel
 {
     class FileSystem;
 
+    // zip archive with stored and deflated entries, indexed from the central directory
+    // entries can be read from several threads at the same time
     class Archive final
     {
     public:
@@ -27,20 +29,31 @@ namespace ouzel
         Archive& operator=(Archive&& other) = delete;
 
         std::vector<uint8_t> readFile(const std::string& filename) const;
+        // stored entries are returned without a copy, compressed entries are inflated and checked against their CRC-32
+        FileData mapFile(const std::string& filename) const;
 
         bool fileExists(const std::string& filename) const;
 
     private:
         FileSystem& fileSystem;
-        File file;
+        FileData mapping;
+
+        enum Compression: uint16_t
+        {
+            STORED = 0,
+            DEFLATE = 8
+        };
 
         struct Entry final
         {
             uint32_t offset;
+            uint32_t compressedSize;
             uint32_t size;
+            uint32_t crc32;
+            uint16_t compression;
         };
 
-        std::map<std::string, Entry> entries;
+        std::unordered_map<std::string, Entry> entries;
     };
 }
 
@@ -216,6 +216,21 @@ namespace ouzel
         if (ret == -1)
             throw std::system_error(errno, std::system_category(), "Failed to seek file");
         return static_cast<uint32_t>(ret);
+#endif
+    }
+
+    uint64_t File::getSize() const
+    {
+#if defined(_WIN32)
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+            throw std::system_error(GetLastError(), std::system_category(), "Failed to get file size");
+        return static_cast<uint64_t>(size.QuadPart);
+#else
+        struct stat buf;
+        if (fstat(file, &buf) == -1)
+            throw std::system_error(errno, std::system_category(), "Failed to get file size");
+        return static_cast<uint64_t>(buf.st_size);
 #endif
     }
 }
@@ -3,6 +3,7 @@
 #ifndef OUZEL_FILES_FILE_HPP
 #define OUZEL_FILES_FILE_HPP
 
+#include <cstdint>
 #include <string>
 
 #if defined(_WIN32)
@@ -63,8 +64,11 @@ namespace ouzel
         uint32_t write(const void* buffer, uint32_t size, bool all = false) const;
         void seek(int32_t offset, int method) const;
         uint32_t getOffset() const;
+        uint64_t getSize() const;
 
     private:
+        friend class FileData;
+
 #if defined(_WIN32)
         HANDLE file = INVALID_HANDLE_VALUE;
 #else
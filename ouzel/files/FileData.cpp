@@ -0,0 +1,132 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <stdexcept>
+#include <system_error>
+#if !defined(_WIN32)
+#  include <sys/mman.h>
+#endif
+#include "FileData.hpp"
+#include "File.hpp"
+
+namespace ouzel
+{
+    class FileData::BufferStorage final: public FileData::Storage
+    {
+    public:
+        explicit BufferStorage(std::vector<uint8_t> initBuffer):
+            buffer(std::move(initBuffer))
+        {
+        }
+
+        std::vector<uint8_t> buffer;
+    };
+
+    class FileData::MappedStorage final: public FileData::Storage
+    {
+    public:
+        MappedStorage(void* initAddress, size_t initSize):
+            address(initAddress), size(initSize)
+        {
+        }
+
+        ~MappedStorage()
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(address);
+#else
+            munmap(address, size);
+#endif
+        }
+
+        void* address;
+        size_t size;
+    };
+
+#if defined(__ANDROID__)
+    class FileData::AssetStorage final: public FileData::Storage
+    {
+    public:
+        explicit AssetStorage(AAsset* initAsset):
+            asset(initAsset)
+        {
+        }
+
+        ~AssetStorage()
+        {
+            AAsset_close(asset);
+        }
+
+        AAsset* asset;
+    };
+#endif
+
+    FileData::FileData(std::vector<uint8_t> buffer)
+    {
+        std::shared_ptr<BufferStorage> bufferStorage = std::make_shared<BufferStorage>(std::move(buffer));
+        pointer = bufferStorage->buffer.data();
+        length = bufferStorage->buffer.size();
+        storage = bufferStorage;
+    }
+
+    FileData::FileData(const std::string& filename)
+    {
+        File file(filename, File::Mode::READ);
+
+        uint64_t fileSize = file.getSize();
+        if (fileSize > SIZE_MAX)
+            throw std::runtime_error("File " + filename + " is too big to map");
+
+        // empty files can not be mapped
+        if (fileSize == 0) return;
+
+        size_t size = static_cast<size_t>(fileSize);
+
+#if defined(_WIN32)
+        HANDLE mapping = CreateFileMappingW(file.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+            throw std::system_error(GetLastError(), std::system_category(), "Failed to create file mapping");
+
+        // the view keeps the mapping alive
+        void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        DWORD error = GetLastError();
+        CloseHandle(mapping);
+
+        if (!address)
+            throw std::system_error(error, std::system_category(), "Failed to map file");
+#else
+        void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.file, 0);
+        if (address == MAP_FAILED)
+            throw std::system_error(errno, std::system_category(), "Failed to map file");
+#endif
+
+        storage = std::make_shared<MappedStorage>(address, size);
+        pointer = static_cast<const uint8_t*>(address);
+        length = size;
+    }
+
+#if defined(__ANDROID__)
+    FileData::FileData(AAsset* asset)
+    {
+        std::shared_ptr<AssetStorage> assetStorage = std::make_shared<AssetStorage>(asset);
+
+        // uncompressed assets are mapped by the asset manager
+        const void* buffer = AAsset_getBuffer(asset);
+        if (!buffer)
+            throw std::runtime_error("Failed to read asset");
+
+        pointer = static_cast<const uint8_t*>(buffer);
+        length = static_cast<size_t>(AAsset_getLength(asset));
+        storage = assetStorage;
+    }
+#endif
+
+    FileData::FileData(const FileData& other, size_t offset, size_t size):
+        storage(other.storage)
+    {
+        if (offset > other.length || size > other.length - offset)
+            throw std::out_of_range("Range is outside of the file data");
+
+        pointer = other.pointer + offset;
+        length = size;
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_FILES_FILEDATA_HPP
+#define OUZEL_FILES_FILEDATA_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__ANDROID__)
+#  include <android/asset_manager.h>
+#endif
+
+namespace ouzel
+{
+    // immutable, reference counted view of the contents of a file
+    // the contents are either memory mapped or stored in a buffer, copies share the storage
+    class FileData final
+    {
+    public:
+        FileData() {}
+        // takes the ownership of the buffer
+        explicit FileData(std::vector<uint8_t> buffer);
+        // does not take the ownership, the memory must outlive the view
+        FileData(const uint8_t* initData, size_t initSize):
+            pointer(initData), length(initSize)
+        {
+        }
+        // maps the whole file to memory
+        explicit FileData(const std::string& filename);
+#if defined(__ANDROID__)
+        // takes the ownership of the asset
+        explicit FileData(AAsset* asset);
+#endif
+        // view of the given range of other, shares its storage
+        FileData(const FileData& other, size_t offset, size_t size);
+
+        inline const uint8_t* data() const { return pointer; }
+        inline size_t size() const { return length; }
+        inline bool empty() const { return length == 0; }
+
+        inline const uint8_t* begin() const { return pointer; }
+        inline const uint8_t* end() const { return pointer + length; }
+        inline const uint8_t* cbegin() const { return pointer; }
+        inline const uint8_t* cend() const { return pointer + length; }
+
+        inline const uint8_t& operator[](size_t index) const { return pointer[index]; }
+
+        inline std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(pointer, pointer + length); }
+
+    private:
+        class Storage
+        {
+        public:
+            virtual ~Storage() {}
+        };
+
+        class BufferStorage;
+        class MappedStorage;
+#if defined(__ANDROID__)
+        class AssetStorage;
+#endif
+
+        std::shared_ptr<const Storage> storage;
+        const uint8_t* pointer = nullptr;
+        size_t length = 0;
+    };
+}
+
+#endif // OUZEL_FILES_FILEDATA_HPP
@@ -25,6 +25,7 @@ extern "C" id NSTemporaryDirectory();
 #  include <limits.h>
 #  include <pwd.h>
 #  include <unistd.h>
+#  include <sys/inotify.h>
 #endif
 
 #if !defined(_WIN32)
@@ -117,6 +118,13 @@ namespace ouzel
 #endif
     }
 
+    FileSystem::~FileSystem()
+    {
+#if defined(__linux__) && !defined(__ANDROID__)
+        if (notifyDescriptor != -1) close(notifyDescriptor);
+#endif
+    }
+
     std::string FileSystem::getStorageDirectory(bool user) const
     {
 #if defined(_WIN32)
@@ -330,7 +338,6 @@ namespace ouzel
         }
 
         std::vector<uint8_t> data;
-        char buffer[1024];
 
 #if defined(__ANDROID__)
         if (pathIsRelative(filename))
@@ -342,13 +349,19 @@ namespace ouzel
             if (!asset)
                 throw std::runtime_error("Failed to open file " + filename);
 
+            data.resize(static_cast<size_t>(AAsset_getLength(asset)));
+
+            size_t offset = 0;
             int bytesRead = 0;
 
-            while ((bytesRead = AAsset_read(asset, buffer, sizeof(buffer))) > 0)
-                data.insert(data.end(), reinterpret_cast<uint8_t*>(buffer), reinterpret_cast<uint8_t*>(buffer + bytesRead));
+            while (offset < data.size() &&
+                   (bytesRead = AAsset_read(asset, data.data() + offset, data.size() - offset)) > 0)
+                offset += static_cast<size_t>(bytesRead);
 
             AAsset_close(asset);
 
+            data.resize(offset);
+
             return data;
         }
 #endif
@@ -361,12 +374,49 @@ namespace ouzel
 
         File file(path, File::Mode::READ);
 
-        while (uint32_t size = file.read(buffer, sizeof(buffer)))
-            data.insert(data.end(), buffer, buffer + size);
+        // read the whole file at once instead of growing the buffer
+        data.resize(static_cast<size_t>(file.getSize()));
+
+        if (!data.empty() && !file.read(data.data(), static_cast<uint32_t>(data.size()), true))
+            throw std::runtime_error("Failed to read file " + filename);
 
         return data;
     }
 
+    FileData FileSystem::mapFile(const std::string& filename, bool searchResources) const
+    {
+        if (searchResources)
+        {
+            for (const auto& archive : archives)
+            {
+                if (archive->fileExists(filename))
+                    return archive->mapFile(filename);
+            }
+        }
+
+#if defined(__ANDROID__)
+        if (pathIsRelative(filename))
+        {
+            EngineAndroid& engineAndroid = static_cast<EngineAndroid&>(engine);
+
+            AAsset* asset = AAssetManager_open(engineAndroid.getAssetManager(), filename.c_str(), AASSET_MODE_BUFFER);
+
+            if (!asset)
+                throw std::runtime_error("Failed to open file " + filename);
+
+            return FileData(asset);
+        }
+#endif
+
+        std::string path = getPath(filename, searchResources);
+
+        // file does not exist
+        if (path.empty())
+            throw std::runtime_error("Failed to find file " + filename);
+
+        return FileData(path);
+    }
+
     void FileSystem::writeFile(const std::string& filename, const std::vector<uint8_t>& data) const
     {
         File file(filename, File::Mode::WRITE | File::Mode::CREATE | File::Mode::TRUNCATE);
@@ -594,4 +644,193 @@ namespace ouzel
         return path.empty() || path[0] != '/';
 #endif
     }
+
+    static bool getFileState(const std::string& path, int64_t& modificationTime, int64_t& size)
+    {
+#if defined(_WIN32)
+        int bufferSize = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+        if (bufferSize == 0)
+            throw std::system_error(GetLastError(), std::system_category(), "Failed to convert UTF-8 to wide char");
+
+        std::vector<WCHAR> buffer(bufferSize);
+        if (MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, buffer.data(), bufferSize) == 0)
+            throw std::system_error(GetLastError(), std::system_category(), "Failed to convert UTF-8 to wide char");
+
+        // relative paths longer than MAX_PATH are not supported
+        if (buffer.size() > MAX_PATH)
+            buffer.insert(buffer.begin(), {L'\\', L'\\', L'?', L'\\'});
+
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!GetFileAttributesExW(buffer.data(), GetFileExInfoStandard, &attributes))
+            return false;
+
+        modificationTime = static_cast<int64_t>((static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+                                                attributes.ftLastWriteTime.dwLowDateTime);
+        size = static_cast<int64_t>((static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow);
+        return true;
+#else
+        struct stat buf;
+        if (stat(path.c_str(), &buf) == -1)
+            return false;
+
+        modificationTime = static_cast<int64_t>(buf.st_mtime);
+        size = static_cast<int64_t>(buf.st_size);
+        return true;
+#endif
+    }
+
+    void FileSystem::watchFile(const std::string& filename)
+    {
+        WatchedFile& watchedFile = watchedFiles[filename];
+        if (watchedFile.count++) return;
+
+        for (const auto& archive : archives)
+            if (archive->fileExists(filename)) return;
+
+        watchedFile.path = getPath(filename);
+        if (watchedFile.path.empty()) return;
+
+        getFileState(watchedFile.path, watchedFile.modificationTime, watchedFile.size);
+
+#if defined(__linux__) && !defined(__ANDROID__)
+        if (notifyDescriptor == -1)
+        {
+            notifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (notifyDescriptor == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to initialize inotify");
+        }
+
+        // the directory is watched, because editors replace the files by renaming a temporary file
+        std::string directory = getDirectoryPart(watchedFile.path);
+        int watchDescriptor = inotify_add_watch(notifyDescriptor, directory.empty() ? "." : directory.c_str(),
+                                                IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watchDescriptor == -1)
+        {
+            engine.log(Log::Level::WARN) << "Failed to watch " << directory << ", error: " << errno;
+            watchedFile.path.clear();
+            return;
+        }
+
+        WatchedDirectory& watchedDirectory = watchedDirectories[watchDescriptor];
+        watchedDirectory.path = directory;
+        ++watchedDirectory.count;
+#endif
+    }
+
+    void FileSystem::unwatchFile(const std::string& filename)
+    {
+        auto i = watchedFiles.find(filename);
+        if (i == watchedFiles.end() || --i->second.count) return;
+
+#if defined(__linux__) && !defined(__ANDROID__)
+        if (!i->second.path.empty())
+        {
+            std::string directory = getDirectoryPart(i->second.path);
+
+            for (auto d = watchedDirectories.begin(); d != watchedDirectories.end(); ++d)
+            {
+                if (d->second.path == directory)
+                {
+                    if (!--d->second.count)
+                    {
+                        inotify_rm_watch(notifyDescriptor, d->first);
+                        watchedDirectories.erase(d);
+                    }
+                    break;
+                }
+            }
+        }
+#endif
+
+        watchedFiles.erase(i);
+    }
+
+    std::vector<std::string> FileSystem::getModifiedFiles()
+    {
+        std::vector<std::string> result;
+
+        if (watchedFiles.empty()) return result;
+
+#if defined(__linux__) && !defined(__ANDROID__)
+        if (notifyDescriptor == -1) return result;
+
+        alignas(inotify_event) char buffer[4096];
+        bool overflow = false;
+
+        for (;;)
+        {
+            ssize_t length = read(notifyDescriptor, buffer, sizeof(buffer));
+            if (length == -1)
+            {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN) break;
+                throw std::system_error(errno, std::system_category(), "Failed to read inotify events");
+            }
+
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                // the queue overflowed and the events were dropped (wd is -1)
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    overflow = true;
+                    continue;
+                }
+
+                auto d = watchedDirectories.find(event->wd);
+                if (d == watchedDirectories.end() || !event->len) continue;
+
+                std::string path = d->second.path.empty() ? std::string(event->name) :
+                    d->second.path + DIRECTORY_SEPARATOR + event->name;
+
+                for (auto& watchedFile : watchedFiles)
+                {
+                    if (watchedFile.second.path == path &&
+                        std::find(result.begin(), result.end(), watchedFile.first) == result.end())
+                    {
+                        // keep the state current for the overflow check
+                        getFileState(path, watchedFile.second.modificationTime, watchedFile.second.size);
+                        result.push_back(watchedFile.first);
+                    }
+                }
+            }
+        }
+
+        if (overflow)
+        {
+            engine.log(Log::Level::WARN) << "File change events were lost, checking the watched files";
+            checkModifiedFiles(result);
+        }
+#else
+        // polling every frame would stat every watched file, so the modification times are checked twice a second
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastPollTime < std::chrono::milliseconds(500)) return result;
+        lastPollTime = now;
+
+        checkModifiedFiles(result);
+#endif
+
+        return result;
+    }
+
+    void FileSystem::checkModifiedFiles(std::vector<std::string>& result)
+    {
+        for (auto& watchedFile : watchedFiles)
+        {
+            if (watchedFile.second.path.empty()) continue;
+
+            int64_t modificationTime;
+            int64_t size;
+            if (getFileState(watchedFile.second.path, modificationTime, size) &&
+                (modificationTime != watchedFile.second.modificationTime || size != watchedFile.second.size))
+            {
+                watchedFile.second.modificationTime = modificationTime;
+                watchedFile.second.size = size;
+                if (std::find(result.begin(), result.end(), watchedFile.first) == result.end())
+                    result.push_back(watchedFile.first);
+            }
+        }
+    }
 }
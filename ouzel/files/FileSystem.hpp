@@ -3,9 +3,12 @@
 #ifndef OUZEL_FILES_FILESYSTEM_HPP
 #define OUZEL_FILES_FILESYSTEM_HPP
 
+#include <chrono>
+#include <map>
 #include <string>
 #include <vector>
 #include <cstdint>
+#include "files/FileData.hpp"
 
 namespace ouzel
 {
@@ -18,6 +21,8 @@ namespace ouzel
         static const std::string DIRECTORY_SEPARATOR;
 
         explicit FileSystem(Engine& initEngine);
+        ~FileSystem();
+
         FileSystem(const FileSystem&) = delete;
         FileSystem& operator=(const FileSystem&) = delete;
 
@@ -28,6 +33,8 @@ namespace ouzel
         std::string getTempDirectory() const;
 
         std::vector<uint8_t> readFile(const std::string& filename, bool searchResources = true) const;
+        // maps the file to memory, stored archive entries are returned without a copy
+        FileData mapFile(const std::string& filename, bool searchResources = true) const;
         void writeFile(const std::string& filename, const std::vector<uint8_t>& data) const;
 
         bool resourceFileExists(const std::string& filename) const;
@@ -44,11 +51,43 @@ namespace ouzel
         bool directoryExists(const std::string& dirname) const;
         bool fileExists(const std::string& filename) const;
 
+        // the watches are counted, so every watchFile call needs a matching unwatchFile call
+        // uses inotify on Linux and polls the modification times on other platforms, the files in archives are not watched
+        void watchFile(const std::string& filename);
+        void unwatchFile(const std::string& filename);
+        // returns the watched files that were written since the last call without blocking, called on the update thread
+        std::vector<std::string> getModifiedFiles();
+
     private:
+        struct WatchedFile final
+        {
+            std::string path;
+            uint32_t count = 0;
+            int64_t modificationTime = 0;
+            int64_t size = 0;
+        };
+
+        // compares the modification times and the sizes of the watched files with the last known ones
+        void checkModifiedFiles(std::vector<std::string>& result);
+
         Engine& engine;
         std::string appPath;
         std::vector<std::string> resourcePaths;
         std::vector<Archive*> archives;
+
+        std::map<std::string, WatchedFile> watchedFiles; // by the filename passed to watchFile
+#if defined(__linux__) && !defined(__ANDROID__)
+        struct WatchedDirectory final
+        {
+            std::string path;
+            uint32_t count = 0;
+        };
+
+        int notifyDescriptor = -1;
+        std::map<int, WatchedDirectory> watchedDirectories; // by the watch descriptor
+#else
+        std::chrono::steady_clock::time_point lastPollTime;
+#endif
     };
 }
 
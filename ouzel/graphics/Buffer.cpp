@@ -22,6 +22,8 @@ namespace ouzel
             flags(initFlags),
             size(initSize)
         {
+            gpuMemory.setSize(size);
+
             renderer.addCommand(std::unique_ptr<Command>(new InitBufferCommand(resource,
                                                                                initUsage,
                                                                                initFlags,
@@ -36,6 +38,8 @@ namespace ouzel
             flags(initFlags),
             size(initSize)
         {
+            gpuMemory.setSize(size);
+
             renderer.addCommand(std::unique_ptr<Command>(new InitBufferCommand(resource,
                                                                                initUsage,
                                                                                initFlags,
@@ -51,6 +55,8 @@ namespace ouzel
             flags(initFlags),
             size(initSize)
         {
+            gpuMemory.setSize(size);
+
             if (!initData.empty() && initSize != initData.size())
                 throw std::runtime_error("Invalid buffer data");
 
@@ -76,6 +82,7 @@ namespace ouzel
             usage = newUsage;
             flags = newFlags;
             size = newSize;
+            gpuMemory.setSize(size);
 
             renderer.addCommand(std::unique_ptr<Command>(new InitBufferCommand(resource,
                                                                                newUsage,
@@ -101,6 +108,7 @@ namespace ouzel
             usage = newUsage;
             flags = newFlags;
             size = newSize;
+            gpuMemory.setSize(size);
 
             renderer.addCommand(std::unique_ptr<Command>(new InitBufferCommand(resource,
                                                                                newUsage,
@@ -124,7 +132,11 @@ namespace ouzel
             if (newData.empty())
                 throw std::runtime_error("Invalid buffer data");
 
-            if (newData.size() > size) size = static_cast<uint32_t>(newData.size());
+            if (newData.size() > size)
+            {
+                size = static_cast<uint32_t>(newData.size());
+                gpuMemory.setSize(size);
+            }
 
             renderer.addCommand(std::unique_ptr<Command>(new SetBufferDataCommand(resource,
                                                                                   newData)));
@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <vector>
+#include "utils/MemoryTracker.hpp"
 
 namespace ouzel
 {
@@ -51,6 +52,8 @@ namespace ouzel
             inline Usage getUsage() const { return usage; }
             inline uint32_t getFlags() const { return flags; }
             inline uint32_t getSize() const { return size; }
+            // estimated size in video memory
+            inline size_t getMemoryUsage() const { return gpuMemory.getSize(); }
 
         private:
             Renderer& renderer;
@@ -59,6 +62,7 @@ namespace ouzel
             Buffer::Usage usage;
             uint32_t flags = 0;
             uint32_t size = 0;
+            TrackedMemory gpuMemory{MemoryTag::BUFFER_GPU};
         };
     } // namespace graphics
 } // namespace ouzel
@@ -3,6 +3,7 @@
 #ifndef OUZEL_GRAPHICS_COMMANDS_HPP
 #define OUZEL_GRAPHICS_COMMANDS_HPP
 
+#include <chrono>
 #include <queue>
 #include <string>
 #include "graphics/BlendState.hpp"
@@ -61,6 +62,15 @@ namespace ouzel
             virtual ~Command() {}
 
             const Type type;
+
+        protected:
+            static size_t getLevelsSize(const std::vector<Texture::Level>& levels)
+            {
+                size_t result = 0;
+                for (const Texture::Level& level : levels)
+                    result += level.data.size();
+                return result;
+            }
         };
 
         class PresentCommand: public Command
@@ -399,7 +409,8 @@ namespace ouzel
                 usage(initUsage),
                 flags(initFlags),
                 data(initData),
-                size(initSize)
+                size(initSize),
+                memory(MemoryTag::COMMAND_BUFFER, data.size())
             {
             }
 
@@ -408,6 +419,7 @@ namespace ouzel
             uint32_t flags;
             std::vector<uint8_t> data;
             uint32_t size;
+            TrackedMemory memory;
         };
 
         class SetBufferDataCommand: public Command
@@ -417,12 +429,14 @@ namespace ouzel
                                  const std::vector<uint8_t>& initData):
                 Command(Command::Type::SET_BUFFER_DATA),
                 buffer(initBuffer),
-                data(initData)
+                data(initData),
+                memory(MemoryTag::COMMAND_BUFFER, data.size())
             {
             }
 
             uintptr_t buffer;
             std::vector<uint8_t> data;
+            TrackedMemory memory;
         };
 
         class InitShaderCommand: public Command
@@ -492,7 +506,8 @@ namespace ouzel
                 levels(initLevels),
                 flags(initFlags),
                 sampleCount(initSampleCount),
-                pixelFormat(initPixelFormat)
+                pixelFormat(initPixelFormat),
+                memory(MemoryTag::COMMAND_BUFFER, getLevelsSize(levels))
             {
             }
 
@@ -501,6 +516,7 @@ namespace ouzel
             uint32_t flags;
             uint32_t sampleCount;
             PixelFormat pixelFormat;
+            TrackedMemory memory;
         };
 
         class SetTextureDataCommand: public Command
@@ -510,12 +526,14 @@ namespace ouzel
                                   const std::vector<Texture::Level>& initLevels):
                 Command(Command::Type::SET_TEXTURE_DATA),
                 texture(initTexture),
-                levels(initLevels)
+                levels(initLevels),
+                memory(MemoryTag::COMMAND_BUFFER, getLevelsSize(levels))
             {
             }
 
             uintptr_t texture;
             std::vector<Texture::Level> levels;
+            TrackedMemory memory;
         };
 
         class SetTextureParametersCommand: public Command
@@ -560,6 +578,11 @@ namespace ouzel
         public:
             std::string name;
             std::queue<std::unique_ptr<Command>> commands;
+
+            // timestamps of the frame for the frame timing
+            std::chrono::steady_clock::time_point updateStartTime;
+            std::chrono::steady_clock::time_point recordStartTime;
+            std::chrono::steady_clock::time_point submitTime;
         };
     } // namespace graphics
 } // namespace ouzel
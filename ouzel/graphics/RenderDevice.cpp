@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include "RenderDevice.hpp"
+#include "utils/Profiler.hpp"
 
 namespace ouzel
 {
     namespace graphics
     {
+        static constexpr size_t MAX_FREE_COMMAND_BUFFERS = 3;
+
         RenderDevice::RenderDevice(Driver initDriver,
                                    const std::function<void(const Event&)>& initCallback):
             driver(initDriver),
@@ -44,9 +47,7 @@ namespace ouzel
 
         void RenderDevice::process()
         {
-            Event event;
-            event.type = Event::Type::FRAME;
-            callback(event);
+            OUZEL_PROFILE_ZONE("RenderDevice::process");
 
             std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
             auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - previousFrameTime);
@@ -68,6 +69,82 @@ namespace ouzel
             }
         }
 
+        void RenderDevice::submitCommandBuffer(CommandBuffer&& commandBuffer)
+        {
+            commandBuffer.submitTime = std::chrono::steady_clock::now();
+
+            std::unique_lock<std::mutex> lock(commandQueueMutex);
+            commandQueue.push(std::forward<CommandBuffer>(commandBuffer));
+            ++submittedFrames;
+            lock.unlock();
+            commandQueueCondition.notify_all();
+        }
+
+        CommandBuffer RenderDevice::getCommandBuffer()
+        {
+            std::unique_lock<std::mutex> lock(commandQueueMutex);
+
+            if (freeCommandBuffers.empty()) return CommandBuffer();
+
+            CommandBuffer commandBuffer = std::move(freeCommandBuffers.front());
+            freeCommandBuffers.pop();
+            return commandBuffer;
+        }
+
+        CommandBuffer RenderDevice::getNextCommandBuffer()
+        {
+            std::unique_lock<std::mutex> lock(commandQueueMutex);
+            while (commandQueue.empty()) commandQueueCondition.wait(lock);
+
+            CommandBuffer commandBuffer = std::move(commandQueue.front());
+            commandQueue.pop();
+            ++startedFrames;
+            lock.unlock();
+
+            if (renderStartTime == std::chrono::steady_clock::time_point())
+                renderStartTime = std::chrono::steady_clock::now();
+
+            // the update thread can record the next frame while this one is rendered
+            Event event;
+            event.type = Event::Type::FRAME;
+            callback(event);
+
+            return commandBuffer;
+        }
+
+        void RenderDevice::completeFrame(CommandBuffer&& commandBuffer)
+        {
+            std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+
+            if (commandBuffer.recordStartTime != std::chrono::steady_clock::time_point())
+            {
+                std::unique_lock<std::mutex> lock(frameTimingMutex);
+                frameTiming.update = commandBuffer.recordStartTime - commandBuffer.updateStartTime;
+                frameTiming.submit = commandBuffer.submitTime - commandBuffer.recordStartTime;
+                frameTiming.render = currentTime - renderStartTime;
+                frameTiming.latency = currentTime - commandBuffer.submitTime;
+            }
+
+            renderStartTime = std::chrono::steady_clock::time_point();
+
+            while (!commandBuffer.commands.empty()) commandBuffer.commands.pop();
+            commandBuffer.name.clear();
+            commandBuffer.updateStartTime = std::chrono::steady_clock::time_point();
+            commandBuffer.recordStartTime = std::chrono::steady_clock::time_point();
+            commandBuffer.submitTime = std::chrono::steady_clock::time_point();
+
+            std::unique_lock<std::mutex> lock(commandQueueMutex);
+            if (freeCommandBuffers.size() < MAX_FREE_COMMAND_BUFFERS)
+                freeCommandBuffers.push(std::move(commandBuffer));
+            ++completedFrames;
+        }
+
+        RenderDevice::FrameTiming RenderDevice::getFrameTiming() const
+        {
+            std::unique_lock<std::mutex> lock(frameTimingMutex);
+            return frameTiming;
+        }
+
         void RenderDevice::setSize(const Size2<uint32_t>& newSize)
         {
             size = newSize;
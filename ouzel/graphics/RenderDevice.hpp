@@ -4,10 +4,12 @@
 #define OUZEL_GRAPHICS_RENDERDEVICE_HPP
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
 #include <set>
+#include <vector>
 #include "graphics/Commands.hpp"
 #include "graphics/Driver.hpp"
 #include "graphics/Texture.hpp"
@@ -38,7 +40,7 @@ namespace ouzel
             {
                 enum class Type
                 {
-                    FRAME
+                    FRAME // sent when the render thread takes the command buffer of a frame
                 };
 
                 Type type;
@@ -64,13 +66,25 @@ namespace ouzel
 
             virtual std::vector<Size2<uint32_t>> getSupportedResolutions() const;
 
-            void submitCommandBuffer(CommandBuffer&& commandBuffer)
+            struct FrameTiming final
             {
-                std::unique_lock<std::mutex> lock(commandQueueMutex);
-                commandQueue.push(std::forward<CommandBuffer>(commandBuffer));
-                lock.unlock();
-                commandQueueCondition.notify_all();
-            }
+                std::chrono::nanoseconds update{0}; // update before the frame was recorded
+                std::chrono::nanoseconds submit{0}; // recording and submission of the command buffer
+                std::chrono::nanoseconds render{0}; // execution of the commands and presentation on the render thread
+                std::chrono::nanoseconds latency{0}; // time from the submission to the presentation
+            };
+
+            // every submitted command buffer is one frame, the frame is started when the render thread takes it and completed when it has been presented
+            void submitCommandBuffer(CommandBuffer&& commandBuffer);
+            // returns a command buffer of a completed frame, so that its storage is reused
+            CommandBuffer getCommandBuffer();
+
+            inline uint64_t getSubmittedFrames() const { return submittedFrames; }
+            inline uint64_t getStartedFrames() const { return startedFrames; }
+            inline uint64_t getCompletedFrames() const { return completedFrames; }
+
+            // timing of the last completed frame
+            FrameTiming getFrameTiming() const;
 
             inline uint32_t getDrawCallCount() const { return drawCallCount; }
 
@@ -122,6 +136,13 @@ namespace ouzel
                               bool newDebugRenderer);
 
             void executeAll();
+
+            // blocks until a command buffer is submitted, counts the frame as started and sends the FRAME event,
+            // the update thread compares the started frames with the submitted ones to limit how far it runs ahead
+            CommandBuffer getNextCommandBuffer();
+            // keeps the command buffer for reuse (at most MAX_FREE_COMMAND_BUFFERS are kept) and counts the frame as completed
+            void completeFrame(CommandBuffer&& commandBuffer);
+
             virtual void setSize(const Size2<uint32_t>& newSize);
 
             virtual void generateScreenshot(const std::string& filename);
@@ -159,9 +180,17 @@ namespace ouzel
             uint32_t drawCallCount = 0;
 
             std::queue<CommandBuffer> commandQueue;
+            std::queue<CommandBuffer> freeCommandBuffers;
             std::mutex commandQueueMutex;
             std::condition_variable commandQueueCondition;
 
+            std::atomic<uint64_t> submittedFrames{0};
+            std::atomic<uint64_t> startedFrames{0};
+            std::atomic<uint64_t> completedFrames{0};
+            std::chrono::steady_clock::time_point renderStartTime;
+            mutable std::mutex frameTimingMutex;
+            FrameTiming frameTiming;
+
             std::atomic<float> currentFPS{0.0F};
             std::chrono::steady_clock::time_point previousFrameTime;
 
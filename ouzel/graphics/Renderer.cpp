@@ -178,9 +178,8 @@ namespace ouzel
         {
             if (event.type == RenderDevice::Event::Type::FRAME)
             {
+                // the lock makes sure that waitForNextFrame does not miss the notification
                 std::unique_lock<std::mutex> lock(frameMutex);
-                newFrame = true;
-                refillQueue = true;
                 lock.unlock();
                 frameCondition.notify_all();
             }
@@ -328,12 +327,17 @@ namespace ouzel
             addCommand(std::unique_ptr<Command>(new SetTexturesCommand(newTextures)));
         }
 
+        void Renderer::beginFrame(std::chrono::steady_clock::time_point updateStartTime)
+        {
+            commandBuffer.updateStartTime = updateStartTime;
+            commandBuffer.recordStartTime = std::chrono::steady_clock::now();
+        }
+
         void Renderer::present()
         {
-            refillQueue = false;
             addCommand(std::unique_ptr<Command>(new PresentCommand()));
             device->submitCommandBuffer(std::move(commandBuffer));
-            commandBuffer = CommandBuffer();
+            commandBuffer = device->getCommandBuffer();
         }
 
         void Renderer::addCommand(std::unique_ptr<Command>&& command)
@@ -341,11 +345,18 @@ namespace ouzel
             commandBuffer.commands.push(std::forward<std::unique_ptr<Command>>(command));
         }
 
+        void Renderer::setMaxFramesInFlight(uint32_t newMaxFramesInFlight)
+        {
+            if (newMaxFramesInFlight < 1 || newMaxFramesInFlight > MAX_FRAMES_IN_FLIGHT)
+                throw std::runtime_error("Invalid number of frames in flight");
+
+            maxFramesInFlight = newMaxFramesInFlight;
+        }
+
         void Renderer::waitForNextFrame()
         {
             std::unique_lock<std::mutex> lock(frameMutex);
-            while (!newFrame) frameCondition.wait(lock);
-            newFrame = false;
+            while (!getRefillQueue()) frameCondition.wait(lock);
         }
     } // namespace graphics
 } // namespace ouzel
@@ -3,9 +3,12 @@
 #ifndef OUZEL_GRAPHICS_RENDERER_HPP
 #define OUZEL_GRAPHICS_RENDERER_HPP
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <queue>
@@ -27,6 +30,8 @@ namespace ouzel
         {
             friend Window;
         public:
+            static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+
             Renderer(Driver driver,
                      Window* newWindow,
                      const Size2<uint32_t>& newSize,
@@ -87,8 +92,21 @@ namespace ouzel
             void present();
             void addCommand(std::unique_ptr<Command>&& command);
 
+            // starts recording of the next frame, updateStartTime is the start of its update
+            void beginFrame(std::chrono::steady_clock::time_point updateStartTime);
+
+            // number of frames that can be queued while the render thread is rendering
+            inline uint32_t getMaxFramesInFlight() const { return maxFramesInFlight; }
+            void setMaxFramesInFlight(uint32_t newMaxFramesInFlight);
+
+            // blocks until a frame can be recorded
             void waitForNextFrame();
-            inline bool getRefillQueue() const { return refillQueue; }
+            inline bool getRefillQueue() const
+            {
+                return device->getSubmittedFrames() - device->getStartedFrames() < maxFramesInFlight;
+            }
+
+            inline RenderDevice::FrameTiming getFrameTiming() const { return device->getFrameTiming(); }
 
             Vector2<float> convertScreenToNormalizedLocation(const Vector2<float>& position)
             {
@@ -115,10 +133,9 @@ namespace ouzel
             bool clearDepthBuffer = false;
             CommandBuffer commandBuffer;
 
-            bool newFrame = false;
             std::mutex frameMutex;
             std::condition_variable frameCondition;
-            std::atomic_bool refillQueue{true};
+            std::atomic<uint32_t> maxFramesInFlight{1};
         };
     } // namespace graphics
 } // namespace ouzel
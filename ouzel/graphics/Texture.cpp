@@ -1,9 +1,11 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
 #include <stdexcept>
+#include <utility>
 #include "Texture.hpp"
 #include "Renderer.hpp"
 #include "RenderDevice.hpp"
+#include "core/Engine.hpp"
 
 extern uint8_t GAMMA_ENCODE[256];
 extern float GAMMA_DECODE[256];
@@ -12,6 +14,8 @@ namespace ouzel
 {
     namespace graphics
     {
+        static constexpr uint32_t PARALLEL_DOWNSAMPLE_PIXELS = 256 * 256;
+
         static void imageA8Downsample2x2(uint32_t width, uint32_t height, uint32_t pitch, const uint8_t* src, uint8_t* dst)
         {
             const uint32_t dstWidth = width >> 1;
@@ -389,10 +393,35 @@ namespace ouzel
             }
         }
 
-        static std::vector<Texture::Level> calculateSizes(const Size2<uint32_t>& size,
-                                                          const std::vector<uint8_t>& data,
-                                                          uint32_t mipmaps,
-                                                          PixelFormat pixelFormat)
+        static void imageDownsample2x2(PixelFormat pixelFormat, uint32_t width, uint32_t height, uint32_t pitch, const uint8_t* src, uint8_t* dst)
+        {
+            switch (pixelFormat)
+            {
+                case PixelFormat::RGBA8_UNORM:
+                    imageRGBA8Downsample2x2(width, height, pitch, src, dst);
+                    break;
+
+                case PixelFormat::RG8_UNORM:
+                    imageRG8Downsample2x2(width, height, pitch, src, dst);
+                    break;
+
+                case PixelFormat::R8_UNORM:
+                    imageR8Downsample2x2(width, height, pitch, src, dst);
+                    break;
+
+                case PixelFormat::A8_UNORM:
+                    imageA8Downsample2x2(width, height, pitch, src, dst);
+                    break;
+
+                default:
+                    throw std::runtime_error("Invalid pixel format");
+            }
+        }
+
+        std::vector<Texture::Level> Texture::calculateLevels(const Size2<uint32_t>& size,
+                                                             const std::vector<uint8_t>& data,
+                                                             uint32_t mipmaps,
+                                                             PixelFormat pixelFormat)
         {
             std::vector<Texture::Level> levels;
 
@@ -431,31 +460,26 @@ namespace ouzel
                 {
                     std::vector<uint8_t> newData(bufferSize);
 
-                    switch (pixelFormat)
+                    const uint32_t rows = previousHeight >> 1;
+
+                    // rows of large levels are downsampled in parallel
+                    if (previousWidth > 1 && rows > 0 && engine && engine->getJobSystem() &&
+                        newWidth * newHeight >= PARALLEL_DOWNSAMPLE_PIXELS)
                     {
-                        case PixelFormat::RGBA8_UNORM:
-                            imageRGBA8Downsample2x2(previousWidth, previousHeight, previousPitch,
-                                                    previousData.data(), newData.data());
-                            break;
-
-                        case PixelFormat::RG8_UNORM:
-                            imageRG8Downsample2x2(previousWidth, previousHeight, previousPitch,
-                                                  previousData.data(), newData.data());
-                            break;
-
-                        case PixelFormat::R8_UNORM:
-                            imageR8Downsample2x2(previousWidth, previousHeight, previousPitch,
-                                                 previousData.data(), newData.data());
-                            break;
-
-                        case PixelFormat::A8_UNORM:
-                            imageA8Downsample2x2(previousWidth, previousHeight, previousPitch,
-                                                 previousData.data(), newData.data());
-                            break;
-
-                        default:
-                            throw std::runtime_error("Invalid pixel format");
+                        const uint8_t* src = previousData.data();
+                        uint8_t* dst = newData.data();
+                        uint32_t width = previousWidth;
+                        uint32_t srcPitch = previousPitch;
+                        uint32_t dstPitch = pitch;
+
+                        engine->getJobSystem()->parallelFor(0, rows, 0, [pixelFormat, width, srcPitch, dstPitch, src, dst](uint32_t begin, uint32_t end) {
+                            imageDownsample2x2(pixelFormat, width, (end - begin) * 2, srcPitch,
+                                               src + begin * 2 * srcPitch, dst + begin * dstPitch);
+                        });
                     }
+                    else
+                        imageDownsample2x2(pixelFormat, previousWidth, previousHeight, previousPitch,
+                                           previousData.data(), newData.data());
 
                     levels.push_back({mipMapSize, pitch, newData});
 
@@ -470,6 +494,16 @@ namespace ouzel
             return levels;
         }
 
+        static size_t getLevelsSize(const std::vector<Texture::Level>& levels)
+        {
+            size_t result = 0;
+
+            for (const Texture::Level& level : levels)
+                result += static_cast<size_t>(level.pitch) * level.size.v[1];
+
+            return result;
+        }
+
         Texture::Texture(Renderer& initRenderer):
             renderer(initRenderer),
             resource(renderer.getDevice()->getResourceId())
@@ -497,7 +531,9 @@ namespace ouzel
                 (!isPowerOfTwo(size.v[0]) || !isPowerOfTwo(size.v[1])))
                 mipmaps = 1;
 
-            std::vector<Level> levels = calculateSizes(size, std::vector<uint8_t>(), mipmaps, pixelFormat);
+            std::vector<Level> levels = calculateLevels(size, std::vector<uint8_t>(), mipmaps, pixelFormat);
+
+            gpuMemory.setSize(getLevelsSize(levels) * sampleCount);
 
             renderer.addCommand(std::unique_ptr<Command>(new InitTextureCommand(resource,
                                                                                 levels,
@@ -527,7 +563,9 @@ namespace ouzel
                 (!isPowerOfTwo(size.v[0]) || !isPowerOfTwo(size.v[1])))
                 mipmaps = 1;
 
-            std::vector<Level> levels = calculateSizes(size, initData, mipmaps, pixelFormat);
+            std::vector<Level> levels = calculateLevels(size, initData, mipmaps, pixelFormat);
+
+            gpuMemory.setSize(getLevelsSize(levels) * sampleCount);
 
             renderer.addCommand(std::unique_ptr<Command>(new InitTextureCommand(resource,
                                                                                 levels,
@@ -561,6 +599,8 @@ namespace ouzel
                 levels.resize(1);
             }
 
+            gpuMemory.setSize(getLevelsSize(levels) * sampleCount);
+
             renderer.addCommand(std::unique_ptr<Command>(new InitTextureCommand(resource,
                                                                                 levels,
                                                                                 flags,
@@ -597,7 +637,9 @@ namespace ouzel
                 (!isPowerOfTwo(size.v[0]) || !isPowerOfTwo(size.v[1])))
                 mipmaps = 1;
 
-            std::vector<Level> levels = calculateSizes(size, std::vector<uint8_t>(), mipmaps, pixelFormat);
+            std::vector<Level> levels = calculateLevels(size, std::vector<uint8_t>(), mipmaps, pixelFormat);
+
+            gpuMemory.setSize(getLevelsSize(levels) * sampleCount);
 
             renderer.addCommand(std::unique_ptr<Command>(new InitTextureCommand(resource,
                                                                                 levels,
@@ -625,7 +667,9 @@ namespace ouzel
                 (!isPowerOfTwo(size.v[0]) || !isPowerOfTwo(size.v[1])))
                 mipmaps = 1;
 
-            std::vector<Level> levels = calculateSizes(size, newData, mipmaps, pixelFormat);
+            std::vector<Level> levels = calculateLevels(size, newData, mipmaps, pixelFormat);
+
+            gpuMemory.setSize(getLevelsSize(levels) * sampleCount);
 
             renderer.addCommand(std::unique_ptr<Command>(new InitTextureCommand(resource,
                                                                                 levels,
@@ -657,6 +701,8 @@ namespace ouzel
                 levels.resize(1);
             }
 
+            gpuMemory.setSize(getLevelsSize(levels) * sampleCount);
+
             renderer.addCommand(std::unique_ptr<Command>(new InitTextureCommand(resource,
                                                                                 levels,
                                                                                 flags,
@@ -664,12 +710,36 @@ namespace ouzel
                                                                                 pixelFormat)));
         }
 
+        void Texture::swap(Texture& other)
+        {
+            std::swap(resource, other.resource);
+            std::swap(dimensions, other.dimensions);
+            std::swap(size, other.size);
+            std::swap(flags, other.flags);
+            std::swap(mipmaps, other.mipmaps);
+            std::swap(sampleCount, other.sampleCount);
+            std::swap(pixelFormat, other.pixelFormat);
+            std::swap(gpuMemory, other.gpuMemory);
+
+            renderer.addCommand(std::unique_ptr<Command>(new SetTextureParametersCommand(resource,
+                                                                                         filter,
+                                                                                         addressX,
+                                                                                         addressY,
+                                                                                         maxAnisotropy)));
+
+            renderer.addCommand(std::unique_ptr<Command>(new SetTextureParametersCommand(other.resource,
+                                                                                         other.filter,
+                                                                                         other.addressX,
+                                                                                         other.addressY,
+                                                                                         other.maxAnisotropy)));
+        }
+
         void Texture::setData(const std::vector<uint8_t>& newData)
         {
             if (!(flags & Texture::DYNAMIC) || flags & Texture::RENDER_TARGET)
                 throw std::runtime_error("Texture is not dynamic");
 
-            std::vector<Level> levels = calculateSizes(size, newData, mipmaps, pixelFormat);
+            std::vector<Level> levels = calculateLevels(size, newData, mipmaps, pixelFormat);
 
             renderer.addCommand(std::unique_ptr<Command>(new SetTextureDataCommand(resource,
                                                                                    levels)));
@@ -8,6 +8,7 @@
 #include "graphics/PixelFormat.hpp"
 #include "math/Color.hpp"
 #include "math/Size2.hpp"
+#include "utils/MemoryTracker.hpp"
 
 namespace ouzel
 {
@@ -60,6 +61,12 @@ namespace ouzel
 
             static constexpr uint32_t LAYERS = 4;
 
+            // downsamples the data to the given number of levels (0 for the full chain), can be called without a renderer
+            static std::vector<Level> calculateLevels(const Size2<uint32_t>& size,
+                                                      const std::vector<uint8_t>& data,
+                                                      uint32_t mipmaps,
+                                                      PixelFormat pixelFormat);
+
             explicit Texture(Renderer& initRenderer);
             Texture(Renderer& initRenderer,
                     const Size2<uint32_t>& newSize,
@@ -101,9 +108,15 @@ namespace ouzel
                       uint32_t newFlags = 0,
                       PixelFormat newPixelFormat = PixelFormat::RGBA8_UNORM);
 
+            // exchanges the device textures and their contents, the sampler parameters stay with the objects
+            // used to reload a texture in place, so the holders of the texture see the new image
+            void swap(Texture& other);
+
             inline uintptr_t getResource() const { return resource; }
 
             inline const Size2<uint32_t>& getSize() const { return size; }
+            // estimated size in video memory
+            inline size_t getMemoryUsage() const { return gpuMemory.getSize(); }
 
             void setData(const std::vector<uint8_t>& newData);
 
@@ -156,6 +169,7 @@ namespace ouzel
             Address addressX = Texture::Address::CLAMP;
             Address addressY = Texture::Address::CLAMP;
             uint32_t maxAnisotropy = 0;
+            TrackedMemory gpuMemory{MemoryTag::TEXTURE_GPU};
         };
     } // namespace graphics
 } // namespace ouzel
@@ -379,11 +379,7 @@ namespace ouzel
 
             for (;;)
             {
-                std::unique_lock<std::mutex> lock(commandQueueMutex);
-                while (commandQueue.empty()) commandQueueCondition.wait(lock);
-                commandBuffer = std::move(commandQueue.front());
-                commandQueue.pop();
-                lock.unlock();
+                commandBuffer = getNextCommandBuffer();
 
                 std::unique_ptr<Command> command;
 
@@ -918,7 +914,11 @@ namespace ouzel
                             throw std::runtime_error("Invalid command");
                     }
 
-                    if (command->type == Command::Type::PRESENT) return;
+                    if (command->type == Command::Type::PRESENT)
+                    {
+                        completeFrame(std::move(commandBuffer));
+                        return;
+                    }
                 }
             }
         }
@@ -18,7 +18,8 @@ namespace ouzel
             OGLRenderResource(renderDeviceOGL),
             usage(newUsage),
             flags(newFlags),
-            data(newData)
+            data(newData),
+            dataMemory(MemoryTag::BUFFER_DATA, newData.size())
         {
             createBuffer();
 
@@ -81,6 +82,7 @@ namespace ouzel
                 throw std::invalid_argument("Data is empty");
 
             data = newData;
+            dataMemory.setSize(data.size());
 
             if (!bufferId)
                 throw std::runtime_error("Buffer not initialized");
@@ -52,6 +52,7 @@ namespace ouzel
             Buffer::Usage usage;
             uint32_t flags = 0;
             std::vector<uint8_t> data;
+            TrackedMemory dataMemory{MemoryTag::BUFFER_DATA};
 
             GLuint bufferId = 0;
             GLsizeiptr size = 0;
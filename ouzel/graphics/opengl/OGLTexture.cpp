@@ -232,6 +232,8 @@ namespace ouzel
             sampleCount(newSampleCount),
             pixelFormat(newPixelFormat)
         {
+            updateDataMemory();
+
             if ((flags & Texture::RENDER_TARGET) && (mipmaps == 0 || mipmaps > 1))
                 throw std::runtime_error("Invalid mip map count");
 
@@ -360,12 +362,22 @@ namespace ouzel
             setTextureParameters();
         }
 
+        void OGLTexture::updateDataMemory()
+        {
+            size_t size = 0;
+            for (const Texture::Level& level : levels)
+                size += level.data.size();
+
+            dataMemory.setSize(size);
+        }
+
         void OGLTexture::setData(const std::vector<Texture::Level>& newLevels)
         {
             if (!(flags & Texture::DYNAMIC) || flags & Texture::RENDER_TARGET)
                 throw std::runtime_error("Texture is not dynamic");
 
             levels = newLevels;
+            updateDataMemory();
 
             if (!textureId)
                 throw std::runtime_error("Texture not initialized");
@@ -76,12 +76,14 @@ namespace ouzel
         private:
             void createTexture();
             void setTextureParameters();
+            void updateDataMemory();
 
             bool clearColorBuffer = true;
             bool clearDepthBuffer = false;
             Color clearColor;
             float clearDepth = 1.0F;
             std::vector<Texture::Level> levels;
+            TrackedMemory dataMemory{MemoryTag::TEXTURE_DATA};
             uint32_t flags = 0;
             uint32_t mipmaps = 0;
             uint32_t sampleCount = 1;
@@ -4,8 +4,6 @@
 #include <iterator>
 #include <stdexcept>
 #include "BMFont.hpp"
-#include "core/Engine.hpp"
-#include "assets/Cache.hpp"
 #include "utils/UTF8.hpp"
 
 namespace ouzel
@@ -178,7 +176,7 @@ namespace ouzel
                         value = parseString(data, iterator);
 
                         if (key == "file")
-                            fontTexture = engine->getCache().getTexture(value);
+                            textureFilename = value;
                     }
                 }
                 else if (keyword == "common")
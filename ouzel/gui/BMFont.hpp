@@ -23,6 +23,10 @@ namespace ouzel
 
         float getStringWidth(const std::string& text);
 
+        // the page texture is not loaded by the font, it is set by the loader
+        const std::string& getTextureFilename() const { return textureFilename; }
+        void setTexture(const std::shared_ptr<graphics::Texture>& newTexture) { fontTexture = newTexture; }
+
     private:
         int16_t getKerningPair(uint32_t, uint32_t);
 
@@ -48,6 +52,7 @@ namespace ouzel
         uint16_t kernCount = 0;
         std::unordered_map<uint32_t, CharDescriptor> chars;
         std::map<std::pair<uint32_t, uint32_t>, int16_t> kern;
+        std::string textureFilename;
         std::shared_ptr<graphics::Texture> fontTexture;
     };
 }
@@ -36,19 +36,19 @@ namespace ouzel
 
         bool Gamepad::handleButtonValueChange(Gamepad::Button button, bool pressed, float value)
         {
-            std::unique_ptr<GamepadEvent> event(new GamepadEvent());
-            event->type = Event::Type::GAMEPAD_BUTTON_CHANGE;
-            event->gamepad = this;
-            event->button = button;
-            event->previousPressed = buttonStates[static_cast<uint32_t>(button)].pressed;
-            event->pressed = pressed;
-            event->value = value;
-            event->previousValue = buttonStates[static_cast<uint32_t>(button)].value;
+            GamepadEvent event;
+            event.type = Event::Type::GAMEPAD_BUTTON_CHANGE;
+            event.gamepad = this;
+            event.button = button;
+            event.previousPressed = buttonStates[static_cast<uint32_t>(button)].pressed;
+            event.pressed = pressed;
+            event.value = value;
+            event.previousValue = buttonStates[static_cast<uint32_t>(button)].value;
 
             buttonStates[static_cast<uint32_t>(button)].pressed = pressed;
             buttonStates[static_cast<uint32_t>(button)].value = value;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         void Gamepad::setVibration(Motor motor, float speed)
@@ -35,53 +35,41 @@ namespace ouzel
     {
         InputManager::InputManager():
 #if TARGET_OS_IOS
-            inputSystem(new InputSystemIOS(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+            inputSystem(new InputSystemIOS())
 #elif TARGET_OS_TV
-            inputSystem(new InputSystemTVOS(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+            inputSystem(new InputSystemTVOS())
 #elif TARGET_OS_MAC
-        inputSystem(new InputSystemMacOS(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+        inputSystem(new InputSystemMacOS())
 #elif defined(__ANDROID__)
-            inputSystem(new InputSystemAndroid(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+            inputSystem(new InputSystemAndroid())
 #elif defined(__linux__)
-            inputSystem(new InputSystemLinux(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+            inputSystem(new InputSystemLinux())
 #elif defined(_WIN32)
-            inputSystem(new InputSystemWin(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+            inputSystem(new InputSystemWin())
 #elif defined(__EMSCRIPTEN__)
-            inputSystem(new InputSystemEm(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+            inputSystem(new InputSystemEm())
 #else
-            inputSystem(new InputSystem(std::bind(&InputManager::eventCallback, this, std::placeholders::_1)))
+            inputSystem(new InputSystem())
 #endif
         {
         }
 
         void InputManager::update()
         {
-            std::pair<std::promise<bool>, InputSystem::Event> p;
+            InputSystem::QueuedEvent queuedEvent;
 
-            for (;;)
+            while (inputSystem->getQueuedEvent(queuedEvent))
             {
-                std::unique_lock<std::mutex> lock(eventQueueMutex);
-                if (eventQueue.empty()) break;
+                bool handled = handleEvent(queuedEvent.event);
 
-                p = std::move(eventQueue.front());
-                eventQueue.pop();
-                lock.unlock();
-
-                p.first.set_value(handleEvent(p.second));
+                if (queuedEvent.promise)
+                {
+                    queuedEvent.promise->set_value(handled);
+                    delete queuedEvent.promise;
+                }
             }
         }
 
-        std::future<bool> InputManager::eventCallback(const InputSystem::Event& event)
-        {
-            std::pair<std::promise<bool>, InputSystem::Event> p(std::promise<bool>(), event);
-            std::future<bool> f = p.first.get_future();
-
-            std::unique_lock<std::mutex> lock(eventQueueMutex);
-            eventQueue.push(std::move(p));
-
-            return f;
-        };
-
         bool InputManager::handleEvent(const InputSystem::Event& event)
         {
             switch (event.type)
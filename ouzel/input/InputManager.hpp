@@ -4,8 +4,6 @@
 #define OUZEL_INPUT_INPUTMANAGER_HPP
 
 #include <memory>
-#include <mutex>
-#include <queue>
 #include <vector>
 #include <unordered_map>
 #include "input/InputSystem.hpp"
@@ -46,12 +44,8 @@ namespace ouzel
             void hideVirtualKeyboard();
 
         private:
-            std::future<bool> eventCallback(const InputSystem::Event& event);
             bool handleEvent(const InputSystem::Event& event);
 
-            std::mutex eventQueueMutex;
-            std::queue<std::pair<std::promise<bool>, InputSystem::Event>> eventQueue;
-
             std::unique_ptr<InputSystem> inputSystem;
             Keyboard* keyboard = nullptr;
             Mouse* mouse = nullptr;
@@ -8,11 +8,24 @@ namespace ouzel
 {
     namespace input
     {
-        InputSystem::InputSystem(const std::function<std::future<bool>(const Event&)>& initCallback):
-            callback(initCallback)
+        InputSystem::InputSystem():
+            eventQueue(1024)
         {
         }
 
+        InputSystem::~InputSystem()
+        {
+            QueuedEvent queuedEvent;
+            while (getQueuedEvent(queuedEvent))
+            {
+                if (queuedEvent.promise)
+                {
+                    queuedEvent.promise->set_value(false);
+                    delete queuedEvent.promise;
+                }
+            }
+        }
+
         void InputSystem::addCommand(const Command& command)
         {
             engine->executeOnMainThread(std::bind(&InputSystem::executeCommand, this, command));
@@ -20,7 +33,48 @@ namespace ouzel
 
         std::future<bool> InputSystem::sendEvent(const Event& event)
         {
-            return callback(event);
+            QueuedEvent queuedEvent;
+            queuedEvent.event = event;
+            queuedEvent.promise = new std::promise<bool>();
+            std::future<bool> future = queuedEvent.promise->get_future();
+
+            pushEvent(std::move(queuedEvent));
+
+            return future;
+        }
+
+        void InputSystem::postEvent(const Event& event)
+        {
+            QueuedEvent queuedEvent;
+            queuedEvent.event = event;
+
+            pushEvent(std::move(queuedEvent));
+        }
+
+        void InputSystem::pushEvent(QueuedEvent&& queuedEvent)
+        {
+            // once an event has overflowed, the following ones must not overtake it through the lock-free queue
+            if (overflowCount == 0 && eventQueue.push(std::move(queuedEvent)))
+                return;
+
+            std::unique_lock<std::mutex> lock(overflowQueueMutex);
+            overflowQueue.push(std::move(queuedEvent));
+            ++overflowCount;
+        }
+
+        bool InputSystem::getQueuedEvent(QueuedEvent& queuedEvent)
+        {
+            // events in the lock-free queue are older than the overflowed ones
+            if (eventQueue.pop(queuedEvent)) return true;
+            if (overflowCount == 0) return false;
+
+            std::unique_lock<std::mutex> lock(overflowQueueMutex);
+            if (overflowQueue.empty()) return false;
+
+            queuedEvent = std::move(overflowQueue.front());
+            overflowQueue.pop();
+            --overflowCount;
+            return true;
         }
 
         void InputSystem::addInputDevice(InputDevice& inputDevice)
@@ -3,8 +3,11 @@
 #ifndef OUZEL_INPUT_INPUTSYSTEM_HPP
 #define OUZEL_INPUT_INPUTSYSTEM_HPP
 
+#include <atomic>
 #include <cstdint>
 #include <future>
+#include <mutex>
+#include <queue>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -16,6 +19,7 @@
 #include "graphics/PixelFormat.hpp"
 #include "math/Size2.hpp"
 #include "math/Vector2.hpp"
+#include "utils/LockFreeQueue.hpp"
 
 namespace ouzel
 {
@@ -126,10 +130,20 @@ namespace ouzel
                 float force = 1.0F;
             };
 
-            explicit InputSystem(const std::function<std::future<bool>(const Event&)>& initCallback);
-            virtual ~InputSystem() {}
+            InputSystem();
+            virtual ~InputSystem();
 
             void addCommand(const Command& command);
+
+            class QueuedEvent final
+            {
+            public:
+                Event event;
+                std::promise<bool>* promise = nullptr; // null for posted events
+            };
+
+            // returns the next event sent or posted to the input manager
+            bool getQueuedEvent(QueuedEvent& queuedEvent);
             virtual void executeCommand(const Command&) {}
 
             uintptr_t getResourceId()
@@ -153,12 +167,20 @@ namespace ouzel
 
         protected:
             std::future<bool> sendEvent(const Event& event);
+            // sends the event without allocating a promise (for high-rate events whose result is not needed)
+            void postEvent(const Event& event);
             void addInputDevice(InputDevice& inputDevice);
             void removeInputDevice(const InputDevice& inputDevice);
             InputDevice* getInputDevice(uint32_t id);
 
         private:
-            std::function<std::future<bool>(const Event&)> callback;
+            void pushEvent(QueuedEvent&& queuedEvent);
+
+            LockFreeQueue<QueuedEvent> eventQueue;
+            // used when the lock-free queue is full, all events go here until it is drained to keep them in order
+            std::atomic<size_t> overflowCount{0};
+            std::mutex overflowQueueMutex;
+            std::queue<QueuedEvent> overflowQueue;
             std::unordered_map<uint32_t, InputDevice*> inputDevices;
 
             uintptr_t lastResourceId = 0;
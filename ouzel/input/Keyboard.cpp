@@ -16,16 +16,16 @@ namespace ouzel
 
         bool Keyboard::handleKeyPress(Keyboard::Key key)
         {
-            std::unique_ptr<KeyboardEvent> event(new KeyboardEvent());
-            event->keyboard = this;
-            event->key = key;
+            KeyboardEvent event;
+            event.keyboard = this;
+            event.key = key;
 
             if (!keyStates[static_cast<uint32_t>(key)])
             {
                 keyStates[static_cast<uint32_t>(key)] = true;
 
-                event->type = Event::Type::KEY_PRESS;
-                return engine->getEventDispatcher().dispatchEvent(std::move(event));
+                event.type = Event::Type::KEY_PRESS;
+                return engine->getEventDispatcher().dispatchEvent(event);
             }
 
             return false;
@@ -35,12 +35,12 @@ namespace ouzel
         {
             keyStates[static_cast<uint32_t>(key)] = false;
 
-            std::unique_ptr<KeyboardEvent> event(new KeyboardEvent());
-            event->type = Event::Type::KEY_RELEASE;
-            event->keyboard = this;
-            event->key = key;
+            KeyboardEvent event;
+            event.type = Event::Type::KEY_RELEASE;
+            event.keyboard = this;
+            event.key = key;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
     } // namespace input
 } // namespace ouzel
@@ -61,39 +61,39 @@ namespace ouzel
         {
             buttonStates[static_cast<uint32_t>(button)] = true;
 
-            std::unique_ptr<MouseEvent> event(new MouseEvent());
-            event->type = Event::Type::MOUSE_PRESS;
-            event->mouse = this;
-            event->button = button;
-            event->position = pos;
+            MouseEvent event;
+            event.type = Event::Type::MOUSE_PRESS;
+            event.mouse = this;
+            event.button = button;
+            event.position = pos;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         bool Mouse::handleButtonRelease(Mouse::Button button, const Vector2<float>& pos)
         {
             buttonStates[static_cast<uint32_t>(button)] = false;
 
-            std::unique_ptr<MouseEvent> event(new MouseEvent());
-            event->type = Event::Type::MOUSE_RELEASE;
-            event->mouse = this;
-            event->button = button;
-            event->position = pos;
+            MouseEvent event;
+            event.type = Event::Type::MOUSE_RELEASE;
+            event.mouse = this;
+            event.button = button;
+            event.position = pos;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         bool Mouse::handleMove(const Vector2<float>& pos)
         {
-            std::unique_ptr<MouseEvent> event(new MouseEvent());
-            event->type = Event::Type::MOUSE_MOVE;
-            event->mouse = this;
-            event->difference = pos - position;
-            event->position = pos;
+            MouseEvent event;
+            event.type = Event::Type::MOUSE_MOVE;
+            event.mouse = this;
+            event.difference = pos - position;
+            event.position = pos;
 
             position = pos;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         bool Mouse::handleRelativeMove(const Vector2<float>& pos)
@@ -108,25 +108,25 @@ namespace ouzel
 
         bool Mouse::handleScroll(const Vector2<float>& scroll, const Vector2<float>& pos)
         {
-            std::unique_ptr<MouseEvent> event(new MouseEvent());
-            event->type = Event::Type::MOUSE_SCROLL;
-            event->mouse = this;
-            event->position = pos;
-            event->scroll = scroll;
+            MouseEvent event;
+            event.type = Event::Type::MOUSE_SCROLL;
+            event.mouse = this;
+            event.position = pos;
+            event.scroll = scroll;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         bool Mouse::handleCursorLockChange(bool locked)
         {
             cursorLocked = locked;
 
-            std::unique_ptr<MouseEvent> event(new MouseEvent());
-            event->type = Event::Type::MOUSE_CURSOR_LOCK_CHANGE;
-            event->mouse = this;
-            event->locked = cursorLocked;
+            MouseEvent event;
+            event.type = Event::Type::MOUSE_CURSOR_LOCK_CHANGE;
+            event.mouse = this;
+            event.locked = cursorLocked;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
     } // namespace input
 } // namespace ouzel
@@ -44,20 +44,20 @@ namespace ouzel
             return inputSystem.sendEvent(event);
         }
 
-        std::future<bool> MouseDevice::handleMove(const Vector2<float>& position)
+        void MouseDevice::handleMove(const Vector2<float>& position)
         {
             InputSystem::Event event(InputSystem::Event::Type::MOUSE_MOVE);
             event.deviceId = id;
             event.position = position;
-            return inputSystem.sendEvent(event);
+            inputSystem.postEvent(event);
         }
 
-        std::future<bool> MouseDevice::handleRelativeMove(const Vector2<float>& position)
+        void MouseDevice::handleRelativeMove(const Vector2<float>& position)
         {
             InputSystem::Event event(InputSystem::Event::Type::MOUSE_RELATIVE_MOVE);
             event.deviceId = id;
             event.position = position;
-            return inputSystem.sendEvent(event);
+            inputSystem.postEvent(event);
         }
 
         std::future<bool> MouseDevice::handleScroll(const Vector2<float>& scroll, const Vector2<float>& position)
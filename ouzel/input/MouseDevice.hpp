@@ -19,8 +19,8 @@ namespace ouzel
 
             std::future<bool> handleButtonPress(Mouse::Button button, const Vector2<float>& position);
             std::future<bool> handleButtonRelease(Mouse::Button button, const Vector2<float>& position);
-            std::future<bool> handleMove(const Vector2<float>& position);
-            std::future<bool> handleRelativeMove(const Vector2<float>& position);
+            void handleMove(const Vector2<float>& position);
+            void handleRelativeMove(const Vector2<float>& position);
             std::future<bool> handleScroll(const Vector2<float>& scroll, const Vector2<float>& position);
             std::future<bool> handleCursorLockChange(bool locked);
         };
@@ -16,65 +16,65 @@ namespace ouzel
 
         bool Touchpad::handleTouchBegin(uint64_t touchId, const Vector2<float>& position, float force)
         {
-            std::unique_ptr<TouchEvent> event(new TouchEvent());
-            event->type = Event::Type::TOUCH_BEGIN;
-            event->touchpad = this;
-            event->touchId = touchId;
-            event->position = position;
-            event->force = force;
+            TouchEvent event;
+            event.type = Event::Type::TOUCH_BEGIN;
+            event.touchpad = this;
+            event.touchId = touchId;
+            event.position = position;
+            event.force = force;
 
             touchPositions[touchId] = position;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         bool Touchpad::handleTouchEnd(uint64_t touchId, const Vector2<float>& position, float force)
         {
-            std::unique_ptr<TouchEvent> event(new TouchEvent());
-            event->type = Event::Type::TOUCH_END;
-            event->touchpad = this;
-            event->touchId = touchId;
-            event->position = position;
-            event->force = force;
+            TouchEvent event;
+            event.type = Event::Type::TOUCH_END;
+            event.touchpad = this;
+            event.touchId = touchId;
+            event.position = position;
+            event.force = force;
 
             auto i = touchPositions.find(touchId);
 
             if (i != touchPositions.end())
                 touchPositions.erase(i);
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         bool Touchpad::handleTouchMove(uint64_t touchId, const Vector2<float>& position, float force)
         {
-            std::unique_ptr<TouchEvent> event(new TouchEvent());
-            event->type = Event::Type::TOUCH_MOVE;
-            event->touchpad = this;
-            event->touchId = touchId;
-            event->difference = position - touchPositions[touchId];
-            event->position = position;
-            event->force = force;
+            TouchEvent event;
+            event.type = Event::Type::TOUCH_MOVE;
+            event.touchpad = this;
+            event.touchId = touchId;
+            event.difference = position - touchPositions[touchId];
+            event.position = position;
+            event.force = force;
 
             touchPositions[touchId] = position;
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
 
         bool Touchpad::handleTouchCancel(uint64_t touchId, const Vector2<float>& position, float force)
         {
-            std::unique_ptr<TouchEvent> event(new TouchEvent());
-            event->type = Event::Type::TOUCH_CANCEL;
-            event->touchpad = this;
-            event->touchId = touchId;
-            event->position = position;
-            event->force = force;
+            TouchEvent event;
+            event.type = Event::Type::TOUCH_CANCEL;
+            event.touchpad = this;
+            event.touchId = touchId;
+            event.position = position;
+            event.force = force;
 
             auto i = touchPositions.find(touchId);
 
             if (i != touchPositions.end())
                 touchPositions.erase(i);
 
-            return engine->getEventDispatcher().dispatchEvent(std::move(event));
+            return engine->getEventDispatcher().dispatchEvent(event);
         }
     } // namespace input
 } // namespace ouzel
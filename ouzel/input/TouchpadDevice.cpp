@@ -47,14 +47,14 @@ namespace ouzel
             return inputSystem.sendEvent(event);
         }
 
-        std::future<bool> TouchpadDevice::handleTouchMove(uint64_t touchId, const Vector2<float>& position, float force)
+        void TouchpadDevice::handleTouchMove(uint64_t touchId, const Vector2<float>& position, float force)
         {
             InputSystem::Event event(InputSystem::Event::Type::TOUCH_MOVE);
             event.deviceId = id;
             event.touchId = touchId;
             event.position = position;
             event.force = force;
-            return inputSystem.sendEvent(event);
+            inputSystem.postEvent(event);
         }
 
         std::future<bool> TouchpadDevice::handleTouchCancel(uint64_t touchId, const Vector2<float>& position, float force)
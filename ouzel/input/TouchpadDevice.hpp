@@ -19,7 +19,7 @@ namespace ouzel
 
             std::future<bool> handleTouchBegin(uint64_t touchId, const Vector2<float>& position, float force = 1.0F);
             std::future<bool> handleTouchEnd(uint64_t touchId, const Vector2<float>& position, float force = 1.0F);
-            std::future<bool> handleTouchMove(uint64_t touchId, const Vector2<float>& position, float force = 1.0F);
+            void handleTouchMove(uint64_t touchId, const Vector2<float>& position, float force = 1.0F);
             std::future<bool> handleTouchCancel(uint64_t touchId, const Vector2<float>& position, float force = 1.0F);
         };
     } // namespace input
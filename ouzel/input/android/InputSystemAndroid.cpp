@@ -11,8 +11,8 @@ namespace ouzel
 {
     namespace input
     {
-        InputSystemAndroid::InputSystemAndroid(const std::function<std::future<bool>(const Event&)>& initCallback):
-            InputSystem(initCallback),
+        InputSystemAndroid::InputSystemAndroid():
+            InputSystem(),
             keyboardDevice(new KeyboardDevice(*this, ++lastDeviceId)),
             mouseDevice(new MouseDevice(*this, ++lastDeviceId)),
             touchpadDevice(new TouchpadDevice(*this, ++lastDeviceId, true))
@@ -15,7 +15,7 @@ namespace ouzel
         class InputSystemAndroid final: public InputSystem
         {
         public:
-            explicit InputSystemAndroid(const std::function<std::future<bool>(const Event&)>& initCallback);
+            InputSystemAndroid();
             ~InputSystemAndroid();
 
             void executeCommand(const Command& command) override;
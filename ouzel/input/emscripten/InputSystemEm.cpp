@@ -297,8 +297,8 @@ namespace ouzel
 {
     namespace input
     {
-        InputSystemEm::InputSystemEm(const std::function<std::future<bool>(const Event&)>& initCallback):
-            InputSystem(initCallback),
+        InputSystemEm::InputSystemEm():
+            InputSystem(),
             keyboardDevice(new KeyboardDevice(*this, ++lastDeviceId)),
             mouseDevice(new MouseDeviceEm(*this, ++lastDeviceId)),
             touchpadDevice(new TouchpadDevice(*this, ++lastDeviceId, true))
@@ -42,8 +42,8 @@ namespace ouzel
 {
     namespace input
     {
-        InputSystemIOS::InputSystemIOS(const std::function<std::future<bool>(const Event&)>& initCallback):
-            InputSystem(initCallback),
+        InputSystemIOS::InputSystemIOS():
+            InputSystem(),
             keyboardDevice(new KeyboardDevice(*this, ++lastDeviceId)),
             touchpadDevice(new TouchpadDevice(*this, ++lastDeviceId, true))
         {
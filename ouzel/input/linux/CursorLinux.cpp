@@ -18,6 +18,7 @@ namespace ouzel
 #if OUZEL_SUPPORTS_X11
             EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
             Display* display = engineLinux->getDisplay();
+            if (!display) return;
 
             switch (systemCursor)
             {
@@ -53,7 +54,7 @@ namespace ouzel
             EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
             Display* display = engineLinux->getDisplay();
 
-            if (!data.empty())
+            if (display && !data.empty())
             {
                 int width = static_cast<int>(size.v[0]);
                 int height = static_cast<int>(size.v[1]);
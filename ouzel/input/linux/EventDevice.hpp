@@ -35,6 +35,7 @@ namespace ouzel
             void update();
 
             inline int getFd() const { return fd; }
+            inline const std::string& getFilename() const { return filename; }
 
         private:
             void handleAxisChange(int32_t oldValue, int32_t newValue,
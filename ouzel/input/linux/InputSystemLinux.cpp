@@ -9,6 +9,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <linux/joystick.h>
+#include <sys/inotify.h>
 #if OUZEL_SUPPORTS_X11
 #  include <X11/cursorfont.h>
 #endif
@@ -21,68 +22,66 @@ namespace ouzel
 {
     namespace input
     {
-        InputSystemLinux::InputSystemLinux(const std::function<std::future<bool>(const Event&)>& initCallback):
+        InputSystemLinux::InputSystemLinux():
 #if OUZEL_SUPPORTS_X11
-            InputSystem(initCallback),
+            InputSystem(),
             keyboardDevice(new KeyboardDeviceLinux(*this, ++lastDeviceId)),
             mouseDevice(new MouseDeviceLinux(*this, ++lastDeviceId)),
             touchpadDevice(new TouchpadDevice(*this, ++lastDeviceId, true))
 #else
-            InputSystem(initCallback)
+            InputSystem()
 #endif
         {
-#if OUZEL_SUPPORTS_X11
             EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
-            Display* display = engineLinux->getDisplay();
-
-            char data[1] = {0};
 
-            Pixmap pixmap = XCreateBitmapFromData(display, DefaultRootWindow(display), data, 1, 1);
-            if (pixmap)
+#if OUZEL_SUPPORTS_X11
+            if (Display* display = engineLinux->getDisplay())
             {
-                XColor color;
-                color.red = color.green = color.blue = 0;
+                char data[1] = {0};
+
+                Pixmap pixmap = XCreateBitmapFromData(display, DefaultRootWindow(display), data, 1, 1);
+                if (pixmap)
+                {
+                    XColor color;
+                    color.red = color.green = color.blue = 0;
 
-                emptyCursor = XCreatePixmapCursor(display, pixmap, pixmap, &color, &color, 0, 0);
-                XFreePixmap(display, pixmap);
+                    emptyCursor = XCreatePixmapCursor(display, pixmap, pixmap, &color, &color, 0, 0);
+                    XFreePixmap(display, pixmap);
+                }
             }
 #endif
-            DIR* dir = opendir("/dev/input");
 
-            if (!dir)
-                throw std::system_error(errno, std::system_category(), "Failed to open directory");
+            // new device nodes are reported by inotify instead of rescanning the directory
+            inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (inotifyFd == -1)
+                throw std::system_error(errno, std::system_category(), "Failed to initialize inotify");
 
-            dirent ent;
-            dirent* p;
+            if (inotify_add_watch(inotifyFd, "/dev/input", IN_CREATE | IN_ATTRIB) == -1)
+                engine->log(Log::Level::WARN) << "Failed to watch /dev/input";
 
-            while (readdir_r(dir, &ent, &p) == 0 && p)
-            {
-                if (strncmp("event", ent.d_name, 5) == 0)
-                {
-                    try
-                    {
-                        std::string filename = std::string("/dev/input/") + ent.d_name;
-                        std::unique_ptr<EventDevice> eventDevice(new EventDevice(*this, filename));
-                        eventDevices.insert(std::make_pair(eventDevice->getFd(), std::move(eventDevice)));
-                    }
-                    catch (const std::exception&)
-                    {
-                    }
-                }
-            }
+            engineLinux->getReactor().addFd(inotifyFd, std::bind(&InputSystemLinux::handleInotify, this));
 
-            closedir(dir);
+            discoverDevices();
         }
 
         InputSystemLinux::~InputSystemLinux()
         {
-#if OUZEL_SUPPORTS_X11
             if (engine)
             {
                 EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
+                ReactorLinux& reactor = engineLinux->getReactor();
+
+                for (const auto& i : eventDevices)
+                    reactor.removeFd(i.first);
+
+                if (inotifyFd != -1) reactor.removeFd(inotifyFd);
+
+#if OUZEL_SUPPORTS_X11
                 if (emptyCursor != None) XFreeCursor(engineLinux->getDisplay(), emptyCursor);
-            }
 #endif
+            }
+
+            if (inotifyFd != -1) close(inotifyFd);
         }
 
         void InputSystemLinux::executeCommand(const Command& command)
@@ -91,6 +90,7 @@ namespace ouzel
             {
                 case Command::Type::START_DEVICE_DISCOVERY:
                     discovering = true;
+                    discoverDevices();
                     break;
                 case Command::Type::STOP_DEVICE_DISCOVERY:
                     discovering = false;
@@ -185,75 +185,88 @@ namespace ouzel
             }
         }
 
-        void InputSystemLinux::update()
+        void InputSystemLinux::discoverDevices()
         {
-            fd_set rfds;
-            struct timeval tv;
-            tv.tv_sec = 0;
-            tv.tv_usec = 0;
+            DIR* dir = opendir("/dev/input");
 
-            FD_ZERO(&rfds);
+            if (!dir)
+                throw std::system_error(errno, std::system_category(), "Failed to open directory");
 
-            int maxFd = 0;
+            dirent ent;
+            dirent* p;
 
-            for (const auto& i : eventDevices)
+            while (readdir_r(dir, &ent, &p) == 0 && p)
             {
-                FD_SET(i.first, &rfds);
-                if (i.first > maxFd) maxFd = i.first;
+                if (strncmp("event", ent.d_name, 5) == 0)
+                    addDevice(std::string("/dev/input/") + ent.d_name);
             }
 
-            int retval;
-            if ((retval = select(maxFd + 1, &rfds, nullptr, nullptr, &tv)) == -1)
-                throw std::system_error(errno, std::system_category(), "Select failed");
+            closedir(dir);
+        }
 
-            if (retval > 0)
+        void InputSystemLinux::addDevice(const std::string& filename)
+        {
+            for (const auto& i : eventDevices)
+                if (i.second->getFilename() == filename) return;
+
+            try
+            {
+                std::unique_ptr<EventDevice> eventDevice(new EventDevice(*this, filename));
+                int fd = eventDevice->getFd();
+
+                EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
+                engineLinux->getReactor().addFd(fd, std::bind(&InputSystemLinux::handleDevice, this, fd));
+
+                eventDevices.insert(std::make_pair(fd, std::move(eventDevice)));
+            }
+            catch (const std::exception&)
             {
-                for (auto i = eventDevices.begin(); i != eventDevices.end();)
-                {
-                    if (FD_ISSET(i->first, &rfds))
-                    {
-                        try
-                        {
-                            i->second->update();
-                            ++i;
-                        }
-                        catch (const std::exception&)
-                        {
-                            i = eventDevices.erase(i);
-                        }
-                    }
-                    else
-                        ++i;
-                }
             }
+        }
 
-            if (discovering)
+        void InputSystemLinux::handleDevice(int fd)
+        {
+            auto i = eventDevices.find(fd);
+            if (i == eventDevices.end()) return;
+
+            try
+            {
+                i->second->update();
+            }
+            catch (const std::exception&)
             {
-                DIR* dir = opendir("/dev/input");
+                // the device was disconnected
+                EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
+                engineLinux->getReactor().removeFd(fd);
+                eventDevices.erase(i);
+            }
+        }
 
-                if (!dir)
-                    throw std::system_error(errno, std::system_category(), "Failed to open directory");
+        void InputSystemLinux::handleInotify()
+        {
+            alignas(inotify_event) char buffer[4096];
 
-                dirent ent;
-                dirent* p;
+            for (;;)
+            {
+                ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
 
-                while (readdir_r(dir, &ent, &p) == 0 && p)
+                if (length == -1)
                 {
-                    if (strncmp("event", ent.d_name, 5) == 0)
-                    {
-                        try
-                        {
-                            std::string filename = std::string("/dev/input/") + ent.d_name;
-                            std::unique_ptr<EventDevice> eventDevice(new EventDevice(*this, filename));
-                            eventDevices.insert(std::make_pair(eventDevice->getFd(), std::move(eventDevice)));
-                        }
-                        catch (const std::exception&)
-                        {
-                        }
-                    }
+                    if (errno == EINTR) continue;
+                    if (errno == EAGAIN) break;
+                    throw std::system_error(errno, std::system_category(), "Failed to read inotify events");
                 }
 
-                closedir(dir);
+                for (char* p = buffer; p < buffer + length;)
+                {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+
+                    // the permissions of a new node are set after it's created, so IN_ATTRIB is also handled
+                    if (discovering && event->len && strncmp("event", event->name, 5) == 0)
+                        addDevice(std::string("/dev/input/") + event->name);
+
+                    p += sizeof(inotify_event) + event->len;
+                }
             }
         }
 
@@ -263,6 +276,8 @@ namespace ouzel
             EngineLinux* engineLinux = static_cast<EngineLinux*>(engine);
             NativeWindowLinux* windowLinux = static_cast<NativeWindowLinux*>(engine->getWindow()->getNativeWindow());
             Display* display = engineLinux->getDisplay();
+
+            if (!display) return;
             ::Window window = windowLinux->getNativeWindow();
 
             if (mouseDevice->isCursorVisible())
@@ -23,7 +23,7 @@ namespace ouzel
         class InputSystemLinux final: public InputSystem
         {
         public:
-            explicit InputSystemLinux(const std::function<std::future<bool>(const Event&)>& initCallback);
+            InputSystemLinux();
             ~InputSystemLinux();
 
             void executeCommand(const Command& command) override;
@@ -34,14 +34,18 @@ namespace ouzel
 
             uint32_t getNextDeviceId() { return ++lastDeviceId; }
 
-            void update();
-
         private:
+            void discoverDevices();
+            void addDevice(const std::string& filename);
+            void handleDevice(int fd);
+            void handleInotify();
+
 #if OUZEL_SUPPORTS_X11
             void updateCursor() const;
 #endif
 
             bool discovering = false;
+            int inotifyFd = -1;
 
             uint32_t lastDeviceId = 0;
             std::unique_ptr<KeyboardDeviceLinux> keyboardDevice;
@@ -106,7 +106,7 @@ namespace ouzel
         class InputSystemMacOS final: public InputSystem
         {
         public:
-            explicit InputSystemMacOS(const std::function<std::future<bool>(const Event&)>& initCallback);
+            InputSystemMacOS();
             ~InputSystemMacOS();
 
             void executeCommand(const Command& command) override;
@@ -61,8 +61,8 @@ namespace ouzel
     {
         const IOKitErrorCategory ioKitErrorCategory {};
 
-        InputSystemMacOS::InputSystemMacOS(const std::function<std::future<bool>(const Event&)>& initCallback):
-            InputSystem(initCallback),
+        InputSystemMacOS::InputSystemMacOS():
+            InputSystem(),
             keyboardDevice(new KeyboardDevice(*this, ++lastDeviceId)),
             mouseDevice(new MouseDeviceMacOS(*this, ++lastDeviceId)),
             touchpadDevice(new TouchpadDevice(*this, ++lastDeviceId, false))
@@ -42,8 +42,8 @@ namespace ouzel
 {
     namespace input
     {
-        InputSystemTVOS::InputSystemTVOS(const std::function<std::future<bool>(const Event&)>& initCallback):
-            InputSystem(initCallback),
+        InputSystemTVOS::InputSystemTVOS():
+            InputSystem(),
             keyboardDevice(new KeyboardDevice(*this, ++lastDeviceId))
         {
             connectDelegate = [[ConnectDelegate alloc] initWithInput:this];
@@ -29,8 +29,8 @@ namespace ouzel
     {
         const DirectInputErrorCategory directInputErrorCategory {};
 
-        InputSystemWin::InputSystemWin(const std::function<std::future<bool>(const Event&)>& initCallback):
-            InputSystem(initCallback),
+        InputSystemWin::InputSystemWin():
+            InputSystem(),
             keyboardDevice(new KeyboardDeviceWin(*this, ++lastDeviceId)),
             mouseDevice(new MouseDeviceWin(*this, ++lastDeviceId)),
             touchpadDevice(new TouchpadDevice(*this, ++lastDeviceId, true))
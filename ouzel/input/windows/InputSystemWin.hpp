@@ -74,7 +74,7 @@ namespace ouzel
         class InputSystemWin final: public InputSystem
         {
         public:
-            explicit InputSystemWin(const std::function<std::future<bool>(const Event&)>& initCallback);
+            InputSystemWin();
             ~InputSystemWin();
 
             void executeCommand(const Command& command) override;
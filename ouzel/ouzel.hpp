@@ -13,11 +13,14 @@
 #include "animators/Scale.hpp"
 #include "animators/Sequence.hpp"
 #include "animators/Shake.hpp"
+#include "assets/AssetId.hpp"
+#include "assets/AssetTable.hpp"
 #include "assets/Bundle.hpp"
 #include "assets/Cache.hpp"
 #include "assets/Loader.hpp"
 #include "assets/BmfLoader.hpp"
 #include "assets/ColladaLoader.hpp"
+#include "assets/CookedLoader.hpp"
 #include "assets/GltfLoader.hpp"
 #include "assets/ImageLoader.hpp"
 #include "assets/MtlLoader.hpp"
@@ -52,6 +55,7 @@
 #include "events/EventHandler.hpp"
 #include "files/Archive.hpp"
 #include "files/File.hpp"
+#include "files/FileData.hpp"
 #include "files/FileSystem.hpp"
 #include "graphics/BlendState.hpp"
 #include "graphics/Buffer.hpp"
@@ -113,6 +117,7 @@
 #include "scene/Light.hpp"
 #include "scene/ParticleSystemData.hpp"
 #include "scene/ParticleSystem.hpp"
+#include "scene/ProfilerOverlay.hpp"
 #include "scene/Scene.hpp"
 #include "scene/SceneManager.hpp"
 #include "scene/ShapeRenderer.hpp"
@@ -125,10 +130,14 @@
 #include "scene/TextRenderer.hpp"
 #include "utils/INI.hpp"
 #include "utils/JSON.hpp"
+#include "utils/JSONDocument.hpp"
 #include "utils/Log.hpp"
+#include "utils/MemoryTracker.hpp"
 #include "utils/OBF.hpp"
+#include "utils/Profiler.hpp"
 #include "utils/UTF8.hpp"
 #include "utils/Utils.hpp"
 #include "utils/XML.hpp"
+#include "utils/XMLDocument.hpp"
 
 #endif // OUZEL_HPP
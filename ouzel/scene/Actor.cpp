@@ -8,6 +8,7 @@
 #include "Camera.hpp"
 #include "math/MathUtils.hpp"
 #include "Component.hpp"
+#include "core/Engine.hpp"
 
 namespace ouzel
 {
@@ -37,6 +38,7 @@ namespace ouzel
 
             if (parentTransformDirty) updateTransform(newParentTransform);
             if (transformDirty) calculateTransform();
+            calculateDrawTransform();
 
             if (!worldHidden)
             {
@@ -54,7 +56,10 @@ namespace ouzel
             }
 
             for (Actor* actor : children)
+            {
+                actor->parentDrawTransform = drawTransformInterpolated ? &drawTransform : nullptr;
                 actor->visit(drawQueue, transform, updateChildrenTransform, camera, worldOrder, worldHidden);
+            }
 
             updateChildrenTransform = false;
         }
@@ -68,7 +73,7 @@ namespace ouzel
             {
                 if (!component->isHidden())
                 {
-                    component->draw(transform,
+                    component->draw(drawTransformInterpolated ? drawTransform : transform,
                                     opacity,
                                     camera->getRenderViewProjection(),
                                     wireframe);
@@ -85,6 +90,8 @@ namespace ouzel
 
         void Actor::setPosition(const Vector2<float>& newPosition)
         {
+            saveState();
+
             position.v[0] = newPosition.v[0];
             position.v[1] = newPosition.v[1];
 
@@ -93,6 +100,8 @@ namespace ouzel
 
         void Actor::setPosition(const Vector3<float>& newPosition)
         {
+            saveState();
+
             position = newPosition;
 
             updateLocalTransform();
@@ -100,6 +109,8 @@ namespace ouzel
 
         void Actor::setRotation(const Quaternion<float>& newRotation)
         {
+            saveState();
+
             rotation = newRotation;
 
             updateLocalTransform();
@@ -107,6 +118,8 @@ namespace ouzel
 
         void Actor::setRotation(const Vector3<float>& newRotation)
         {
+            saveState();
+
             Quaternion<float> roationQuaternion;
             roationQuaternion.setEulerAngles(newRotation);
 
@@ -117,6 +130,8 @@ namespace ouzel
 
         void Actor::setRotation(float newRotation)
         {
+            saveState();
+
             Quaternion<float> roationQuaternion;
             roationQuaternion.rotate(newRotation, Vector3<float>(0.0F, 0.0F, 1.0F));
 
@@ -127,6 +142,8 @@ namespace ouzel
 
         void Actor::setScale(const Vector2<float>& newScale)
         {
+            saveState();
+
             scale.v[0] = newScale.v[0];
             scale.v[1] = newScale.v[1];
 
@@ -135,6 +152,8 @@ namespace ouzel
 
         void Actor::setScale(const Vector3<float>& newScale)
         {
+            saveState();
+
             scale = newScale;
 
             updateLocalTransform();
@@ -218,10 +237,16 @@ namespace ouzel
 
         Vector3<float> Actor::getWorldPosition() const
         {
-            Vector3<float> result = position;
+            // the transform already contains the position of the actor
+            Vector3<float> result;
             getTransform().transformPoint(result);
 
-            return position;
+            return result;
+        }
+
+        Quaternion<float> Actor::getWorldRotation() const
+        {
+            return getTransform().getRotation();
         }
 
         Vector3<float> Actor::convertWorldToLocal(const Vector3<float>& worldPosition) const
@@ -271,6 +296,66 @@ namespace ouzel
             updateChildrenTransform = true;
         }
 
+        void Actor::saveState()
+        {
+            if (!engine || statePhase == engine->getUpdatePhase()) return;
+
+            previousPosition = position;
+            previousRotation = rotation;
+            previousScale = scale;
+            statePhase = engine->getUpdatePhase();
+        }
+
+        void Actor::resetState()
+        {
+            previousPosition = position;
+            previousRotation = rotation;
+            previousScale = scale;
+            statePhase = 0;
+        }
+
+        void Actor::calculateDrawTransform()
+        {
+            // interpolate only if the actor was last changed in the last fixed step
+            if (interpolated && engine && statePhase == engine->getFixedUpdatePhase())
+            {
+                float alpha = engine->getFixedUpdateAlpha();
+
+                // the shortest path between the rotations
+                Quaternion<float> startRotation = previousRotation;
+                if (startRotation.v[0] * rotation.v[0] + startRotation.v[1] * rotation.v[1] +
+                    startRotation.v[2] * rotation.v[2] + startRotation.v[3] * rotation.v[3] < 0.0F)
+                    startRotation = -startRotation;
+
+                Quaternion<float> drawRotation;
+                drawRotation.lerp(startRotation, rotation, alpha);
+                drawRotation.normalize();
+
+                Vector3<float> drawScale = previousScale + (scale - previousScale) * alpha;
+
+                Matrix4<float> localDrawTransform = Matrix4<float>::identity();
+                localDrawTransform.translate(previousPosition + (position - previousPosition) * alpha);
+
+                Matrix4<float> rotationMatrix;
+                rotationMatrix.setRotation(drawRotation);
+                localDrawTransform *= rotationMatrix;
+
+                localDrawTransform.scale(Vector3<float>(drawScale.v[0] * (flipX ? -1.0F : 1.0F),
+                                                        drawScale.v[1] * (flipY ? -1.0F : 1.0F),
+                                                        drawScale.v[2]));
+
+                drawTransform = (parentDrawTransform ? *parentDrawTransform : parentTransform) * localDrawTransform;
+                drawTransformInterpolated = true;
+            }
+            else if (parentDrawTransform)
+            {
+                drawTransform = *parentDrawTransform * getLocalTransform();
+                drawTransformInterpolated = true;
+            }
+            else
+                drawTransformInterpolated = false;
+        }
+
         void Actor::calculateInverseTransform() const
         {
             inverseTransform = getTransform();
@@ -320,6 +405,9 @@ namespace ouzel
 
         void Actor::setLayer(Layer* newLayer)
         {
+            // the actor has not been drawn before, so it must not be interpolated from its old transform
+            if (newLayer && newLayer != layer) resetState();
+
             ActorContainer::setLayer(newLayer);
 
             for (Component* component : components)
@@ -95,7 +95,12 @@ namespace ouzel
                 return inverseTransform;
             }
 
+            // transform changes made in the fixed update are interpolated between the last two fixed steps when drawing
+            inline bool isInterpolated() const { return interpolated; }
+            inline void setInterpolated(bool newInterpolated) { interpolated = newInterpolated; }
+
             Vector3<float> getWorldPosition() const;
+            Quaternion<float> getWorldRotation() const;
             virtual int32_t getWorldOrder() const { return worldOrder; }
 
             Vector3<float> convertWorldToLocal(const Vector3<float>& worldPosition) const;
@@ -126,6 +131,12 @@ namespace ouzel
 
             virtual void calculateInverseTransform() const;
 
+            // stores the state before the first change in the current update phase
+            void saveState();
+            // sets the previous state to the current transform
+            void resetState();
+            void calculateDrawTransform();
+
             Matrix4<float> parentTransform;
             mutable Matrix4<float> transform;
             mutable Matrix4<float> inverseTransform;
@@ -151,6 +162,17 @@ namespace ouzel
             int32_t order = 0;
             int32_t worldOrder = 0;
 
+            bool interpolated = true;
+            Vector3<float> previousPosition;
+            Quaternion<float> previousRotation = Quaternion<float>::identity();
+            Vector3<float> previousScale = Vector3<float>(1.0F, 1.0F, 1.0F);
+            uint64_t statePhase = 0; // update phase in which the transform was last changed
+
+            // interpolated transform, used instead of transform if drawTransformInterpolated is set
+            Matrix4<float> drawTransform;
+            const Matrix4<float>* parentDrawTransform = nullptr;
+            bool drawTransformInterpolated = false;
+
             ActorContainer* parent = nullptr;
 
             std::vector<Component*> components;
@@ -10,6 +10,7 @@
 #include "Scene.hpp"
 #include "math/Matrix4.hpp"
 #include "Component.hpp"
+#include "utils/Profiler.hpp"
 
 namespace ouzel
 {
@@ -27,12 +28,17 @@ namespace ouzel
 
         void Layer::draw()
         {
+            OUZEL_PROFILE_ZONE("Layer::draw");
+
             for (Camera* camera : cameras)
             {
                 std::vector<Actor*> drawQueue;
 
                 for (Actor* actor : children)
+                {
+                    actor->parentDrawTransform = nullptr;
                     actor->visit(drawQueue, Matrix4<float>::identity(), false, camera, 0, false);
+                }
 
                 engine->getRenderer()->setRenderTarget(camera->getRenderTarget() ? camera->getRenderTarget()->getResource() : 0);
                 engine->getRenderer()->setViewport(camera->getRenderViewport());
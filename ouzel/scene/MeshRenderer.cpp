@@ -0,0 +1,44 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include "MeshRenderer.hpp"
+#include "core/Engine.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        void drawMesh(const graphics::Material& material,
+                      float opacity,
+                      const Matrix4<float>& modelViewProjection,
+                      const graphics::Buffer& indexBuffer,
+                      uint32_t indexCount,
+                      uint32_t indexSize,
+                      const graphics::Buffer& vertexBuffer)
+        {
+            float colorVector[] = {material.diffuseColor.normR(), material.diffuseColor.normG(), material.diffuseColor.normB(), material.diffuseColor.normA() * opacity * material.opacity};
+
+            std::vector<std::vector<float>> fragmentShaderConstants(1);
+            fragmentShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
+
+            std::vector<std::vector<float>> vertexShaderConstants(1);
+            vertexShaderConstants[0] = {std::begin(modelViewProjection.m), std::end(modelViewProjection.m)};
+
+            std::vector<uintptr_t> textures;
+            for (const std::shared_ptr<graphics::Texture>& texture : material.textures)
+                textures.push_back(texture ? texture->getResource() : 0);
+
+            engine->getRenderer()->setCullMode(material.cullMode);
+            engine->getRenderer()->setPipelineState(material.blendState->getResource(),
+                                                    material.shader->getResource());
+            engine->getRenderer()->setShaderConstants(fragmentShaderConstants,
+                                                      vertexShaderConstants);
+            engine->getRenderer()->setTextures(textures);
+            engine->getRenderer()->draw(indexBuffer.getResource(),
+                                        indexCount,
+                                        indexSize,
+                                        vertexBuffer.getResource(),
+                                        graphics::DrawMode::TRIANGLE_LIST,
+                                        0);
+        }
+    } // namespace scene
+} // namespace ouzel
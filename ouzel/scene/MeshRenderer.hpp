@@ -0,0 +1,26 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_SCENE_MESHRENDERER_HPP
+#define OUZEL_SCENE_MESHRENDERER_HPP
+
+#include <cstdint>
+#include "graphics/Buffer.hpp"
+#include "graphics/Material.hpp"
+#include "math/Matrix4.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        // draws the indexed triangle list of a static or skinned mesh with the material
+        void drawMesh(const graphics::Material& material,
+                      float opacity,
+                      const Matrix4<float>& modelViewProjection,
+                      const graphics::Buffer& indexBuffer,
+                      uint32_t indexCount,
+                      uint32_t indexSize,
+                      const graphics::Buffer& vertexBuffer);
+    } // namespace scene
+} // namespace ouzel
+
+#endif // OUZEL_SCENE_MESHRENDERER_HPP
@@ -13,8 +13,6 @@
 #include "utils/Utils.hpp"
 #include "math/MathUtils.hpp"
 
-static constexpr float UPDATE_STEP = 1.0F / 60.0F;
-
 namespace ouzel
 {
     namespace scene
@@ -25,8 +23,6 @@ namespace ouzel
             shader = engine->getCache().getShader(SHADER_TEXTURE);
             blendState = engine->getCache().getBlendState(BLEND_ALPHA);
             whitePixelTexture = engine->getCache().getTexture(TEXTURE_WHITE_PIXEL);
-
-            updateHandler.updateHandler = std::bind(&ParticleSystem::handleUpdate, this, std::placeholders::_1);
         }
 
         ParticleSystem::ParticleSystem(const ParticleSystemData& initParticleSystemData):
@@ -91,125 +87,118 @@ namespace ouzel
 
         void ParticleSystem::update(float delta)
         {
-            timeSinceUpdate += delta;
-
             bool needsBoundingBoxUpdate = false;
 
-            while (timeSinceUpdate >= UPDATE_STEP)
+            if (running && particleSystemData.emissionRate > 0.0F)
             {
-                timeSinceUpdate -= UPDATE_STEP;
+                float rate = 1.0F / particleSystemData.emissionRate;
 
-                if (running && particleSystemData.emissionRate > 0.0F)
+                if (particleCount < particleSystemData.maxParticles)
                 {
-                    float rate = 1.0F / particleSystemData.emissionRate;
-
-                    if (particleCount < particleSystemData.maxParticles)
-                    {
-                        emitCounter += UPDATE_STEP;
-                        if (emitCounter < 0.0F)
-                            emitCounter = 0.0F;
-                    }
+                    emitCounter += delta;
+                    if (emitCounter < 0.0F)
+                        emitCounter = 0.0F;
+                }
 
-                    uint32_t emitCount = static_cast<uint32_t>(std::min(static_cast<float>(particleSystemData.maxParticles - particleCount), emitCounter / rate));
-                    emitParticles(emitCount);
-                    emitCounter -= rate * emitCount;
+                uint32_t emitCount = static_cast<uint32_t>(std::min(static_cast<float>(particleSystemData.maxParticles - particleCount), emitCounter / rate));
+                emitParticles(emitCount);
+                emitCounter -= rate * emitCount;
 
-                    elapsed += UPDATE_STEP;
-                    if (elapsed < 0.0F)
-                        elapsed = 0.0F;
-                    if (particleSystemData.duration >= 0.0F && particleSystemData.duration < elapsed)
-                    {
-                        finished = true;
-                        stop();
-                    }
-                }
-                else if (active && !particleCount)
+                elapsed += delta;
+                if (elapsed < 0.0F)
+                    elapsed = 0.0F;
+                if (particleSystemData.duration >= 0.0F && particleSystemData.duration < elapsed)
                 {
-                    active = false;
-                    updateHandler.remove();
+                    finished = true;
+                    stop();
+                }
+            }
+            else if (active && !particleCount)
+            {
+                active = false;
+                updateEntry.remove();
 
-                    std::unique_ptr<AnimationEvent> finishEvent(new AnimationEvent());
-                    finishEvent->type = Event::Type::ANIMATION_FINISH;
-                    finishEvent->component = this;
-                    engine->getEventDispatcher().dispatchEvent(std::move(finishEvent));
+                std::unique_ptr<AnimationEvent> finishEvent(new AnimationEvent());
+                finishEvent->type = Event::Type::ANIMATION_FINISH;
+                finishEvent->component = this;
+                engine->getEventDispatcher().dispatchEvent(std::move(finishEvent));
 
-                    return;
-                }
+                return;
+            }
 
-                if (active)
+            if (active)
+            {
+                for (uint32_t counter = particleCount; counter > 0; --counter)
                 {
-                    for (uint32_t counter = particleCount; counter > 0; --counter)
-                    {
-                        size_t i = counter - 1;
+                    size_t i = counter - 1;
 
-                        particles[i].life -= UPDATE_STEP;
+                    particles[i].life -= delta;
 
-                        if (particles[i].life >= 0.0F)
+                    if (particles[i].life >= 0.0F)
+                    {
+                        if (particleSystemData.emitterType == ParticleSystemData::EmitterType::GRAVITY)
                         {
-                            if (particleSystemData.emitterType == ParticleSystemData::EmitterType::GRAVITY)
-                            {
-                                Vector2<float> tmp;
-                                Vector2<float> radial;
-                                Vector2<float> tangential;
-
-                                // radial acceleration
-                                if (particles[i].position.v[0] == 0.0F || particles[i].position.v[1] == 0.0F)
-                                {
-                                    radial = particles[i].position;
-                                    radial.normalize();
-                                }
-                                tangential = radial;
-                                radial *= particles[i].radialAcceleration;
-
-                                // tangential acceleration
-                                std::swap(tangential.v[0], tangential.v[1]);
-                                tangential.v[0] *= - particles[i].tangentialAcceleration;
-                                tangential.v[1] *= particles[i].tangentialAcceleration;
-
-                                // (gravity + radial + tangential) * UPDATE_STEP
-                                tmp.v[0] = radial.v[0] + tangential.v[0] + particleSystemData.gravity.v[0];
-                                tmp.v[1] = radial.v[1] + tangential.v[1] + particleSystemData.gravity.v[1];
-                                tmp.v[0] *= UPDATE_STEP;
-                                tmp.v[1] *= UPDATE_STEP;
-
-                                particles[i].direction.v[0] += tmp.v[0];
-                                particles[i].direction.v[1] += tmp.v[1];
-                                tmp.v[0] = particles[i].direction.v[0] * UPDATE_STEP * particleSystemData.yCoordFlipped;
-                                tmp.v[1] = particles[i].direction.v[1] * UPDATE_STEP * particleSystemData.yCoordFlipped;
-                                particles[i].position.v[0] += tmp.v[0];
-                                particles[i].position.v[1] += tmp.v[1];
-                            }
-                            else
+                            Vector2<float> tmp;
+                            Vector2<float> radial;
+                            Vector2<float> tangential;
+
+                            // radial acceleration
+                            if (particles[i].position.v[0] == 0.0F || particles[i].position.v[1] == 0.0F)
                             {
-                                particles[i].angle += particles[i].degreesPerSecond * UPDATE_STEP;
-                                particles[i].radius += particles[i].deltaRadius * UPDATE_STEP;
-                                particles[i].position.v[0] = -cosf(particles[i].angle) * particles[i].radius;
-                                particles[i].position.v[1] = -sinf(particles[i].angle) * particles[i].radius * particleSystemData.yCoordFlipped;
+                                radial = particles[i].position;
+                                radial.normalize();
                             }
-
-                            // color r,g,b,a
-                            particles[i].colorRed += particles[i].deltaColorRed * UPDATE_STEP;
-                            particles[i].colorGreen += particles[i].deltaColorGreen * UPDATE_STEP;
-                            particles[i].colorBlue += particles[i].deltaColorBlue * UPDATE_STEP;
-                            particles[i].colorAlpha += particles[i].deltaColorAlpha * UPDATE_STEP;
-
-                            // size
-                            particles[i].size += (particles[i].deltaSize * UPDATE_STEP);
-                            particles[i].size = std::max(0.0F, particles[i].size);
-
-                            // angle
-                            particles[i].rotation += particles[i].deltaRotation * UPDATE_STEP;
+                            tangential = radial;
+                            radial *= particles[i].radialAcceleration;
+
+                            // tangential acceleration
+                            std::swap(tangential.v[0], tangential.v[1]);
+                            tangential.v[0] *= - particles[i].tangentialAcceleration;
+                            tangential.v[1] *= particles[i].tangentialAcceleration;
+
+                            // (gravity + radial + tangential) * delta
+                            tmp.v[0] = radial.v[0] + tangential.v[0] + particleSystemData.gravity.v[0];
+                            tmp.v[1] = radial.v[1] + tangential.v[1] + particleSystemData.gravity.v[1];
+                            tmp.v[0] *= delta;
+                            tmp.v[1] *= delta;
+
+                            particles[i].direction.v[0] += tmp.v[0];
+                            particles[i].direction.v[1] += tmp.v[1];
+                            tmp.v[0] = particles[i].direction.v[0] * delta * particleSystemData.yCoordFlipped;
+                            tmp.v[1] = particles[i].direction.v[1] * delta * particleSystemData.yCoordFlipped;
+                            particles[i].position.v[0] += tmp.v[0];
+                            particles[i].position.v[1] += tmp.v[1];
                         }
                         else
                         {
-                            particles[i] = particles[particleCount - 1];
-                            --particleCount;
+                            particles[i].angle += particles[i].degreesPerSecond * delta;
+                            particles[i].radius += particles[i].deltaRadius * delta;
+                            particles[i].position.v[0] = -cosf(particles[i].angle) * particles[i].radius;
+                            particles[i].position.v[1] = -sinf(particles[i].angle) * particles[i].radius * particleSystemData.yCoordFlipped;
                         }
-                    }
 
-                    needsMeshUpdate = true;
-                    needsBoundingBoxUpdate = true;
+                        // color r,g,b,a
+                        particles[i].colorRed += particles[i].deltaColorRed * delta;
+                        particles[i].colorGreen += particles[i].deltaColorGreen * delta;
+                        particles[i].colorBlue += particles[i].deltaColorBlue * delta;
+                        particles[i].colorAlpha += particles[i].deltaColorAlpha * delta;
+
+                        // size
+                        particles[i].size += (particles[i].deltaSize * delta);
+                        particles[i].size = std::max(0.0F, particles[i].size);
+
+                        // angle
+                        particles[i].rotation += particles[i].deltaRotation * delta;
+                    }
+                    else
+                    {
+                        particles[i] = particles[particleCount - 1];
+                        --particleCount;
+                    }
                 }
+
+                needsMeshUpdate = true;
+                needsBoundingBoxUpdate = true;
             }
 
             if (needsBoundingBoxUpdate)
@@ -240,14 +229,10 @@ namespace ouzel
             }
         }
 
-        bool ParticleSystem::handleUpdate(const UpdateEvent& event)
-        {
-            update(event.delta);
-            return false;
-        }
-
         void ParticleSystem::init(const ParticleSystemData& newParticleSystemData)
         {
+            dataFilename.clear();
+
             particleSystemData = newParticleSystemData;
 
             texture = particleSystemData.texture;
@@ -261,6 +246,14 @@ namespace ouzel
 
         void ParticleSystem::init(const std::string& filename)
         {
+            dataFilename = filename;
+
+            if (!reloadHandler.systemHandler)
+            {
+                reloadHandler.systemHandler = std::bind(&ParticleSystem::handleSystem, this, std::placeholders::_1);
+                engine->getEventDispatcher().addEventHandler(&reloadHandler);
+            }
+
             particleSystemData = *engine->getCache().getParticleSystemData(filename);
 
             texture = particleSystemData.texture;
@@ -282,7 +275,7 @@ namespace ouzel
                 if (!active)
                 {
                     active = true;
-                    engine->getEventDispatcher().addEventHandler(&updateHandler);
+                    engine->getUpdateScheduler().add(this, updateEntry, UpdateScheduler::FIXED_GROUP);
                 }
 
                 if (particleCount == 0)
@@ -304,7 +297,6 @@ namespace ouzel
         {
             emitCounter = 0.0F;
             elapsed = 0.0F;
-            timeSinceUpdate = 0.0F;
             particleCount = 0;
             finished = false;
         }
@@ -475,5 +467,13 @@ namespace ouzel
                 particleCount += count;
             }
         }
+
+        bool ParticleSystem::handleSystem(const SystemEvent& event)
+        {
+            if (event.type == Event::Type::ASSET_RELOAD && event.filename == dataFilename)
+                init(dataFilename);
+
+            return false;
+        }
     } // namespace scene
 } // namespace ouzel
@@ -10,6 +10,7 @@
 #include "scene/ParticleSystemData.hpp"
 #include "math/Vector2.hpp"
 #include "math/Color.hpp"
+#include "core/UpdateScheduler.hpp"
 #include "events/EventHandler.hpp"
 #include "graphics/Vertex.hpp"
 #include "graphics/BlendState.hpp"
@@ -23,6 +24,7 @@ namespace ouzel
     {
         class ParticleSystem: public Component
         {
+            friend UpdateScheduler;
         public:
             static constexpr uint32_t CLASS = Component::PARTICLE_SYSTEM;
 
@@ -50,15 +52,20 @@ namespace ouzel
 
         private:
             void update(float delta);
-            bool handleUpdate(const UpdateEvent& event);
 
             void createParticleMesh();
             void updateParticleMesh();
 
             void emitParticles(uint32_t count);
 
+            bool handleSystem(const SystemEvent& event);
+
             ParticleSystemData particleSystemData;
 
+            // the particle system is initialized again when its file is reloaded
+            std::string dataFilename;
+            EventHandler reloadHandler;
+
             std::shared_ptr<graphics::Shader> shader;
             std::shared_ptr<graphics::BlendState> blendState;
             std::shared_ptr<graphics::Texture> texture;
@@ -110,14 +117,13 @@ namespace ouzel
 
             float emitCounter = 0.0F;
             float elapsed = 0.0F;
-            float timeSinceUpdate = 0.0F;
             bool active = false;
             bool running = false;
             bool finished = false;
 
             bool needsMeshUpdate = false;
 
-            EventHandler updateHandler;
+            UpdateScheduler::Entry updateEntry;
         };
     } // namespace scene
 } // namespace ouzel
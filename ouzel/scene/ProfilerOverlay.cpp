@@ -0,0 +1,126 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <algorithm>
+#include <cstdio>
+#include "ProfilerOverlay.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Profiler.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        static const uint32_t ZONE_COLORS[] = {
+            0x4e79a7ff,
+            0xf28e2bff,
+            0xe15759ff,
+            0x76b7b2ff,
+            0x59a14fff,
+            0xedc948ff,
+            0xb07aa1ff,
+            0xff9da7ff
+        };
+
+        ProfilerOverlay::ProfilerOverlay(const std::string& fontFile,
+                                         float initFontSize)
+        {
+            if (!fontFile.empty())
+                textRenderer.reset(new TextRenderer(fontFile, initFontSize, std::string(), Color::WHITE, Vector2<float>(0.0F, 1.0F)));
+        }
+
+        void ProfilerOverlay::draw(const Matrix4<float>& transformMatrix,
+                                   float opacity,
+                                   const Matrix4<float>& renderViewProjection,
+                                   bool wireframe)
+        {
+            if (profiler.getFrameIndex() != frameIndex)
+            {
+                frameIndex = profiler.getFrameIndex();
+                updateBars();
+            }
+
+            ShapeRenderer::draw(transformMatrix,
+                                opacity,
+                                renderViewProjection,
+                                wireframe);
+
+            if (textRenderer)
+            {
+                Matrix4<float> textMatrix = transformMatrix;
+                textMatrix.translate(textOffset, 0.0F, 0.0F);
+
+                textRenderer->draw(textMatrix,
+                                   opacity,
+                                   renderViewProjection,
+                                   wireframe);
+            }
+        }
+
+        void ProfilerOverlay::updateBars()
+        {
+            clear();
+
+            std::vector<Profiler::ZoneStats> frameStats = profiler.getFrameStats();
+            std::string text;
+            char buffer[64];
+            uint32_t thread = 0;
+            float y = 0.0F;
+            float right = frameBudget * scale;
+
+            for (auto i = frameStats.begin(); i != frameStats.end(); ++i)
+            {
+                // every thread starts with a header row
+                if (i == frameStats.begin() || i->thread != thread)
+                {
+                    thread = i->thread;
+                    text += profiler.getThreadName(thread) + "\n";
+                    y -= rowHeight;
+                }
+
+                uint32_t hash = 0;
+                for (const char* c = i->name; *c; ++c) hash = hash * 31 + static_cast<uint8_t>(*c);
+
+                float time = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(i->time).count();
+                float x = static_cast<float>(i->depth) * rowHeight * 0.5F;
+                float width = std::max(time * scale, 1.0F);
+
+                rectangle(Rect<float>(x, y - rowHeight * 0.9F, width, rowHeight * 0.8F),
+                          ZONE_COLORS[hash % (sizeof(ZONE_COLORS) / sizeof(ZONE_COLORS[0]))],
+                          true);
+
+                right = std::max(right, x + width);
+
+                if (textRenderer)
+                {
+                    text += std::string(i->depth * 2, ' ') + i->name;
+                    snprintf(buffer, sizeof(buffer), " %.2f ms", static_cast<double>(time));
+                    text += buffer;
+                    if (i->calls > 1) text += " x" + std::to_string(i->calls);
+                    text += "\n";
+                }
+
+                y -= rowHeight;
+            }
+
+            line(Vector2<float>(frameBudget * scale, 0.0F), Vector2<float>(frameBudget * scale, y), Color::RED);
+
+            if (textRenderer)
+            {
+                text += "\n";
+
+                for (size_t tag = 0; tag < static_cast<size_t>(MemoryTag::COUNT); ++tag)
+                {
+                    const double megabyte = 1024.0 * 1024.0;
+                    snprintf(buffer, sizeof(buffer), ": %.2f MB (peak %.2f MB)\n",
+                             static_cast<double>(memoryTracker.getLive(static_cast<MemoryTag>(tag))) / megabyte,
+                             static_cast<double>(memoryTracker.getPeak(static_cast<MemoryTag>(tag))) / megabyte);
+                    text += MemoryTracker::getTagName(static_cast<MemoryTag>(tag));
+                    text += buffer;
+                }
+            }
+
+            textOffset = right + rowHeight;
+            if (textRenderer) textRenderer->setText(text);
+        }
+    } // namespace scene
+} // namespace ouzel
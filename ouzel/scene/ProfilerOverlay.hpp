@@ -0,0 +1,52 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_SCENE_PROFILEROVERLAY_HPP
+#define OUZEL_SCENE_PROFILEROVERLAY_HPP
+
+#include <memory>
+#include <string>
+#include "scene/ShapeRenderer.hpp"
+#include "scene/TextRenderer.hpp"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        // draws the zones of the last profiled frame as bars (one row per zone, grouped by thread)
+        // if a font is set, the names and times of the zones and the memory usage are printed next to the bars
+        class ProfilerOverlay: public ShapeRenderer
+        {
+        public:
+            explicit ProfilerOverlay(const std::string& fontFile = std::string(),
+                                     float initFontSize = 1.0F);
+
+            void draw(const Matrix4<float>& transformMatrix,
+                      float opacity,
+                      const Matrix4<float>& renderViewProjection,
+                      bool wireframe) override;
+
+            // width of one millisecond
+            inline float getScale() const { return scale; }
+            inline void setScale(float newScale) { scale = newScale; }
+
+            inline float getRowHeight() const { return rowHeight; }
+            inline void setRowHeight(float newRowHeight) { rowHeight = newRowHeight; }
+
+            // frame budget in milliseconds, marked with a vertical line
+            inline float getFrameBudget() const { return frameBudget; }
+            inline void setFrameBudget(float newFrameBudget) { frameBudget = newFrameBudget; }
+
+        private:
+            void updateBars();
+
+            std::unique_ptr<TextRenderer> textRenderer;
+            float scale = 20.0F;
+            float rowHeight = 8.0F;
+            float frameBudget = 1000.0F / 60.0F;
+            float textOffset = 0.0F;
+            uint64_t frameIndex = 0;
+        };
+    } // namespace scene
+} // namespace ouzel
+
+#endif // OUZEL_SCENE_PROFILEROVERLAY_HPP
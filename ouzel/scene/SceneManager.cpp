@@ -5,6 +5,7 @@
 #include "SceneManager.hpp"
 #include "Scene.hpp"
 #include "Actor.hpp"
+#include "utils/Profiler.hpp"
 
 namespace ouzel
 {
@@ -61,6 +62,8 @@ namespace ouzel
 
         void SceneManager::draw()
         {
+            OUZEL_PROFILE_ZONE("SceneManager::draw");
+
             while (scenes.size() > 1)
                 removeScene(scenes.front());
 
@@ -1,6 +1,7 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
 #include "SkinnedMeshData.hpp"
+#include "core/Engine.hpp"
 #include "utils/Utils.hpp"
 
 namespace ouzel
@@ -13,5 +14,38 @@ namespace ouzel
             material(initMaterial)
         {
         }
+
+        SkinnedMeshData::SkinnedMeshData(Box3<float> initBoundingBox,
+                                         const std::vector<uint32_t>& indices,
+                                         const std::vector<graphics::Vertex>& vertices,
+                                         const std::shared_ptr<graphics::Material>& initMaterial):
+            boundingBox(initBoundingBox),
+            material(initMaterial)
+        {
+            indexCount = static_cast<uint32_t>(indices.size());
+            indexSize = sizeof(uint32_t);
+
+            indexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            indexBuffer->init(graphics::Buffer::Usage::INDEX, 0, indices.data(), static_cast<uint32_t>(getVectorSize(indices)));
+
+            vertexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, 0, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)));
+        }
+
+        SkinnedMeshData::SkinnedMeshData(Box3<float> initBoundingBox,
+                                         const void* indices, uint32_t initIndexSize, uint32_t initIndexCount,
+                                         const graphics::Vertex* vertices, uint32_t vertexCount,
+                                         const std::shared_ptr<graphics::Material>& initMaterial):
+            boundingBox(initBoundingBox),
+            material(initMaterial),
+            indexCount(initIndexCount),
+            indexSize(initIndexSize)
+        {
+            indexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            indexBuffer->init(graphics::Buffer::Usage::INDEX, 0, indices, indexSize * indexCount);
+
+            vertexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, 0, vertices, static_cast<uint32_t>(sizeof(graphics::Vertex) * vertexCount));
+        }
     } // namespace scene
 } // namespace ouzel
@@ -4,7 +4,9 @@
 #define OUZEL_SCENE_SKINNEDMESHDATA_HPP
 
 #include <vector>
+#include "graphics/Buffer.hpp"
 #include "graphics/Material.hpp"
+#include "graphics/Vertex.hpp"
 
 namespace ouzel
 {
@@ -23,9 +25,23 @@ namespace ouzel
             SkinnedMeshData() {}
             SkinnedMeshData(Box3<float> initBoundingBox,
                             const std::shared_ptr<graphics::Material>& initMaterial);
+            // the mesh in the bind pose
+            SkinnedMeshData(Box3<float> initBoundingBox,
+                            const std::vector<uint32_t>& indices,
+                            const std::vector<graphics::Vertex>& vertices,
+                            const std::shared_ptr<graphics::Material>& initMaterial);
+            // the buffers are initialized directly from the given memory, the index size is 2 or 4 bytes
+            SkinnedMeshData(Box3<float> initBoundingBox,
+                            const void* indices, uint32_t initIndexSize, uint32_t initIndexCount,
+                            const graphics::Vertex* vertices, uint32_t vertexCount,
+                            const std::shared_ptr<graphics::Material>& initMaterial);
 
             Box3<float> boundingBox;
             std::shared_ptr<graphics::Material> material;
+            uint32_t indexCount = 0;
+            uint32_t indexSize = 0;
+            std::shared_ptr<graphics::Buffer> indexBuffer;
+            std::shared_ptr<graphics::Buffer> vertexBuffer;
         };
     } // namespace scene
 } // namespace ouzel
@@ -1,6 +1,7 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
 #include "SkinnedMeshRenderer.hpp"
+#include "MeshRenderer.hpp"
 #include "core/Engine.hpp"
 
 namespace ouzel
@@ -27,13 +28,27 @@ namespace ouzel
 
         void SkinnedMeshRenderer::init(const SkinnedMeshData& meshData)
         {
+            dataFilename.clear();
+
             boundingBox = meshData.boundingBox;
             material = meshData.material;
+            indexCount = meshData.indexCount;
+            indexSize = meshData.indexSize;
+            indexBuffer = meshData.indexBuffer;
+            vertexBuffer = meshData.vertexBuffer;
         }
 
         void SkinnedMeshRenderer::init(const std::string& filename)
         {
             init(*engine->getCache().getSkinnedMeshData(filename));
+
+            dataFilename = filename;
+
+            if (!reloadHandler.systemHandler)
+            {
+                reloadHandler.systemHandler = std::bind(&SkinnedMeshRenderer::handleSystem, this, std::placeholders::_1);
+                engine->getEventDispatcher().addEventHandler(&reloadHandler);
+            }
         }
 
         void SkinnedMeshRenderer::draw(const Matrix4<float>& transformMatrix,
@@ -45,6 +60,24 @@ namespace ouzel
                             opacity,
                             renderViewProjection,
                             wireframe);
+
+            // the mesh is drawn in the bind pose
+            if (!material || !indexBuffer || !vertexBuffer) return;
+
+            drawMesh(*material, opacity, renderViewProjection * transformMatrix,
+                     *indexBuffer, indexCount, indexSize, *vertexBuffer);
+        }
+
+        bool SkinnedMeshRenderer::handleSystem(const SystemEvent& event)
+        {
+            if (event.type == Event::Type::ASSET_RELOAD && event.filename == dataFilename)
+            {
+                // init clears the filename
+                const std::string filename = dataFilename;
+                init(filename);
+            }
+
+            return false;
         }
     } // namespace scene
 } // namespace ouzel
@@ -16,8 +16,6 @@ namespace ouzel
         Sprite::Sprite():
             Component(CLASS)
         {
-            updateHandler.updateHandler = std::bind(&Sprite::handleUpdate, this, std::placeholders::_1);
-
             currentAnimation = animationQueue.end();
         }
 
@@ -43,6 +41,8 @@ namespace ouzel
 
         void Sprite::init(const SpriteData& spriteData)
         {
+            dataFilename.clear();
+
             material = std::make_shared<graphics::Material>();
             material->cullMode = graphics::CullMode::NONE;
             material->blendState = spriteData.blendState ? spriteData.blendState : engine->getCache().getBlendState(BLEND_ALPHA);
@@ -60,6 +60,14 @@ namespace ouzel
 
         void Sprite::init(const std::string& filename)
         {
+            dataFilename = filename;
+
+            if (!reloadHandler.systemHandler)
+            {
+                reloadHandler.systemHandler = std::bind(&Sprite::handleSystem, this, std::placeholders::_1);
+                engine->getEventDispatcher().addEventHandler(&reloadHandler);
+            }
+
             material = std::make_shared<graphics::Material>();
             material->cullMode = graphics::CullMode::NONE;
             material->shader = engine->getCache().getShader(SHADER_TEXTURE);
@@ -99,6 +107,8 @@ namespace ouzel
                           uint32_t spritesX, uint32_t spritesY,
                           const Vector2<float>& pivot)
         {
+            dataFilename.clear();
+
             material = std::make_shared<graphics::Material>();
             material->cullMode = graphics::CullMode::NONE;
             material->shader = engine->getCache().getShader(SHADER_TEXTURE);
@@ -202,12 +212,6 @@ namespace ouzel
             }
         }
 
-        bool Sprite::handleUpdate(const UpdateEvent& event)
-        {
-            update(event.delta);
-            return false;
-        }
-
         void Sprite::draw(const Matrix4<float>& transformMatrix,
                           float opacity,
                           const Matrix4<float>& renderViewProjection,
@@ -268,7 +272,7 @@ namespace ouzel
         {
             if (!playing)
             {
-                engine->getEventDispatcher().addEventHandler(&updateHandler);
+                engine->getUpdateScheduler().add(this, updateEntry);
                 playing = true;
                 running = true;
             }
@@ -280,7 +284,7 @@ namespace ouzel
             {
                 playing = false;
                 running = false;
-                updateHandler.remove();
+                updateEntry.remove();
             }
 
             if (resetAnimation) reset();
@@ -391,5 +395,32 @@ namespace ouzel
             else
                 boundingBox.reset();
         }
+
+        bool Sprite::handleSystem(const SystemEvent& event)
+        {
+            if (event.type == Event::Type::ASSET_RELOAD && event.filename == dataFilename)
+            {
+                // keep the current animation if the reloaded data still has it
+                std::string animationName;
+                bool repeat = false;
+                const bool wasRunning = running;
+
+                if (currentAnimation != animationQueue.end())
+                {
+                    animationName = currentAnimation->animation->name;
+                    repeat = currentAnimation->repeat;
+                }
+
+                init(dataFilename);
+
+                if (!animationName.empty() && hasAnimation(animationName))
+                {
+                    setAnimation(animationName, repeat);
+                    running = wasRunning;
+                }
+            }
+
+            return false;
+        }
     } // namespace scene
 } // namespace ouzel
@@ -8,6 +8,7 @@
 #include "math/Size2.hpp"
 #include "math/Vector2.hpp"
 #include "scene/SpriteData.hpp"
+#include "core/UpdateScheduler.hpp"
 #include "events/EventHandler.hpp"
 #include "graphics/Material.hpp"
 
@@ -61,8 +62,8 @@ namespace ouzel
             void setAnimationTime(float time);
 
         private:
-            bool handleUpdate(const UpdateEvent& event);
             void updateBoundingBox();
+            bool handleSystem(const SystemEvent& event);
 
             std::shared_ptr<graphics::Material> material;
             std::map<std::string, SpriteData::Animation> animations;
@@ -83,7 +84,11 @@ namespace ouzel
             bool running = false;
             float currentTime = 0.0F;
 
-            EventHandler updateHandler;
+            UpdateScheduler::Entry updateEntry;
+
+            // the sprite is initialized again when its file is reloaded
+            std::string dataFilename;
+            EventHandler reloadHandler;
         };
     } // namespace scene
 } // namespace ouzel
@@ -17,51 +17,15 @@ namespace ouzel
                                  const Vector2<float>& pivot):
             name(frameName)
         {
-            std::vector<uint16_t> indices = {0, 1, 2, 1, 3, 2};
+            std::vector<uint16_t> indices;
+            std::vector<graphics::Vertex> vertices;
+            calculateVertices(textureSize, frameRectangle, rotated, sourceSize, sourceOffset, pivot, indices, vertices);
+
             indexCount = static_cast<uint32_t>(indices.size());
 
-            Vector2<float> textCoords[4];
             Vector2<float> finalOffset(-sourceSize.v[0] * pivot.v[0] + sourceOffset.v[0],
                                        -sourceSize.v[1] * pivot.v[1] + (sourceSize.v[1] - frameRectangle.size.v[1] - sourceOffset.v[1]));
 
-            if (!rotated)
-            {
-                Vector2<float> leftTop(frameRectangle.position.v[0] / textureSize.v[0],
-                                frameRectangle.position.v[1] / textureSize.v[1]);
-
-                Vector2<float> rightBottom((frameRectangle.position.v[0] + frameRectangle.size.v[0]) / textureSize.v[0],
-                                    (frameRectangle.position.v[1] + frameRectangle.size.v[1]) / textureSize.v[1]);
-
-                textCoords[0] = Vector2<float>(leftTop.v[0], rightBottom.v[1]);
-                textCoords[1] = Vector2<float>(rightBottom.v[0], rightBottom.v[1]);
-                textCoords[2] = Vector2<float>(leftTop.v[0], leftTop.v[1]);
-                textCoords[3] = Vector2<float>(rightBottom.v[0], leftTop.v[1]);
-            }
-            else
-            {
-                Vector2<float> leftTop = Vector2<float>(frameRectangle.position.v[0] / textureSize.v[0],
-                                          frameRectangle.position.v[1] / textureSize.v[1]);
-
-                Vector2<float> rightBottom = Vector2<float>((frameRectangle.position.v[0] + frameRectangle.size.v[1]) / textureSize.v[0],
-                                              (frameRectangle.position.v[1] + frameRectangle.size.v[0]) / textureSize.v[1]);
-
-                textCoords[0] = Vector2<float>(leftTop.v[0], leftTop.v[1]);
-                textCoords[1] = Vector2<float>(leftTop.v[0], rightBottom.v[1]);
-                textCoords[2] = Vector2<float>(rightBottom.v[0], leftTop.v[1]);
-                textCoords[3] = Vector2<float>(rightBottom.v[0], rightBottom.v[1]);
-            }
-
-            std::vector<graphics::Vertex> vertices = {
-                graphics::Vertex(Vector3<float>(finalOffset.v[0], finalOffset.v[1], 0.0F), Color::WHITE,
-                                 textCoords[0], Vector3<float>(0.0F, 0.0F, -1.0F)),
-                graphics::Vertex(Vector3<float>(finalOffset.v[0] + frameRectangle.size.v[0], finalOffset.v[1], 0.0F), Color::WHITE,
-                                 textCoords[1], Vector3<float>(0.0F, 0.0F, -1.0F)),
-                graphics::Vertex(Vector3<float>(finalOffset.v[0], finalOffset.v[1] + frameRectangle.size.v[1], 0.0F), Color::WHITE,
-                                 textCoords[2], Vector3<float>(0.0F, 0.0F, -1.0F)),
-                graphics::Vertex(Vector3<float>(finalOffset.v[0] + frameRectangle.size.v[0], finalOffset.v[1] + frameRectangle.size.v[1], 0.0F), Color::WHITE,
-                                 textCoords[3], Vector3<float>(0.0F, 0.0F, -1.0F))
-            };
-
             boundingBox.min = finalOffset;
             boundingBox.max = finalOffset + Vector2<float>(frameRectangle.size.v[0], frameRectangle.size.v[1]);
 
@@ -113,5 +77,75 @@ namespace ouzel
             vertexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
             vertexBuffer->init(graphics::Buffer::Usage::VERTEX, 0, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)));
         }
+
+        SpriteData::Frame::Frame(const std::string& frameName,
+                                 const uint16_t* indices, uint32_t initIndexCount,
+                                 const graphics::Vertex* vertices, uint32_t vertexCount):
+            name(frameName),
+            indexCount(initIndexCount)
+        {
+            for (uint32_t i = 0; i < vertexCount; ++i)
+                boundingBox.insertPoint(Vector2<float>(vertices[i].position));
+
+            indexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            indexBuffer->init(graphics::Buffer::Usage::INDEX, 0, indices, static_cast<uint32_t>(sizeof(uint16_t) * indexCount));
+
+            vertexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, 0, vertices, static_cast<uint32_t>(sizeof(graphics::Vertex) * vertexCount));
+        }
+
+        void SpriteData::Frame::calculateVertices(const Size2<float>& textureSize,
+                                                  const Rect<float>& frameRectangle,
+                                                  bool rotated,
+                                                  const Size2<float>& sourceSize,
+                                                  const Vector2<float>& sourceOffset,
+                                                  const Vector2<float>& pivot,
+                                                  std::vector<uint16_t>& indices,
+                                                  std::vector<graphics::Vertex>& vertices)
+        {
+            Vector2<float> textCoords[4];
+            Vector2<float> finalOffset(-sourceSize.v[0] * pivot.v[0] + sourceOffset.v[0],
+                                       -sourceSize.v[1] * pivot.v[1] + (sourceSize.v[1] - frameRectangle.size.v[1] - sourceOffset.v[1]));
+
+            if (!rotated)
+            {
+                Vector2<float> leftTop(frameRectangle.position.v[0] / textureSize.v[0],
+                                frameRectangle.position.v[1] / textureSize.v[1]);
+
+                Vector2<float> rightBottom((frameRectangle.position.v[0] + frameRectangle.size.v[0]) / textureSize.v[0],
+                                    (frameRectangle.position.v[1] + frameRectangle.size.v[1]) / textureSize.v[1]);
+
+                textCoords[0] = Vector2<float>(leftTop.v[0], rightBottom.v[1]);
+                textCoords[1] = Vector2<float>(rightBottom.v[0], rightBottom.v[1]);
+                textCoords[2] = Vector2<float>(leftTop.v[0], leftTop.v[1]);
+                textCoords[3] = Vector2<float>(rightBottom.v[0], leftTop.v[1]);
+            }
+            else
+            {
+                Vector2<float> leftTop = Vector2<float>(frameRectangle.position.v[0] / textureSize.v[0],
+                                          frameRectangle.position.v[1] / textureSize.v[1]);
+
+                Vector2<float> rightBottom = Vector2<float>((frameRectangle.position.v[0] + frameRectangle.size.v[1]) / textureSize.v[0],
+                                              (frameRectangle.position.v[1] + frameRectangle.size.v[0]) / textureSize.v[1]);
+
+                textCoords[0] = Vector2<float>(leftTop.v[0], leftTop.v[1]);
+                textCoords[1] = Vector2<float>(leftTop.v[0], rightBottom.v[1]);
+                textCoords[2] = Vector2<float>(rightBottom.v[0], leftTop.v[1]);
+                textCoords[3] = Vector2<float>(rightBottom.v[0], rightBottom.v[1]);
+            }
+
+            indices = {0, 1, 2, 1, 3, 2};
+
+            vertices = {
+                graphics::Vertex(Vector3<float>(finalOffset.v[0], finalOffset.v[1], 0.0F), Color::WHITE,
+                                 textCoords[0], Vector3<float>(0.0F, 0.0F, -1.0F)),
+                graphics::Vertex(Vector3<float>(finalOffset.v[0] + frameRectangle.size.v[0], finalOffset.v[1], 0.0F), Color::WHITE,
+                                 textCoords[1], Vector3<float>(0.0F, 0.0F, -1.0F)),
+                graphics::Vertex(Vector3<float>(finalOffset.v[0], finalOffset.v[1] + frameRectangle.size.v[1], 0.0F), Color::WHITE,
+                                 textCoords[2], Vector3<float>(0.0F, 0.0F, -1.0F)),
+                graphics::Vertex(Vector3<float>(finalOffset.v[0] + frameRectangle.size.v[0], finalOffset.v[1] + frameRectangle.size.v[1], 0.0F), Color::WHITE,
+                                 textCoords[3], Vector3<float>(0.0F, 0.0F, -1.0F))
+            };
+        }
     } // namespace scene
 } // namespace ouzel
@@ -44,6 +44,21 @@ namespace ouzel
                       const Vector2<float>& sourceOffset,
                       const Vector2<float>& pivot);
 
+                // the buffers are initialized directly from the given memory
+                Frame(const std::string& frameName,
+                      const uint16_t* indices, uint32_t initIndexCount,
+                      const graphics::Vertex* vertices, uint32_t vertexCount);
+
+                // quad of a rectangle cut out of the texture, can be called without an engine
+                static void calculateVertices(const Size2<float>& textureSize,
+                                              const Rect<float>& frameRectangle,
+                                              bool rotated,
+                                              const Size2<float>& sourceSize,
+                                              const Vector2<float>& sourceOffset,
+                                              const Vector2<float>& pivot,
+                                              std::vector<uint16_t>& indices,
+                                              std::vector<graphics::Vertex>& vertices);
+
                 inline const std::string& getName() const { return name; }
 
                 inline const Box2<float>& getBoundingBox() const { return boundingBox; }
@@ -24,5 +24,21 @@ namespace ouzel
             vertexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
             vertexBuffer->init(graphics::Buffer::Usage::VERTEX, 0, vertices.data(), static_cast<uint32_t>(getVectorSize(vertices)));
         }
+
+        StaticMeshData::StaticMeshData(Box3<float> initBoundingBox,
+                                       const void* indices, uint32_t initIndexSize, uint32_t initIndexCount,
+                                       const graphics::Vertex* vertices, uint32_t vertexCount,
+                                       const std::shared_ptr<graphics::Material>& initMaterial):
+            boundingBox(initBoundingBox),
+            material(initMaterial),
+            indexCount(initIndexCount),
+            indexSize(initIndexSize)
+        {
+            indexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            indexBuffer->init(graphics::Buffer::Usage::INDEX, 0, indices, indexSize * indexCount);
+
+            vertexBuffer = std::make_shared<graphics::Buffer>(*engine->getRenderer());
+            vertexBuffer->init(graphics::Buffer::Usage::VERTEX, 0, vertices, static_cast<uint32_t>(sizeof(graphics::Vertex) * vertexCount));
+        }
     } // namespace scene
 } // namespace ouzel
@@ -20,6 +20,11 @@ namespace ouzel
                            const std::vector<uint32_t> indices,
                            const std::vector<graphics::Vertex>& vertices,
                            const std::shared_ptr<graphics::Material>& initMaterial);
+            // the buffers are initialized directly from the given memory, the index size is 2 or 4 bytes
+            StaticMeshData(Box3<float> initBoundingBox,
+                           const void* indices, uint32_t initIndexSize, uint32_t initIndexCount,
+                           const graphics::Vertex* vertices, uint32_t vertexCount,
+                           const std::shared_ptr<graphics::Material>& initMaterial);
 
             Box3<float> boundingBox;
             std::shared_ptr<graphics::Material> material;
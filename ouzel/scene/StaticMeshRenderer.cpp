@@ -1,6 +1,7 @@
 // Copyright 2015-2018 Elviss Strazdins. All rights reserved.
 
 #include "StaticMeshRenderer.hpp"
+#include "MeshRenderer.hpp"
 #include "core/Engine.hpp"
 
 namespace ouzel
@@ -26,6 +27,8 @@ namespace ouzel
 
         void StaticMeshRenderer::init(const StaticMeshData& meshData)
         {
+            dataFilename.clear();
+
             boundingBox = meshData.boundingBox;
             material = meshData.material;
             indexCount = meshData.indexCount;
@@ -37,6 +40,14 @@ namespace ouzel
         void StaticMeshRenderer::init(const std::string& filename)
         {
             init(*engine->getCache().getStaticMeshData(filename));
+
+            dataFilename = filename;
+
+            if (!reloadHandler.systemHandler)
+            {
+                reloadHandler.systemHandler = std::bind(&StaticMeshRenderer::handleSystem, this, std::placeholders::_1);
+                engine->getEventDispatcher().addEventHandler(&reloadHandler);
+            }
         }
 
         void StaticMeshRenderer::draw(const Matrix4<float>& transformMatrix,
@@ -51,31 +62,20 @@ namespace ouzel
 
             material->cullMode = graphics::CullMode::NONE;
 
-            Matrix4<float> modelViewProj = renderViewProjection * transformMatrix;
-            float colorVector[] = {material->diffuseColor.normR(), material->diffuseColor.normG(), material->diffuseColor.normB(), material->diffuseColor.normA() * opacity * material->opacity};
-
-            std::vector<std::vector<float>> fragmentShaderConstants(1);
-            fragmentShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
-
-            std::vector<std::vector<float>> vertexShaderConstants(1);
-            vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
+            drawMesh(*material, opacity, renderViewProjection * transformMatrix,
+                     *indexBuffer, indexCount, indexSize, *vertexBuffer);
+        }
 
-            std::vector<uintptr_t> textures;
-            for (const std::shared_ptr<graphics::Texture>& texture : material->textures)
-                textures.push_back(texture ? texture->getResource() : 0);
+        bool StaticMeshRenderer::handleSystem(const SystemEvent& event)
+        {
+            if (event.type == Event::Type::ASSET_RELOAD && event.filename == dataFilename)
+            {
+                // init clears the filename
+                const std::string filename = dataFilename;
+                init(filename);
+            }
 
-            engine->getRenderer()->setCullMode(material->cullMode);
-            engine->getRenderer()->setPipelineState(material->blendState->getResource(),
-                                                    material->shader->getResource());
-            engine->getRenderer()->setShaderConstants(fragmentShaderConstants,
-                                                      vertexShaderConstants);
-            engine->getRenderer()->setTextures(textures);
-            engine->getRenderer()->draw(indexBuffer->getResource(),
-                                        indexCount,
-                                        indexSize,
-                                        vertexBuffer->getResource(),
-                                        graphics::DrawMode::TRIANGLE_LIST,
-                                        0);
+            return false;
         }
     } // namespace scene
 } // namespace ouzel
@@ -5,6 +5,7 @@
 
 #include "scene/Component.hpp"
 #include "scene/StaticMeshData.hpp"
+#include "events/EventHandler.hpp"
 
 namespace ouzel
 {
@@ -31,11 +32,17 @@ namespace ouzel
             inline void setMaterial(const std::shared_ptr<graphics::Material>& newMaterial) { material = newMaterial; }
 
         private:
+            bool handleSystem(const SystemEvent& event);
+
             std::shared_ptr<graphics::Material> material;
             uint32_t indexCount = 0;
             uint32_t indexSize = 0;
             std::shared_ptr<graphics::Buffer> indexBuffer;
             std::shared_ptr<graphics::Buffer> vertexBuffer;
+
+            // the mesh is initialized again when its file is reloaded
+            std::string dataFilename;
+            EventHandler reloadHandler;
         };
     } // namespace scene
 } // namespace ouzel
@@ -11,12 +11,13 @@ namespace ouzel
 {
     namespace scene
     {
-        TextRenderer::TextRenderer(const std::string& fontFile,
+        TextRenderer::TextRenderer(const std::string& initFontFile,
                                    float initFontSize,
                                    const std::string& initText,
                                    Color initColor,
                                    const Vector2<float>& initTextAnchor):
             Component(CLASS),
+            fontFile(initFontFile),
             text(initText),
             fontSize(initFontSize),
             textAnchor(initTextAnchor),
@@ -34,11 +35,15 @@ namespace ouzel
 
             font = engine->getCache().getFont(fontFile);
 
+            reloadHandler.systemHandler = std::bind(&TextRenderer::handleSystem, this, std::placeholders::_1);
+            engine->getEventDispatcher().addEventHandler(&reloadHandler);
+
             updateText();
         }
 
-        void TextRenderer::setFont(const std::string& fontFile)
+        void TextRenderer::setFont(const std::string& newFontFile)
         {
+            fontFile = newFontFile;
             font = engine->getCache().getFont(fontFile);
 
             updateText();
@@ -129,5 +134,16 @@ namespace ouzel
                 texture.reset();
             }
         }
+
+        bool TextRenderer::handleSystem(const SystemEvent& event)
+        {
+            if (event.type == Event::Type::ASSET_RELOAD && event.filename == fontFile)
+            {
+                font = engine->getCache().getFont(fontFile);
+                updateText();
+            }
+
+            return false;
+        }
     } // namespace scene
 } // namespace ouzel
@@ -7,6 +7,7 @@
 #include "scene/Component.hpp"
 #include "math/Color.hpp"
 #include "gui/BMFont.hpp"
+#include "events/EventHandler.hpp"
 #include "graphics/BlendState.hpp"
 #include "graphics/Buffer.hpp"
 #include "graphics/Shader.hpp"
@@ -21,7 +22,7 @@ namespace ouzel
         public:
             static constexpr uint32_t CLASS = Component::TEXT_RENDERER;
 
-            TextRenderer(const std::string& fontFile,
+            TextRenderer(const std::string& initFontFile,
                          float initFontSize = 1.0F,
                          const std::string& initText = std::string(),
                          Color initColor = Color::WHITE,
@@ -32,7 +33,7 @@ namespace ouzel
                       const Matrix4<float>& renderViewProjection,
                       bool wireframe) override;
 
-            void setFont(const std::string& fontFile);
+            void setFont(const std::string& newFontFile);
 
             inline float getFontSize() const { return fontSize; }
             void setFontSize(float newFontSize);
@@ -54,6 +55,7 @@ namespace ouzel
 
         private:
             void updateText();
+            bool handleSystem(const SystemEvent& event);
 
             std::shared_ptr<graphics::Shader> shader;
             std::shared_ptr<graphics::BlendState> blendState;
@@ -64,6 +66,9 @@ namespace ouzel
             std::shared_ptr<graphics::Texture> texture;
             std::shared_ptr<graphics::Texture> whitePixelTexture;
 
+            // the font is taken from the cache again when its file is reloaded
+            std::string fontFile;
+            EventHandler reloadHandler;
             std::shared_ptr<Font> font;
             std::string text;
             float fontSize = 1.0F;
@@ -0,0 +1,472 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <limits>
+#include <stdexcept>
+#include "JSONDocument.hpp"
+#include "NumberParser.hpp"
+
+namespace ouzel
+{
+    namespace json
+    {
+        static inline bool isWhitespace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        static inline bool isDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        static uint32_t parseHex(const char* str)
+        {
+            uint32_t result = 0;
+
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                uint32_t code;
+
+                if (str[i] >= '0' && str[i] <= '9') code = static_cast<uint32_t>(str[i] - '0');
+                else if (str[i] >= 'a' && str[i] <= 'f') code = static_cast<uint32_t>(str[i] - 'a' + 10);
+                else if (str[i] >= 'A' && str[i] <= 'F') code = static_cast<uint32_t>(str[i] - 'A' + 10);
+                else
+                    throw std::runtime_error("Invalid character code");
+
+                result = (result << 4) | code;
+            }
+
+            return result;
+        }
+
+        // the encoded character is never longer than its escape sequence
+        static char* encodeUtf8(char* output, uint32_t c)
+        {
+            if (c <= 0x7F)
+                *output++ = static_cast<char>(c);
+            else if (c <= 0x7FF)
+            {
+                *output++ = static_cast<char>(0xC0 | ((c >> 6) & 0x1F));
+                *output++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else if (c <= 0xFFFF)
+            {
+                *output++ = static_cast<char>(0xE0 | ((c >> 12) & 0x0F));
+                *output++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                *output++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else
+            {
+                *output++ = static_cast<char>(0xF0 | ((c >> 18) & 0x07));
+                *output++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                *output++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                *output++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+
+            return output;
+        }
+
+        Reader::Reader(char* initData, size_t initSize):
+            position(initData), end(initData + initSize)
+        {
+        }
+
+        Reader::Event Reader::next()
+        {
+            for (;;)
+            {
+                skipWhitespaces();
+
+                switch (state)
+                {
+                    case State::VALUE:
+                        return event = readValue();
+                    case State::FIRST_MEMBER:
+                        if (position != end && *position == '}')
+                        {
+                            ++position;
+                            return event = endContainer(Event::END_OBJECT);
+                        }
+                        return event = readKey();
+                    case State::MEMBER:
+                        return event = readKey();
+                    case State::FIRST_ELEMENT:
+                        if (position != end && *position == ']')
+                        {
+                            ++position;
+                            return event = endContainer(Event::END_ARRAY);
+                        }
+                        return event = readValue();
+                    case State::NEXT:
+                        if (containers.empty())
+                        {
+                            if (position != end)
+                                throw std::runtime_error("Unexpected data after the root value");
+
+                            state = State::END;
+                            return event = Event::END;
+                        }
+
+                        if (position == end)
+                            throw std::runtime_error("Unexpected end of data");
+
+                        if (*position == ',')
+                        {
+                            ++position;
+                            state = containers.back() ? State::MEMBER : State::VALUE;
+                            break;
+                        }
+                        else if (*position == '}' && containers.back())
+                        {
+                            ++position;
+                            return event = endContainer(Event::END_OBJECT);
+                        }
+                        else if (*position == ']' && !containers.back())
+                        {
+                            ++position;
+                            return event = endContainer(Event::END_ARRAY);
+                        }
+                        else
+                            throw std::runtime_error("Expected a comma");
+                    case State::END:
+                        return event = Event::END;
+                }
+            }
+        }
+
+        void Reader::skip()
+        {
+            if (event == Event::KEY) next();
+
+            if (event == Event::BEGIN_OBJECT || event == Event::BEGIN_ARRAY)
+            {
+                size_t depth = containers.size();
+                while (containers.size() >= depth) next();
+            }
+        }
+
+        void Reader::skipWhitespaces()
+        {
+            while (position != end && isWhitespace(*position)) ++position;
+        }
+
+        Reader::Event Reader::readValue()
+        {
+            if (position == end)
+                throw std::runtime_error("Unexpected end of data");
+
+            switch (*position)
+            {
+                case '{':
+                    ++position;
+                    containers.push_back(true);
+                    state = State::FIRST_MEMBER;
+                    return Event::BEGIN_OBJECT;
+                case '[':
+                    ++position;
+                    containers.push_back(false);
+                    state = State::FIRST_ELEMENT;
+                    return Event::BEGIN_ARRAY;
+                case '"':
+                    readString();
+                    state = State::NEXT;
+                    return Event::STRING;
+                case 't':
+                    readKeyword("true", 4);
+                    boolean = true;
+                    state = State::NEXT;
+                    return Event::BOOLEAN;
+                case 'f':
+                    readKeyword("false", 5);
+                    boolean = false;
+                    state = State::NEXT;
+                    return Event::BOOLEAN;
+                case 'n':
+                    readKeyword("null", 4);
+                    state = State::NEXT;
+                    return Event::NULL_VALUE;
+                default:
+                    if (*position == '-' || isDigit(*position))
+                    {
+                        readNumber();
+                        state = State::NEXT;
+                        return Event::NUMBER;
+                    }
+
+                    throw std::runtime_error("Expected a value");
+            }
+        }
+
+        Reader::Event Reader::readKey()
+        {
+            if (position == end)
+                throw std::runtime_error("Unexpected end of data");
+
+            if (*position != '"')
+                throw std::runtime_error("Expected a string literal");
+
+            readString();
+            skipWhitespaces();
+
+            if (position == end)
+                throw std::runtime_error("Unexpected end of data");
+
+            if (*position != ':')
+                throw std::runtime_error("Expected a colon");
+
+            ++position;
+            state = State::VALUE;
+
+            return Event::KEY;
+        }
+
+        Reader::Event Reader::endContainer(Event endEvent)
+        {
+            containers.pop_back();
+            state = State::NEXT;
+            return endEvent;
+        }
+
+        void Reader::readString()
+        {
+            ++position; // skip the quotation mark
+
+            // fast path for the strings without escape sequences
+            char* start = position;
+            while (position != end && *position != '"' && *position != '\\' &&
+                   static_cast<uint8_t>(*position) > 0x1F)
+                ++position;
+
+            char* output = position;
+
+            for (;;)
+            {
+                if (position == end)
+                    throw std::runtime_error("Unterminated string literal");
+
+                if (*position == '"')
+                {
+                    *output = '\0';
+                    ++position;
+                    break;
+                }
+                else if (*position == '\\')
+                {
+                    if (++position == end)
+                        throw std::runtime_error("Unterminated string literal");
+
+                    switch (*position++)
+                    {
+                        case '"': *output++ = '"'; break;
+                        case '\\': *output++ = '\\'; break;
+                        case '/': *output++ = '/'; break;
+                        case 'b': *output++ = '\b'; break;
+                        case 'f': *output++ = '\f'; break;
+                        case 'n': *output++ = '\n'; break;
+                        case 'r': *output++ = '\r'; break;
+                        case 't': *output++ = '\t'; break;
+                        case 'u':
+                        {
+                            if (end - position < 4)
+                                throw std::runtime_error("Unexpected end of data");
+
+                            uint32_t c = parseHex(position);
+                            position += 4;
+
+                            // surrogate pair
+                            if (c >= 0xD800 && c <= 0xDBFF &&
+                                end - position >= 6 && position[0] == '\\' && position[1] == 'u')
+                            {
+                                uint32_t low = parseHex(position + 2);
+                                if (low >= 0xDC00 && low <= 0xDFFF)
+                                {
+                                    c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                                    position += 6;
+                                }
+                            }
+
+                            output = encodeUtf8(output, c);
+                            break;
+                        }
+                        default:
+                            throw std::runtime_error("Unrecognized escape character");
+                    }
+                }
+                else if (static_cast<uint8_t>(*position) <= 0x1F) // control char
+                    throw std::runtime_error("Unterminated string literal");
+                else
+                    *output++ = *position++;
+            }
+
+            string = start;
+            stringLength = static_cast<size_t>(output - start);
+        }
+
+        void Reader::readNumber()
+        {
+            const char* start = position;
+            bool integer = true;
+
+            if (*position == '-') ++position;
+
+            if (position == end || !isDigit(*position))
+                throw std::runtime_error("Expected a number");
+
+            uint64_t integerValue = 0;
+            uint32_t digits = 0;
+
+            for (; position != end && isDigit(*position); ++position, ++digits)
+                integerValue = integerValue * 10 + static_cast<uint64_t>(*position - '0');
+
+            if (position != end && *position == '.')
+            {
+                integer = false;
+
+                if (++position == end || !isDigit(*position))
+                    throw std::runtime_error("Invalid number");
+
+                while (position != end && isDigit(*position)) ++position;
+            }
+
+            if (position != end && (*position == 'e' || *position == 'E'))
+            {
+                integer = false;
+
+                if (++position != end && (*position == '+' || *position == '-')) ++position;
+
+                if (position == end || !isDigit(*position))
+                    throw std::runtime_error("Invalid exponent");
+
+                while (position != end && isDigit(*position)) ++position;
+            }
+
+            // integers up to 19 digits fit in 64 bits
+            if (integer && digits < 20)
+            {
+                number = static_cast<double>(integerValue);
+                if (*start == '-') number = -number;
+            }
+            else
+                number = parseDouble<const char*>(start, position);
+        }
+
+        void Reader::readKeyword(const char* keyword, size_t length)
+        {
+            if (static_cast<size_t>(end - position) < length ||
+                std::memcmp(position, keyword, length) != 0)
+                throw std::runtime_error("Unknown keyword");
+
+            position += length;
+        }
+
+        Document::Document(std::vector<uint8_t> initData):
+            data(std::move(initData))
+        {
+            char* begin = reinterpret_cast<char*>(data.data());
+            size_t size = data.size();
+
+            // BOM
+            if (size >= 3 &&
+                data[0] == 0xEF &&
+                data[1] == 0xBB &&
+                data[2] == 0xBF)
+            {
+                bom = true;
+                begin += 3;
+                size -= 3;
+            }
+
+            Reader reader(begin, size);
+
+            // values of the open containers, the children are moved to the nodes when the container ends
+            std::vector<Node> stack;
+            std::vector<size_t> starts;
+            const char* key = nullptr;
+            size_t keyLength = 0;
+
+            for (;;)
+            {
+                Reader::Event event = reader.next();
+
+                if (event == Reader::Event::END)
+                    break;
+                else if (event == Reader::Event::KEY)
+                {
+                    key = reader.getString();
+                    keyLength = reader.getStringLength();
+                }
+                else if (event == Reader::Event::END_OBJECT ||
+                         event == Reader::Event::END_ARRAY)
+                {
+                    size_t start = starts.back();
+                    starts.pop_back();
+
+                    if (stack.size() - start > std::numeric_limits<uint32_t>::max())
+                        throw std::runtime_error("Too many children");
+
+                    Node& container = stack[start - 1];
+                    container.value.first = nodes.size();
+                    container.size = static_cast<uint32_t>(stack.size() - start);
+
+                    nodes.insert(nodes.end(), stack.begin() + static_cast<std::ptrdiff_t>(start), stack.end());
+                    stack.resize(start);
+                }
+                else
+                {
+                    Node node;
+                    node.key = key;
+                    node.keyLength = static_cast<uint32_t>(keyLength);
+                    key = nullptr;
+                    keyLength = 0;
+
+                    switch (event)
+                    {
+                        case Reader::Event::BEGIN_OBJECT:
+                            node.type = Node::Type::OBJECT;
+                            break;
+                        case Reader::Event::BEGIN_ARRAY:
+                            node.type = Node::Type::ARRAY;
+                            break;
+                        case Reader::Event::STRING:
+                            if (reader.getStringLength() > std::numeric_limits<uint32_t>::max())
+                                throw std::runtime_error("String is too long");
+
+                            node.type = Node::Type::STRING;
+                            node.value.string = reader.getString();
+                            node.size = static_cast<uint32_t>(reader.getStringLength());
+                            break;
+                        case Reader::Event::NUMBER:
+                            node.type = Node::Type::NUMBER;
+                            node.value.number = reader.getNumber();
+                            break;
+                        case Reader::Event::BOOLEAN:
+                            node.type = Node::Type::BOOLEAN;
+                            node.value.boolean = reader.getBoolean();
+                            break;
+                        default:
+                            break;
+                    }
+
+                    stack.push_back(node);
+
+                    if (event == Reader::Event::BEGIN_OBJECT ||
+                        event == Reader::Event::BEGIN_ARRAY)
+                        starts.push_back(stack.size());
+                }
+            }
+
+            if (stack.empty())
+                throw std::runtime_error("Unexpected end of data");
+
+            root = stack.front();
+
+            // the nodes do not move anymore
+            for (Node& node : nodes)
+                if (node.type == Node::Type::OBJECT || node.type == Node::Type::ARRAY)
+                    node.value.children = nodes.data() + node.value.first;
+
+            if (root.type == Node::Type::OBJECT || root.type == Node::Type::ARRAY)
+                root.value.children = nodes.data() + root.value.first;
+        }
+    } // namespace json
+} // namespace ouzel
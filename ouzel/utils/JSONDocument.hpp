@@ -0,0 +1,251 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_UTILS_JSONDOCUMENT_HPP
+#define OUZEL_UTILS_JSONDOCUMENT_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ouzel
+{
+    namespace json
+    {
+        // single-pass pull parser that works directly on the UTF-8 data
+        // the data is modified in place: the escape sequences are decoded and the strings are terminated with a null character,
+        // so the strings returned by getString point into the data
+        class Reader final
+        {
+        public:
+            enum class Event
+            {
+                END,
+                BEGIN_OBJECT,
+                END_OBJECT,
+                BEGIN_ARRAY,
+                END_ARRAY,
+                KEY,
+                STRING,
+                NUMBER,
+                BOOLEAN,
+                NULL_VALUE
+            };
+
+            Reader(char* initData, size_t initSize);
+
+            Event next();
+            // skips the value of the last KEY event or the rest of the container of the last BEGIN_OBJECT or BEGIN_ARRAY event
+            void skip();
+
+            inline Event getEvent() const { return event; }
+            inline const char* getString() const { return string; }
+            inline size_t getStringLength() const { return stringLength; }
+            inline double getNumber() const { return number; }
+            inline bool getBoolean() const { return boolean; }
+
+        private:
+            enum class State
+            {
+                VALUE,
+                FIRST_MEMBER,
+                MEMBER,
+                FIRST_ELEMENT,
+                NEXT,
+                END
+            };
+
+            void skipWhitespaces();
+            Event readValue();
+            Event readKey();
+            Event endContainer(Event endEvent);
+            void readString();
+            void readNumber();
+            void readKeyword(const char* keyword, size_t length);
+
+            char* position;
+            char* end;
+            State state = State::VALUE;
+            std::vector<bool> containers; // true for objects
+
+            Event event = Event::END;
+            const char* string = nullptr;
+            size_t stringLength = 0;
+            double number = 0.0;
+            bool boolean = false;
+        };
+
+        class Document;
+
+        // node of the document, the children of objects and arrays are stored contiguously
+        class Node final
+        {
+            friend Document;
+        public:
+            enum class Type: uint8_t
+            {
+                NONE, // null or missing
+                OBJECT,
+                ARRAY,
+                STRING,
+                NUMBER,
+                BOOLEAN
+            };
+
+            Node() { value.children = nullptr; }
+
+            inline Type getType() const { return type; }
+            inline bool isNull() const { return type == Type::NONE; }
+
+            // name of the member, nullptr for elements of arrays and the root
+            inline const char* getKey() const { return key; }
+
+            template<typename T, typename std::enable_if<std::is_same<T, std::string>::value>::type* = nullptr>
+            std::string as() const
+            {
+                assert(type == Type::STRING);
+                return std::string(value.string, size);
+            }
+
+            template<typename T, typename std::enable_if<std::is_same<T, const char*>::value>::type* = nullptr>
+            const char* as() const
+            {
+                assert(type == Type::STRING);
+                return value.string;
+            }
+
+            template<typename T, typename std::enable_if<std::is_same<T, bool>::value>::type* = nullptr>
+            T as() const
+            {
+                assert(type == Type::BOOLEAN || type == Type::NUMBER);
+                if (type == Type::BOOLEAN) return value.boolean;
+                else return value.number != 0.0;
+            }
+
+            template<typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type* = nullptr>
+            T as() const
+            {
+                assert(type == Type::BOOLEAN || type == Type::NUMBER);
+                if (type == Type::BOOLEAN) return value.boolean;
+                else return static_cast<T>(value.number);
+            }
+
+            inline size_t getStringLength() const
+            {
+                assert(type == Type::STRING);
+                return size;
+            }
+
+            // the members are searched linearly, the objects in asset files are small
+            const Node* findMember(const char* member, size_t length) const
+            {
+                assert(type == Type::OBJECT);
+
+                for (const Node* i = value.children; i != value.children + size; ++i)
+                    if (i->keyLength == length && std::memcmp(i->key, member, length) == 0)
+                        return i;
+
+                return nullptr;
+            }
+
+            inline bool hasMember(const char* member) const
+            {
+                return findMember(member, std::strlen(member)) != nullptr;
+            }
+
+            inline bool hasMember(const std::string& member) const
+            {
+                return findMember(member.data(), member.length()) != nullptr;
+            }
+
+            // returns a null node if the member does not exist
+            template<size_t N>
+            inline const Node& operator[](const char (&member)[N]) const
+            {
+                const Node* result = findMember(member, std::strlen(member));
+                return result ? *result : empty();
+            }
+
+            inline const Node& operator[](const std::string& member) const
+            {
+                const Node* result = findMember(member.data(), member.length());
+                return result ? *result : empty();
+            }
+
+            inline const Node& operator[](size_t index) const
+            {
+                assert(type == Type::ARRAY);
+                return index < size ? value.children[index] : empty();
+            }
+
+            inline size_t getSize() const
+            {
+                assert(type == Type::OBJECT || type == Type::ARRAY);
+                return size;
+            }
+
+            // iterates the elements of arrays and the members of objects
+            inline const Node* begin() const
+            {
+                assert(type == Type::OBJECT || type == Type::ARRAY);
+                return value.children;
+            }
+
+            inline const Node* end() const
+            {
+                assert(type == Type::OBJECT || type == Type::ARRAY);
+                return value.children + size;
+            }
+
+        private:
+            static const Node& empty()
+            {
+                static const Node node;
+                return node;
+            }
+
+            Type type = Type::NONE;
+            uint32_t size = 0; // length of the string or the number of children
+            uint32_t keyLength = 0;
+            const char* key = nullptr;
+
+            union
+            {
+                double number;
+                bool boolean;
+                const char* string;
+                size_t first; // index of the first child while parsing
+                const Node* children;
+            } value;
+        };
+
+        // read-only document built in a single pass
+        // the strings point into the data of the document and the nodes are stored in one array, so the document can not be copied
+        class Document final
+        {
+        public:
+            Document() {}
+            explicit Document(std::vector<uint8_t> initData);
+
+            Document(const Document&) = delete;
+            Document& operator=(const Document&) = delete;
+
+            Document(Document&&) = default;
+            Document& operator=(Document&&) = default;
+
+            inline const Node& getRoot() const { return root; }
+
+            inline bool hasBOM() const { return bom; }
+
+        private:
+            std::vector<uint8_t> data;
+            std::vector<Node> nodes;
+            Node root;
+            bool bom = false;
+        };
+    } // namespace json
+} // namespace ouzel
+
+#endif // OUZEL_UTILS_JSONDOCUMENT_HPP
@@ -0,0 +1,116 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_UTILS_LOCKFREEQUEUE_HPP
+#define OUZEL_UTILS_LOCKFREEQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace ouzel
+{
+    // bounded multi-producer multi-consumer queue, each cell has a sequence number that tells whether it can be written or read
+    template<class T>
+    class LockFreeQueue final
+    {
+    public:
+        // the capacity is rounded up to a power of two
+        explicit LockFreeQueue(size_t initCapacity)
+        {
+            size_t capacity = 2;
+            while (capacity < initCapacity) capacity <<= 1;
+
+            mask = capacity - 1;
+            cells.reset(new Cell[capacity]);
+
+            for (size_t i = 0; i < capacity; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        LockFreeQueue(const LockFreeQueue&) = delete;
+        LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+        LockFreeQueue(LockFreeQueue&&) = delete;
+        LockFreeQueue& operator=(LockFreeQueue&&) = delete;
+
+        inline size_t getCapacity() const { return mask + 1; }
+
+        // returns false if the queue is full
+        bool push(T&& value)
+        {
+            Cell* cell;
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                cell = &cells[position & mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (difference == 0)
+                {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0)
+                    return false;
+                else
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+
+            cell->value = std::move(value);
+            cell->sequence.store(position + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // returns false if the queue is empty
+        bool pop(T& value)
+        {
+            Cell* cell;
+            size_t position = dequeuePosition.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                cell = &cells[position & mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+                if (difference == 0)
+                {
+                    if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0)
+                    return false;
+                else
+                    position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+
+            value = std::move(cell->value);
+            cell->sequence.store(position + mask + 1, std::memory_order_release);
+
+            return true;
+        }
+
+    private:
+        struct Cell final
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+
+        // keeps producers and consumers on separate cache lines
+        uint8_t padding1[64];
+        std::atomic<size_t> enqueuePosition{0};
+        uint8_t padding2[64];
+        std::atomic<size_t> dequeuePosition{0};
+    };
+}
+
+#endif // OUZEL_UTILS_LOCKFREEQUEUE_HPP
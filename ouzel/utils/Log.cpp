@@ -25,106 +25,377 @@
 #  include <emscripten.h>
 #endif
 
+#include <cstdio>
 #include "Log.hpp"
+#include "files/File.hpp"
 
 namespace ouzel
 {
+    // returns the length of the longest prefix of at most maxLength bytes that does not split a UTF-8 character
+    static size_t getRecordLength(const char* str, size_t length, size_t maxLength)
+    {
+        if (length <= maxLength) return length;
+
+        // step back to the first byte of the character that does not fit
+        size_t result = maxLength;
+        while (result > 0 && (static_cast<unsigned char>(str[result]) & 0xC0) == 0x80) --result;
+        return result;
+    }
+
+    Log::Log(const Logger& initLogger, Level initLevel):
+        logger(initLogger), level(initLevel), enabled(initLogger.isEnabled(initLevel))
+    {
+    }
+
     Log::~Log()
     {
-        if (!s.empty())
-            logger.log(s, level);
+        if (length) flush();
     }
 
-    void Logger::logString(const std::string& str, Log::Level level)
+    void Log::append(const char* str, size_t size)
     {
-#if defined(__ANDROID__)
-        int priority = 0;
-        switch (level)
+        if (!enabled) return;
+
+        while (size)
         {
-            case Log::Level::ERR: priority = ANDROID_LOG_ERROR; break;
-            case Log::Level::WARN: priority = ANDROID_LOG_WARN; break;
-            case Log::Level::INFO: priority = ANDROID_LOG_INFO; break;
-            case Log::Level::ALL: priority = ANDROID_LOG_DEBUG; break;
-            default: break;
+            size_t count = getRecordLength(str, size, sizeof(buffer) - length);
+            if (!count && !length) count = sizeof(buffer); // not a valid UTF-8 string
+
+            std::copy(str, str + count, buffer + length);
+            length += count;
+            str += count;
+            size -= count;
+
+            if (size) flush();
         }
-        __android_log_print(priority, "Ouzel", "%s", str.c_str());
-#elif TARGET_OS_IOS || TARGET_OS_TV
-        int priority = 0;
+    }
+
+    void Log::appendFloat(double val)
+    {
+        if (!enabled) return;
+
+        char str[64];
+        int count = snprintf(str, sizeof(str), "%f", val);
+        if (count >= static_cast<int>(sizeof(str)))
+            count = snprintf(str, sizeof(str), "%g", val);
+        if (count > 0) append(str, static_cast<size_t>(count));
+    }
+
+    void Log::appendSigned(long long val)
+    {
+        if (!enabled) return;
+
+        char str[32];
+        int count = snprintf(str, sizeof(str), "%lld", val);
+        if (count > 0) append(str, static_cast<size_t>(count));
+    }
+
+    void Log::appendUnsigned(unsigned long long val)
+    {
+        if (!enabled) return;
+
+        char str[32];
+        int count = snprintf(str, sizeof(str), "%llu", val);
+        if (count > 0) append(str, static_cast<size_t>(count));
+    }
+
+    void Log::flush()
+    {
+        logger.log(buffer, length, level);
+        length = 0;
+    }
+
+    static const char* getLevelName(Log::Level level)
+    {
         switch (level)
         {
-            case Log::Level::ERR: priority = LOG_ERR; break;
-            case Log::Level::WARN: priority = LOG_WARNING; break;
-            case Log::Level::INFO: priority = LOG_INFO; break;
-            case Log::Level::ALL: priority = LOG_DEBUG; break;
-            default: break;
+            case Log::Level::ERR: return "error";
+            case Log::Level::WARN: return "warning";
+            case Log::Level::INFO: return "info";
+            case Log::Level::ALL: return "debug";
+            default: return "";
         }
-        syslog(priority, "%s", str.c_str());
+    }
+
+    void ConsoleLogSink::write(const LogRecord* records, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const LogRecord& record = records[i];
+            int length = static_cast<int>(record.length);
+
+#if defined(__ANDROID__)
+            int priority = 0;
+            switch (record.level)
+            {
+                case Log::Level::ERR: priority = ANDROID_LOG_ERROR; break;
+                case Log::Level::WARN: priority = ANDROID_LOG_WARN; break;
+                case Log::Level::INFO: priority = ANDROID_LOG_INFO; break;
+                case Log::Level::ALL: priority = ANDROID_LOG_DEBUG; break;
+                default: break;
+            }
+            __android_log_print(priority, "Ouzel", "%.*s", length, record.text);
+#elif TARGET_OS_IOS || TARGET_OS_TV
+            int priority = 0;
+            switch (record.level)
+            {
+                case Log::Level::ERR: priority = LOG_ERR; break;
+                case Log::Level::WARN: priority = LOG_WARNING; break;
+                case Log::Level::INFO: priority = LOG_INFO; break;
+                case Log::Level::ALL: priority = LOG_DEBUG; break;
+                default: break;
+            }
+            syslog(priority, "%.*s", length, record.text);
 #elif TARGET_OS_MAC || defined(__linux__)
-        int fd = 0;
-        switch (level)
+            int fd = 0;
+            switch (record.level)
+            {
+                case Log::Level::ERR:
+                case Log::Level::WARN:
+                    fd = STDERR_FILENO;
+                    break;
+                case Log::Level::INFO:
+                case Log::Level::ALL:
+                    fd = STDOUT_FILENO;
+                    break;
+                default: break;
+            }
+
+            output.insert(output.end(), record.text, record.text + length);
+            output.push_back('\n');
+
+            // records that go to the same stream are written with one call
+            if (i + 1 < count &&
+                (records[i + 1].level <= Log::Level::WARN) == (record.level <= Log::Level::WARN))
+                continue;
+
+            size_t offset = 0;
+            while (offset < output.size())
+            {
+                ssize_t written = ::write(fd, output.data() + offset, output.size() - offset);
+                if (written == -1)
+                    break;
+
+                offset += static_cast<size_t>(written);
+            }
+
+            output.clear();
+#elif defined(_WIN32)
+            int bufferSize = MultiByteToWideChar(CP_UTF8, 0, record.text, length, nullptr, 0);
+            if (bufferSize == 0)
+                continue;
+
+            std::vector<WCHAR> buffer(bufferSize + 2); // for the newline and the terminating null
+            if (MultiByteToWideChar(CP_UTF8, 0, record.text, length, buffer.data(), bufferSize) == 0)
+                continue;
+
+            buffer[bufferSize] = L'\n';
+            OutputDebugStringW(buffer.data());
+#  if DEBUG
+            HANDLE handle = 0;
+            switch (record.level)
+            {
+                case Log::Level::ERR:
+                case Log::Level::WARN:
+                    handle = GetStdHandle(STD_ERROR_HANDLE);
+                    break;
+                case Log::Level::INFO:
+                case Log::Level::ALL:
+                    handle = GetStdHandle(STD_OUTPUT_HANDLE);
+                    break;
+                default: break;
+            }
+
+            if (handle)
+            {
+                DWORD bytesWritten;
+                WriteConsoleW(handle, buffer.data(), static_cast<DWORD>(bufferSize + 1), &bytesWritten, nullptr);
+            }
+#  endif
+#elif defined(__EMSCRIPTEN__)
+            int flags = EM_LOG_CONSOLE;
+            if (record.level == Log::Level::ERR) flags |= EM_LOG_ERROR;
+            else if (record.level == Log::Level::WARN) flags |= EM_LOG_WARN;
+            emscripten_log(flags, "%.*s", length, record.text);
+#endif
+        }
+    }
+
+    FileLogSink::FileLogSink(const std::string& filename):
+        file(new File(filename, File::Mode::WRITE | File::Mode::CREATE | File::Mode::TRUNCATE))
+    {
+    }
+
+    FileLogSink::~FileLogSink()
+    {
+    }
+
+    void FileLogSink::write(const LogRecord* records, size_t count)
+    {
+        char prefix[64];
+
+        for (size_t i = 0; i < count; ++i)
         {
-            case Log::Level::ERR:
-            case Log::Level::WARN:
-                fd = STDERR_FILENO;
-                break;
-            case Log::Level::INFO:
-            case Log::Level::ALL:
-                fd = STDOUT_FILENO;
-                break;
-            default: break;
+            const LogRecord& record = records[i];
+
+            int prefixLength = snprintf(prefix, sizeof(prefix), "[%.6f] %s: ",
+                                        std::chrono::duration<double>(record.time).count(),
+                                        getLevelName(record.level));
+            if (prefixLength > 0) output.insert(output.end(), prefix, prefix + prefixLength);
+            output.insert(output.end(), record.text, record.text + record.length);
+            output.push_back('\n');
         }
 
-        std::vector<char> output(str.begin(), str.end());
-        output.push_back('\n');
+        file->write(output.data(), static_cast<uint32_t>(output.size()), true);
+        output.clear();
+    }
+
+    Logger::Logger(Log::Level initThreshold):
+        threshold(initThreshold),
+        startTime(std::chrono::steady_clock::now())
+#if !defined(__EMSCRIPTEN__)
+        , records(QUEUE_SIZE)
+#endif
+    {
+        sinks.push_back(std::unique_ptr<LogSink>(new ConsoleLogSink()));
+
+#if !defined(__EMSCRIPTEN__)
+        logThread = std::thread(&Logger::logLoop, this);
+#endif
+    }
+
+    Logger::~Logger()
+    {
+#if !defined(__EMSCRIPTEN__)
+        std::unique_lock<std::mutex> lock(logMutex);
+        running = false;
+        lock.unlock();
+        logCondition.notify_all();
+        if (logThread.joinable()) logThread.join();
+#endif
+    }
+
+    void Logger::log(const char* str, size_t length, Log::Level level) const
+    {
+        if (!isEnabled(level)) return;
+
+        std::chrono::nanoseconds time = std::chrono::steady_clock::now() - startTime;
 
-        size_t offset = 0;
-        while (offset < output.size())
+        do
         {
-            ssize_t written = write(fd, output.data() + offset, output.size() - offset);
-            if (written == -1)
-                return;
+            LogRecord record;
+            record.time = time;
+            record.level = level;
+            size_t recordLength = getRecordLength(str, length, sizeof(record.text));
+            if (!recordLength) recordLength = sizeof(record.text); // not a valid UTF-8 string
+            record.length = static_cast<uint32_t>(recordLength);
+            std::copy(str, str + record.length, record.text);
+            str += record.length;
+            length -= record.length;
 
-            offset += static_cast<size_t>(written);
+#if defined(__EMSCRIPTEN__)
+            writeRecords(&record, 1);
+#else
+            pushRecord(record);
+#endif
         }
-#elif defined(_WIN32)
-        int bufferSize = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
-        if (bufferSize == 0)
-            return;
+        while (length);
+    }
 
-        ++bufferSize; // for the newline
-        std::vector<WCHAR> buffer(bufferSize);
-        if (MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, buffer.data(), bufferSize) == 0)
-            return;
+    void Logger::addSink(std::unique_ptr<LogSink> sink)
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        sinks.push_back(std::move(sink));
+    }
 
-        StringCchCatW(buffer.data(), buffer.size(), L"\n");
-        OutputDebugStringW(buffer.data());
-#  if DEBUG
-        HANDLE handle = 0;
-        switch (level)
+    void Logger::writeRecords(const LogRecord* records, size_t count) const
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+
+        for (const std::unique_ptr<LogSink>& sink : sinks)
         {
-            case Log::Level::ERR:
-            case Log::Level::WARN:
-                handle = GetStdHandle(STD_ERROR_HANDLE);
-                break;
-            case Log::Level::INFO:
-            case Log::Level::ALL:
-                handle = GetStdHandle(STD_OUTPUT_HANDLE);
-                break;
-            default: break;
+            try
+            {
+                sink->write(records, count);
+            }
+            catch (...)
+            {
+            }
         }
+    }
 
-        if (handle)
+#if !defined(__EMSCRIPTEN__)
+    void Logger::pushRecord(LogRecord& record) const
+    {
+        if (!records.push(std::move(record)))
         {
-            DWORD bytesWritten;
-            WriteConsoleW(handle, buffer.data(), static_cast<DWORD>(wcslen(buffer.data())), &bytesWritten, nullptr);
+            if (record.level <= Log::Level::WARN)
+            {
+                blockedRecords.fetch_add(1, std::memory_order_relaxed);
+
+                do
+                {
+                    wakeLogThread();
+                    std::this_thread::yield();
+                }
+                while (!records.push(std::move(record)));
+            }
+            else
+                droppedRecords.fetch_add(1, std::memory_order_relaxed);
         }
-#  endif
-#elif defined(__EMSCRIPTEN__)
-        int flags = EM_LOG_CONSOLE;
-        if (level == Log::Level::ERR) flags |= EM_LOG_ERROR;
-        else if (level == Log::Level::WARN) flags |= EM_LOG_WARN;
-        emscripten_log(flags, "%s", str.c_str());
 
-#endif
+        wakeLogThread();
+    }
+
+    void Logger::wakeLogThread() const
+    {
+        // the log thread is awake until it has emptied the queue
+        if (recordsQueued.exchange(true)) return;
+
+        // the lock makes sure that the log thread does not miss the notification
+        std::unique_lock<std::mutex> lock(logMutex);
+        lock.unlock();
+        logCondition.notify_one();
     }
+
+    void Logger::logLoop()
+    {
+        std::vector<LogRecord> batch(BATCH_SIZE);
+        uint64_t reportedDroppedRecords = 0;
+
+        for (;;)
+        {
+            // everything that was posted before the logger was stopped gets written
+            bool stop = !running.load(std::memory_order_acquire);
+            recordsQueued = false;
+
+            for (;;)
+            {
+                size_t count = 0;
+                while (count < BATCH_SIZE && records.pop(batch[count])) ++count;
+
+                uint64_t currentDroppedRecords = droppedRecords.load(std::memory_order_relaxed);
+                if (currentDroppedRecords != reportedDroppedRecords && count < BATCH_SIZE)
+                {
+                    LogRecord& record = batch[count++];
+                    record.time = std::chrono::steady_clock::now() - startTime;
+                    record.level = Log::Level::WARN;
+                    int length = snprintf(record.text, sizeof(record.text), "%llu log messages dropped",
+                                          static_cast<unsigned long long>(currentDroppedRecords - reportedDroppedRecords));
+                    record.length = (length > 0) ? static_cast<uint32_t>(length) : 0;
+                    reportedDroppedRecords = currentDroppedRecords;
+                }
+
+                if (!count) break;
+
+                writeRecords(batch.data(), count);
+            }
+
+            if (stop) break;
+
+            std::unique_lock<std::mutex> lock(logMutex);
+            while (running && !recordsQueued) logCondition.wait(lock);
+        }
+    }
+#endif
 }
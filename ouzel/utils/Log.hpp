@@ -3,12 +3,17 @@
 #ifndef OUZEL_UTILS_LOG_HPP
 #define OUZEL_UTILS_LOG_HPP
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <vector>
 #include "math/Matrix4.hpp"
 #include "math/Quaternion.hpp"
@@ -17,14 +22,20 @@
 #include "math/Vector2.hpp"
 #include "math/Vector3.hpp"
 #include "math/Vector4.hpp"
+#include "utils/LockFreeQueue.hpp"
 
 namespace ouzel
 {
+    class File;
     class Logger;
 
+    // formats the message in its own buffer on the stack of the calling thread, so no memory is allocated
+    // messages longer than the buffer are split into several records
     class Log final
     {
     public:
+        static constexpr size_t MAX_RECORD_SIZE = 512;
+
         enum class Level
         {
             OFF,
@@ -34,30 +45,28 @@ namespace ouzel
             ALL
         };
 
-        explicit Log(const Logger& initLogger, Level initLevel = Level::INFO):
-            logger(initLogger), level(initLevel)
-        {
-        }
+        explicit Log(const Logger& initLogger, Level initLevel = Level::INFO);
 
         Log(const Log& other):
-            logger(other.logger)
+            logger(other.logger), level(other.level), enabled(other.enabled), length(other.length)
         {
-            level = other.level;
-            s = other.s;
+            std::copy(other.buffer, other.buffer + other.length, buffer);
         }
 
         Log(Log&& other):
-            logger(other.logger)
+            logger(other.logger), level(other.level), enabled(other.enabled), length(other.length)
         {
-            level = other.level;
+            std::copy(other.buffer, other.buffer + other.length, buffer);
             other.level = Level::INFO;
-            s = std::move(other.s);
+            other.length = 0;
         }
 
         Log& operator=(const Log& other)
         {
             level = other.level;
-            s = other.s;
+            enabled = other.enabled;
+            length = other.length;
+            std::copy(other.buffer, other.buffer + other.length, buffer);
 
             return *this;
         }
@@ -67,8 +76,11 @@ namespace ouzel
             if (&other != this)
             {
                 level = other.level;
+                enabled = other.enabled;
+                length = other.length;
+                std::copy(other.buffer, other.buffer + other.length, buffer);
                 other.level = Level::INFO;
-                s = std::move(other.s);
+                other.length = 0;
             }
 
             return *this;
@@ -76,28 +88,28 @@ namespace ouzel
 
         ~Log();
 
-        template<typename T> Log& operator<<(T val)
+        template<typename T, typename std::enable_if<std::is_arithmetic<T>::value>::type* = nullptr>
+        Log& operator<<(T val)
         {
-            s += std::to_string(val);
+            appendNumber(val);
             return *this;
         }
 
         Log& operator<<(const std::string& val)
         {
-            s += val;
+            append(val.data(), val.length());
             return *this;
         }
 
         Log& operator<<(const char* val)
         {
-            s += val;
-
+            append(val, strlen(val));
             return *this;
         }
 
         Log& operator<<(char* val)
         {
-            s += val;
+            append(val, strlen(val));
             return *this;
         }
 
@@ -107,9 +119,9 @@ namespace ouzel
 
             for (const std::string& str : val)
             {
-                if (!first) s += ", ";
+                if (!first) append(", ", 2);
                 first = false;
-                s += str;
+                append(str.data(), str.length());
             }
 
             return *this;
@@ -118,10 +130,11 @@ namespace ouzel
         template<class T>
         Log& operator<<(const Matrix4<T>& val)
         {
-            s += std::to_string(val.m[0]) + "," + std::to_string(val.m[1]) + "," + std::to_string(val.m[2]) + "," + std::to_string(val.m[3]) + "\n" +
-                std::to_string(val.m[4]) + "," + std::to_string(val.m[5]) + "," + std::to_string(val.m[6]) + "," + std::to_string(val.m[7]) + "\n" +
-                std::to_string(val.m[8]) + "," + std::to_string(val.m[9]) + "," + std::to_string(val.m[10]) + "," + std::to_string(val.m[11]) + "\n" +
-                std::to_string(val.m[12]) + "," + std::to_string(val.m[13]) + "," + std::to_string(val.m[14]) + "," + std::to_string(val.m[15]);
+            for (size_t i = 0; i < 16; ++i)
+            {
+                if (i > 0) append((i % 4) ? "," : "\n", 1);
+                appendNumber(val.m[i]);
+            }
 
             return *this;
         }
@@ -129,24 +142,28 @@ namespace ouzel
         template<class T>
         Log& operator<<(const Quaternion<T>& val)
         {
-            s += std::to_string(val.v[0]) + "," + std::to_string(val.v[1]) + "," +
-                std::to_string(val.v[2]) + "," + std::to_string(val.v[3]);
-
+            appendNumbers(val.v, 4);
             return *this;
         }
 
         template<class T>
         Log& operator<<(const Size2<T>& val)
         {
-            s += std::to_string(val.width) + "," + std::to_string(val.height);
+            appendNumber(val.width);
+            append(",", 1);
+            appendNumber(val.height);
+
             return *this;
         }
 
         template<class T>
         Log& operator<<(const Size3<T>& val)
         {
-            s += std::to_string(val.width) + "," + std::to_string(val.height) + "," +
-                std::to_string(val.depth);
+            appendNumber(val.width);
+            append(",", 1);
+            appendNumber(val.height);
+            append(",", 1);
+            appendNumber(val.depth);
 
             return *this;
         }
@@ -154,56 +171,114 @@ namespace ouzel
         template<class T>
         Log& operator<<(const Vector2<T>& val)
         {
-            s += std::to_string(val.v[0]) + "," + std::to_string(val.v[1]);
-
+            appendNumbers(val.v, 2);
             return *this;
         }
 
         template<class T>
         Log& operator<<(const Vector3<T>& val)
         {
-            s += std::to_string(val.v[0]) + "," + std::to_string(val.v[1]) + "," +
-                std::to_string(val.v[2]);
-
+            appendNumbers(val.v, 3);
             return *this;
         }
 
         template<class T>
         Log& operator<<(const Vector4<T>& val)
         {
-            s += std::to_string(val.v[0]) + "," + std::to_string(val.v[1]) + "," +
-                std::to_string(val.v[2]) + "," + std::to_string(val.v[3]);
-
+            appendNumbers(val.v, 4);
             return *this;
         }
 
     private:
+        void append(const char* str, size_t size);
+        void appendFloat(double val);
+        void appendSigned(long long val);
+        void appendUnsigned(unsigned long long val);
+        void flush();
+
+        template<typename T>
+        void appendNumber(T val)
+        {
+            if (std::is_floating_point<T>::value) appendFloat(static_cast<double>(val));
+            else if (std::is_signed<T>::value) appendSigned(static_cast<long long>(val));
+            else appendUnsigned(static_cast<unsigned long long>(val));
+        }
+
+        template<typename T>
+        void appendNumbers(const T* values, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (i > 0) append(",", 1);
+                appendNumber(values[i]);
+            }
+        }
+
         const Logger& logger;
         Level level = Level::INFO;
-        std::string s;
+        bool enabled; // false if the level is above the threshold of the logger
+        size_t length = 0;
+        char buffer[MAX_RECORD_SIZE];
     };
 
+    struct LogRecord final
+    {
+        std::chrono::nanoseconds time; // since the start of the logger
+        Log::Level level;
+        uint32_t length;
+        char text[Log::MAX_RECORD_SIZE];
+    };
+
+    // receives the log records in batches on the log thread
+    class LogSink
+    {
+    public:
+        virtual ~LogSink() {}
+
+        virtual void write(const LogRecord* records, size_t count) = 0;
+    };
+
+    // writes the records to the standard output or the platform log
+    class ConsoleLogSink final: public LogSink
+    {
+    public:
+        void write(const LogRecord* records, size_t count) override;
+
+    private:
+        std::vector<char> output;
+    };
+
+    // writes the records with their time and level to a file
+    class FileLogSink final: public LogSink
+    {
+    public:
+        explicit FileLogSink(const std::string& filename);
+        ~FileLogSink();
+
+        void write(const LogRecord* records, size_t count) override;
+
+    private:
+        std::unique_ptr<File> file;
+        std::vector<char> output;
+    };
+
+    // the messages are posted to a bounded lock-free queue and written to the sinks in batches by the log thread
+    // when the queue is full, errors and warnings wait for the log thread and other messages are dropped
     class Logger final
     {
     public:
-        explicit Logger(Log::Level initThreshold = Log::Level::ALL):
-            threshold(initThreshold)
-        {
-#if !defined(__EMSCRIPTEN__)
-            logThread = std::thread(&Logger::logLoop, this);
-#endif
-        }
+        static constexpr size_t QUEUE_SIZE = 1024;
+        static constexpr size_t BATCH_SIZE = 64;
 
-        ~Logger()
-        {
-#if !defined(__EMSCRIPTEN__)
-            std::unique_lock<std::mutex> lock(queueMutex);
-            running = false;
-            lock.unlock();
-            logCondition.notify_all();
-            if (logThread.joinable()) logThread.join();
-#endif
-        }
+        explicit Logger(Log::Level initThreshold = Log::Level::ALL);
+        // writes all queued messages before returning
+        ~Logger();
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        Logger(Logger&&) = delete;
+        Logger& operator=(Logger&&) = delete;
 
         Log log(Log::Level level = Log::Level::INFO) const
         {
@@ -212,21 +287,26 @@ namespace ouzel
 
         void log(const std::string& str, Log::Level level = Log::Level::INFO) const
         {
-            if (level <= threshold)
-            {
-#if defined(__EMSCRIPTEN__)
-                logString(str, level);
-#else
-                std::unique_lock<std::mutex> lock(queueMutex);
-                logQueue.push(std::make_pair(level, str));
-                lock.unlock();
-                logCondition.notify_all();
-#endif
-            }
+            log(str.data(), str.length(), level);
         }
 
+        void log(const char* str, size_t length, Log::Level level = Log::Level::INFO) const;
+
+        inline bool isEnabled(Log::Level level) const { return level <= threshold.load(std::memory_order_relaxed); }
+        inline Log::Level getThreshold() const { return threshold.load(std::memory_order_relaxed); }
+        inline void setThreshold(Log::Level newThreshold) { threshold.store(newThreshold, std::memory_order_relaxed); }
+
+        void addSink(std::unique_ptr<LogSink> sink);
+
+        // number of messages lost because the queue was full
+        inline uint64_t getDroppedRecords() const { return droppedRecords.load(std::memory_order_relaxed); }
+        // number of messages that had to wait for the log thread
+        inline uint64_t getBlockedRecords() const { return blockedRecords.load(std::memory_order_relaxed); }
+
     private:
-        static void logString(const std::string& str, Log::Level level = Log::Level::INFO);
+        void pushRecord(LogRecord& record) const;
+        void wakeLogThread() const;
+        void writeRecords(const LogRecord* records, size_t count) const;
 
 #ifdef DEBUG
         std::atomic<Log::Level> threshold{Log::Level::ALL};
@@ -234,27 +314,23 @@ namespace ouzel
         std::atomic<Log::Level> threshold{Log::Level::INFO};
 #endif
 
+        const std::chrono::steady_clock::time_point startTime;
+
+        mutable std::mutex sinkMutex;
+        std::vector<std::unique_ptr<LogSink>> sinks;
+
+        mutable std::atomic<uint64_t> droppedRecords{0};
+        mutable std::atomic<uint64_t> blockedRecords{0};
+
 #if !defined(__EMSCRIPTEN__)
-        void logLoop()
-        {
-            for (;;)
-            {
-                std::unique_lock<std::mutex> lock(queueMutex);
-                while (running && logQueue.empty()) logCondition.wait(lock);
-                if (!running) break;
-                std::pair<Log::Level, std::string> str = std::move(logQueue.front());
-                logQueue.pop();
-                lock.unlock();
-
-                logString(str.second, str.first);
-            }
-        }
+        void logLoop();
 
+        mutable LockFreeQueue<LogRecord> records;
         mutable std::condition_variable logCondition;
-        mutable std::mutex queueMutex;
-        mutable std::queue<std::pair<Log::Level, std::string>> logQueue;
+        mutable std::mutex logMutex;
+        mutable std::atomic_bool recordsQueued{false}; // set when a record is pushed to the empty queue
+        std::atomic_bool running{true};
         std::thread logThread;
-        bool running = true;
 #endif
     };
 }
@@ -0,0 +1,52 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include "MemoryTracker.hpp"
+
+namespace ouzel
+{
+    MemoryTracker memoryTracker;
+
+    const char* MemoryTracker::getTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+            case MemoryTag::TEXTURE_DATA: return "Texture data";
+            case MemoryTag::TEXTURE_GPU: return "Textures (GPU)";
+            case MemoryTag::BUFFER_DATA: return "Buffer data";
+            case MemoryTag::BUFFER_GPU: return "Buffers (GPU)";
+            case MemoryTag::COMMAND_BUFFER: return "Command buffers";
+            case MemoryTag::SOUND: return "Sounds";
+            default: return "";
+        }
+    }
+
+    void MemoryTracker::allocate(MemoryTag tag, size_t size)
+    {
+        Counter& counter = counters[static_cast<size_t>(tag)];
+        size_t live = counter.live.fetch_add(size, std::memory_order_relaxed) + size;
+
+        size_t peak = counter.peak.load(std::memory_order_relaxed);
+        while (live > peak && !counter.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+    }
+
+    void MemoryTracker::deallocate(MemoryTag tag, size_t size)
+    {
+        counters[static_cast<size_t>(tag)].live.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    size_t MemoryTracker::getTotalLive() const
+    {
+        size_t result = 0;
+
+        for (const Counter& counter : counters)
+            result += counter.live.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    void MemoryTracker::resetPeaks()
+    {
+        for (Counter& counter : counters)
+            counter.peak.store(counter.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_UTILS_MEMORYTRACKER_HPP
+#define OUZEL_UTILS_MEMORYTRACKER_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace ouzel
+{
+    enum class MemoryTag
+    {
+        TEXTURE_DATA, // CPU copies of the texture levels
+        TEXTURE_GPU, // estimated size of the textures in video memory
+        BUFFER_DATA, // CPU copies of the vertex and index buffers
+        BUFFER_GPU, // estimated size of the buffers in video memory
+        COMMAND_BUFFER, // data waiting in the render command buffers
+        SOUND, // decoded and compressed sound data
+        COUNT
+    };
+
+    // live and peak number of bytes per memory tag
+    class MemoryTracker final
+    {
+    public:
+        static const char* getTagName(MemoryTag tag);
+
+        void allocate(MemoryTag tag, size_t size);
+        void deallocate(MemoryTag tag, size_t size);
+
+        inline size_t getLive(MemoryTag tag) const
+        {
+            return counters[static_cast<size_t>(tag)].live.load(std::memory_order_relaxed);
+        }
+
+        inline size_t getPeak(MemoryTag tag) const
+        {
+            return counters[static_cast<size_t>(tag)].peak.load(std::memory_order_relaxed);
+        }
+
+        size_t getTotalLive() const;
+
+        // sets the peaks to the current live sizes
+        void resetPeaks();
+
+    private:
+        struct Counter final
+        {
+            std::atomic<size_t> live{0};
+            std::atomic<size_t> peak{0};
+        };
+
+        Counter counters[static_cast<size_t>(MemoryTag::COUNT)];
+    };
+
+    extern MemoryTracker memoryTracker;
+
+    // accounts the size of the memory owned by the object it's a member of
+    class TrackedMemory final
+    {
+    public:
+        explicit TrackedMemory(MemoryTag initTag, size_t initSize = 0):
+            tag(initTag), size(initSize)
+        {
+            if (size) memoryTracker.allocate(tag, size);
+        }
+
+        ~TrackedMemory()
+        {
+            if (size) memoryTracker.deallocate(tag, size);
+        }
+
+        TrackedMemory(const TrackedMemory& other):
+            tag(other.tag), size(other.size)
+        {
+            if (size) memoryTracker.allocate(tag, size);
+        }
+
+        TrackedMemory& operator=(const TrackedMemory& other)
+        {
+            if (&other != this)
+            {
+                if (size) memoryTracker.deallocate(tag, size);
+                tag = other.tag;
+                size = other.size;
+                if (size) memoryTracker.allocate(tag, size);
+            }
+
+            return *this;
+        }
+
+        TrackedMemory(TrackedMemory&& other):
+            tag(other.tag), size(other.size)
+        {
+            other.size = 0;
+        }
+
+        TrackedMemory& operator=(TrackedMemory&& other)
+        {
+            if (&other != this)
+            {
+                if (size) memoryTracker.deallocate(tag, size);
+                tag = other.tag;
+                size = other.size;
+                other.size = 0;
+            }
+
+            return *this;
+        }
+
+        inline size_t getSize() const { return size; }
+
+        void setSize(size_t newSize)
+        {
+            if (newSize > size) memoryTracker.allocate(tag, newSize - size);
+            else if (newSize < size) memoryTracker.deallocate(tag, size - newSize);
+            size = newSize;
+        }
+
+    private:
+        MemoryTag tag;
+        size_t size;
+    };
+}
+
+#endif // OUZEL_UTILS_MEMORYTRACKER_HPP
@@ -0,0 +1,107 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_UTILS_NUMBERPARSER_HPP
+#define OUZEL_UTILS_NUMBERPARSER_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace ouzel
+{
+    // parses a decimal number with an optional sign, fraction and exponent, does not depend on the locale
+    // advances the iterator past the number, throws if the iterator does not point to a number
+    template<class Iterator>
+    double parseDouble(Iterator& iterator, Iterator end)
+    {
+        static const double POWERS_OF_TEN[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        bool negative = false;
+
+        if (iterator != end && (*iterator == '-' || *iterator == '+'))
+        {
+            negative = (*iterator == '-');
+            ++iterator;
+        }
+
+        // the digits that do not fit in the mantissa only change the exponent
+        uint64_t mantissa = 0;
+        uint32_t digits = 0;
+        int32_t exponent = 0;
+        bool hasDigits = false;
+
+        for (; iterator != end && *iterator >= '0' && *iterator <= '9'; ++iterator)
+        {
+            hasDigits = true;
+
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*iterator - '0');
+                if (mantissa) ++digits;
+            }
+            else
+                ++exponent;
+        }
+
+        if (iterator != end && *iterator == '.')
+        {
+            ++iterator;
+
+            for (; iterator != end && *iterator >= '0' && *iterator <= '9'; ++iterator)
+            {
+                hasDigits = true;
+
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*iterator - '0');
+                    if (mantissa) ++digits;
+                    --exponent;
+                }
+            }
+        }
+
+        if (!hasDigits)
+            throw std::runtime_error("Invalid number");
+
+        if (iterator != end && (*iterator == 'e' || *iterator == 'E'))
+        {
+            ++iterator;
+
+            bool negativeExponent = false;
+            if (iterator != end && (*iterator == '-' || *iterator == '+'))
+            {
+                negativeExponent = (*iterator == '-');
+                ++iterator;
+            }
+
+            if (iterator == end || *iterator < '0' || *iterator > '9')
+                throw std::runtime_error("Invalid exponent");
+
+            int32_t value = 0;
+            for (; iterator != end && *iterator >= '0' && *iterator <= '9'; ++iterator)
+                if (value < 1000) value = value * 10 + (*iterator - '0');
+
+            exponent += negativeExponent ? -value : value;
+        }
+
+        double result = static_cast<double>(mantissa);
+
+        if (exponent < 0)
+            result = (exponent >= -22) ? result / POWERS_OF_TEN[-exponent] : result * std::pow(10.0, exponent);
+        else if (exponent > 0)
+            result = (exponent <= 22) ? result * POWERS_OF_TEN[exponent] : result * std::pow(10.0, exponent);
+
+        return negative ? -result : result;
+    }
+
+    template<class Iterator>
+    inline float parseFloat(Iterator& iterator, Iterator end)
+    {
+        return static_cast<float>(parseDouble(iterator, end));
+    }
+}
+
+#endif // OUZEL_UTILS_NUMBERPARSER_HPP
@@ -0,0 +1,263 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <algorithm>
+#include <cstdio>
+#include "Profiler.hpp"
+
+namespace ouzel
+{
+    Profiler profiler;
+
+    thread_local Profiler::ThreadBufferReference Profiler::currentBuffer;
+
+    Profiler::ThreadBufferReference::~ThreadBufferReference()
+    {
+        if (buffer)
+        {
+            std::lock_guard<std::mutex> lock(profiler.bufferMutex);
+            buffer->used = false;
+        }
+    }
+
+    Profiler::Zone::Zone(const char* initName):
+        name(initName)
+    {
+        if (profiler.isEnabled())
+        {
+            buffer = profiler.getThreadBuffer();
+            depth = buffer->depth++;
+            start = profiler.getTime();
+        }
+    }
+
+    Profiler::Zone::~Zone()
+    {
+        if (buffer)
+        {
+            Sample sample;
+            sample.name = name;
+            sample.start = start;
+            sample.end = profiler.getTime();
+            sample.depth = depth;
+            sample.thread = buffer->index;
+
+            --buffer->depth;
+
+            if (!buffer->samples.push(std::move(sample)))
+                profiler.droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Profiler::Profiler():
+        startTime(std::chrono::steady_clock::now())
+    {
+    }
+
+    Profiler::~Profiler()
+    {
+    }
+
+    uint64_t Profiler::getTime() const
+    {
+        auto diff = std::chrono::steady_clock::now() - startTime;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count());
+    }
+
+    Profiler::ThreadBuffer* Profiler::getThreadBuffer()
+    {
+        if (currentBuffer.buffer) return currentBuffer.buffer;
+
+        std::lock_guard<std::mutex> lock(bufferMutex);
+
+        // reuse the buffer of a thread that has exited
+        for (const std::unique_ptr<ThreadBuffer>& buffer : buffers)
+        {
+            if (!buffer->used)
+            {
+                buffer->used = true;
+                buffer->depth = 0;
+                buffer->name = currentBuffer.name;
+                currentBuffer.buffer = buffer.get();
+                return currentBuffer.buffer;
+            }
+        }
+
+        std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer(static_cast<uint32_t>(buffers.size())));
+        buffer->name = currentBuffer.name;
+        currentBuffer.buffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+
+        return currentBuffer.buffer;
+    }
+
+    void Profiler::setThreadName(const std::string& name)
+    {
+        currentBuffer.name = name;
+
+        if (currentBuffer.buffer)
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            currentBuffer.buffer->name = name;
+        }
+    }
+
+    std::string Profiler::getThreadName(uint32_t thread) const
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+
+        if (thread < buffers.size() && !buffers[thread]->name.empty())
+            return buffers[thread]->name;
+        else
+            return "Thread " + std::to_string(thread);
+    }
+
+    void Profiler::endFrame()
+    {
+        uint64_t currentTime = getTime();
+
+        std::lock_guard<std::mutex> bufferLock(bufferMutex);
+        std::lock_guard<std::mutex> statsLock(statsMutex);
+
+        pendingStats.clear();
+
+        for (const std::unique_ptr<ThreadBuffer>& buffer : buffers)
+        {
+            Sample sample;
+            while (buffer->samples.pop(sample))
+            {
+                auto start = std::chrono::nanoseconds(static_cast<int64_t>(sample.start) - static_cast<int64_t>(frameStart));
+                auto time = std::chrono::nanoseconds(sample.end - sample.start);
+
+                // zones are identified by the address of their name
+                auto i = std::find_if(pendingStats.begin(), pendingStats.end(), [&sample](const ZoneStats& stats) {
+                    return stats.name == sample.name && stats.thread == sample.thread;
+                });
+
+                if (i == pendingStats.end())
+                {
+                    ZoneStats stats;
+                    stats.name = sample.name;
+                    stats.thread = sample.thread;
+                    stats.depth = sample.depth;
+                    stats.calls = 1;
+                    stats.start = start;
+                    stats.time = time;
+                    pendingStats.push_back(stats);
+                }
+                else
+                {
+                    ++i->calls;
+                    i->time += time;
+                    if (start < i->start)
+                    {
+                        i->start = start;
+                        i->depth = sample.depth;
+                    }
+                }
+
+                if (capturing && capturedSamples.size() < MAX_CAPTURE_SAMPLES)
+                    capturedSamples.push_back(sample);
+            }
+        }
+
+        std::sort(pendingStats.begin(), pendingStats.end(), [](const ZoneStats& a, const ZoneStats& b) {
+            return (a.thread == b.thread) ? a.start < b.start : a.thread < b.thread;
+        });
+
+        frameStats.swap(pendingStats);
+        frameTime = std::chrono::nanoseconds(currentTime - frameStart);
+        frameStart = currentTime;
+        frameIndex.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<Profiler::ZoneStats> Profiler::getFrameStats() const
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        return frameStats;
+    }
+
+    std::chrono::nanoseconds Profiler::getFrameTime() const
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        return frameTime;
+    }
+
+    void Profiler::startCapture()
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        capturedSamples.clear();
+        capturing = true;
+    }
+
+    void Profiler::stopCapture()
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        capturing = false;
+    }
+
+    static void encodeString(std::vector<uint8_t>& data, const std::string& str)
+    {
+        data.push_back('"');
+
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                data.push_back('\\');
+                data.push_back(static_cast<uint8_t>(c));
+            }
+            else if (static_cast<uint8_t>(c) >= 0x20)
+                data.push_back(static_cast<uint8_t>(c));
+        }
+
+        data.push_back('"');
+    }
+
+    static void encode(std::vector<uint8_t>& data, const char* str)
+    {
+        while (*str) data.push_back(static_cast<uint8_t>(*str++));
+    }
+
+    std::vector<uint8_t> Profiler::exportTrace() const
+    {
+        std::vector<uint8_t> result;
+        char buffer[128];
+
+        std::lock_guard<std::mutex> bufferLock(bufferMutex);
+        std::lock_guard<std::mutex> statsLock(statsMutex);
+
+        encode(result, "{\"traceEvents\":[");
+
+        bool first = true;
+
+        for (const std::unique_ptr<ThreadBuffer>& threadBuffer : buffers)
+        {
+            if (!first) result.push_back(',');
+            first = false;
+
+            snprintf(buffer, sizeof(buffer), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", threadBuffer->index);
+            encode(result, buffer);
+            encodeString(result, threadBuffer->name.empty() ? "Thread " + std::to_string(threadBuffer->index) : threadBuffer->name);
+            encode(result, "}}");
+        }
+
+        for (const Sample& sample : capturedSamples)
+        {
+            if (!first) result.push_back(',');
+            first = false;
+
+            encode(result, "{\"name\":");
+            encodeString(result, sample.name);
+            // timestamps are in microseconds
+            snprintf(buffer, sizeof(buffer), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                     static_cast<double>(sample.start) / 1000.0,
+                     static_cast<double>(sample.end - sample.start) / 1000.0,
+                     sample.thread);
+            encode(result, buffer);
+        }
+
+        encode(result, "],\"displayTimeUnit\":\"ms\"}");
+
+        return result;
+    }
+}
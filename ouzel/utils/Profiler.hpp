@@ -0,0 +1,165 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_UTILS_PROFILER_HPP
+#define OUZEL_UTILS_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/Setup.h"
+#include "utils/LockFreeQueue.hpp"
+
+#ifndef OUZEL_ENABLE_PROFILER
+#  define OUZEL_ENABLE_PROFILER 1
+#endif
+
+#if OUZEL_ENABLE_PROFILER
+#  define OUZEL_PROFILE_CONCAT_IMPL(a, b) a##b
+#  define OUZEL_PROFILE_CONCAT(a, b) OUZEL_PROFILE_CONCAT_IMPL(a, b)
+// name must be a string literal (or have a static storage duration)
+#  define OUZEL_PROFILE_ZONE(name) ouzel::Profiler::Zone OUZEL_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#  define OUZEL_PROFILE_ZONE(name)
+#endif
+
+namespace ouzel
+{
+    // hierarchical CPU profiler, every thread writes its zones to its own lock-free buffer
+    // the buffers are collected once per frame by endFrame
+    class Profiler final
+    {
+        class ThreadBuffer;
+    public:
+        static constexpr size_t THREAD_BUFFER_SIZE = 4096;
+        static constexpr size_t MAX_CAPTURE_SAMPLES = 1024 * 1024;
+
+        struct Sample final
+        {
+            const char* name;
+            uint64_t start; // nanoseconds since the profiler was created
+            uint64_t end;
+            uint32_t depth;
+            uint32_t thread;
+        };
+
+        // total time of a zone in the last frame
+        struct ZoneStats final
+        {
+            const char* name;
+            uint32_t thread;
+            uint32_t depth;
+            uint32_t calls;
+            std::chrono::nanoseconds start; // start of the first call relative to the start of the frame
+            std::chrono::nanoseconds time;
+        };
+
+        class Zone final
+        {
+        public:
+            explicit Zone(const char* initName);
+            ~Zone();
+
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+
+            Zone(Zone&&) = delete;
+            Zone& operator=(Zone&&) = delete;
+
+        private:
+            ThreadBuffer* buffer = nullptr;
+            const char* name;
+            uint64_t start;
+            uint32_t depth;
+        };
+
+        Profiler();
+        ~Profiler();
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        Profiler(Profiler&&) = delete;
+        Profiler& operator=(Profiler&&) = delete;
+
+        inline bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+        inline void setEnabled(bool newEnabled) { enabled.store(newEnabled, std::memory_order_relaxed); }
+
+        // names the calling thread in the frame statistics and the trace
+        void setThreadName(const std::string& name);
+        std::string getThreadName(uint32_t thread) const;
+
+        // collects the zones that finished since the previous call
+        void endFrame();
+
+        // zones of the last frame, sorted by thread and start time
+        std::vector<ZoneStats> getFrameStats() const;
+        std::chrono::nanoseconds getFrameTime() const;
+        inline uint64_t getFrameIndex() const { return frameIndex.load(std::memory_order_relaxed); }
+        // number of samples lost because a thread buffer was full
+        inline uint64_t getDroppedSamples() const { return droppedSamples.load(std::memory_order_relaxed); }
+
+        // records all zones (up to MAX_CAPTURE_SAMPLES) until the capture is stopped
+        void startCapture();
+        void stopCapture();
+        inline bool isCapturing() const { return capturing.load(std::memory_order_relaxed); }
+
+        // captured samples in the Chrome trace event format (chrome://tracing)
+        std::vector<uint8_t> exportTrace() const;
+
+    private:
+        uint64_t getTime() const;
+        ThreadBuffer* getThreadBuffer();
+
+        class ThreadBuffer final
+        {
+        public:
+            explicit ThreadBuffer(uint32_t initIndex):
+                index(initIndex), samples(THREAD_BUFFER_SIZE)
+            {
+            }
+
+            uint32_t index;
+            uint32_t depth = 0;
+            bool used = true;
+            std::string name;
+            LockFreeQueue<Sample> samples;
+        };
+
+        // releases the buffer for reuse when its thread exits
+        class ThreadBufferReference final
+        {
+        public:
+            ~ThreadBufferReference();
+
+            ThreadBuffer* buffer = nullptr;
+            std::string name;
+        };
+
+        static thread_local ThreadBufferReference currentBuffer;
+
+        const std::chrono::steady_clock::time_point startTime;
+        std::atomic_bool enabled{false};
+
+        mutable std::mutex bufferMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        mutable std::mutex statsMutex;
+        std::vector<ZoneStats> frameStats;
+        std::vector<ZoneStats> pendingStats;
+        uint64_t frameStart = 0;
+        std::chrono::nanoseconds frameTime{0};
+        std::atomic<uint64_t> frameIndex{0};
+        std::atomic<uint64_t> droppedSamples{0};
+
+        std::atomic_bool capturing{false};
+        std::vector<Sample> capturedSamples;
+    };
+
+    extern Profiler profiler;
+}
+
+#endif // OUZEL_UTILS_PROFILER_HPP
@@ -11,6 +11,7 @@
 #  include <pthread.h>
 #endif
 #include "Utils.hpp"
+#include "Profiler.hpp"
 
 #if defined(_WIN32)
 static constexpr DWORD MS_VC_EXCEPTION = 0x406D1388;
@@ -31,6 +32,8 @@ namespace ouzel
 
     void setCurrentThreadName(const std::string& name)
     {
+        profiler.setThreadName(name);
+
 #if defined(_MSC_VER)
         THREADNAME_INFO info;
         info.dwType = 0x1000;
@@ -0,0 +1,622 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "XMLDocument.hpp"
+#include "NumberParser.hpp"
+
+namespace ouzel
+{
+    namespace xml
+    {
+        static inline bool isWhitespace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        static inline bool isNameStartChar(char c)
+        {
+            return (c >= 'a' && c <= 'z') ||
+                (c >= 'A' && c <= 'Z') ||
+                c == ':' || c == '_' ||
+                static_cast<uint8_t>(c) >= 0x80; // multibyte UTF-8 characters
+        }
+
+        static inline bool isNameChar(char c)
+        {
+            return isNameStartChar(c) ||
+                c == '-' || c == '.' ||
+                (c >= '0' && c <= '9');
+        }
+
+        // the encoded character is never longer than its entity
+        static char* encodeUtf8(char* output, uint32_t c)
+        {
+            if (c <= 0x7F)
+                *output++ = static_cast<char>(c);
+            else if (c <= 0x7FF)
+            {
+                *output++ = static_cast<char>(0xC0 | ((c >> 6) & 0x1F));
+                *output++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else if (c <= 0xFFFF)
+            {
+                *output++ = static_cast<char>(0xE0 | ((c >> 12) & 0x0F));
+                *output++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                *output++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else
+            {
+                *output++ = static_cast<char>(0xF0 | ((c >> 18) & 0x07));
+                *output++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                *output++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                *output++ = static_cast<char>(0x80 | (c & 0x3F));
+            }
+
+            return output;
+        }
+
+        // decodes the entity at the position and writes it to the output
+        static char* decodeEntity(char*& position, const char* end, char* output)
+        {
+            const char* start = ++position; // skip the ampersand
+
+            while (position != end && *position != ';') ++position;
+
+            if (position == end)
+                throw std::runtime_error("Unexpected end of data");
+
+            size_t length = static_cast<size_t>(position - start);
+            ++position; // skip the semicolon
+
+            if (length == 4 && std::memcmp(start, "quot", 4) == 0) *output++ = '"';
+            else if (length == 3 && std::memcmp(start, "amp", 3) == 0) *output++ = '&';
+            else if (length == 4 && std::memcmp(start, "apos", 4) == 0) *output++ = '\'';
+            else if (length == 2 && std::memcmp(start, "lt", 2) == 0) *output++ = '<';
+            else if (length == 2 && std::memcmp(start, "gt", 2) == 0) *output++ = '>';
+            else if (length >= 2 && start[0] == '#')
+            {
+                uint32_t c = 0;
+
+                if (start[1] == 'x') // hex value
+                {
+                    if (length < 3 || length > 8)
+                        throw std::runtime_error("Invalid entity");
+
+                    for (size_t i = 2; i < length; ++i)
+                    {
+                        uint32_t code;
+
+                        if (start[i] >= '0' && start[i] <= '9') code = static_cast<uint32_t>(start[i] - '0');
+                        else if (start[i] >= 'a' && start[i] <= 'f') code = static_cast<uint32_t>(start[i] - 'a' + 10);
+                        else if (start[i] >= 'A' && start[i] <= 'F') code = static_cast<uint32_t>(start[i] - 'A' + 10);
+                        else
+                            throw std::runtime_error("Invalid character code");
+
+                        c = (c << 4) | code;
+                    }
+                }
+                else
+                {
+                    if (length > 8)
+                        throw std::runtime_error("Invalid entity");
+
+                    for (size_t i = 1; i < length; ++i)
+                    {
+                        if (start[i] < '0' || start[i] > '9')
+                            throw std::runtime_error("Invalid character code");
+
+                        c = c * 10 + static_cast<uint32_t>(start[i] - '0');
+                    }
+                }
+
+                if (c > 0x10FFFF)
+                    throw std::runtime_error("Invalid character code");
+
+                output = encodeUtf8(output, c);
+            }
+            else
+                throw std::runtime_error("Invalid entity");
+
+            return output;
+        }
+
+        Reader::Reader(char* initData, size_t initSize,
+                       bool initPreserveWhitespaces,
+                       bool initPreserveComments,
+                       bool initPreserveProcessingInstructions):
+            position(initData), end(initData + initSize),
+            preserveWhitespaces(initPreserveWhitespaces),
+            preserveComments(initPreserveComments),
+            preserveProcessingInstructions(initPreserveProcessingInstructions)
+        {
+        }
+
+        Reader::Event Reader::next()
+        {
+            if (elementClosed)
+            {
+                elementClosed = false;
+                value = elements.back().first;
+                valueLength = elements.back().second;
+                elements.pop_back();
+                return event = Event::END_ELEMENT;
+            }
+
+            for (;;)
+            {
+                if (!markupPending)
+                {
+                    // only whitespaces, comments and processing instructions are allowed outside of the root tag
+                    if (elements.empty()) skipWhitespaces();
+
+                    if (position == end)
+                    {
+                        if (!elements.empty())
+                            throw std::runtime_error("Unexpected end of data");
+
+                        if (!rootFound)
+                            throw std::runtime_error("No root tag found");
+
+                        value = "";
+                        valueLength = 0;
+                        return event = Event::END;
+                    }
+
+                    if (*position != '<')
+                    {
+                        if (elements.empty())
+                            throw std::runtime_error("Text outside of the root tag");
+
+                        if (readText()) return event;
+                        continue;
+                    }
+                }
+
+                if (readMarkup()) return event;
+            }
+        }
+
+        void Reader::skip()
+        {
+            if (event == Event::START_ELEMENT)
+            {
+                size_t depth = elements.size();
+                while (elements.size() >= depth) next();
+            }
+        }
+
+        const char* Reader::getAttribute(const char* name) const
+        {
+            for (const Attribute& attribute : attributes)
+                if (std::strcmp(attribute.name, name) == 0) return attribute.value;
+
+            return nullptr;
+        }
+
+        void Reader::skipWhitespaces()
+        {
+            while (position != end && isWhitespace(*position)) ++position;
+        }
+
+        bool Reader::startsWith(const char* str, size_t length) const
+        {
+            return static_cast<size_t>(end - position) >= length && std::memcmp(position, str, length) == 0;
+        }
+
+        char* Reader::readName()
+        {
+            if (position == end)
+                throw std::runtime_error("Unexpected end of data");
+
+            if (!isNameStartChar(*position))
+                throw std::runtime_error("Invalid name start");
+
+            while (position != end && isNameChar(*position)) ++position;
+
+            return position;
+        }
+
+        void Reader::readAttributes(char* name, char* nameEnd, bool processingInstruction)
+        {
+            attributes.clear();
+
+            // the terminators are written after the characters they overwrite have been parsed
+            terminators.clear();
+            terminators.push_back(nameEnd);
+
+            for (;;)
+            {
+                skipWhitespaces();
+
+                if (position == end)
+                    throw std::runtime_error("Unexpected end of data");
+
+                if (processingInstruction && *position == '?')
+                {
+                    if (++position == end)
+                        throw std::runtime_error("Unexpected end of data");
+
+                    if (*position != '>') // ?>
+                        throw std::runtime_error("Expected a right angle bracket");
+
+                    ++position;
+                    break;
+                }
+                else if (!processingInstruction && *position == '>')
+                {
+                    ++position;
+                    break;
+                }
+                else if (!processingInstruction && *position == '/')
+                {
+                    if (++position == end)
+                        throw std::runtime_error("Unexpected end of data");
+
+                    if (*position != '>') // />
+                        throw std::runtime_error("Expected a right angle bracket");
+
+                    ++position;
+                    elementClosed = true;
+                    break;
+                }
+
+                Attribute attribute;
+                attribute.name = position;
+                terminators.push_back(readName());
+
+                skipWhitespaces();
+
+                if (position == end)
+                    throw std::runtime_error("Unexpected end of data");
+
+                if (*position != '=')
+                    throw std::runtime_error("Expected an equal sign");
+
+                ++position;
+
+                skipWhitespaces();
+
+                if (position == end)
+                    throw std::runtime_error("Unexpected end of data");
+
+                if (*position != '"' && *position != '\'')
+                    throw std::runtime_error("Expected quotes");
+
+                char quotes = *position++;
+                char* output = position;
+                attribute.value = position;
+
+                for (;;)
+                {
+                    if (position == end)
+                        throw std::runtime_error("Unexpected end of data");
+
+                    if (*position == quotes)
+                    {
+                        ++position;
+                        break;
+                    }
+                    else if (*position == '&')
+                        output = decodeEntity(position, end, output);
+                    else
+                        *output++ = *position++;
+                }
+
+                attribute.valueLength = static_cast<size_t>(output - attribute.value);
+                *output = '\0'; // the closing quotes or a part of a decoded entity
+                attributes.push_back(attribute);
+            }
+
+            for (char* terminator : terminators) *terminator = '\0';
+
+            value = name;
+            valueLength = static_cast<size_t>(nameEnd - name);
+        }
+
+        bool Reader::readText()
+        {
+            char* start = position;
+
+            if (!preserveWhitespaces)
+            {
+                skipWhitespaces();
+                start = position;
+            }
+
+            // fast path for the texts without entities
+            while (position != end && *position != '<' && *position != '&') ++position;
+
+            char* output = position;
+
+            for (;;)
+            {
+                if (position == end)
+                    throw std::runtime_error("Unexpected end of data");
+
+                if (*position == '<')
+                    break;
+                else if (*position == '&')
+                    output = decodeEntity(position, end, output);
+                else
+                    *output++ = *position++;
+            }
+
+            if (output == start) // whitespaces only
+                return false;
+
+            // the left angle bracket is overwritten if there were no entities
+            markupPending = (output == position);
+            *output = '\0';
+
+            value = start;
+            valueLength = static_cast<size_t>(output - start);
+            event = Event::TEXT;
+
+            return true;
+        }
+
+        bool Reader::readMarkup()
+        {
+            markupPending = false;
+
+            if (++position == end) // skip the left angle bracket
+                throw std::runtime_error("Unexpected end of data");
+
+            if (*position == '!')
+            {
+                if (startsWith("!--", 3))
+                {
+                    position += 3;
+                    char* start = position;
+
+                    for (;;)
+                    {
+                        if (end - position < 3)
+                            throw std::runtime_error("Unexpected end of data");
+
+                        if (position[0] == '-' && position[1] == '-')
+                        {
+                            if (position[2] != '>')
+                                throw std::runtime_error("Unexpected double-hyphen inside comment");
+
+                            *position = '\0';
+                            value = start;
+                            valueLength = static_cast<size_t>(position - start);
+                            position += 3;
+                            break;
+                        }
+
+                        ++position;
+                    }
+
+                    event = Event::COMMENT;
+                    return preserveComments;
+                }
+                else if (startsWith("![CDATA[", 8))
+                {
+                    position += 8;
+                    char* start = position;
+
+                    for (;;)
+                    {
+                        if (end - position < 3)
+                            throw std::runtime_error("Unexpected end of data");
+
+                        if (position[0] == ']' && position[1] == ']' && position[2] == '>')
+                        {
+                            *position = '\0';
+                            value = start;
+                            valueLength = static_cast<size_t>(position - start);
+                            position += 3;
+                            break;
+                        }
+
+                        ++position;
+                    }
+
+                    if (elements.empty())
+                        throw std::runtime_error("CDATA outside of the root tag");
+
+                    event = Event::CDATA;
+                    return true;
+                }
+                else
+                    throw std::runtime_error("Type declarations are not supported");
+            }
+            else if (*position == '?') // <?
+            {
+                char* name = ++position;
+                char* nameEnd = readName();
+                readAttributes(name, nameEnd, true);
+
+                event = Event::PROCESSING_INSTRUCTION;
+                return preserveProcessingInstructions;
+            }
+            else if (*position == '/') // </
+            {
+                if (elements.empty())
+                    throw std::runtime_error("Unexpected end tag");
+
+                const char* name = ++position;
+                size_t length = static_cast<size_t>(readName() - name);
+
+                if (length != elements.back().second ||
+                    std::memcmp(name, elements.back().first, length) != 0)
+                    throw std::runtime_error("Tag not closed properly");
+
+                skipWhitespaces();
+
+                if (position == end)
+                    throw std::runtime_error("Unexpected end of data");
+
+                if (*position != '>')
+                    throw std::runtime_error("Expected a right angle bracket");
+
+                ++position;
+
+                value = elements.back().first;
+                valueLength = elements.back().second;
+                elements.pop_back();
+
+                event = Event::END_ELEMENT;
+                return true;
+            }
+            else // <
+            {
+                if (elements.empty() && rootFound)
+                    throw std::runtime_error("Multiple root tags found");
+
+                char* name = position;
+                char* nameEnd = readName();
+                readAttributes(name, nameEnd, false);
+
+                rootFound = true;
+                elements.push_back(std::make_pair(value, valueLength));
+
+                event = Event::START_ELEMENT;
+                return true;
+            }
+        }
+
+        size_t parseFloats(const char* str, std::vector<float>& result)
+        {
+            const char* end = str + std::strlen(str);
+            size_t count = 0;
+
+            for (;;)
+            {
+                while (str != end && isWhitespace(*str)) ++str;
+                if (str == end) break;
+
+                result.push_back(parseFloat(str, end));
+                ++count;
+            }
+
+            return count;
+        }
+
+        size_t parseUInts(const char* str, std::vector<uint32_t>& result)
+        {
+            size_t count = 0;
+
+            for (;;)
+            {
+                while (isWhitespace(*str)) ++str;
+                if (*str == '\0') break;
+
+                if (*str < '0' || *str > '9')
+                    throw std::runtime_error("Invalid number");
+
+                uint64_t value = 0;
+
+                for (; *str >= '0' && *str <= '9'; ++str)
+                {
+                    value = value * 10 + static_cast<uint64_t>(*str - '0');
+
+                    if (value > std::numeric_limits<uint32_t>::max())
+                        throw std::runtime_error("Number is too big");
+                }
+
+                result.push_back(static_cast<uint32_t>(value));
+                ++count;
+            }
+
+            return count;
+        }
+
+        Document::Document(std::vector<uint8_t> initData,
+                           bool preserveWhitespaces,
+                           bool preserveComments,
+                           bool preserveProcessingInstructions):
+            data(std::move(initData))
+        {
+            char* begin = reinterpret_cast<char*>(data.data());
+            size_t size = data.size();
+
+            // BOM
+            if (size >= 3 &&
+                data[0] == 0xEF &&
+                data[1] == 0xBB &&
+                data[2] == 0xBF)
+            {
+                bom = true;
+                begin += 3;
+                size -= 3;
+            }
+
+            Reader reader(begin, size, preserveWhitespaces, preserveComments, preserveProcessingInstructions);
+
+            // nodes of the open tags, the children are moved to the nodes when the tag ends
+            std::vector<Node> stack;
+            std::vector<size_t> starts;
+            starts.push_back(0);
+
+            for (;;)
+            {
+                Reader::Event event = reader.next();
+
+                if (event == Reader::Event::END)
+                    break;
+                else if (event == Reader::Event::END_ELEMENT)
+                {
+                    size_t start = starts.back();
+                    starts.pop_back();
+
+                    if (stack.size() - start > std::numeric_limits<uint32_t>::max())
+                        throw std::runtime_error("Too many children");
+
+                    Node& tag = stack[start - 1];
+                    tag.children.index = nodes.size();
+                    tag.childCount = static_cast<uint32_t>(stack.size() - start);
+
+                    nodes.insert(nodes.end(), stack.begin() + static_cast<std::ptrdiff_t>(start), stack.end());
+                    stack.resize(start);
+                }
+                else
+                {
+                    Node node;
+                    node.value = reader.getValue();
+                    node.valueLength = reader.getValueLength();
+
+                    switch (event)
+                    {
+                        case Reader::Event::START_ELEMENT:
+                            node.type = Node::Type::TAG;
+                            node.attributes.index = attributes.size();
+                            node.attributeCount = static_cast<uint32_t>(reader.getAttributes().size());
+                            attributes.insert(attributes.end(), reader.getAttributes().begin(), reader.getAttributes().end());
+                            break;
+                        case Reader::Event::TEXT: node.type = Node::Type::TEXT; break;
+                        case Reader::Event::CDATA: node.type = Node::Type::CDATA; break;
+                        case Reader::Event::COMMENT: node.type = Node::Type::COMMENT; break;
+                        case Reader::Event::PROCESSING_INSTRUCTION: node.type = Node::Type::PROCESSING_INSTRUCTION; break;
+                        default: break;
+                    }
+
+                    stack.push_back(node);
+
+                    if (event == Reader::Event::START_ELEMENT)
+                        starts.push_back(stack.size());
+                }
+            }
+
+            // the nodes outside of the root tag
+            first = nodes.size();
+            count = stack.size();
+            nodes.insert(nodes.end(), stack.begin(), stack.end());
+
+            // the nodes and the attributes do not move anymore
+            for (Node& node : nodes)
+            {
+                node.children.pointer = nodes.data() + node.children.index;
+                node.attributes.pointer = attributes.data() + node.attributes.index;
+            }
+
+            for (const Node& node : *this)
+                if (node.type == Node::Type::TAG) root = &node;
+        }
+    } // namespace xml
+} // namespace ouzel
@@ -0,0 +1,202 @@
+// Copyright 2015-2018 Elviss Strazdins. All rights reserved.
+
+#ifndef OUZEL_UTILS_XMLDOCUMENT_HPP
+#define OUZEL_UTILS_XMLDOCUMENT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ouzel
+{
+    namespace xml
+    {
+        // pull parser that works directly on the UTF-8 data
+        // the data is modified in place: the entities are decoded and the names, the attribute values and the texts are terminated with a null character,
+        // so the strings returned by the reader point into the data and large texts can be parsed without copying them
+        class Reader final
+        {
+        public:
+            enum class Event
+            {
+                END,
+                START_ELEMENT, // self-closing elements are reported with START_ELEMENT and END_ELEMENT
+                END_ELEMENT,
+                TEXT,
+                CDATA,
+                COMMENT,
+                PROCESSING_INSTRUCTION
+            };
+
+            struct Attribute final
+            {
+                const char* name;
+                const char* value;
+                size_t valueLength;
+            };
+
+            Reader(char* initData, size_t initSize,
+                   bool initPreserveWhitespaces = false,
+                   bool initPreserveComments = false,
+                   bool initPreserveProcessingInstructions = false);
+
+            Event next();
+            // skips the rest of the element of the last START_ELEMENT event
+            void skip();
+
+            inline Event getEvent() const { return event; }
+            // name of the element or the processing instruction, the content of the text, CDATA or comment
+            inline const char* getValue() const { return value; }
+            inline size_t getValueLength() const { return valueLength; }
+            inline size_t getDepth() const { return elements.size(); }
+
+            inline const std::vector<Attribute>& getAttributes() const { return attributes; }
+            // returns nullptr if the element does not have the attribute
+            const char* getAttribute(const char* name) const;
+
+        private:
+            void skipWhitespaces();
+            bool startsWith(const char* str, size_t length) const;
+            char* readName();
+            void readAttributes(char* name, char* nameEnd, bool processingInstruction);
+            bool readText();
+            bool readMarkup();
+
+            char* position;
+            char* end;
+            bool preserveWhitespaces;
+            bool preserveComments;
+            bool preserveProcessingInstructions;
+
+            bool markupPending = false; // the left angle bracket at the position was overwritten by the terminator of the text
+            bool elementClosed = false; // the last element was self-closing
+            bool rootFound = false;
+            std::vector<std::pair<const char*, size_t>> elements;
+
+            Event event = Event::END;
+            const char* value = "";
+            size_t valueLength = 0;
+            std::vector<Attribute> attributes;
+            std::vector<char*> terminators;
+        };
+
+        // parses the numbers separated by whitespaces without depending on the locale, returns the number of parsed values
+        size_t parseFloats(const char* str, std::vector<float>& result);
+        size_t parseUInts(const char* str, std::vector<uint32_t>& result);
+
+        // read-only tree built with the reader in a single pass
+        // the strings point into the data of the document and the nodes are stored in one array, so the document can not be copied
+        class Document final
+        {
+        public:
+            class Node final
+            {
+                friend Document;
+            public:
+                enum class Type: uint8_t
+                {
+                    NONE,
+                    COMMENT,
+                    CDATA,
+                    PROCESSING_INSTRUCTION,
+                    TAG,
+                    TEXT
+                };
+
+                Node() { children.index = 0; attributes.index = 0; }
+
+                inline Type getType() const { return type; }
+                // name of the tag or the content of the text
+                inline const char* getValue() const { return value; }
+                inline size_t getValueLength() const { return valueLength; }
+
+                inline const Node* begin() const { return children.pointer; }
+                inline const Node* end() const { return children.pointer + childCount; }
+                inline size_t getChildCount() const { return childCount; }
+
+                inline const Reader::Attribute* beginAttributes() const { return attributes.pointer; }
+                inline const Reader::Attribute* endAttributes() const { return attributes.pointer + attributeCount; }
+
+                // returns nullptr if the tag does not have the attribute
+                const char* getAttribute(const char* name) const
+                {
+                    for (const Reader::Attribute* i = beginAttributes(); i != endAttributes(); ++i)
+                        if (std::strcmp(i->name, name) == 0) return i->value;
+
+                    return nullptr;
+                }
+
+                // returns the first child tag with the name or nullptr
+                const Node* findChild(const char* name) const
+                {
+                    for (const Node& child : *this)
+                        if (child.type == Type::TAG && std::strcmp(child.value, name) == 0) return &child;
+
+                    return nullptr;
+                }
+
+                // returns the content of the first text child or an empty string
+                const char* getText() const
+                {
+                    for (const Node& child : *this)
+                        if (child.type == Type::TEXT || child.type == Type::CDATA) return child.value;
+
+                    return "";
+                }
+
+            private:
+                Type type = Type::NONE;
+                uint32_t childCount = 0;
+                uint32_t attributeCount = 0;
+                const char* value = "";
+                size_t valueLength = 0;
+
+                // indices while parsing
+                union
+                {
+                    size_t index;
+                    const Node* pointer;
+                } children;
+
+                union
+                {
+                    size_t index;
+                    const Reader::Attribute* pointer;
+                } attributes;
+            };
+
+            Document() {}
+            explicit Document(std::vector<uint8_t> initData,
+                              bool preserveWhitespaces = false,
+                              bool preserveComments = false,
+                              bool preserveProcessingInstructions = false);
+
+            Document(const Document&) = delete;
+            Document& operator=(const Document&) = delete;
+
+            Document(Document&&) = default;
+            Document& operator=(Document&&) = default;
+
+            // the root tag
+            inline const Node* getRoot() const { return root; }
+
+            // iterates the nodes outside of the root tag and the root tag
+            inline const Node* begin() const { return nodes.data() + first; }
+            inline const Node* end() const { return nodes.data() + first + count; }
+
+            inline bool hasBOM() const { return bom; }
+
+        private:
+            std::vector<uint8_t> data;
+            std::vector<Node> nodes;
+            std::vector<Reader::Attribute> attributes;
+            size_t first = 0;
+            size_t count = 0;
+            const Node* root = nullptr;
+            bool bom = false;
+        };
+    } // namespace xml
+} // namespace ouzel
+
+#endif // OUZEL_UTILS_XMLDOCUMENT_HPP
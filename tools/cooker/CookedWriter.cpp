@@ -0,0 +1,110 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cstring>
+#include <stdexcept>
+#include "CookedWriter.hpp"
+#include "ouzel.hpp"
+
+using namespace ouzel;
+
+static size_t align(size_t offset)
+{
+    return (offset + assets::CookedLoader::ALIGNMENT - 1) / assets::CookedLoader::ALIGNMENT * assets::CookedLoader::ALIGNMENT;
+}
+
+CookedWriter::CookedWriter(uint32_t initType):
+    type(initType)
+{
+}
+
+void CookedWriter::writeUInt32(uint32_t value)
+{
+    content.push_back(value);
+}
+
+void CookedWriter::writeFloat(float value)
+{
+    uint32_t result;
+    memcpy(&result, &value, sizeof(result));
+    content.push_back(result);
+}
+
+void CookedWriter::writeString(const std::string& str)
+{
+    if (str.empty())
+    {
+        writeUInt32(assets::CookedLoader::NO_STRING);
+        return;
+    }
+
+    auto i = stringIndices.find(str);
+    if (i == stringIndices.end())
+    {
+        i = stringIndices.insert(std::make_pair(str, static_cast<uint32_t>(strings.size()))).first;
+        strings.push_back(str);
+    }
+
+    writeUInt32(i->second);
+}
+
+void CookedWriter::writeBlob(const void* blob, size_t size)
+{
+    size_t offset = align(blobs.size());
+    if (offset > UINT32_MAX || size > UINT32_MAX - offset)
+        throw std::runtime_error("Cooked asset is too big");
+
+    blobs.resize(offset + size);
+    if (size) memcpy(blobs.data() + offset, blob, size);
+
+    blobOffsets.push_back(content.size());
+    content.push_back(static_cast<uint32_t>(offset));
+}
+
+std::vector<uint8_t> CookedWriter::getData() const
+{
+    const size_t contentOffset = assets::CookedLoader::HEADER_SIZE;
+    const size_t stringTableOffset = contentOffset + content.size() * sizeof(uint32_t);
+    size_t stringDataOffset = stringTableOffset + strings.size() * 2 * sizeof(uint32_t);
+
+    size_t stringDataSize = 0;
+    for (const std::string& str : strings)
+        stringDataSize += str.size();
+
+    const size_t blobOffset = align(stringDataOffset + stringDataSize);
+
+    if (blobOffset > UINT32_MAX || blobs.size() > UINT32_MAX - blobOffset)
+        throw std::runtime_error("Cooked asset is too big");
+
+    std::vector<uint8_t> result(blobOffset + blobs.size());
+
+    encodeUInt32Little(result.data(), assets::CookedLoader::MAGIC);
+    encodeUInt32Little(result.data() + 4, assets::CookedLoader::VERSION);
+    encodeUInt32Little(result.data() + 8, type);
+    encodeUInt32Little(result.data() + 12, static_cast<uint32_t>(sizeof(graphics::Vertex)));
+    encodeUInt32Little(result.data() + 16, static_cast<uint32_t>(strings.size()));
+    encodeUInt32Little(result.data() + 20, static_cast<uint32_t>(stringTableOffset));
+    encodeUInt32Little(result.data() + 24, static_cast<uint32_t>(contentOffset));
+
+    std::vector<uint32_t> values = content;
+    for (size_t position : blobOffsets)
+        values[position] += static_cast<uint32_t>(blobOffset);
+
+    for (size_t i = 0; i < values.size(); ++i)
+        encodeUInt32Little(result.data() + contentOffset + i * sizeof(uint32_t), values[i]);
+
+    for (size_t i = 0; i < strings.size(); ++i)
+    {
+        uint8_t* entry = result.data() + stringTableOffset + i * 2 * sizeof(uint32_t);
+        encodeUInt32Little(entry, static_cast<uint32_t>(stringDataOffset));
+        encodeUInt32Little(entry + sizeof(uint32_t), static_cast<uint32_t>(strings[i].size()));
+
+        memcpy(result.data() + stringDataOffset, strings[i].data(), strings[i].size());
+        stringDataOffset += strings[i].size();
+    }
+
+    if (!blobs.empty())
+        memcpy(result.data() + blobOffset, blobs.data(), blobs.size());
+
+    return result;
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#ifndef COOKEDWRITER_HPP
+#define COOKEDWRITER_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// builds a cooked asset in the format read by ouzel::assets::CookedLoader
+// the content is written as a sequence of values, the strings and the blobs are appended after it
+class CookedWriter final
+{
+public:
+    explicit CookedWriter(uint32_t initType);
+
+    void writeUInt32(uint32_t value);
+    void writeFloat(float value);
+    // empty strings are written as NO_STRING, equal strings are stored once
+    void writeString(const std::string& str);
+    // writes the offset of the blob, the offset is fixed up in getData
+    void writeBlob(const void* blob, size_t size);
+
+    std::vector<uint8_t> getData() const;
+
+private:
+    uint32_t type;
+    std::vector<uint32_t> content;
+    std::vector<std::string> strings;
+    std::map<std::string, uint32_t> stringIndices;
+    std::vector<uint8_t> blobs;
+    std::vector<size_t> blobOffsets; // positions of the blob offsets in the content
+};
+
+#endif // COOKEDWRITER_HPP
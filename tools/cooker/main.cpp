@@ -0,0 +1,355 @@
+// Copyright (C) 2018 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#if defined(_WIN32)
+#  include <direct.h>
+#else
+#  include <sys/stat.h>
+#endif
+#include "ouzel.hpp"
+#include "CookedWriter.hpp"
+
+using namespace ouzel;
+
+class ValueWriter final
+{
+public:
+    explicit ValueWriter(CookedWriter& initWriter): writer(initWriter) {}
+
+    void operator()(uint32_t value) { writer.writeUInt32(value); }
+    void operator()(float value) { writer.writeFloat(value); }
+    void operator()(bool value) { writer.writeUInt32(value ? 1 : 0); }
+    template<class T> void operator()(T value) { writer.writeUInt32(static_cast<uint32_t>(value)); }
+
+private:
+    CookedWriter& writer;
+};
+
+static std::string getPath(const std::string& directory, const std::string& filename)
+{
+    return directory.empty() ? filename : directory + FileSystem::DIRECTORY_SEPARATOR + filename;
+}
+
+static void createDirectories(const std::string& path)
+{
+    if (path.empty()) return;
+
+    createDirectories(FileSystem::getDirectoryPart(path));
+
+#if defined(_WIN32)
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0777);
+#endif
+}
+
+static std::vector<uint8_t> cookImage(const FileData& data)
+{
+    graphics::ImageData image = assets::ImageLoader::decodeImage(data);
+
+    // the whole chain is stored, the loader drops the mip levels if they are not needed
+    std::vector<graphics::Texture::Level> levels = graphics::Texture::calculateLevels(image.getSize(), image.getData(),
+                                                                                      0, image.getPixelFormat());
+
+    CookedWriter writer(assets::Loader::IMAGE);
+    writer.writeUInt32(image.getSize().v[0]);
+    writer.writeUInt32(image.getSize().v[1]);
+    writer.writeUInt32(static_cast<uint32_t>(image.getPixelFormat()));
+    writer.writeUInt32(static_cast<uint32_t>(levels.size()));
+
+    for (const graphics::Texture::Level& level : levels)
+    {
+        writer.writeUInt32(level.size.v[0]);
+        writer.writeUInt32(level.size.v[1]);
+        writer.writeUInt32(level.pitch);
+        writer.writeBlob(level.data.data(), level.data.size());
+    }
+
+    return writer.getData();
+}
+
+static std::vector<uint8_t> cookSprite(const std::string& inputDirectory, const json::Node& document,
+                                       std::vector<assets::Asset>& dependencies)
+{
+    std::string imageFilename = document["meta"]["image"].as<std::string>();
+    dependencies.push_back(assets::Asset(assets::Loader::IMAGE, imageFilename));
+
+    // the texture coordinates depend on the size of the image
+    graphics::ImageData image = assets::ImageLoader::decodeImage(FileData(getPath(inputDirectory, imageFilename)));
+    const Size2<float> textureSize(static_cast<float>(image.getSize().v[0]),
+                                   static_cast<float>(image.getSize().v[1]));
+
+    std::vector<assets::SpriteLoader::FrameDescription> frames;
+    assets::SpriteLoader::parseFrames(document, textureSize, frames);
+
+    CookedWriter writer(assets::Loader::SPRITE);
+    writer.writeString(imageFilename);
+    writer.writeUInt32(static_cast<uint32_t>(frames.size()));
+
+    for (const assets::SpriteLoader::FrameDescription& frame : frames)
+    {
+        writer.writeString(frame.name);
+        writer.writeUInt32(static_cast<uint32_t>(frame.indices.size()));
+        writer.writeBlob(frame.indices.data(), getVectorSize(frame.indices));
+        writer.writeUInt32(static_cast<uint32_t>(frame.vertices.size()));
+        writer.writeBlob(frame.vertices.data(), getVectorSize(frame.vertices));
+    }
+
+    return writer.getData();
+}
+
+static std::vector<uint8_t> cookParticleSystem(const json::Node& document,
+                                               std::vector<assets::Asset>& dependencies)
+{
+    scene::ParticleSystemData particleSystemData;
+    if (!assets::ParticleSystemLoader::parseParticleSystemData(document, particleSystemData))
+        throw std::runtime_error("Invalid particle system");
+
+    std::string textureFilename = document["textureFileName"].as<std::string>();
+    dependencies.push_back(assets::Asset(assets::Loader::IMAGE, textureFilename));
+
+    CookedWriter writer(assets::Loader::PARTICLE_SYSTEM);
+    writer.writeString(particleSystemData.name);
+    writer.writeString(textureFilename);
+
+    // the loader checks the value count against its own
+    assets::CookedLoader::ValueCounter valueCounter;
+    assets::CookedLoader::visitParticleSystemValues(particleSystemData, valueCounter);
+    writer.writeUInt32(valueCounter.count);
+
+    ValueWriter valueWriter(writer);
+    assets::CookedLoader::visitParticleSystemValues(particleSystemData, valueWriter);
+
+    return writer.getData();
+}
+
+static std::vector<uint8_t> cookMaterials(const std::string& filename, const FileData& data,
+                                          std::vector<assets::Asset>& dependencies)
+{
+    std::vector<assets::MtlLoader::MaterialDescription> materials;
+    assets::MtlLoader::parseMaterials(filename, data, materials);
+
+    CookedWriter writer(assets::Loader::MATERIAL);
+    writer.writeUInt32(static_cast<uint32_t>(materials.size()));
+
+    for (const assets::MtlLoader::MaterialDescription& material : materials)
+    {
+        writer.writeString(material.name);
+        writer.writeString(material.diffuseTexture);
+        writer.writeString(material.ambientTexture);
+        writer.writeUInt32(material.diffuseColor.getIntValue());
+        writer.writeFloat(material.opacity);
+
+        if (!material.diffuseTexture.empty())
+            dependencies.push_back(assets::Asset(assets::Loader::IMAGE, material.diffuseTexture));
+        if (!material.ambientTexture.empty())
+            dependencies.push_back(assets::Asset(assets::Loader::IMAGE, material.ambientTexture));
+    }
+
+    return writer.getData();
+}
+
+static std::vector<uint8_t> cookStaticMeshes(const std::string& filename, const FileData& data,
+                                             std::vector<assets::Asset>& dependencies)
+{
+    std::vector<std::string> materialLibraries;
+    std::vector<assets::ObjLoader::ObjectDescription> objects;
+    assets::ObjLoader::parseObjects(filename, data, materialLibraries, objects);
+
+    CookedWriter writer(assets::Loader::STATIC_MESH);
+    writer.writeUInt32(static_cast<uint32_t>(materialLibraries.size()));
+
+    for (const std::string& materialLibrary : materialLibraries)
+    {
+        writer.writeString(materialLibrary);
+        dependencies.push_back(assets::Asset(assets::Loader::MATERIAL, materialLibrary));
+    }
+
+    writer.writeUInt32(static_cast<uint32_t>(objects.size()));
+
+    for (const assets::ObjLoader::ObjectDescription& object : objects)
+    {
+        writer.writeString(object.name);
+        writer.writeString(object.material);
+        for (float value : object.boundingBox.min.v) writer.writeFloat(value);
+        for (float value : object.boundingBox.max.v) writer.writeFloat(value);
+
+        // 16-bit indices are used if all the vertices can be addressed with them
+        if (object.vertices.size() <= 65536)
+        {
+            std::vector<uint16_t> indices(object.indices.begin(), object.indices.end());
+            writer.writeUInt32(sizeof(uint16_t));
+            writer.writeUInt32(static_cast<uint32_t>(indices.size()));
+            writer.writeBlob(indices.data(), getVectorSize(indices));
+        }
+        else
+        {
+            writer.writeUInt32(sizeof(uint32_t));
+            writer.writeUInt32(static_cast<uint32_t>(object.indices.size()));
+            writer.writeBlob(object.indices.data(), getVectorSize(object.indices));
+        }
+
+        writer.writeUInt32(static_cast<uint32_t>(object.vertices.size()));
+        writer.writeBlob(object.vertices.data(), getVectorSize(object.vertices));
+    }
+
+    return writer.getData();
+}
+
+static uint32_t getAssetType(const std::string& filename, const FileData& data)
+{
+    std::string extension = FileSystem::getExtensionPart(filename);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){ return std::tolower(c); });
+
+    if (extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "bmp" || extension == "tga")
+        return assets::Loader::IMAGE;
+    else if (extension == "mtl")
+        return assets::Loader::MATERIAL;
+    else if (extension == "obj")
+        return assets::Loader::STATIC_MESH;
+    else if (extension == "json")
+    {
+        json::Document document(data.toVector());
+
+        if (assets::SpriteLoader::isSpriteDocument(document.getRoot()))
+            return assets::Loader::SPRITE;
+
+        scene::ParticleSystemData particleSystemData;
+        if (assets::ParticleSystemLoader::parseParticleSystemData(document.getRoot(), particleSystemData))
+            return assets::Loader::PARTICLE_SYSTEM;
+    }
+
+    return assets::Loader::NONE;
+}
+
+// assets that can not be cooked are copied
+static void cookAsset(const std::string& inputDirectory, const std::string& outputDirectory,
+                      const assets::Asset& asset, std::vector<assets::Asset>& dependencies)
+{
+    FileData data(getPath(inputDirectory, asset.filename));
+
+    std::vector<uint8_t> result;
+    std::string extension = FileSystem::getExtensionPart(asset.filename);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){ return std::tolower(c); });
+
+    switch (asset.type)
+    {
+        case assets::Loader::IMAGE:
+            result = cookImage(data);
+            break;
+        case assets::Loader::SPRITE:
+        {
+            json::Document document(data.toVector());
+            if (assets::SpriteLoader::isSpriteDocument(document.getRoot()))
+                result = cookSprite(inputDirectory, document.getRoot(), dependencies);
+            else
+                result = data.toVector();
+            break;
+        }
+        case assets::Loader::PARTICLE_SYSTEM:
+            result = cookParticleSystem(json::Document(data.toVector()).getRoot(), dependencies);
+            break;
+        case assets::Loader::MATERIAL:
+            result = cookMaterials(asset.filename, data, dependencies);
+            break;
+        case assets::Loader::STATIC_MESH:
+            if (extension == "obj")
+                result = cookStaticMeshes(asset.filename, data, dependencies);
+            else
+                result = data.toVector();
+            break;
+        default:
+            result = data.toVector();
+            break;
+    }
+
+    std::string outputPath = getPath(outputDirectory, asset.filename);
+    createDirectories(FileSystem::getDirectoryPart(outputPath));
+
+    File file(outputPath, File::WRITE | File::CREATE | File::TRUNCATE);
+    file.write(result.data(), static_cast<uint32_t>(result.size()), true);
+}
+
+int main(int argc, char* argv[])
+{
+    std::string inputDirectory;
+    std::string outputDirectory;
+    std::deque<assets::Asset> assetQueue;
+    std::vector<std::string> filenames;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "-i" && i + 1 < argc)
+            inputDirectory = argv[++i];
+        else if (arg == "-o" && i + 1 < argc)
+            outputDirectory = argv[++i];
+        else
+            filenames.push_back(arg);
+    }
+
+    if (filenames.empty() || outputDirectory.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " [-i input directory] -o output directory file..." << std::endl;
+        std::cerr << "Files are relative to the input directory, bundle files (with an \"assets\" array) are cooked with all their assets" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        for (const std::string& filename : filenames)
+        {
+            FileData data(getPath(inputDirectory, filename));
+
+            if (FileSystem::getExtensionPart(filename) == "json")
+            {
+                json::Document document(data.toVector());
+                const json::Node& root = document.getRoot();
+
+                if (root.getType() == json::Node::Type::OBJECT && root.hasMember("assets"))
+                {
+                    for (const json::Node& asset : root["assets"])
+                        assetQueue.push_back(assets::Asset(asset["type"].as<uint32_t>(), asset["filename"].as<std::string>()));
+
+                    // the bundle file itself is copied
+                    assetQueue.push_back(assets::Asset(assets::Loader::NONE, filename));
+                    continue;
+                }
+            }
+
+            assetQueue.push_back(assets::Asset(getAssetType(filename, data), filename));
+        }
+
+        std::set<std::string> cooked;
+
+        while (!assetQueue.empty())
+        {
+            assets::Asset asset = assetQueue.front();
+            assetQueue.pop_front();
+
+            if (!cooked.insert(asset.filename).second) continue;
+
+            std::vector<assets::Asset> dependencies;
+            cookAsset(inputDirectory, outputDirectory, asset, dependencies);
+
+            std::cout << asset.filename << std::endl;
+
+            for (const assets::Asset& dependency : dependencies)
+                assetQueue.push_back(dependency);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}